@@ -1,2484 +1,4749 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#ifndef HMI_API_H
-#define HMI_API_H
-
-
-/* ======== API-Revision ======== */
-
-#define HMI_API_REV 1
-
-/* ======== IO-Types ======== */
-
-/* Possible IO-types */
-#define HMI_IO_CUSTOM 0
-#define HMI_IO_CDC_SERIAL 1
-#define HMI_IO_HID_3DTOUCHPAD 2
-
-/* ======== Declaration of hmi_t ======== */
-
-#ifndef HMI_NO_HMI_TYPEDEF
-typedef struct hmi_struct hmi_t;
-#endif
-
-/* hmi_custom.h allows to provide extra configuration and functionality
- * on a per project-basis.
- * This is mainly used by projects for embedded devices that provide their
- * IO-functionality and configuration this way.
- */
-#ifdef HMI_CUSTOM
-#include "hmi_custom.h"
-#endif
-
-#if defined(HMI_API_DYNAMIC) && defined(_WIN32)
-#   ifdef HMI_API_EXPORT
-#       define HMI_API __declspec(dllexport)
-#   else
-#       define HMI_API __declspec(dllimport)
-#   endif
-#else
-#   define HMI_API
-#endif
-
-#ifndef CDECL
-#   ifdef _WIN32
-#       define CDECL __cdecl
-#   else
-#       define CDECL
-#   endif
-#endif
-
-#ifndef HMI_UNDEFINED_VALUE
-#   define HMI_UNDEFINED_VALUE 0
-#endif
-
-/* ======== IO-related configuration ======== */
-
-/* Default IO-implementation */
-#ifndef HMI_IO
-#if defined(_WIN32) || defined(__linux__)
-#   define HMI_IO HMI_IO_HID_3DTOUCHPAD
-#else
-#   error "No IO-implementation selected"
-#endif
-#endif
-
-#if HMI_IO != HMI_IO_CUSTOM && HMI_IO != HMI_IO_HID_3DTOUCHPAD && \
-    HMI_IO != HMI_IO_CDC_SERIAL
-#   error "Unknown IO implementation selected"
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* ======== Error Codes ======== */
-
-/* Enum: hmi_error_t
- *
- * Error codes as returned by functions of the HMI API.
- *
- * HMI_NO_ERROR                - No Error Occured
- * HMI_NO_DATA                 - <hmi3d_retrieve_data> could not retrieve new data.
- *                               This code does not necessarily mark an error.
- * HMI_3D_SYSTEM_ERROR         - Last System_Status message contained an error state
- *                               See <hmi3d_get_system_error> and <hmi3d_system_error_t> for details.
- * HMI_NO_RESPONSE_ERROR       - Could not receive an response for the last sent instruction
- * HMI_MSG_MISSING_ERROR       - Request for message was acknowledged but no message or requested type
- *                               was received.
- * HMI_2D_BOOTLOADER_ERROR     - Last response to an 2D update function contained an error state
- *                               See <hmi2d_get_bootloader_error> and <hmi2d_bootloader_error_t> for details.
- * HMI_IO_ERROR                - There was some unspecified error during communication
- * HMI_IO_CTL_ERROR            - Configuration of the connection to the device failed with an error
- * HMI_IO_OPEN_ERROR           - Opening the connection to the device failed
- * HMI_IO_ENUM_ERROR           - Error during automatic device detection.
- *                               This error is specific to systems that provide automatic
- *                               device detection
- * HMI_BAD_PARAM_ERROR         - Parameter of a function call was invalid in that context
- * HMI_NO_IMPLEMENTATION_ERROR - The implementation of the called function is missing or incomplete
- */
-
-typedef enum {
-    HMI_NO_ERROR = 0,
-    HMI_NO_DATA = -1,
-    HMI_3D_SYSTEM_ERROR = -8,
-    HMI_NO_RESPONSE_ERROR = -9,
-    HMI_MSG_MISSING_ERROR = -10,
-    HMI_2D_BOOTLOADER_ERROR = -11,
-    HMI_IO_ERROR = -16,
-    HMI_IO_CTL_ERROR = -17,
-    HMI_IO_OPEN_ERROR = -18,
-    HMI_IO_ENUM_ERROR = -19,
-    HMI_BAD_PARAM_ERROR = -32,
-    HMI_NO_IMPLEMENTATION_ERROR = -48
-} hmi_error_t;
-
-/* Enum: hmi3d_system_error_t
- *
- * Error codes as returned from the MGC3130 system.
- *
- * hmi3d_system_NoError              - No error occured
- * hmi3d_system_UnknownCommand       - Message ID is unknown
- * hmi3d_system_InvalidSessionid     - Session ID is invalid or does not match (<3D Firmware Update>)
- * hmi3d_system_InvalidCrc           - CRC is invalid (<3D Firmware Update>)
- * hmi3d_system_InvalidLength        - Length is invalid (<3D Firmware Update>)
- * hmi3d_system_InvalidAddress       - Address is invalid (<3D Firmware Update>)
- * hmi3d_system_InvalidFunction      - Function id is invalid (<3D Firmware Update>)
- * hmi3d_system_ContentMismatch      - <hmi3d_UpdateFunction_VerifyOnly> found mismatch between
- *                                     sent data block and flash memory (<3D Firmware Update>)
- * hmi3d_system_WrongParameterAddr   - Parameter start address does not match
- *                                     Library Loader assumptions (<3D Firmware Update>)
- * hmi3d_system_WrongParameterValue  - Parameter Value is invalid
- * hmi3d_system_UnknownParameterID   - Parameter ID is invalid
- * hmi3d_system_WakeupHappened       - Device was sleeping and therefore could not
- *                                     process the request
- * hmi3d_system_LoaderUpdateStarted  - Library Loader Update has started (<3D Firmware Update>)
- * hmi3d_system_LoaderUpdateFinished - Library Loader Update has finished (<3D Firmware Update>)
- */
-typedef enum {
-    hmi3d_system_NoError = 0,
-    hmi3d_system_UnknownCommand = 0x01,
-    hmi3d_system_InvalidSessionid = 0x02,
-    hmi3d_system_InvalidCrc = 0x03,
-    hmi3d_system_InvalidLength = 0x04,
-    hmi3d_system_InvalidAddress = 0x05,
-    hmi3d_system_InvalidFunction = 0x06,
-    hmi3d_system_ContentMismatch = 0x08,
-    hmi3d_system_WrongParameterAddr = 0x0B,
-    hmi3d_system_WrongParameterValue = 0x14,
-    hmi3d_system_UnknownParameterID = 0x15,
-    hmi3d_system_WakeupHappened = 0x1A,
-    hmi3d_system_LoaderUpdateStarted = 0x80,
-    hmi3d_system_LoaderUpdateFinished = 0x81
-} hmi3d_system_error_t;
-
-
-/* ======== Common Functions ======== */
-
-/* Function: hmi_initialize
- *
- * Initializes hmi for further use. Resources that were aquired with
- * <hmi_initialize> have to be released with <hmi_cleanup> once they are
- * no longer needed.
- *
- * hmi - The <hmi_t>-instance to be initialized.
- *          New instances could be aquired with <hmi_create>.
- *
- * See also:
- *    <hmi_create>, <hmi_free>, <hmi_cleanup>
- */
-HMI_API void CDECL hmi_initialize(hmi_t *hmi);
-
-/* Function: hmi_cleanup
- *
- * Releases resources that were aquired by <hmi_initialize>.
- * 
- * See also:
- *    <hmi_initialize>
- */
-HMI_API void CDECL hmi_cleanup(hmi_t *hmi);
-
-/* ======== Logging ======== */
-
-#ifndef HMI_NO_LOGGING
-
-#include <stdarg.h>
-
-/* Function: hmi_log
- *
- * Calls the logger set with <hmi_set_logger> to do printf like output.
- *
- * fmt - The format string
- * ... - The extra parameters that are forwarded via va_list
- *
- * If not logger is set this function returns 0. Otherwise it returns
- * the return-value of the call to the logger-function.
- *
- * See also:
- *    <hmi_set_logger>
- */
-HMI_API int CDECL hmi_log(hmi_t *hmi, const char *fmt, ...);
-
-/* Typedef: hmi_logger_t
- *
- * Definition of the signature for logger functions.
- *
- * opaque - <hmi_log> will pass the opaque pointer provided with
- *          <hmi_set_logger>
- * fmt    - The format string
- * vlist  - List of the variadic arguments
- *
- * See also:
- *    <hmi_set_logger>
- */
-typedef int (CDECL* hmi_logger_t)(void *opaque,
-                                  const char *fmt,
-                                  va_list vlist);
-
-/* Function: hmi_set_logger
- *
- * Sets the logger implementation that is called by <hmi_log>.
- *
- * logger - A logger function accepting the opaque-pointer, format string
- *          and the variadic argument list as parameters
- * opaque - An opaque pointer that is provided on calls of logger as the
- *          first argument
- *
- * This function always return 0.
- *
- * An example of valid functions for logger is vfprintf.
- *
- * See also:
- *    <hmi_log>, <hmi_logger_t>
- */
-HMI_API int CDECL hmi_set_logger(hmi_t *hmi,
-                                    hmi_logger_t logger,
-                                    void *opaque);
-
-#endif
-
-/* ======== Connection Handling ======== */
-
-#if HMI_IO == HMI_IO_HID_3DTOUCHPAD
-
-/* Function: hmi_hid_set_details
- *
- * Sets the Vendor ID, Product ID, Report ID and Interface that is used by
- * the HID connection.
- *
- * vendor_id  - The Vendor ID of the device to open
- * product_id - The Product ID of the device to open
- * report_id  - The report ID to be used in the communication
- * iface      - The interface of the device to open (not needed on Windows)
- *
- * This function is only defined when compiled for communication with the
- * 3DTouchPad.
- *
- * It should be used when connection with different IDs than the default
- * is required. This is the case for example when connecting to the
- * 2D bootloader device during <2D Firmware Update>.
- */
-HMI_API void CDECL hmi_hid_set_details(hmi_t *hmi,
-                                       int vendor_id,
-                                       int product_id,
-                                       int report_id,
-                                       int iface);
-
-#endif
-
-/* Function: hmi_open
- *
- * Opens a connection to the physical device and associates it with hmi
- * that was already initialized with <hmi_initialize>.
- *
- * Returns 0 on success or a negative value on error.
- *
- * The connection has to be closed with <hmi_close> after use.
- *
- * See also:
- *    <hmi_initialize>, <hmi_close>
- */
-HMI_API int CDECL hmi_open(hmi_t *hmi);
-
-/* Function: hmi_close
- *
- * Closes the connection to the device associated with hmi that was
- * established with <hmi_open>.
- */
-HMI_API void CDECL hmi_close(hmi_t *hmi);
-
-/* Function: hmi3d_reset
- *
- * Tries to reset the 3D-device if this is supported by the system setup.
- *
- * Returns 0 on success or a negative value on error.
- *
- * Resetting the hardware is done by signaling the reset line of the chip.
- * This requires support by the hardware connection.
- */
-HMI_API int CDECL hmi3d_reset(hmi_t *hmi);
-
-/* ======== 3D Low Level Communication ======== */
-
-/* Enum: hmi3d_message_id_t
- *
- * Enumeration of message IDs sent from or to device.
- *
- * hmi3d_msg_System_Status         - Response to other messages
- * hmi3d_msg_Request_Message       - Request for a message sent by host
- * hmi3d_msg_Fw_Update_Start       - Starts <3D Firmware Update>
- * hmi3d_msg_Fw_Update_Block       - Content during <3D Firmware Update>
- * hmi3d_msg_Fw_Update_Completed   - Finishes <3D Firmware Update>
- * hmi3d_msg_Fw_Version_Info       - Contains FW Version data
- * hmi3d_msg_Sensor_Data_Output    - Contains different sensor data
- * hmi3d_msg_Set_Runtime_Parameter - Update of runtime parameter if from host
- *                                   Requested parameter value if from device
- *
- * Some of the message IDs are used for messages in both directions with a
- * different meaning.
- */
-typedef enum {
-    hmi3d_msg_System_Status = 0x15,
-    hmi3d_msg_Request_Message = 0x06,
-    hmi3d_msg_Fw_Update_Start = 0x80,
-    hmi3d_msg_Fw_Update_Block = 0x81,
-    hmi3d_msg_Fw_Update_Completed = 0x82,
-    hmi3d_msg_Fw_Version_Info = 0x83,
-    hmi3d_msg_Sensor_Data_Output = 0x91,
-    hmi3d_msg_Set_Runtime_Parameter = 0xA2,
-} hmi3d_message_id_t;
-
-/* Enum: hmi3d_parameter_id_t
- *
- * Enumeration of possible parameter ids.
- * For the correct arguments refer to the MGC3130 GestIC Library
- * Interface Description User's Guids or use the
- * <3D Real Time Control> functions.
- *
- * hmi3d_param_trigger                     - Trigger an action.
- *                                           See <hmi3d_trigger_action>
- * hmi3d_param_makePersistent              - Make changes persistent.
- * hmi3d_param_afeRxAtt_S                  - Signal Matching for South electrode
- * hmi3d_param_afeRxAtt_W                  - Signal Matching for West electrode
- * hmi3d_param_afeRxAtt_N                  - Signal Matching for North electrode
- * hmi3d_param_afeRxAtt_E                  - Signal Matching for East electrode
- * hmi3d_param_afeRxAtt_C                  - Signal Matching for Center electrode
- * hmi3d_param_channelmapping_S            - Physical channel for South electrode
- * hmi3d_param_channelmapping_W            - Physical channel for West electrode
- * hmi3d_param_channelmapping_N            - Physical channel for North electrode
- * hmi3d_param_channelmapping_E            - Physical channel for East electrode
- * hmi3d_param_channelmapping_C            - Physical channel for Center electrode
- * hmi3d_param_dspCalOpMode                - Calibration Operation Mode Flags.
- *                                           See <hmi3d_set_auto_calibration>
- * hmi3d_param_transFreqSelect             - Transmit Frequency Selection.
- *                                           See <hmi3d_select_frequencies>
- * hmi3d_param_dspGestureMask              - Mask for Gesture Processing.
- *                                           See <hmi3d_set_enabled_gestures>
- * hmi3d_param_dspAirWheelConfig           - Enables/Disables AirWheel.
- *                                           See <hmi3d_set_air_wheel_enabled>
- * hmi3d_param_dspTouchConfig              - Enables/Disables Touch Detection.
- *                                           See <hmi3d_set_touch_detection>
- * hmi3d_param_dspApproachDetectionMode    - Enables/Disables Approach Detection.
- *                                           See <hmi3d_set_approach_detection>
- * hmi3d_param_dataOutputEnableMask        - Determines the continuous data output of the device.
- *                                           See <hmi3d_set_output_enable_mask>
- * hmi3d_param_dataOutputLockMask          - Determines the continuous data output of the device.
- *                                           See <hmi3d_set_output_enable_mask>
- * hmi3d_param_dataOutputRequestMask       - Determines the data output for next message.
- * hmi3d_param_dataOutputGestureInProgress - Enables/Disables output of
- *                                           gestures in progress
- */
-typedef enum {
-    hmi3d_param_trigger = 0x1000,
-    hmi3d_param_makePersistent = 0xFF00,
-    hmi3d_param_afeRxAtt_S = 0x50,
-    hmi3d_param_afeRxAtt_W = 0x51,
-    hmi3d_param_afeRxAtt_N = 0x52,
-    hmi3d_param_afeRxAtt_E = 0x53,
-    hmi3d_param_afeRxAtt_C = 0x54,
-    hmi3d_param_channelmapping_S = 0x65,
-    hmi3d_param_channelmapping_W = 0x66,
-    hmi3d_param_channelmapping_N = 0x67,
-    hmi3d_param_channelmapping_E = 0x68,
-    hmi3d_param_channelmapping_C = 0x69,
-    hmi3d_param_dspCalOpMode = 0x80,
-    hmi3d_param_transFreqSelect = 0x82,
-    hmi3d_param_dspGestureMask = 0x85,
-    hmi3d_param_dspAirWheelConfig = 0x90,
-    hmi3d_param_dspTouchConfig = 0x97,
-    hmi3d_param_dspApproachDetectionMode = 0x97,
-    hmi3d_param_dataOutputEnableMask = 0xA0,
-    hmi3d_param_dataOutputLockMask = 0xA1,
-    hmi3d_param_dataOutputRequestMask = 0xA2,
-    hmi3d_param_dataOutputGestureInProgress = 0xA3
-} hmi3d_parameter_id_t;
-
-/* Enum: hmi3d_trigger_id_t
- *
- * Actions that could be triggered with <hmi3d_trigger_action>.
- *
- * hmi3d_trigger_calibration     - Triggers manual calibration
- *                                 (see also <hmi3d_force_calibration>).
- * hmi3d_trigger_enterDeepSleep1 - Enters deep sleep mode 1. Device will wake up
- *                                 at incoming messages or hardware reset
- *                                 (see also <hmi3d_reset>).
- * hmi3d_trigger_enterDeepSleep2 - Enters deep sleep mode 2. Device will wake up
- *                                 at falling edge on External Interrupt (IRQ0)
- *                                 or hardware reset (see also <hmi3d_reset>).
- *
- * See also:
- *    <hmi3d_trigger_action>, <hmi3d_param_trigger>
- */
-typedef enum {
-    hmi3d_trigger_calibration = 0x00,
-    hmi3d_trigger_enterDeepSleep1 = 0x01,
-    hmi3d_trigger_enterDeepSleep2 = 0x02
-} hmi3d_trigger_id_t;
-
-/* Enum: hmi3d_DataOutConfigMask_t
- *
- * Enumeration of flags for possible sensor data output.
- *
- * This enumeration is used for selecting what data to communicate
- * via <hmi3d_set_output_enable_mask> and in <hmi3d_msg_Sensor_Data_Output>
- * to mark available fields and the format of the raw sensor data.
- *
- * hmi3d_DataOutConfigMask_DSPStatus    - DSP related information like
- *                                        calibration events amnd frequency
- *                                        (accessed via <hmi3d_get_calibration>
- *                                        and <hmi3d_get_frequency>)
- * hmi3d_DataOutConfigMask_GestureInfo  - Gesture related data
- *                                        (accessible via <hmi3d_get_gesture>)
- * hmi3d_DataOutConfigMask_TouchInfo    - Touch related data
- *                                        (accessible via <hmi3d_get_touch>)
- * hmi3d_DataOutConfigMask_AirWheelInfo - AirWheel related data
- *                                        (accessible via <hmi3d_get_air_wheel>)
- * hmi3d_DataOutConfigMask_xyzPosition  - Position data (accessible via
- *                                        <hmi3d_get_position>)
- * hmi3d_DataOutConfigMask_NoisePower   - Noise power data (accessible via
- *                                        <hmi3d_get_noise_power>)
- * hmi3d_DataOutConfigMask_CICData      - Raw CIC sensor data (accessible via
- *                                        <hmi3d_get_cic>)
- * hmi3d_DataOutConfigMask_SDData       - SD sensor data (accessible via
- *                                        <hmi3d_get_sd>)
- *
- * The following are masks that are not directly related to data output.
- *
- * hmi3d_DataOutConfigMask_ElectrodeConfiguration - Mask for the electrode
- *                                        configuration. Only relevant for
- *                                        <hmi3d_msg_Sensor_Data_Output>
- *                                        message-handling.
- * hmi3d_DataOutConfigMask_OutputAll    - Mask for all data flags
- */
-typedef enum {
-    hmi3d_DataOutConfigMask_DSPStatus = 0x0001,
-    hmi3d_DataOutConfigMask_GestureInfo = 0x0002,
-    hmi3d_DataOutConfigMask_TouchInfo = 0x0004,
-    hmi3d_DataOutConfigMask_AirWheelInfo = 0x0008,
-    hmi3d_DataOutConfigMask_xyzPosition = 0x0010,
-    hmi3d_DataOutConfigMask_NoisePower = 0x0020,
-    hmi3d_DataOutConfigMask_CICData = 0x0800,
-    hmi3d_DataOutConfigMask_SDData = 0x1000,
-    /* Masks */
-    hmi3d_DataOutConfigMask_ElectrodeConfiguration = 0x0700,
-    hmi3d_DataOutConfigMask_OutputAll = 0x183F
-} hmi3d_DataOutConfigMask_t;
-
-/* Enum: hmi3d_SystemInfo_t
- *
- * Contains information about the system state and the content of the
- * containing <hmi3d_msg_Sensor_Data_Output> message.
- *
- * hmi3d_SystemInfo_PositionValid      - Contained position data is valid
- * hmi3d_SystemInfo_AirWheelValid      - Contained AirWheel data is valid
- * hmi3d_SystemInfo_RawDataValid       - Contained RawData fields are valid
- * hmi3d_SystemInfo_NoisePowerValid    - Contained noise-power data is valid
- * hmi3d_SystemInfo_EnvironmentalNoise - Environment noise was detected
- * hmi3d_SystemInfo_Clipping           - Sensor data values are clipped
- * hmi3d_SystemInfo_DSPRunning         - The signal processing (DSP) is running
- */
-typedef enum {
-    hmi3d_SystemInfo_PositionValid = 0x01,
-    hmi3d_SystemInfo_AirWheelValid = 0x02,
-    hmi3d_SystemInfo_RawDataValid = 0x04,
-    hmi3d_SystemInfo_NoisePowerValid = 0x08,
-    hmi3d_SystemInfo_EnvironmentalNoise = 0x10,
-    hmi3d_SystemInfo_Clipping = 0x20,
-    hmi3d_SystemInfo_DSPRunning = 0x80
-} hmi3d_SystemInfo_t;
-
-/* Enum: hmi3d_param_category
- *
- * Enumeration of possible categories for use with <hmi3d_make_persistent>.
- *
- * hmi3d_afe_category    - AFE Category
- * hmi3d_dsp_category    - DSP Category
- * hmi3d_system_category - System Category
- */
-typedef enum {
-    hmi3d_afe_category = 0,
-    hmi3d_dsp_category = 1,
-    hmi3d_system_category = 2
-} hmi3d_param_category;
-
-/* Function: hmi3d_send_message
- *
- * Sends a message to the device and waits for a response.
- *
- * msg     - Pointer to the message to send
- * size    - The size of the message as set in msg
- * timeout - Timeout in milliseconds to wait for a response
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * This function calls <wait_response> to wait for an response.
- * If <wait_response> returns an error this function retries up to three times
- * before it in turn returns an error to the caller.
- *
- * See also:
- *    <wait_response>, <hmi3d_set_param>, <hmi3d_trigger_action>
- */
-HMI_API int CDECL hmi3d_send_message(hmi_t *hmi,
-                                        void *msg,
-                                        int size,
-                                        int timeout);
-
-/* Function: hmi3d_set_param
- *
- * Sends the instruction for updating a runtime-parameter to the device.
- *
- * param   - The code for the parameter to update
- * arg0    - First parameter specific argument
- * arg1    - Second parameter specific argument
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_send_message>, <hmi3d_set_auto_calibration>,
- *    <hmi3d_select_frequencies>, <hmi3d_set_approach_detection>,
- *    <hmi3d_set_enabled_gestures>, <hmi3d_get_param>
- */
-HMI_API int CDECL hmi3d_set_param(hmi_t *hmi,
-                                     unsigned short param,
-                                     unsigned int arg0,
-                                     unsigned int arg1);
-
-/* Function: hmi3d_get_param
- *
- * Reads back a parameter from the device.
- *
- * param   - The code for the parameter to read
- * arg0    - Pointer where to store the first argument, could be NULL
- * arg1    - Pointer where to store the second argument, could be NULL
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * The read parameter arguments are stored in arg0 and arg1 if those pointers
- * are valid.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_param>
- */
-HMI_API int CDECL hmi3d_get_param(hmi_t *hmi,
-                                     unsigned short param,
-                                     unsigned int *arg0,
-                                     unsigned int *arg1);
-
-/* Function: hmi3d_trigger_action
- *
- * Sends the instruction for a specific action to the device.
- *
- * action  - The firmware-specific code for the action
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * The enumeration hmi3d_trigger_id_t provides the possible actions.
- *
- * See also:
- *    <hmi3d_send_message>, <hmi3d_force_calibration>
- */
-HMI_API int CDECL hmi3d_trigger_action(hmi_t *hmi,
-                                          unsigned short action);
-
-
-/* ======== 3D Data Retrieval ======== */
-
-#ifndef HMI3D_NO_DATA_RETRIEVAL
-
-/* Enumeration: hmi3d_gestures_t
- *
- * The gestures supported by the API
- *
- * hmi3d_gest_none  - No gesture detected
- * hmi3d_flick_w2e  - Flick from west to east detected
- * hmi3d_flick_e2w  - Flick from east to west was detected
- * hmi3d_flick_s2n  - Flick from south to north was detected
- * hmi3d_flick_n2s  - Flick from north to south was detected
- * hmi3d_circle_cw  - Clock-wise circle detected
- * hmi3d_circle_ccw - Counter-clock-wise circle detected
- */
-typedef enum {
-    hmi3d_gest_none    = 0x00,
-    hmi3d_flick_w2e    = 0x01,
-    hmi3d_flick_e2w    = 0x02,
-    hmi3d_flick_s2n    = 0x03,
-    hmi3d_flick_n2s    = 0x04,
-    hmi3d_circle_cw    = 0x05,
-    hmi3d_circle_ccw   = 0x06
-} hmi3d_gestures_t;
-
-/* Enumeration: hmi3d_gesture_flags_t
- *
- * Bitmask of gesture related flags:
- *
- * hmi3d_gesture_edge_flick  - The flick was actually an edge flick
- * hmi3d_gesture_in_progress - Gesture recognition is in progress.
- *                             Only set while recognizer is active and
- *                             gets reset once gesture got recognized.
- * hmi3d_gesture_flags_mask  - Mask of possible flags.
- */
-typedef enum {
-    hmi3d_gesture_edge_flick = 0x00010000,
-    hmi3d_gesture_in_progress = 0x80000000,
-    hmi3d_gesture_flags_mask = 0x80010000
-} hmi3d_gesture_flags_t;
-
-/* Enum: hmi3d_touch_flags_t
- *
- * Bitmask of gesture related flags
- *
- * hmi3d_touch_north  - Touch at north electrode detected
- * hmi3d_touch_east   - Touch at east electrode detected
- * hmi3d_touch_south  - Touch at south electrode detected
- * hmi3d_touch_west   - Touch at west electrode detected
- * hmi3d_touch_center - Touch at center electrode detected
- * hmi3d_touch_mask   - Mask for detected touchs
- */
-typedef enum {
-    hmi3d_touch_north = 0x04,
-    hmi3d_touch_east = 0x08,
-    hmi3d_touch_south = 0x01,
-    hmi3d_touch_west = 0x02,
-    hmi3d_touch_center = 0x10,
-    hmi3d_touch_mask = 0x1F
-} hmi3d_touch_flags_t;
-
-/* Enum: hmi3d_tap_flags_t
- *
- * Flags for the different tap events as they are communicated by the
- * <hmi3d_msg_Sensor_Data_Output> message.
- *
- * hmi3d_tap_north         - Tap on north electrode
- * hmi3d_tap_east          - Tap on east electrode
- * hmi3d_tap_south         - Tap on south electrode
- * hmi3d_tap_west          - Tap on west electrode
- * hmi3d_tap_center        - Tap on center electrode
- * hmi3d_double_tap_north  - Double tap on north electrode
- * hmi3d_double_tap_east   - Double tap on east electrode
- * hmi3d_double_tap_south  - Double tap on south electrode
- * hmi3d_double_tap_west   - Double tap on west electrode
- * hmi3d_double_tap_center - Double tap on center electrode
- * hmi3d_single_tap_mask   - Mask for tap events
- * hmi3d_double_tap_mask   - Mask for double tap events
- * hmi3d_tap_mask          - Mask for tap and double tap events
- *
- * Each tap results in the corresponding tap event while two consecutive taps
- * result in an additional double-tap event.
- */
-typedef enum {
-    hmi3d_tap_north = 0x0080,
-    hmi3d_tap_east = 0x0100,
-    hmi3d_tap_south = 0x0020,
-    hmi3d_tap_west = 0x0040,
-    hmi3d_tap_center = 0x0200,
-    hmi3d_double_tap_north = 0x1000,
-    hmi3d_double_tap_east = 0x2000,
-    hmi3d_double_tap_south = 0x0400,
-    hmi3d_double_tap_west = 0x0800,
-    hmi3d_double_tap_center = 0x4000,
-    hmi3d_single_tap_mask = 0x03E0,
-    hmi3d_double_tap_mask = 0x7C00,
-    hmi3d_tap_mask = 0x7FE0
-} hmi3d_tap_flags_t;
-
-/* Enumeration: hmi3d_calib_reason_t
- *
- * Bitmask of possible reasons for calibrations
- *
- * hmi3d_forced_calib     - Enforced with <hmi3d_force_calibration>
- * hmi3d_startup_calib    - Triggered during startup
- * hmi3d_gesture_calib    - Triggered after gesture
- * hmi3d_negative_calib   - Triggered to compensate negative values
- * hmi3d_idle_calib       - Triggered to compensate background noise
- * hmi3d_invalidity_calib - Triggered as signals exceeded their valid range
- * hmi3d_dsp_forced_calib - Internally triggered calibration
- */
-typedef enum {
-    hmi3d_forced_calib = 0x0002,
-    hmi3d_startup_calib = 0x0004,
-    hmi3d_gesture_calib = 0x0008,
-    hmi3d_negative_calib = 0x0010,
-    hmi3d_idle_calib = 0x0020,
-    hmi3d_invalidity_calib = 0x0040,
-    hmi3d_dsp_forced_calib = 0x0080,
-} hmi3d_calib_reason_t;
-
-/* Structure: hmi3d_signal_t
- *
- * Contains data for all channels of one type of signal.
- *
- * channel - The indvidual channels
- *
- * The channels are typically in the order
- * (south, west, north, east, center).
- *
- * See also:
- *    <hmi3d_get_cic>, <hmi3d_get_sd>
- */
-typedef struct {
-    float channel[5];
-} hmi3d_signal_t;
-
-/* Structure: hmi3d_position_t
- *
- * Contains position data that could be accessed with <hmi3d_get_position>.
- *
- * x - Ranges from 0 (west) to 65535 (east)
- * y - Ranges from 0 (south) to 65535 (north)
- * z - Ranges from 0 (touching) to 65535 (hand away)
- */
-typedef struct {
-    int x, y, z;
-} hmi3d_position_t;
-
-/* Structure: hmi3d_gesture_t
- *
- * Contains information about gestures
- *
- * gesture    - The type of the gesture (See <hmi3d_gesture_t>)
- * flags      - Flags for the gesture (See <hmi3d_gesture_flags_t>)
- * last_event - Count of samples since the last detected gesture
- *
- * gesture will be set only once. It will be reset to <hmi3d_gest_none> by the
- * next call to <hmi3d_retrieve_data> if no subsequent gesture occured.
- *
- * Gesture data could be accessed with <hmi3d_get_gesture>.
- *
- * Note:
- *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
- *    To be accurate the device isn't allowed to sleep and has to send at least
- *    one such message per second.
- *
- * Note:
- *    internally last_event is set to the count of samples between start-up
- *    and last gesture.
- */
-typedef struct {
-    hmi3d_gestures_t gesture;
-    hmi3d_gesture_flags_t flags;
-    int last_event;
-} hmi3d_gesture_t;
-
-/* Struct: hmi3d_touch_t
- *
- * Contains information about touch events.
- *
- * flags                  - Flags for the touch (See <hmi3d_touch_flags_t>)
- * last_event             - Count of samples since last touch event
- * tap_flags              - Flags for tap events
- * last_tap_event         - Count of samples since last tap event
- * last_touch_event_start - Count of samples since last touch event started
- *
- * Note:
- *    The *last_event fields are based on the TimeStamp field of
- *    SENSOR_DATA_OUTPUT message.
- *    To be accurate the device isn't allowed to sleep and has to send at least
- *    one such message per second.
- *
- * Note:
- *    internally the *last_event fiels are set to the count of samples between
- *    start-up and last gesture.
- */
-typedef struct {
-    hmi3d_touch_flags_t touch_flags;
-    int last_touch_event;
-    int last_touch_event_start;
-    hmi3d_tap_flags_t tap_flags;
-    int last_tap_event;
-} hmi3d_touch_t;
-
-/* Struct: hmi3d_air_wheel_t
- *
- * Contains information about AirWheel events.
- *
- * counter    - Counter which indicates how far the AirWheel rotation has
- *              progressed. Incrementing values indicate a clockwise rotation.
- *              Decrementing values indicate counter clockwise rotation.
- *              An increment of 32 approximates one full rotation.
- * active     - Boolean value indicating whether AirWheel is currently detected
- * last_event - Count of samples since last change of active
- *
- * Note:
- *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
- *    To be accurate the device isn't allowed to sleep and has to send at least
- *    one such message per second.
- *
- * Note:
- *    internally last_event is set to the count of samples between start-up
- *    and last gesture.
- */
-typedef struct {
-    int counter;
-    int active;
-    int last_event;
-} hmi3d_air_wheel_t;
-
-/* Structure: hmi3d_calib_t
- *
- * Contains information about calibrations.
- *
- * reason     - Reason of the calibration as OR-combination of
- *              <hmi3d_calib_reason_t>.
- * last_event - Count of samples since last calibration
- *
- * reason will be set only once. It will be reset to 0 by subsequent calls to
- * <hmi3d_retrieve_data> when no further calibration occurs.
- *
- * Calibration data could be accessed with <hmi3d_get_calibration>.
- * Calibrations are updated when <hmi3d_DataOutConfigMask_SDData> is set.
- *
- * See also:
- *    <hmi3d_set_auto_calibration>, <hmi3d_force_calibration>
- *
- * Note:
- *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
- *    To be accurate the device isn't allowed to sleep and has to send at least
- *    one such message per second.
- *
- * Note:
- *    internally last_event is set to the count of samples between start-up
- *    and last gesture.
- */
-typedef struct {
-    hmi3d_calib_reason_t reason;
-    int last_event;
-} hmi3d_calib_t;
-
-/* Structure: hmi3d_freq_t
- *
- * Contains information about the working frequency.
- *
- * frequency    - The currently active frequency in kHz
- * freq_changed - Boolean value set to 1 when last frequency changed during
- *                last call to <hmi3d_retrieve_data>
- * last_event   - Count of samples since last calibration
- *
- * Frequency data could be accessed with <hmi3d_get_frequency>.
- * Frequency is always updated when any data is retrieved.
- *
- * See also:
- *    <hmi3d_select_frequencies>
- *
- * Note:
- *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
- *    To be accurate the device isn't allowed to sleep and has to send at least
- *    one such message per second.
- *
- * Note:
- *    internally last_event is set to the count of samples between start-up
- *    and last gesture.
- */
-typedef struct {
-    int frequency;
-    int freq_changed;
-    int last_event;
-} hmi3d_freq_t;
-
-/* Structure: hmi3d_noise_power_t
- *
- * Contains current noise value
- *
- * value - The value of the noise power
- * valid - Not zero when value is valid or zero otherwise
- *
- * Noise power data is accessed with <hmi3d_get_noise_power>.
- * Or directly via hmi->results.noise_power when using the
- * static API.
- */
-typedef struct {
-    float value;
-    int valid;
-} hmi3d_noise_power_t;
-
-#endif
-
-#ifndef HMI3D_NO_DATA_RETRIEVAL
-
-/* Function: hmi3d_retrieve_data
- *
- * Retrieves the availabe data output from the device and updates the result
- * buffer.
- *
- * skipped - If a pointer to an integer is provided it will be updated with the
- *           count of skipped data-sets.
- *
- * Returns 0 on success or a negative <hmi_error_t> code if no new data is
- * available or the communication is broken.
- *
- * It is possible that multiple updates were received during calls to different
- * functions. In this case the buffer will contain an accumulation of received
- * data after this call and skipped will be set to the amount of skipped
- * data-sets.
- *
- * The fetched data could be accessed with the hmi3d_get_* functions.
- *
- * Note:
- *    <hmi3d_retrieve_data> may process only fragments of the incoming
- *    data. It is therefore usefull to call it repeatedly until no more data are
- *    available to keep it in sync with the device.
- *
- * See also:
- *    <hmi3d_get_cic>, <hmi3d_get_sd>,
- *    <hmi3d_get_position>, <hmi3d_get_gesture>, <hmi3d_get_calibration>
- */
-HMI_API int CDECL hmi3d_retrieve_data(hmi_t *hmi, int *skipped);
-
-#endif
-
-/* ======== 3D Firmware Version ======== */
-
-#ifndef HMI3D_NO_FW_VERSION
-
-/* Function: hmi3d_query_fw_version
- *
- * Reads the library version information.
- *
- * version  - Pointer to a buffer receiving the version string
- * v_length - Maximal length of version in bytes including the terminating 0.
- *
- * Note:
- *    The complete firmware-version-string has a maximum size of 120
- *    characters.
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- */
-HMI_API int CDECL hmi3d_query_fw_version(hmi_t *hmi,
-                                            char *version,
-                                            int v_length);
-
-#endif
-
-/* ======== 3D Real time control (RTC) ======== */
-
-#ifndef HMI3D_NO_DATA_RETRIEVAL
-
-/* Function: hmi3d_set_output_enable_mask
- *
- * Changes the data output of the 3D part of the device.
- *
- * flags   - Which data to be streamed as a combination of
- *           <hmi3d_DataOutConfigMask_t>-values
- * locked  - Which of the streamed data have to be always included in the
- *           message even when they have no valid data.
- * mask    - The mask of which data should get configured by this call
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_output_enable_mask>
- */
-HMI_API int CDECL hmi3d_set_output_enable_mask(hmi_t *hmi,
-                                               hmi3d_DataOutConfigMask_t flags,
-                                               hmi3d_DataOutConfigMask_t locked,
-                                               hmi3d_DataOutConfigMask_t mask);
-
-/* Function: hmi3d_get_output_enable_mask
- *
- * Reads back the mask of data output set in the 3D part of the device.
- *
- * flags   - Pointer to variable receiving which data is to be streamed as a
- *           combination of <hmi3d_DataOutConfigMask_t>-values. May be 0.
- * locked  - Pointer to variable receiving which of the streamed data has to
- *           be included always even though they are not valid. May be 0.
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of flags and locked is not defined.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_output_enable_mask>
- */
-HMI_API int CDECL hmi3d_get_output_enable_mask(hmi_t *hmi,
-                                               hmi3d_DataOutConfigMask_t *flags,
-                                               hmi3d_DataOutConfigMask_t *locked);
-
-#endif
-
-#ifndef HMI3D_NO_RTC
-
-/* Enumeration: hmi3d_frequencies_t
- *
- * Bitmask for working frequencies that could be enabled.
- * The actual frequencies depend on the library version in place and are listed
- * in the libraries manual.
- * The currently selected frequency may be fetched with <hmi3d_get_frequency>.
- *
- * hmi3d_freq1    - Frequency 1 enabled (highest)
- * hmi3d_freq2    - Frequency 2 enabled
- * hmi3d_freq3    - Frequency 3 enabled
- * hmi3d_freq4    - Frequency 4 enabled
- * hmi3d_freq5    - Frequency 5 enabled (lowest)
- * hmi3d_all_freq - All frequencies enabled
- *
- * See also:
- *    <hmi3d_select_frequencies>
- */
-typedef enum {
-    hmi3d_freq1 = 0x01,
-    hmi3d_freq2 = 0x02,
-    hmi3d_freq3 = 0x04,
-    hmi3d_freq4 = 0x08,
-    hmi3d_freq5 = 0x10,
-    hmi3d_all_freq = 0x1F
-} hmi3d_frequencies_t;
-
-/* Function: hmi3d_set_auto_calibration
- *
- * Enables automatic calibration if enabled is set to a value other than 0.
- *
- * enabled - Boolean value whether calibration is enabled
- *
- * Returns 0 if the change was succesfull or a negative value on failure.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_auto_calibration>, <hmi3d_force_calibration>,
- *    <hmi3d_get_calibration>
- */
-HMI_API int CDECL hmi3d_set_auto_calibration(hmi_t *hmi,
-                                             int enabled);
-
-/* Function: hmi3d_get_auto_calibration
- *
- * Reads back whether automatic calibration is enabled.
- *
- * enabled - Pointer to variable that receives the state of auto-calibration
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of enabled will not be changed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_auto_calibration>, <hmi3d_force_calibration>
- */
-HMI_API int CDECL hmi3d_get_auto_calibration(hmi_t *hmi,
-                                             int *enabled);
-
-/* Function: hmi3d_force_calibration
- *
- * Enforces a immediate calibration of the device.
- *
- * Returns 0 if the device acknoledged the calibration-request.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_auto_calibration>
- */
-HMI_API int CDECL hmi3d_force_calibration(hmi_t *hmi);
-
-/* Function: hmi3d_select_frequencies
- *
- * Selects which working frequencies are allowed.
- *
- * frequencies - Allowed frequencies as a combination of <hmi3d_frequencies_t>
- *
- * Selects the allowed working frequencies for the device. The allowed
- * frequencies are passed in the argument frequencies as a bitwise-or
- * combination of <hmi3d_frequencies_t>-values.
- *
- * Returns 0 if the change was successfull.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- */
-HMI_API int CDECL hmi3d_select_frequencies(hmi_t *hmi,
-                                           hmi3d_frequencies_t frequencies);
-
-/* Function: hmi3d_set_approach_detection
- *
- * Enables approach detection for power saving.
- *
- * enabled - Boolean value whether approach detection is enabled
- *
- * Returns 0 if the change was successfull.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_approach_detection>
- */
-HMI_API int CDECL hmi3d_set_approach_detection(hmi_t *hmi, int enabled);
-
-/* Function: hmi3d_get_approach_detection
- *
- * Reads back whether approach detection is enabled.
- *
- * enabled - Pointer to a variable receiving the state of the approach detection
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of enabled will not be changed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_approach_detection>
- */
-HMI_API int CDECL hmi3d_get_approach_detection(hmi_t *hmi, int *enabled);
-
-/* Function: hmi3d_set_enabled_gestures
- *
- * Makes certain gestures available for gesture recognition.
- *
- * gestures - Bitmask of gestures that are to be enabled
- *
- * Returns 0 if the enabled gestures was successfully changed.
- *
- * The individual gestures are represented as 1 shifted by the value of the
- * according <hmi3d_gestures_t>-constant. E.g. Horizontal flicks are
- * represented by (1 << hmi3d_flick_w2e) | (1 << hmi3d_flick_e2w)
- *
- * After a failure or no response within the timeout the request gest resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_enabled_gestures>, <hmi3d_get_gesture>
- */
-HMI_API int CDECL hmi3d_set_enabled_gestures(hmi_t *hmi, int gestures);
-
-/* Function: hmi3d_get_enabled_gestures
- *
- * Reads back which gestures are currently available for gesture detection.
- *
- * gestures - Pointer to a variable receiving the bitmask of enabled gestures
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of gestures will not be changed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_enabled_gestures>
- */
-HMI_API int CDECL hmi3d_get_enabled_gestures(hmi_t *hmi, int *gestures);
-
-/* Function: hmi3d_set_touch_detection
- *
- * En-/Disables touch detection.
- *
- * enabled - Boolean value whether touch detection is enabled
- *
- * Returns 0 if the change was successfull.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_touch_detection>, <hmi3d_get_touch>
- */
-HMI_API int CDECL hmi3d_set_touch_detection(hmi_t *hmi, int enabled);
-
-/* Function: hmi3d_get_touch_detection
- *
- * Reads back whether touch detection is enabled
- *
- * enabled - Pointer to a variable receiving the state of touch-detection
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of enabled will not be changed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_touch_detection>
- */
-HMI_API int CDECL hmi3d_get_touch_detection(hmi_t *hmi, int *enabled);
-
-/* Function: hmi3d_set_air_wheel_enabled
- *
- * En-/Disables AirWheel.
- *
- * enabled - Boolean value whether AirWheel is enabled
- *
- * Returns 0 if the change was successfull.
- *
- * If AirWheel is enabled no circle-gestures could be detected.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_get_air_wheel_enabled>, <hmi3d_get_air_wheel>
- */
-HMI_API int CDECL hmi3d_set_air_wheel_enabled(hmi_t *hmi, int enabled);
-
-/* Function: hmi3d_get_air_wheel_enabled
- *
- * Reads back whether the AirWheel-feature is enabled
- *
- * enabled - Pointer to a variable receiving the state of AirWheel-feature
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * If the request failed the content of enabled will not be changed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * See also:
- *    <hmi3d_set_air_wheel_enabled>
- */
-HMI_API int CDECL hmi3d_get_air_wheel_enabled(hmi_t *hmi, int *enabled);
-
-/* Function: hmi3d_make_persistent
- *
- * Stores current value for all parameters of a category to the flash.
- *
- * category - Parameter category which should be stored
- *
- * Returns 0 if parameters where successfully stored or
- * the negative error-code on failure.
- *
- * After a failure or no response within the timeout the request gets
- * resend up to three times.
- *
- * See also:
- *    <hmi3d_set_param>, <hmi3d_param_category>
- */
-HMI_API int CDECL hmi3d_make_persistent(hmi_t *hmi,
-                                        hmi3d_param_category category);
-
-#endif
-
-/* ======== 3D Firmware Update Functions ======== */
-
-#ifndef HMI3D_NO_UPDATE
-
-/* Enumeration: hmi3d_UpdateFunction_t
- *
- * The mode of the update-session
- *
- * hmi3d_UpdateFunction_ProgramFlash - Records will be written to the flash
- * hmi3d_UpdateFunction_VerifyOnly   - Code will only be verified but not
- *                                     changed in flash.
- * hmi3d_UpdateFunction_Restart      - Only used internally for final restart.
- *                                     Don't provide this to the hmi3d_update_*
- *                                     functions
- *
- * If a session gets started by calling <hmi3d_update_begin> with
- * <hmi3d_UpdateFunction_VerifyOnly> no other value is allowed in subsequent
- * <hmi3d_update_write> calls.
- *
- * If a session gets started with <hmi3d_UpdateFunction_ProgramFlash> it has to
- * be finished with <hmi3d_UpdateFunction_ProgramFlash> too in order to have a
- * valid firmware.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
- *    <hmi3d_update_write>
- */
-typedef enum {
-    hmi3d_UpdateFunction_ProgramFlash = 0,
-    hmi3d_UpdateFunction_VerifyOnly = 1,
-    hmi3d_UpdateFunction_Restart = 3
-} hmi3d_UpdateFunction_t;
-
-/* Structure: hmi3d_update_record_t
- *
- * Contains one record of a firmware library image.
- *
- * address - The address of the record aligned to 128 bytes
- * length  - The length of the data packed in the record.
- *           This is NOT the size of the record itself.
- * record  - The 128-byte long content of the record.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_image_t>
- */
-typedef struct {
-    unsigned short address;
-    unsigned char length;
-    unsigned char data[128];
-} hmi3d_update_record_t;
-
-/* Structure: hmi3d_update_image_t
- *
- * Contains the data of a library image as required by <hmi3d_update_image>
- *
- * record_count - The actual count of records
- * iv           - The initialization vector.
- * fw_version   - The version containing an ASCII-string
- * data         - The first of record_count records
- *
- * For instructions on how to obtain an hmi3d_update_image_t instance see
- * <3D Firmware Update>.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>
- */
-typedef struct {
-    int record_count;
-    unsigned char iv[14];
-    unsigned char fw_version[120];
-    hmi3d_update_record_t data[1];
-} hmi3d_update_image_t;
-
-/* Function: hmi3d_update_begin
- *
- * Starts a flash session to update the contained firmware-library
- *
- * session_id - A random session-id. Can be any value except 0.
- * iv         - The 14-byte long initialization vector.
- *              It is provided as part of the library-image.
- * mode       - The mode for this session
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * This function resets the device and starts an session for updating the
- * contained firmware-library. The session has to be finished with
- * hmi3d_update_end or another reset to cancel it.
- *
- * Note:
- *    If the mode is <hmi3d_UpdateFunction_VerifyOnly> subsequent calls to
- *    <hmi3d_update_write> have to be called with the same mode.
- *    <hmi3d_update_end> implicitely uses the same mode to finish the session.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_write>,
- *    <hmi3d_update_end>
- */
-HMI_API int CDECL hmi3d_update_begin(hmi_t *hmi,
-                                     unsigned int session_id,
-                                     void *iv,
-                                     hmi3d_UpdateFunction_t mode);
-
-/* Function: hmi3d_update_write
- *
- * Writes one record during a flash session
- *
- * address - The address of the record, This is part of the library-image
- * length  - The size of the data packed in the record.
- *           This is NOT the size of the record
- * record  - The 128-byte long data of the record
- * mode    - The update-mode for this record.
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * The address is aligned to 128 bytes and the record is always 128-bytes long
- * independant of size-argument. If the provided record is less than 128-bytes
- * the rest of the record has to be filled with zeros.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * Note:
- *    If <hmi3d_update_begin> was called with <hmi3d_UpdateFunction_VerifyOnly>
- *    this mode has to be used in the <hmi3d_update_write> too.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
- *    <hmi3d_update_end>
- */
-HMI_API int CDECL hmi3d_update_write(hmi_t *hmi,
-                                     unsigned short address,
-                                     unsigned char length,
-                                     unsigned char *record,
-                                     hmi3d_UpdateFunction_t mode);
-
-/* Function: hmi3d_update_end
- *
- * Finishes the flash process and ends the flash session.
- *
- * version - The 120-byte long library-version containing an ASCII-string
- *           It is provided as part of the the firmware image
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * This function ends the flash session by finally writing the version-string
- * and resetting the device. After this function returns the device
- * needs some time until it finishes the reset and subsequent start-up
- * procedure. <hmi3d_wait_for_version_info> waits until the
- * wanted start-up procedure sends the firmware version message which
- * marks that the library loader is ready (first call) or the library itself
- * is ready (second call).
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * Note:
- *    The final reset triggered by <hmi3d_update_end> may be delayed by
- *    the firmware for a few seconds. This could be shortened by a manual
- *    <hmi3d_reset> about 200 milliseconds after <hmi3d_update_end> succeeded.
- *
- * Important:
- *    After flashing of loader-updates the chip requires some time
- *    (about 20-25 seconds) to complete the update before it is ready for
- *    flashing the firmware. <hmi3d_update_wait_loader_done> does the
- *    required check.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
- *    <hmi3d_update_write>
- */
-HMI_API int CDECL hmi3d_update_end(hmi_t *hmi,
-                                   unsigned char *version);
-
-/* Function: hmi3d_update_image
- *
- * Does the whole process of writing the image to device including the resets.
- *
- * session_id - A random session-id. Can be any value except 0.
- * image      - Ptr to a <hmi3d_update_image_t>-structure containing the image.
- *
- * Returns 0 on success or a negative value when the request failed.
- *
- * Runs the whole process of flashing the firmware library on the provided
- * image. This includeds the initial and final restarts of the device.
- * If the image is not available in a <hmi3d_update_image_t>-structure the
- * functions <hmi3d_update_begin>, <hmi3d_update_write> and <hmi3d_update_end>
- * could be used directly.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- *
- * Important:
- *    After flashing of loader-updates the chip requires some time to
- *    complete the update before it is ready for flashing the firmware.
- *    <hmi3d_update_wait_loader_done> does the required check.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_begin>, <hmi3d_update_write>,
- *    <hmi3d_update_end>
- */
-HMI_API int CDECL hmi3d_update_image(hmi_t *hmi,
-                                     unsigned int session_id,
-                                     hmi3d_update_image_t *image,
-                                     hmi3d_UpdateFunction_t mode);
-
-/* Function: hmi3d_update_wait_loader_done
- *
- * Waits until loader update is finished.
- *
- * Return 0 on success or a negative value when request failed.
- *
- * Call this function after a loader got uploaded to the chip to ensure
- * that it was completely processed and stored in flash before starting
- * the firmware-update.
- *
- * Note:
- *    An bootloader update can take up to 20 seconds.
- *
- * Important:
- *    Only call this function after a loader-upload.
- *    Otherwise it will fail and return an error.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_end>
- */
-HMI_API int CDECL hmi3d_update_wait_loader_done(hmi_t *hmi);
-
-/* Function: hmi3d_wait_for_version_info
- *
- * After a reset waits until version info message was received.
- *
- * Return 0 on success or the negative <hmi_error_t> code
- * when request failed.
- *
- * This function waits after a reset until the library loader
- * version info was received. At this point the loader is ready
- * to receive instructions.
- *
- * Note:
- *    <hmi3d_update_begin> already contains the reset and waiting
- *    until the loader is ready. There is no need to do an extra
- *    call to <hmi3d_reset> and <hmi3d_wait_for_version_info>
- *
- * A second subsequent call will wait until the library version
- * information was received. At that point the GestIC library is
- * completely operational.
- *
- * Note:
- *    This function is only intended to be used for waiting until
- *    the different start-up states are finished.
- *
- * See also:
- *    <3D Firmware Update>, <hmi3d_reset>
- */
-HMI_API int CDECL hmi3d_wait_for_version_info(hmi_t *hmi);
-#endif
-
-/* ======== 2D Low Level Communication ======== */
-
-/* Enum: hmi2d_msg_receive_id_t
- *
- * IDs for incoming messages from the 2D subsystem as processed by this library
- *
- * hmi2d_msg_r_update       - Response to <hmi2d_msg_t_update>
- * hmi2d_msg_r_parameter    - One parameter entry as response to
- *                            <hmi2d_msg_t_get_param>
- * hmi2d_msg_r_mutual_raw_0 - First row of raw sensor data
- * hmi2d_msg_r_mutual_raw_f - Last row of raw sensor data
- * hmi2d_msg_r_mutual_cal_0 - First row of calibrated sensor data
- * hmi2d_msg_r_mutual_cal_f - Last row of calibrated sensor data
- * hmi2d_msg_r_ack          - Acknowledge of command
- * hmi2d_msg_r_mouse_btns   - State of the emulated mouse-buttons
- * hmi2d_msg_r_gesture      - Gestures as used for keyboard-emulation
- * hmi2d_msg_r_finger_pos   - List of finger positions
- * hmi2d_msg_r_self_raw     - Raw self scan sensor data
- * hmi2d_msg_r_self_measure - Calibrated self scan sensor data
- * hmi2d_msg_r_3d_subsystem - Message that was forwarded from 3D subsystem
- * hmi2d_msg_r_fw_version   - FW Version as response to <hmi2d_msg_t_fw_version>
- */
-typedef enum {
-    hmi2d_msg_r_update = 0x55,
-    hmi2d_msg_r_parameter = 0xCF,
-    hmi2d_msg_r_mutual_raw_0 = 0xD0,
-    hmi2d_msg_r_mutual_raw_f = 0xDF,
-    hmi2d_msg_r_mutual_cal_0 = 0xE0,
-    hmi2d_msg_r_mutual_cal_f = 0xEF,
-    hmi2d_msg_r_ack = 0xF0,
-    hmi2d_msg_r_mouse_btns = 0xF6,
-    hmi2d_msg_r_gesture = 0xF7,
-    hmi2d_msg_r_finger_pos = 0xF8,
-    hmi2d_msg_r_self_raw = 0xFA,
-    hmi2d_msg_r_self_measure = 0xFD,
-    hmi2d_msg_r_3d_subsystem = 0xFE,
-    hmi2d_msg_r_fw_version = 0xFF
-} hmi2d_msg_receive_id_t;
-
-/* Enum: hmi2d_msg_transmit_id_t
- *
- * IDs for outgoing messages for the 2D-subsystem as sent by this library
- *
- * hmi2d_msg_t_update       - <2D Firmware Update> related messages.
- *                            The exact meaning depends on the data of the
- *                            message.
- * hmi2d_msg_t_set_param    - Command to change the value of a parameter.
- *                            The related API function is <hmi2d_set_param>.
- * hmi2d_msg_t_get_param    - Query for the current value of a parameter.
- *                            The related API function is <hmi2d_get_param>.
- * hmi2d_msg_t_3d_reset     - Command to do a hard reset of the
- *                            3D subsystem. It gets sent by <hmi3d_reset> when
- *                            compiled for communication with the 3DTouchPad.
- * hmi2d_msg_t_3d_subsystem - Command that are addressed to the 3D subsystem.
- *                            Gets sent by <hmi3d_message_write>
- *                            when compiled for use with the 3DTouchPad.
- * hmi2d_msg_t_fw_version   - Query for the version of the 2D firmware.
- *                            The related API function is
- *                            <hmi2d_query_fw_version>.
- */
-typedef enum {
-    hmi2d_msg_t_update = 0x55,
-    hmi2d_msg_t_set_param = 0xE0,
-    hmi2d_msg_t_get_param = 0xE1,
-    hmi2d_msg_t_3d_reset = 0xFC,
-    hmi2d_msg_t_3d_subsystem = 0xFD,
-    hmi2d_msg_t_fw_version = 0xFF
-} hmi2d_msg_transmit_id_t;
-
-/* Enum: hmi2d_parameter_id_t
- *
- * IDs of parameters for the 2D-subsystem that are supported by this library
- *
- * hmi2d_param_com_mask             - Mask for communicated messages as set by
- *                                    <hmi2d_set_com_mask>
- * hmi2d_param_active_mask          - Mask of active features as set by
- *                                    <hmi2d_set_active_mask>
- * hmi2d_param_operation_mode       - 2D/3D operation mode as set by
- *                                    <hmi2d_set_operation_mode>
- *
- * hmi2d_param_swipeBorderLeft      - Left border of of swipe region.
- *                                    Swipes have to start outside the region.
- *                                    The whole board has range [0,0]-[512,384]
- * hmi2d_param_swipeBorderRight     - Right border of swipe region.
- * hmi2d_param_swipeBorderTop       - Top border of swipe region.
- * hmi2d_param_swipeBorderBottom    - Bottom border of swipe region.
- * hmi2d_param_clickBorderLeft      - Left border of click region.
- *                                    Clicks will only be detected inside.
- *                                    The whole board has range [0,0]-[512,384]
- * hmi2d_param_clickBorderRight     - Right border of swipe region.
- * hmi2d_param_clickBorderTop       - Top border of swipe region.
- * hmi2d_param_clickBorderBottom    - Bottom border of swipe region.
- * hmi2d_param_autoMovBorderHorz    - Horizontal border for automatic movement
- *                                    at edges (0 = no auto-mov region,
- *                                    512/2 = the border takes the whole board)
- * hmi2d_param_autoMovBorderVert    - Vertical border for automatic movement at
- *                                    edges (0 = no auto-mov region,
- *                                    512/2 = the border takes the whole board)
- * hmi2d_param_autoMovSpeedX        - Speed of horizontal automatic movement
- * hmi2d_param_autoMovSpeedY        - Speed of vertical automatic movement
- * hmi2d_param_autoMovDragSpeedX    - Speed of horizontal movement while dragging
- * hmi2d_param_autoMovDragSpeedY    - Speed of vertical movement while dragging
- * hmi2d_param_autoMovScrollSpeedX  - Speed of automatic horizontal scrolling
- * hmi2d_param_autoMovScrollSpeedY  - Speed of automatic Vertical scrolling
- * hmi2d_param_scrollSpeedX         - Horizontal scroll speed
- * hmi2d_param_scrollSpeedY         - Vertical scroll speed
- * hmi2d_param_scrollStartThreshold - Minimal movement to start scrolling
- * hmi2d_param_scrollInertiaX       - To what degree horizontal scrolling
- *                                    continues after fingers were raised
- * hmi2d_param_scrollInertiaY       - To what degree vertical scrolling
- *                                    continues after fingers were raised
- *
- * There are parameters for the key combinations that are sent to the host in
- * case of an detected gesture. Each of those key-combos consists of four
- * parameters:
- *
- * send - Defines under which conditions the key-combo should be emitted
- * key1 - The first key of the combo
- * key2 - The second key of the combo
- * key3 - The third and last key of the combo
- *
- * The sends parameter is the one of the key-combo parameters that is used by
- * <hmi2d_set_key_combo> to identify the parameters for the key-combo.
- * The send parameters are:
- *
- * hmi2d_param_outkeyFlickL_send   - Flick right to left key-combo
- * hmi2d_param_outkeyFlickR_send   - Flick left to right key-combo
- * hmi2d_param_outkeyFlickU_send   - Flick bottom to top key-combo
- * hmi2d_param_outkeyFlickD_send   - Flick top to bottom key-combo
- * hmi2d_param_outkeySwipe1FL_send - Swipe from right edge key-combo
- * hmi2d_param_outkeySwipe1FR_send - Swipe from left edge key-combo
- * hmi2d_param_outkeySwipe1FU_send - Swipe from bottom edge key-combo
- * hmi2d_param_outkeySwipe1FD_send - Swipe from top edge key-combo
- *
- * See also:
- *    <hmi2d_set_param>, <hmi2d_get_param>, <2D Real Time Control>
- */
-typedef enum {
-    hmi2d_param_com_mask = 0x0080,
-    hmi2d_param_active_mask = 0x0081,
-    hmi2d_param_operation_mode = 0x0082,
-
-    hmi2d_param_swipeBorderLeft = 0x0502,
-    hmi2d_param_swipeBorderRight = 0x0503,
-    hmi2d_param_swipeBorderTop = 0x0504,
-    hmi2d_param_swipeBorderBottom = 0x0505,
-    hmi2d_param_clickBorderLeft = 0x0540,
-    hmi2d_param_clickBorderRight = 0x0541,
-    hmi2d_param_clickBorderTop = 0x0542,
-    hmi2d_param_clickBorderBottom = 0x0543,
-    hmi2d_param_autoMovBorderHorz = 0x0600,
-    hmi2d_param_autoMovBorderVert = 0x0601,
-    hmi2d_param_autoMovSpeedX = 0x0602,
-    hmi2d_param_autoMovSpeedY = 0x0603,
-    hmi2d_param_autoMovDragSpeedX = 0x0604,
-    hmi2d_param_autoMovDragSpeedY = 0x0605,
-    hmi2d_param_autoMovScrollSpeedX = 0x0606,
-    hmi2d_param_autoMovScrollSpeedY = 0x0607,
-    hmi2d_param_scrollSpeedX = 0x06A0,
-    hmi2d_param_scrollSpeedY = 0x06A1,
-    hmi2d_param_scrollStartThreshold = 0x6A2,
-    hmi2d_param_scrollInertiaX = 0x6A4,
-    hmi2d_param_inertStartThresX = 0x6A5,
-    hmi2d_param_inertStopThresX = 0x6A6,
-    hmi2d_param_scrollInertiaY = 0x6A8,
-    hmi2d_param_inertStartThresY = 0x6A9,
-    hmi2d_param_inertStopThresY = 0x6AA,
-
-    hmi2d_param_outkeyFlickL_send = 0x1000,
-    hmi2d_param_outkeyFlickL_key1 = 0x1001,
-    hmi2d_param_outkeyFlickL_key2 = 0x1002,
-    hmi2d_param_outkeyFlickL_key3 = 0x1003,
-    hmi2d_param_outkeyFlickR_send = 0x1010,
-    hmi2d_param_outkeyFlickR_key1 = 0x1011,
-    hmi2d_param_outkeyFlickR_key2 = 0x1012,
-    hmi2d_param_outkeyFlickR_key3 = 0x1013,
-    hmi2d_param_outkeyFlickU_send = 0x1020,
-    hmi2d_param_outkeyFlickU_key1 = 0x1021,
-    hmi2d_param_outkeyFlickU_key2 = 0x1022,
-    hmi2d_param_outkeyFlickU_key3 = 0x1023,
-    hmi2d_param_outkeyFlickD_send = 0x1030,
-    hmi2d_param_outkeyFlickD_key1 = 0x1031,
-    hmi2d_param_outkeyFlickD_key2 = 0x1032,
-    hmi2d_param_outkeyFlickD_key3 = 0x1033,
-    hmi2d_param_outkeySwipe1FL_send = 0x1100,
-    hmi2d_param_outkeySwipe1FL_key1 = 0x1101,
-    hmi2d_param_outkeySwipe1FL_key2 = 0x1102,
-    hmi2d_param_outkeySwipe1FL_key3 = 0x1103,
-    hmi2d_param_outkeySwipe1FR_send = 0x1110,
-    hmi2d_param_outkeySwipe1FR_key1 = 0x1111,
-    hmi2d_param_outkeySwipe1FR_key2 = 0x1112,
-    hmi2d_param_outkeySwipe1FR_key3 = 0x1113,
-    hmi2d_param_outkeySwipe1FU_send = 0x1120,
-    hmi2d_param_outkeySwipe1FU_key1 = 0x1121,
-    hmi2d_param_outkeySwipe1FU_key2 = 0x1122,
-    hmi2d_param_outkeySwipe1FU_key3 = 0x1123,
-    hmi2d_param_outkeySwipe1FD_send = 0x1130,
-    hmi2d_param_outkeySwipe1FD_key1 = 0x1131,
-    hmi2d_param_outkeySwipe1FD_key2 = 0x1132,
-    hmi2d_param_outkeySwipe1FD_key3 = 0x1133,
-    hmi2d_param_outkeyApproach_send = 0x1140,
-    hmi2d_param_outkeyApproach_key1 = 0x1141,
-    hmi2d_param_outkeyApproach_key2 = 0x1142,
-    hmi2d_param_outkeyApproach_key3 = 0x1143,
-} hmi2d_parameter_id_t;
-
-/* Function: hmi2d_set_param
- *
- * This functions sets a parameter in the 2D subsystem.
- *
- * param - The id of the parameter to be set
- * arg0  - The first arg of the parameter.
- *         This is normaly the parameter value itself
- * arg1  - The second arg of the parameter. If not stated otherwise this is
- *         the mask of the bits of the parameter that have to be changed.
- *         To change all flags or to set a scalar parameter set this to ~0.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_get_param>, <hmi2d_parameter_id_t>, <2D Real Time Control>
- */
-HMI_API int CDECL hmi2d_set_param(hmi_t *hmi, hmi2d_parameter_id_t param,
-                                  int arg0, int arg1);
-
-/* Function: hmi2d_get_param
- *
- * This function fetches a parameter from the 2D subsystem
- *
- * param - The id of the parameter to fetch
- * arg0  - Pointer to an integer receiving the value of the parameter
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_set_param>, <hmi2d_parameter_id_t>
- */
-HMI_API int CDECL hmi2d_get_param(hmi_t *hmi, hmi2d_parameter_id_t param,
-                                  unsigned int *arg0);
-
-
-/* ======== 2D Data Retrieval ======== */
-
-#ifndef HMI2D_NO_DATA_RETRIEVAL
-
-/* Enum: hmi2d_mouse_button_t
- *
- * Possible mouse buttons that could be emitted by the mouse emulation of the
- * 2D subsystem.
- *
- * hmi2d_mouse_left_btn   - Left mouse button clicked
- * hmi2d_mouse_right_btn  - Middle mouse button clicked
- * hmi2d_mouse_middle_btn - Right mouse button clicked
- */
-typedef enum {
-    hmi2d_mouse_left_btn   = 0x01,
-    hmi2d_mouse_right_btn  = 0x02,
-    hmi2d_mouse_middle_btn = 0x04
-} hmi2d_mouse_button_t;
-
-/* Enum: hmi2d_gesture_id_t
- *
- * hmi2d_no_gesture         - No gesture detected
- * hmi2d_edge_swipe1f_left  - Leftward swipe with one finger from the right edge
- * hmi2d_edge_swipe1f_right - Rightward swipe with one finger from the left edge
- * hmi2d_edge_swipe1f_up    - Upward swipe with one finger from the bottom edge
- * hmi2d_edge_swipe1f_down  - Downward swipe with one finger from the top edge
- * hmi2d_flick_left         - Leftward flick (from 3D subsystem)
- * hmi2d_flick_right        - Rightward flick (from 3D subsystem)
- * hmi2d_flick_up           - Upward flick (from 3D subsystem)
- * hmi2d_flick_down         - Downward flick (from 3D subsystem)
- * hmi2d_approach_detected  - Approach detected (from 3D subsystem)
- * hmi2d_pinch_narrowing    - Narrowing pinch
- * hmi2d_pinch_widening     - Widening pinch
- *
- */
-typedef enum {
-    hmi2d_no_gesture = 0x00,
-    hmi2d_edge_swipe1f_left  = 0x10,
-    hmi2d_edge_swipe1f_right = 0x11,
-    hmi2d_edge_swipe1f_up    = 0x12,
-    hmi2d_edge_swipe1f_down  = 0x13,
-    hmi2d_flick_left         = 0x20,
-    hmi2d_flick_right        = 0x21,
-    hmi2d_flick_up           = 0x22,
-    hmi2d_flick_down         = 0x23,
-    hmi2d_approach_detected  = 0x30,
-    hmi2d_pinch_narrowing    = 0x40,
-    hmi2d_pinch_widening     = 0x41
-} hmi2d_gesture_id_t;
-
-/* Typedef: hmi2d_row_t
- *
- * One row of sensor data.
- */
-typedef int hmi2d_row_t[16];
-
-/* Typedef: hmi2d_block_t
- *
- * One block of sensor data.
- * Rows that were not update on the last <hmi2d_retrieve_data> call are set to
- * zero.
- */
-typedef hmi2d_row_t hmi2d_block_t[16];
-
-/* Struct: hmi2d_finger_pos_t
- *
- * Structure containig touch related data for one finger.
- *
- * x         - X-position of finger
- * y         - Y-position of finger
- * finger_id - An ID of the finger as assigned by the signal processing
- */
-typedef struct {
-    int x;
-    int y;
-    int finger_id;
-} hmi2d_finger_pos_t;
-
-/* Struct: hmi2d_finger_pos_list_t
- *
- * Structure containing touch related data for all fingers.
- *
- * count - The number of active entries in this list.
- * entry - The individual <hmi2d_finger_pos_t> -entries
- */
-typedef struct {
-    int count;
-    hmi2d_finger_pos_t entry[10];
-} hmi2d_finger_pos_list_t;
-
-// NOTE This is for debugging purpose
-/* Struct: hmi2d_mouse_t
- *
- * Structure containing data about the state of the mouse emulation.
- *
- * button_state  - Currently pressed buttons as <hmi2d_mouse_button_t> -flags
- * press_event   - Emulated mouse buttons pressed since the last update
- * release_event - Emulated mouse buttons release since the last update
- */
-typedef struct {
-    hmi2d_mouse_button_t button_state;
-    hmi2d_mouse_button_t press_event;
-    hmi2d_mouse_button_t release_event;
-} hmi2d_mouse_t;
-
-/* Struct: hmi2d_gesture_t
- *
- * Structure containing gesture data as used by the keyboard emulation.
- *
- * gesture - The id of the detected gesture (See <hmi2d_gesture_id_t>)
- */
-typedef struct {
-    hmi2d_gesture_id_t gesture;
-} hmi2d_gesture_t;
-
-/* Function: hmi2d_retrieve_data
- *
- * Retrieves incoming data from the 2D subsystem and updates result buffers.
- *
- * Returns HMI_NO_ERROR on success, HMI_NO_DATA if no data was available
- * for retrieval or a negative error code in case of an error.
- *
- * See also:
- *    <2D Data Retrieval>
- */
-HMI_API int CDECL hmi2d_retrieve_data(hmi_t *hmi);
-
-#endif
-
-/* ======== 2D Real Time Control (RTC) ======== */
-
-#ifndef HMI2D_NO_RTC
-
-/* Enum: hmi2d_operation_mode_t
- *
- * hmi2d_mixed_mode  - Both 2D and 3D processing is enabled.
- * hmi2d_2d_mode     - Only 2D subsystem is enabled.
- * hmi2d_3d_mode     - Only 3D subsystem and 3D-based event generation
- *                     are enabled.
- * hmi2d_bridge_mode - 2D system is reduced to pure forwarding of messages.
- *                     No event generation is done.
- *
- * The default on device-startup is <hmi2d_mixed_mode>.
- *
- * Note:
- *    Communication with the 3D subsystem requires
- *    <hmi2d_com_3d_messages> to be set. Without it <hmi2d_3d_mode> is
- *    limited to gestures as accessible with <hmi2d_get_gesture> and
- *    <hmi2d_bridge_mode> will result in no data output at all.
- *
- * See also:
- *    <hmi2d_set_operation_mode>, <hmi2d_set_com_mask>,
- *    <hmi2d_com_3d_messages>
- */
-typedef enum {
-    hmi2d_mixed_mode = 0,
-    hmi2d_2d_mode = 1,
-    hmi2d_3d_mode = 2,
-    hmi2d_bridge_mode = 3
-} hmi2d_operation_mode_t;
-
-/* Function: hmi2d_set_operation_mode
- *
- * Sets operation mode for 2D subsystem.
- *
- * mode - The new operation mode
- *
- * Note:
- *    Communication with the 3D subsystem requires
- *    <hmi2d_com_3d_messages> to be set. Without it <hmi2d_3d_mode> is
- *    limited to gestures as accessible with <hmi2d_get_gesture> and
- *    <hmi2d_bridge_mode> will result in no data output at all.
- *
- * See also:
- *    <hmi2d_get_operation_mode>, <hmi2d_operation_mode_t>, <hmi2d_set_param>,
- *    <hmi2d_set_com_mask>, <hmi2d_com_3d_messages>
- */
-HMI_API int CDECL hmi2d_set_operation_mode(hmi_t *hmi,
-                                           hmi2d_operation_mode_t mode);
-
-/* Function: hmi2d_get_operation_mode
- *
- * Gets the currently active operation mode of the 2D subsystem.
- *
- * mode - Pointer <hmi2d_operation_mode_t> variable that receives the mode
- *
- * See also:
- *    <hmi2d_set_operation_mode>, <hmi2d_operation_mode_t>, <hmi2d_get_param>
- */
-HMI_API int CDECL hmi2d_get_operation_mode(hmi_t *hmi,
-                                           hmi2d_operation_mode_t *mode);
-
-/* Enum: hmi2d_active_mask_t
- *
- * hmi2d_active_gesture_recognition     - Gesture processing is enabled
- * hmi2d_active_lock_scroll_dir         - Disables simultaneous scrolling in
- *                                        horizontal and vertical direction
- * hmi2d_active_full_mutual             - Full mutal scanning is enabled
- * hmi2d_active_mouse_buttons           - Emiting of emulated mouse buttons
- * hmi2d_active_mouse_movement          - Emiting of emulated mouse movement
- * hmi2d_active_flick_events            - Emiting of keys based on flick events
- * hmi2d_active_swipe_events            - Emiting of keys based on swipe events
- * hmi2d_active_air_wheel_scroll_events - Emiting of scroll events based on
- *                                        AirWheel
- * hmi2d_active_scroll_events           - Emiting of two-finger scroll events
- * hmi2d_active_pinch_events            - Emiting of pinch events
- * hmi2d_active_default                 - Default state after device startup
- * hmi2d_active_all                     - Mask of all defined flags
- *
- * The gesture based HID events (<hmi2d_active_mouse_buttons>,
- * <hmi2d_active_mouse_movement>, <hmi2d_active_flick_events>,
- * <hmi2d_active_swipe_events>, <hmi2d_active_air_wheel_scroll_events>,
- * <hmi2d_active_scroll_events>) also require <hmi2d_active_gesture_recognition>
- * in order to detect the events for emiting.
- *
- * See also:
- *    <hmi2d_set_active_mask>
- */
-typedef enum {
-    hmi2d_active_gesture_recognition = 0x0001,
-    hmi2d_active_lock_scroll_dir = 0x0002,
-    hmi2d_active_full_mutual = 0x0004,
-    hmi2d_active_mouse_buttons = 0x0008,
-    hmi2d_active_mouse_movement = 0x0010,
-    hmi2d_active_flick_events = 0x0020,
-    hmi2d_active_swipe_events = 0x0040,
-    hmi2d_active_air_wheel_scroll_events = 0x0080,
-    hmi2d_active_scroll_events = 0x0100,
-    hmi2d_active_pinch_events = 0x0200,
-    hmi2d_active_default = 0x03F9,
-    hmi2d_active_all = 0x03FF
-} hmi2d_active_mask_t;
-
-/* Function: hmi2d_set_active_mask
- *
- * Sets/changes mask of activated processings.
- *
- * active - Bitmask of active events
- * mask   - Bitmask of which flags should be changed ~0 changes all flags
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_get_active_mask>, <hmi2d_active_mask_t>, <hmi2d_set_param>
- */
-HMI_API int CDECL hmi2d_set_active_mask(hmi_t *hmi, hmi2d_active_mask_t active,
-                                        hmi2d_active_mask_t mask);
-
-/* Function: hmi2d_get_active_mask
- *
- * Gets the mask of activated processings.
- *
- * active - Pointer to <hmi2d_active_mask_t> variable that receives the mask
- *
- * Return HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_set_active_mask>, <hmi2d_active_mask_t>, <hmi2d_get_param>
- */
-HMI_API int CDECL hmi2d_get_active_mask(hmi_t *hmi,
-                                        hmi2d_active_mask_t *active);
-
-/* Function: hmi2d_set_full_mutual
- *
- * Enables/disables full-mutual mode.
- *
- * enabled - Boolean whether full-mutual is enabled
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_get_full_mutual>, <hmi2d_set_param>, <hmi2d_set_com_mask>
- */
-HMI_API int CDECL hmi2d_set_full_mutual(hmi_t *hmi, int enabled);
-
-/* Function: hmi2d_get_full_mutual
- *
- * Gets current state of mutual mode.
- *
- * enabled - Pointer to boolean variable receiving the state
- *
- * See also:
- *    <hmi2d_set_full_mutual>. <hmi2d_get_param>, <hmi2d_get_com_mask>
- */
-HMI_API int CDECL hmi2d_get_full_mutual(hmi_t *hmi, int *enabled);
-
-/* Enum: hmi2d_com_mask_t
- *
- * hmi2d_com_cal_self_measure   - Output of calibrated self-scan data
- *                                accessed via <hmi2d_get_self_cal>
- * hmi2d_com_cal_mutual_measure - Output of calibrated mutual-scan data
- *                                accessed via <hmi2d_get_mutual_cal>
- * hmi2d_com_raw_self_measure   - Output of raw self-scan data
- *                                accessed via <hmi2d_get_self_raw>
- * hmi2d_com_raw_mutual_measure - Output of raw mutual-scan data
- *                                accessed via <hmi2d_get_mutual_raw>
- * hmi2d_com_finger_positions   - Output of finger positions
- *                                accessed via <hmi2d_get_finger_positions>
- * hmi2d_com_gestures           - Output of gesture events
- *                                accessed via <hmi2d_get_gesture>
- *                                Requires <hmi2d_active_gesture_recognition>
- * hmi2d_com_mouse_buttons      - Output of mouse button state
- *                                accessed via <hmi2d_get_mouse>
- *                                Requires <hmi2d_active_gesture_recognition>
- * hmi2d_com_3d_messages        - Required for 3D communication
- * hmi2d_com_default            - Default value after device-startup
- * hmi2d_com_all                - Mask of all defined flags
- *
- * <hmi2d_com_3d_messages> is required for all 3D communication in
- * either direction. Without it the direct communication between the host and
- * the 3D subsystem is disabled. However events like flicks might still be
- * accessed via <hmi2d_get_gesture> when <hmi2d_com_gestures> is set.
- *
- * <hmi2d_com_gestures> and <hmi2d_com_mouse_buttons> require that gesture
- * recognition is activated (see <hmi2d_active_gesture_recognition> ) in order
- * to produce any events.
- *
- * See also:
- *    <hmi2d_set_com_mask>, <hmi2d_get_com_mask>
- */
-typedef enum {
-    hmi2d_com_cal_self_measure = 0x0001,
-    hmi2d_com_cal_mutual_measure = 0x0002,
-    hmi2d_com_raw_self_measure = 0x0004,
-    hmi2d_com_raw_mutual_measure = 0x0008,
-    hmi2d_com_finger_positions = 0x0800,
-    hmi2d_com_gestures = 0x1000,
-    hmi2d_com_mouse_buttons = 0x2000,
-    hmi2d_com_3d_messages = 0x8000,
-    hmi2d_com_default = 0x0000,
-    hmi2d_com_all = 0xB80F,
-} hmi2d_com_mask_t;
-
-/* Function: hmi2d_set_com_mask
- *
- * Sets mask of what messages should be sent to the host.
- *
- * enabled - Bitmask containing flags for enabled messages
- * mask    - Bitmask of which flags should be affected by this change
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * Note:
- *    Always set <hmi2d_com_3d_messages> when direct communication
- *    with the 3D subsystem is required. Otherwise communication via functions
- *    with the hmi3d_-prefix will fail.
- *
- * See also:
- *    <hmi2d_get_com_mask>, <hmi2d_com_mask_t>, <hmi2d_set_param>,
- *    <hmi2d_set_full_mutual>, <hmi2d_set_operation_mode>
- */
-HMI_API int CDECL hmi2d_set_com_mask(hmi_t *hmi,
-                                     hmi2d_com_mask_t enabled,
-                                     hmi2d_com_mask_t mask);
-
-/* Function: hmi2d_get_com_mask
- *
- * Gets current mask of what messages should be sent to the host.
- *
- * enabled - Pointer to <hmi2d_com_mask_t> variable receiving the maks.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_set_com_mask>, <hmi2d_com_mask_t>, <hmi2d_get_param>,
- *    <hmi2d_get_full_mutual>
- */
-HMI_API int CDECL hmi2d_get_com_mask(hmi_t *hmi, hmi2d_com_mask_t *enabled);
-
-/* Enum: hmi2d_event_cond_t
- *
- * Possible conditions for event generation
- *
- * hmi2d_event_disabled  - Event will never cause key-emulation or similar
- * hmi2d_event_on_single - Single event will cause key-emulation
- * hmi2d_event_on_double - Double event will cause key-emulation
- *
- * Note:
- *    <hmi2d_event_on_double> only has an effect for flicks. For other events
- *    will be processed as if <hmi2d_event_on_single> was selected.
- *
- * See also:
- *    <hmi2d_key_combo_t>, <hmi2d_set_key_combo>
- */
-typedef enum {
-    hmi2d_event_disabled = 0,
-    hmi2d_event_on_single = 1,
-    hmi2d_event_on_double = 2,
-} hmi2d_event_cond_t;
-
-/* Struct: hmi2d_key_combo_t
- *
- * cond - Condition for sending the associated key-combo
- * key  - The keys of the key combo
- *
- * The values of the keys are the same as specified in the USB HID Usage Tables.
- *
- * See also:
- *    <hmi2d_set_key_combo>, <hmi2d_event_cond_t>
- */
-typedef struct {
-    hmi2d_event_cond_t cond;
-    int key[3];
-} hmi2d_key_combo_t;
-
-/* Function: hmi2d_set_key_combo
- *
- * Sets the parameters related to one key-combo-mapping
- *
- * param - The id of the send-parameter of the key-combo
- * combo - The combo itself
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_get_key_combo>, <hmi2d_key_combo_t>, <hmi2d_parameter_id_t>,
- *    <hmi2d_set_param>
- */
-HMI_API int CDECL hmi2d_set_key_combo(hmi_t *hmi, int param,
-                                      hmi2d_key_combo_t *combo);
-
-/* Function: hmi2d_get_key_combo
- *
- * Gets the parameters related to one key-combo-mapping
- *
- * param - The id of the send-parameter of the key-combo
- * combo - Pointer to <hmi2d_key_combo_t> instance receiving the key-combo
- *
- * Return HMI_NO_ERROR on success or a negative error code.
- *
- * See aslo:
- *    <hmi2d_set_key_combo>, <hmi2d_key_combo_t>, <hmi2d_parameter_id_t>,
- *    <hmi2d_get_param>
- */
-HMI_API int CDECL hmi2d_get_key_combo(hmi_t *hmi, int param,
-                                      hmi2d_key_combo_t *combo);
-
-#endif
-
-/* ======== 2D Firmware Version ======== */
-
-/* Struct: hmi2d_version_info_t
- *
- * Structure for the 2D firmware version.
- *
- * See also:
- *    <hmi2d_query_fw_version>
- */
-typedef struct {
-    unsigned short svn_revision;
-    unsigned char wc_mixed;
-    unsigned char wc_modified;
-    unsigned short build_year;
-    unsigned char build_month;
-    unsigned char build_day;
-    unsigned char build_hour;
-    unsigned char build_minute;
-    unsigned char build_second;
-    char buildBy[9];
-    char infoString[76];
-    unsigned int checksum;
-    unsigned int fw_app_id;
-    unsigned char fw_version[4];
-} hmi2d_version_info_t;
-
-/* Function: hmi2d_query_fw_version
- *
- * Queries the version of the currently running 2D firmware and stores it
- * to the provided version argument.
- *
- * version - Pointer to a memory location where to store the retrieved
- *           firmware version
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * See also:
- *    <hmi2d_version_info_t>, <2D Firmware Update>
- */
-HMI_API int CDECL hmi2d_query_fw_version(hmi_t *hmi,
-                                         hmi2d_version_info_t *version);
-
-
-/* ======== 2D Firmware Update Functions ======== */
-
-#ifndef HMI2D_NO_UPDATE
-
-/* Enum: hmi2d_bootloader_error_t
- *
- */
-typedef enum {
-    hmi2d_bl_no_error = 0,
-    hmi2d_bl_flash_erase_error = 6,
-    hmi2d_bl_checksum_mismatch_error = 7,
-    hmi2d_bl_block_count_error = 8,
-    hmi2d_bl_flash_write_error = 9,
-    hmi2d_bl_out_of_ragne_address_error = 10,
-    hmi2d_bl_bootloader_locked_error = 11,
-    hmi2d_bl_unrecognized_command_error = 12,
-    hmi2d_bl_number_of_bytes_error = 13,
-    hmi2d_bl_hex_file_error = 14
-} hmi2d_bootloader_error_t;
-
-/* Enum: HMI_PROG
- *
- * A few values that are used in the <2D Firmware Update>.
- *
- * HMI2D_PROG_MEM_START    - Address of first byte of firmware
- * HMI2D_PROG_MEM_END      - Address of first byte after firmware
- * HMI2D_PROG_MEM_SIZE     - Size of firmware in bytes
- * HMI2D_PROG_PAGE_SIZE    - Size of memory pages (for erasing)
- * HMI2D_PROG_BLOCK_SIZE   - Size of single update block
- * HMI2D_PROG_BLOCK_COUNT  - Count of blocks in the firmware image
- * HMI2D_PROG_ERASED_VALUE - Value that is used in erased memory
- */
-enum {
-    HMI2D_PROG_MEM_START = 0x1d003000,
-    HMI2D_PROG_MEM_END = 0x1d010000,
-    HMI2D_PROG_MEM_SIZE = HMI2D_PROG_MEM_END - HMI2D_PROG_MEM_START,
-    HMI2D_PROG_PAGE_SIZE = 0x1000,
-    HMI2D_PROG_BLOCK_SIZE = 0x200,
-    HMI2D_PROG_BLOCK_COUNT = HMI2D_PROG_MEM_SIZE / HMI2D_PROG_BLOCK_SIZE,
-    HMI2D_PROG_ERASED_VALUE = 0xFFFFFFFF
-};
-
-/* Typedef: hmi2d_update_block_t
- *
- * Typedef for one single block of the firmware image.
- */
-typedef char hmi2d_update_block_t[HMI2D_PROG_BLOCK_SIZE];
-
-/* Typedef: hmi2d_update_image_t
- *
- * Typedef for the complete image.
- */
-typedef hmi2d_update_block_t hmi2d_update_image_t[HMI2D_PROG_BLOCK_COUNT];
-
-/* Function: hmi2d_update_enter_bootloader
- *
- * Enters the bootloader-mode for 2D firmware update.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * This instruction has to be sent to 2D firmware in order to access
- * 2D bootloader device. It is not needed if already connected to the
- * 2D bootloader device.
- *
- * After a successfull call to hmi2d_update_enter_bootloader the connection
- * to the 2D device has to be closed and a connection to the
- * 2D bootloader device has to be opened. It might take some time until this
- * device is accessible as Windows has to install drivers first.
- *
- * The <Update2D Application> demonstrates this.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>,
- *    <hmi2d_update_exit_bootloader>
- */
-HMI_API int CDECL hmi2d_update_enter_bootloader(hmi_t *hmi);
-
-/* Function: hmi2d_update_unlock
- *
- * Unlocks the memory for the 2D firmware update.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * This instruction has to be sent to the 2D bootloader device. If connected
- * to normal 2D device <hmi2d_update_enter_bootloader> has to be called first
- * with a subsequent reconnect to the 2D bootloader device.
- *
- * The next step affter hmi2d_update_unlock is a call to
- * <hmi2d_update_erase_memory>.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>
- */
-HMI_API int CDECL hmi2d_update_unlock(hmi_t *hmi);
-
-/* Function: hmi2d_update_erase_memory
- *
- * Erases the memory of the 2D firmware.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * <hmi2d_update_erase_memory> has to be called while connected to the
- * 2D bootloader device after the memory was unlocked.
- * It is followed by programming the new image with either
- * <hmi2d_update_flash_memory> for the whole image or by individual calls
- * to <hmi2d_update_flash_block>.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_memory>
- */
-HMI_API int CDECL hmi2d_update_erase_memory(hmi_t *hmi);
-
-/* Function: hmi2d_update_flash_block
- *
- * Writes one block of the firmware image.
- *
- * addr  - Address of the first byte of the block
- * block - The block to be written
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * An alternative to calling hmi2d_update_flash_block for each block of the
- * firmware image individually would be to call <hmi2d_update_flash_memory>
- * once for the whole image.
- *
- * The <Update2D Application> demonstrates the use of hmi2d_update_flash_block
- * in order to give detailed feedback on the progress of the update.
- *
- * Once the whole 2D firmware image was written the bootloader mode could
- * be left by calling <hmi2d_update_exit_bootloader>.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_memory>
- */
-HMI_API int CDECL hmi2d_update_flash_block(hmi_t *hmi,
-                                           int addr,
-                                           hmi2d_update_block_t *block);
-
-/* Function: hmi2d_update_flash_memory
- *
- * Writes the whole 2D firmware image at once.
- *
- * image - The image to be written.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * hmi2d_update_flash_memory has to be called after erasing the memory while
- * connected to the 2D bootloader device.
- *
- * If detailed feedback on the progress is needed <hmi2d_update_flash_block>
- * could be called for each block of the image instead of
- * <hmi2d_update_flash_memory>.
- *
- * Once the whole 2D firmware image was written the bootloader mode could
- * be left by calling <hmi2d_update_exit_bootloader>.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_block>
- */
-HMI_API int CDECL hmi2d_update_flash_memory(hmi_t *hmi,
-                                            hmi2d_update_image_t *image);
-
-/* Function: hmi2d_update_exit_bootloader
- *
- * Exits the 2D bootloader mode.
- *
- * Returns HMI_NO_ERROR on success or a negative error code.
- *
- * This instruction has to be sent to the 2D bootloader firmware in order to
- * start the normal operation of the 2D firmware. If a 2D firmware update was
- * already started it has to be completed in order to successfully leave the
- * 2D bootloader mode.
- *
- * After a successfull call to hmi2d_update_exit_bootloader the connection
- * to the 2D bootloader device has to be closed and a connection to the
- * normal 2D device has to be opened in order to be used.
- * It might take some time until this device is accessible as Windows might
- * have to install drivers first.
- *
- * The <Update2D Application> demonstrates how to do a complete 2D firmware
- * update.
- *
- * See also:
- *    <Update2D Application>, <2D Firmware Update>,
- *    <hmi2d_update_enter_bootloader>
- */
-HMI_API int CDECL hmi2d_update_exit_bootloader(hmi_t *hmi);
-
-#endif
-
-/* Include the dynamic API that has to be used when accessing
- * the HMI-library via dynamic linking.
- * This is required because the exact configuration of the dynamic
- * library and therefore the structure of hmi_t is unknown.
- */
-#if defined(HMI_API_DYNAMIC) || defined(HMI_HAS_DYNAMIC)
-#include "hmi_dynamic.h"
-#endif
-
-/* Include the static part of the API that is not accessible
- * to applications linking dynamically against the HMI-library.
- */
-#if defined(HMI_API_EXPORT) || !defined(HMI_API_DYNAMIC)
-#include "hmi_static.h"
-#endif
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* HMI_API_H */
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#ifndef HMI_API_H
+#define HMI_API_H
+
+
+/* ======== API-Revision ======== */
+
+#define HMI_API_REV 1
+
+/* ======== IO-Types ======== */
+
+/* Possible IO-types */
+#define HMI_IO_CUSTOM 0
+#define HMI_IO_CDC_SERIAL 1
+#define HMI_IO_HID_3DTOUCHPAD 2
+
+/* ======== Declaration of hmi_t ======== */
+
+#ifndef HMI_NO_HMI_TYPEDEF
+typedef struct hmi_struct hmi_t;
+#endif
+
+/* hmi_custom.h allows to provide extra configuration and functionality
+ * on a per project-basis.
+ * This is mainly used by projects for embedded devices that provide their
+ * IO-functionality and configuration this way.
+ */
+#ifdef HMI_CUSTOM
+#include "hmi_custom.h"
+#endif
+
+#if defined(HMI_API_DYNAMIC) && defined(_WIN32)
+#   ifdef HMI_API_EXPORT
+#       define HMI_API __declspec(dllexport)
+#   else
+#       define HMI_API __declspec(dllimport)
+#   endif
+#else
+#   define HMI_API
+#endif
+
+#ifndef CDECL
+#   ifdef _WIN32
+#       define CDECL __cdecl
+#   else
+#       define CDECL
+#   endif
+#endif
+
+#ifndef HMI_UNDEFINED_VALUE
+#   define HMI_UNDEFINED_VALUE 0
+#endif
+
+/* Signed 64-bit integer for values that would overflow an int */
+#ifndef HMI_INT64
+#   ifdef _MSC_VER
+#       define HMI_INT64 __int64
+#   else
+#       define HMI_INT64 long long
+#   endif
+#endif
+
+/* ======== IO-related configuration ======== */
+
+/* Default IO-implementation */
+#ifndef HMI_IO
+#if defined(_WIN32) || defined(__linux__)
+#   define HMI_IO HMI_IO_HID_3DTOUCHPAD
+#else
+#   error "No IO-implementation selected"
+#endif
+#endif
+
+#if HMI_IO != HMI_IO_CUSTOM && HMI_IO != HMI_IO_HID_3DTOUCHPAD && \
+    HMI_IO != HMI_IO_CDC_SERIAL
+#   error "Unknown IO implementation selected"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======== Error Codes ======== */
+
+/* Enum: hmi_error_t
+ *
+ * Error codes as returned by functions of the HMI API.
+ *
+ * HMI_NO_ERROR                - No Error Occured
+ * HMI_NO_DATA                 - <hmi3d_retrieve_data> could not retrieve new data.
+ *                               This code does not necessarily mark an error.
+ * HMI_3D_SYSTEM_ERROR         - Last System_Status message contained an error state
+ *                               See <hmi3d_get_system_error> and <hmi3d_system_error_t> for details.
+ * HMI_NO_RESPONSE_ERROR       - Could not receive an response for the last sent instruction
+ * HMI_MSG_MISSING_ERROR       - Request for message was acknowledged but no message or requested type
+ *                               was received.
+ * HMI_2D_BOOTLOADER_ERROR     - Last response to an 2D update function contained an error state
+ *                               See <hmi2d_get_bootloader_error> and <hmi2d_bootloader_error_t> for details.
+ * HMI_IO_ERROR                - There was some unspecified error during communication
+ * HMI_IO_CTL_ERROR            - Configuration of the connection to the device failed with an error
+ * HMI_IO_OPEN_ERROR           - Opening the connection to the device failed
+ * HMI_IO_ENUM_ERROR           - Error during automatic device detection.
+ *                               This error is specific to systems that provide automatic
+ *                               device detection
+ * HMI_BAD_PARAM_ERROR         - Parameter of a function call was invalid in that context
+ * HMI_BAD_FORMAT_ERROR        - Provided data like a firmware package is malformed
+ * HMI_NO_IMPLEMENTATION_ERROR - The implementation of the called function is missing or incomplete
+ */
+
+typedef enum {
+    HMI_NO_ERROR = 0,
+    HMI_NO_DATA = -1,
+    HMI_3D_SYSTEM_ERROR = -8,
+    HMI_NO_RESPONSE_ERROR = -9,
+    HMI_MSG_MISSING_ERROR = -10,
+    HMI_2D_BOOTLOADER_ERROR = -11,
+    HMI_IO_ERROR = -16,
+    HMI_IO_CTL_ERROR = -17,
+    HMI_IO_OPEN_ERROR = -18,
+    HMI_IO_ENUM_ERROR = -19,
+    HMI_BAD_PARAM_ERROR = -32,
+    HMI_BAD_FORMAT_ERROR = -33,
+    HMI_NO_IMPLEMENTATION_ERROR = -48
+} hmi_error_t;
+
+/* Enum: hmi3d_system_error_t
+ *
+ * Error codes as returned from the MGC3130 system.
+ *
+ * hmi3d_system_NoError              - No error occured
+ * hmi3d_system_UnknownCommand       - Message ID is unknown
+ * hmi3d_system_InvalidSessionid     - Session ID is invalid or does not match (<3D Firmware Update>)
+ * hmi3d_system_InvalidCrc           - CRC is invalid (<3D Firmware Update>)
+ * hmi3d_system_InvalidLength        - Length is invalid (<3D Firmware Update>)
+ * hmi3d_system_InvalidAddress       - Address is invalid (<3D Firmware Update>)
+ * hmi3d_system_InvalidFunction      - Function id is invalid (<3D Firmware Update>)
+ * hmi3d_system_ContentMismatch      - <hmi3d_UpdateFunction_VerifyOnly> found mismatch between
+ *                                     sent data block and flash memory (<3D Firmware Update>)
+ * hmi3d_system_WrongParameterAddr   - Parameter start address does not match
+ *                                     Library Loader assumptions (<3D Firmware Update>)
+ * hmi3d_system_WrongParameterValue  - Parameter Value is invalid
+ * hmi3d_system_UnknownParameterID   - Parameter ID is invalid
+ * hmi3d_system_WakeupHappened       - Device was sleeping and therefore could not
+ *                                     process the request
+ * hmi3d_system_LoaderUpdateStarted  - Library Loader Update has started (<3D Firmware Update>)
+ * hmi3d_system_LoaderUpdateFinished - Library Loader Update has finished (<3D Firmware Update>)
+ */
+typedef enum {
+    hmi3d_system_NoError = 0,
+    hmi3d_system_UnknownCommand = 0x01,
+    hmi3d_system_InvalidSessionid = 0x02,
+    hmi3d_system_InvalidCrc = 0x03,
+    hmi3d_system_InvalidLength = 0x04,
+    hmi3d_system_InvalidAddress = 0x05,
+    hmi3d_system_InvalidFunction = 0x06,
+    hmi3d_system_ContentMismatch = 0x08,
+    hmi3d_system_WrongParameterAddr = 0x0B,
+    hmi3d_system_WrongParameterValue = 0x14,
+    hmi3d_system_UnknownParameterID = 0x15,
+    hmi3d_system_WakeupHappened = 0x1A,
+    hmi3d_system_LoaderUpdateStarted = 0x80,
+    hmi3d_system_LoaderUpdateFinished = 0x81
+} hmi3d_system_error_t;
+
+
+/* ======== Common Functions ======== */
+
+/* Function: hmi_initialize
+ *
+ * Initializes hmi for further use. Resources that were aquired with
+ * <hmi_initialize> have to be released with <hmi_cleanup> once they are
+ * no longer needed.
+ *
+ * hmi - The <hmi_t>-instance to be initialized.
+ *          New instances could be aquired with <hmi_create>.
+ *
+ * See also:
+ *    <hmi_create>, <hmi_free>, <hmi_cleanup>
+ */
+HMI_API void CDECL hmi_initialize(hmi_t *hmi);
+
+/* Function: hmi_cleanup
+ *
+ * Releases resources that were aquired by <hmi_initialize>.
+ * 
+ * See also:
+ *    <hmi_initialize>
+ */
+HMI_API void CDECL hmi_cleanup(hmi_t *hmi);
+
+/* ======== Logging ======== */
+
+#ifndef HMI_NO_LOGGING
+
+#include <stdarg.h>
+
+/* Function: hmi_log
+ *
+ * Calls the logger set with <hmi_set_logger> to do printf like output.
+ *
+ * fmt - The format string
+ * ... - The extra parameters that are forwarded via va_list
+ *
+ * If not logger is set this function returns 0. Otherwise it returns
+ * the return-value of the call to the logger-function.
+ *
+ * See also:
+ *    <hmi_set_logger>
+ */
+HMI_API int CDECL hmi_log(hmi_t *hmi, const char *fmt, ...);
+
+/* Typedef: hmi_logger_t
+ *
+ * Definition of the signature for logger functions.
+ *
+ * opaque - <hmi_log> will pass the opaque pointer provided with
+ *          <hmi_set_logger>
+ * fmt    - The format string
+ * vlist  - List of the variadic arguments
+ *
+ * See also:
+ *    <hmi_set_logger>
+ */
+typedef int (CDECL* hmi_logger_t)(void *opaque,
+                                  const char *fmt,
+                                  va_list vlist);
+
+/* Function: hmi_set_logger
+ *
+ * Sets the logger implementation that is called by <hmi_log>.
+ *
+ * logger - A logger function accepting the opaque-pointer, format string
+ *          and the variadic argument list as parameters
+ * opaque - An opaque pointer that is provided on calls of logger as the
+ *          first argument
+ *
+ * This function always return 0.
+ *
+ * An example of valid functions for logger is vfprintf.
+ *
+ * See also:
+ *    <hmi_log>, <hmi_logger_t>
+ */
+HMI_API int CDECL hmi_set_logger(hmi_t *hmi,
+                                    hmi_logger_t logger,
+                                    void *opaque);
+
+#endif
+
+/* ======== Flight Recorder ======== */
+
+#ifndef HMI_NO_RECORDER
+
+/* Enum: hmi_recorder_entry_type_t
+ *
+ * Types of the entries stored by the flight recorder.
+ *
+ * hmi_rec_3d_message - Raw message as passed to <hmi3d_message_handle>
+ * hmi_rec_2d_message - Raw message as passed to <hmi2d_message_handle>
+ * hmi_rec_3d_frame   - Host side results after a
+ *                      <hmi3d_msg_Sensor_Data_Output> message: the 32-bit
+ *                      frame counter, the 16-bit
+ *                      <hmi3d_DataOutConfigMask_t> -sections with valid
+ *                      data, the 16-bit filtered x, y and z, the 16-bit
+ *                      gesture and 16 reserved bits
+ * hmi_rec_2d_fingers - Decoded <hmi2d_finger_pos_list_t> after a
+ *                      <hmi2d_msg_r_finger_pos> message
+ * hmi_rec_trigger    - Marker that is recorded whenever a dump is written and
+ *                      therefore is the last entry of each dump. The payload
+ *                      is one 32-bit value with the <hmi_recorder_trigger_t>
+ *                      flags that caused the dump.
+ *
+ * See also:
+ *    <hmi_recorder_dump>
+ */
+typedef enum {
+    hmi_rec_3d_message = 1,
+    hmi_rec_2d_message = 2,
+    hmi_rec_3d_frame = 3,
+    hmi_rec_2d_fingers = 4,
+    hmi_rec_trigger = 5
+} hmi_recorder_entry_type_t;
+
+/* Enum: hmi_recorder_trigger_t
+ *
+ * Flags for the conditions that caused a dump of the flight recorder.
+ *
+ * hmi_rec_trigger_manual      - Dump was requested by the application
+ * hmi_rec_trigger_bad_data    - Too many malformed messages within the window
+ * hmi_rec_trigger_stall       - The 3D data stream stopped unexpectedly
+ * hmi_rec_trigger_calibration - Too many calibrations within the window
+ *
+ * See also:
+ *    <hmi_recorder_triggers_t>, <hmi_recorder_poll>
+ */
+typedef enum {
+    hmi_rec_trigger_manual = 0x01,
+    hmi_rec_trigger_bad_data = 0x02,
+    hmi_rec_trigger_stall = 0x04,
+    hmi_rec_trigger_calibration = 0x08
+} hmi_recorder_trigger_t;
+
+/* Struct: hmi_recorder_triggers_t
+ *
+ * Configuration of the automatic dumps of the flight recorder.
+ *
+ * window_ms         - Length of the window in milliseconds in which bad
+ *                     data reports and calibrations are counted
+ * bad_data_limit    - Count of bad data reports within one window that
+ *                     triggers a dump. 0 disables the trigger.
+ * calibration_limit - Count of calibrations within one window that triggers
+ *                     a dump. 0 disables the trigger.
+ * stall_ms          - Time in milliseconds without 3D data output after which
+ *                     a running stream is considered stalled.
+ *                     0 disables the trigger.
+ * holdoff_ms        - Minimal time in milliseconds between two automatic
+ *                     dumps
+ *
+ * See also:
+ *    <hmi_recorder_set_triggers>
+ */
+typedef struct {
+    int window_ms;
+    int bad_data_limit;
+    int calibration_limit;
+    int stall_ms;
+    int holdoff_ms;
+} hmi_recorder_triggers_t;
+
+/* Typedef: hmi_recorder_writer_t
+ *
+ * Definition of the signature for functions receiving dumps of the
+ * flight recorder.
+ *
+ * opaque - The opaque pointer that was provided together with the writer
+ * data   - Pointer to the next part of the dump
+ * size   - Size of data in bytes
+ *
+ * The writer has to return 0 on success. A nonzero value aborts the dump.
+ *
+ * See also:
+ *    <hmi_recorder_dump>, <hmi_recorder_set_target>
+ */
+typedef int (CDECL* hmi_recorder_writer_t)(void *opaque,
+                                           const void *data,
+                                           int size);
+
+/* Function: hmi_recorder_set_enabled
+ *
+ * Enables or pauses the recording of messages and frames.
+ *
+ * enabled - Boolean value whether new data should be recorded
+ *
+ * The flight recorder is enabled by <hmi_initialize>. It keeps the most
+ * recent messages and decoded frames in a ring buffer of
+ * HMI_RECORDER_CAPACITY bytes inside <hmi_t>. No memory is allocated
+ * while recording.
+ *
+ * The capacity is derived from HMI_RECORDER_SECONDS, which defaults to 1
+ * second of 3D data output with all sections at 200 Hz (about 20 KB).
+ * Builds that want a longer history define it larger. Defining
+ * HMI_NO_RECORDER removes the flight recorder completely.
+ */
+HMI_API void CDECL hmi_recorder_set_enabled(hmi_t *hmi, int enabled);
+
+/* Function: hmi_recorder_clear
+ *
+ * Discards all recorded entries.
+ */
+HMI_API void CDECL hmi_recorder_clear(hmi_t *hmi);
+
+/* Function: hmi_recorder_set_triggers
+ *
+ * Configures the conditions for automatic dumps.
+ *
+ * triggers - The new configuration
+ *
+ * Automatic dumps are only written when a target was set with
+ * <hmi_recorder_set_target>. The defaults set by <hmi_initialize> are a
+ * window of 1 second, a limit of 10 bad data reports, a limit of 5
+ * calibrations, a stall time of 500 milliseconds and a holdoff of 10 seconds.
+ *
+ * See also:
+ *    <hmi_recorder_triggers_t>, <hmi_recorder_poll>
+ */
+HMI_API void CDECL hmi_recorder_set_triggers(hmi_t *hmi,
+                                             const hmi_recorder_triggers_t *triggers);
+
+/* Function: hmi_recorder_set_target
+ *
+ * Sets the writer that receives automatic dumps.
+ *
+ * writer - The writer function or NULL to disable automatic dumps
+ * opaque - Opaque pointer that is passed to writer
+ *
+ * See also:
+ *    <hmi_recorder_writer_t>, <hmi_recorder_poll>
+ */
+HMI_API void CDECL hmi_recorder_set_target(hmi_t *hmi,
+                                           hmi_recorder_writer_t writer,
+                                           void *opaque);
+
+/* Function: hmi_recorder_poll
+ *
+ * Evaluates the triggers and writes a pending automatic dump.
+ *
+ * Returns the <hmi_recorder_trigger_t> flags of a dump that was written by
+ * this call, 0 if no dump was written or a negative error code if the
+ * writer failed.
+ *
+ * Triggers are detected while messages are handled, but dumps are only
+ * written by this function so that message handling never blocks on the
+ * writer. <hmi3d_retrieve_data> and <hmi2d_retrieve_data> call it
+ * automatically. Applications that don't use those functions should call
+ * it periodically.
+ */
+HMI_API int CDECL hmi_recorder_poll(hmi_t *hmi);
+
+/* Function: hmi_recorder_dump
+ *
+ * Writes the content of the flight recorder.
+ *
+ * writer - The function receiving the data
+ * opaque - Opaque pointer that is passed to writer
+ *
+ * Returns 0 on success, <HMI_IO_ERROR> if the writer failed or
+ * <HMI_NO_DATA> if another dump is still being written.
+ *
+ * The dump writes a snapshot of the entries without holding the
+ * synchronization against the message handlers. Entries that arrive
+ * meanwhile are kept as long as they fit without overwriting the snapshot
+ * and dropped otherwise.
+ *
+ * The dump starts with the 4 byte magic "HMIR" followed by a 16-bit version
+ * (currently 1) and 16 reserved bits. Each entry follows with an 8-byte
+ * header consisting of the 32-bit timestamp in microseconds, the 16-bit
+ * size of the payload, the 8-bit <hmi_recorder_entry_type_t> and one
+ * reserved byte. The payload is padded to a multiple of 4 bytes.
+ * All values are stored in little-endian order and the entries are in the
+ * order they were recorded.
+ */
+HMI_API int CDECL hmi_recorder_dump(hmi_t *hmi,
+                                    hmi_recorder_writer_t writer,
+                                    void *opaque);
+
+#if defined(_WIN32) || defined(__linux__)
+
+/* Function: hmi_recorder_dump_file
+ *
+ * Writes the content of the flight recorder to a file.
+ *
+ * filename - The name of the file to create
+ *
+ * Returns 0 on success, <HMI_IO_OPEN_ERROR> if the file could not be created
+ * or <HMI_IO_ERROR> if writing failed.
+ *
+ * See also:
+ *    <hmi_recorder_dump>
+ */
+HMI_API int CDECL hmi_recorder_dump_file(hmi_t *hmi, const char *filename);
+
+#endif
+
+#endif
+
+/* ======== Connection Handling ======== */
+
+#if HMI_IO == HMI_IO_HID_3DTOUCHPAD
+
+/* Function: hmi_hid_set_details
+ *
+ * Sets the Vendor ID, Product ID, Report ID and Interface that is used by
+ * the HID connection.
+ *
+ * vendor_id  - The Vendor ID of the device to open
+ * product_id - The Product ID of the device to open
+ * report_id  - The report ID to be used in the communication
+ * iface      - The interface of the device to open (not needed on Windows)
+ *
+ * This function is only defined when compiled for communication with the
+ * 3DTouchPad.
+ *
+ * It should be used when connection with different IDs than the default
+ * is required. This is the case for example when connecting to the
+ * 2D bootloader device during <2D Firmware Update>.
+ */
+HMI_API void CDECL hmi_hid_set_details(hmi_t *hmi,
+                                       int vendor_id,
+                                       int product_id,
+                                       int report_id,
+                                       int iface);
+
+#endif
+
+/* Function: hmi_open
+ *
+ * Opens a connection to the physical device and associates it with hmi
+ * that was already initialized with <hmi_initialize>.
+ *
+ * Returns 0 on success or a negative value on error.
+ *
+ * The connection has to be closed with <hmi_close> after use.
+ *
+ * See also:
+ *    <hmi_initialize>, <hmi_close>
+ */
+HMI_API int CDECL hmi_open(hmi_t *hmi);
+
+/* Function: hmi_close
+ *
+ * Closes the connection to the device associated with hmi that was
+ * established with <hmi_open>.
+ */
+HMI_API void CDECL hmi_close(hmi_t *hmi);
+
+/* Function: hmi3d_reset
+ *
+ * Tries to reset the 3D-device if this is supported by the system setup.
+ *
+ * Returns 0 on success or a negative value on error.
+ *
+ * Resetting the hardware is done by signaling the reset line of the chip.
+ * This requires support by the hardware connection.
+ */
+HMI_API int CDECL hmi3d_reset(hmi_t *hmi);
+
+/* ======== 3D Low Level Communication ======== */
+
+/* Enum: hmi3d_message_id_t
+ *
+ * Enumeration of message IDs sent from or to device.
+ *
+ * hmi3d_msg_System_Status         - Response to other messages
+ * hmi3d_msg_Request_Message       - Request for a message sent by host
+ * hmi3d_msg_Fw_Update_Start       - Starts <3D Firmware Update>
+ * hmi3d_msg_Fw_Update_Block       - Content during <3D Firmware Update>
+ * hmi3d_msg_Fw_Update_Completed   - Finishes <3D Firmware Update>
+ * hmi3d_msg_Fw_Version_Info       - Contains FW Version data
+ * hmi3d_msg_Sensor_Data_Output    - Contains different sensor data
+ * hmi3d_msg_Set_Runtime_Parameter - Update of runtime parameter if from host
+ *                                   Requested parameter value if from device
+ *
+ * Some of the message IDs are used for messages in both directions with a
+ * different meaning.
+ */
+typedef enum {
+    hmi3d_msg_System_Status = 0x15,
+    hmi3d_msg_Request_Message = 0x06,
+    hmi3d_msg_Fw_Update_Start = 0x80,
+    hmi3d_msg_Fw_Update_Block = 0x81,
+    hmi3d_msg_Fw_Update_Completed = 0x82,
+    hmi3d_msg_Fw_Version_Info = 0x83,
+    hmi3d_msg_Sensor_Data_Output = 0x91,
+    hmi3d_msg_Set_Runtime_Parameter = 0xA2,
+} hmi3d_message_id_t;
+
+/* Enum: hmi3d_parameter_id_t
+ *
+ * Enumeration of possible parameter ids.
+ * For the correct arguments refer to the MGC3130 GestIC Library
+ * Interface Description User's Guids or use the
+ * <3D Real Time Control> functions.
+ *
+ * hmi3d_param_trigger                     - Trigger an action.
+ *                                           See <hmi3d_trigger_action>
+ * hmi3d_param_makePersistent              - Make changes persistent.
+ * hmi3d_param_afeRxAtt_S                  - Signal Matching for South electrode
+ * hmi3d_param_afeRxAtt_W                  - Signal Matching for West electrode
+ * hmi3d_param_afeRxAtt_N                  - Signal Matching for North electrode
+ * hmi3d_param_afeRxAtt_E                  - Signal Matching for East electrode
+ * hmi3d_param_afeRxAtt_C                  - Signal Matching for Center electrode
+ * hmi3d_param_channelmapping_S            - Physical channel for South electrode
+ * hmi3d_param_channelmapping_W            - Physical channel for West electrode
+ * hmi3d_param_channelmapping_N            - Physical channel for North electrode
+ * hmi3d_param_channelmapping_E            - Physical channel for East electrode
+ * hmi3d_param_channelmapping_C            - Physical channel for Center electrode
+ * hmi3d_param_dspCalOpMode                - Calibration Operation Mode Flags.
+ *                                           See <hmi3d_set_auto_calibration>
+ * hmi3d_param_transFreqSelect             - Transmit Frequency Selection.
+ *                                           See <hmi3d_select_frequencies>
+ * hmi3d_param_dspGestureMask              - Mask for Gesture Processing.
+ *                                           See <hmi3d_set_enabled_gestures>
+ * hmi3d_param_dspAirWheelConfig           - Enables/Disables AirWheel.
+ *                                           See <hmi3d_set_air_wheel_enabled>
+ * hmi3d_param_dspTouchConfig              - Enables/Disables Touch Detection.
+ *                                           See <hmi3d_set_touch_detection>
+ * hmi3d_param_dspApproachDetectionMode    - Enables/Disables Approach Detection.
+ *                                           See <hmi3d_set_approach_detection>
+ * hmi3d_param_dataOutputEnableMask        - Determines the continuous data output of the device.
+ *                                           See <hmi3d_set_output_enable_mask>
+ * hmi3d_param_dataOutputLockMask          - Determines the continuous data output of the device.
+ *                                           See <hmi3d_set_output_enable_mask>
+ * hmi3d_param_dataOutputRequestMask       - Determines the data output for next message.
+ * hmi3d_param_dataOutputGestureInProgress - Enables/Disables output of
+ *                                           gestures in progress
+ */
+typedef enum {
+    hmi3d_param_trigger = 0x1000,
+    hmi3d_param_makePersistent = 0xFF00,
+    hmi3d_param_afeRxAtt_S = 0x50,
+    hmi3d_param_afeRxAtt_W = 0x51,
+    hmi3d_param_afeRxAtt_N = 0x52,
+    hmi3d_param_afeRxAtt_E = 0x53,
+    hmi3d_param_afeRxAtt_C = 0x54,
+    hmi3d_param_channelmapping_S = 0x65,
+    hmi3d_param_channelmapping_W = 0x66,
+    hmi3d_param_channelmapping_N = 0x67,
+    hmi3d_param_channelmapping_E = 0x68,
+    hmi3d_param_channelmapping_C = 0x69,
+    hmi3d_param_dspCalOpMode = 0x80,
+    hmi3d_param_transFreqSelect = 0x82,
+    hmi3d_param_dspGestureMask = 0x85,
+    hmi3d_param_dspAirWheelConfig = 0x90,
+    hmi3d_param_dspTouchConfig = 0x97,
+    hmi3d_param_dspApproachDetectionMode = 0x97,
+    hmi3d_param_dataOutputEnableMask = 0xA0,
+    hmi3d_param_dataOutputLockMask = 0xA1,
+    hmi3d_param_dataOutputRequestMask = 0xA2,
+    hmi3d_param_dataOutputGestureInProgress = 0xA3
+} hmi3d_parameter_id_t;
+
+/* Enum: hmi3d_trigger_id_t
+ *
+ * Actions that could be triggered with <hmi3d_trigger_action>.
+ *
+ * hmi3d_trigger_calibration     - Triggers manual calibration
+ *                                 (see also <hmi3d_force_calibration>).
+ * hmi3d_trigger_enterDeepSleep1 - Enters deep sleep mode 1. Device will wake up
+ *                                 at incoming messages or hardware reset
+ *                                 (see also <hmi3d_reset>).
+ * hmi3d_trigger_enterDeepSleep2 - Enters deep sleep mode 2. Device will wake up
+ *                                 at falling edge on External Interrupt (IRQ0)
+ *                                 or hardware reset (see also <hmi3d_reset>).
+ *
+ * See also:
+ *    <hmi3d_trigger_action>, <hmi3d_param_trigger>
+ */
+typedef enum {
+    hmi3d_trigger_calibration = 0x00,
+    hmi3d_trigger_enterDeepSleep1 = 0x01,
+    hmi3d_trigger_enterDeepSleep2 = 0x02
+} hmi3d_trigger_id_t;
+
+/* Enum: hmi3d_DataOutConfigMask_t
+ *
+ * Enumeration of flags for possible sensor data output.
+ *
+ * This enumeration is used for selecting what data to communicate
+ * via <hmi3d_set_output_enable_mask> and in <hmi3d_msg_Sensor_Data_Output>
+ * to mark available fields and the format of the raw sensor data.
+ *
+ * hmi3d_DataOutConfigMask_DSPStatus    - DSP related information like
+ *                                        calibration events amnd frequency
+ *                                        (accessed via <hmi3d_get_calibration>
+ *                                        and <hmi3d_get_frequency>)
+ * hmi3d_DataOutConfigMask_GestureInfo  - Gesture related data
+ *                                        (accessible via <hmi3d_get_gesture>)
+ * hmi3d_DataOutConfigMask_TouchInfo    - Touch related data
+ *                                        (accessible via <hmi3d_get_touch>)
+ * hmi3d_DataOutConfigMask_AirWheelInfo - AirWheel related data
+ *                                        (accessible via <hmi3d_get_air_wheel>)
+ * hmi3d_DataOutConfigMask_xyzPosition  - Position data (accessible via
+ *                                        <hmi3d_get_position>)
+ * hmi3d_DataOutConfigMask_NoisePower   - Noise power data (accessible via
+ *                                        <hmi3d_get_noise_power>)
+ * hmi3d_DataOutConfigMask_CICData      - Raw CIC sensor data (accessible via
+ *                                        <hmi3d_get_cic>)
+ * hmi3d_DataOutConfigMask_SDData       - SD sensor data (accessible via
+ *                                        <hmi3d_get_sd>)
+ *
+ * The following are masks that are not directly related to data output.
+ *
+ * hmi3d_DataOutConfigMask_ElectrodeConfiguration - Mask for the electrode
+ *                                        configuration. Only relevant for
+ *                                        <hmi3d_msg_Sensor_Data_Output>
+ *                                        message-handling.
+ * hmi3d_DataOutConfigMask_OutputAll    - Mask for all data flags
+ */
+typedef enum {
+    hmi3d_DataOutConfigMask_DSPStatus = 0x0001,
+    hmi3d_DataOutConfigMask_GestureInfo = 0x0002,
+    hmi3d_DataOutConfigMask_TouchInfo = 0x0004,
+    hmi3d_DataOutConfigMask_AirWheelInfo = 0x0008,
+    hmi3d_DataOutConfigMask_xyzPosition = 0x0010,
+    hmi3d_DataOutConfigMask_NoisePower = 0x0020,
+    hmi3d_DataOutConfigMask_CICData = 0x0800,
+    hmi3d_DataOutConfigMask_SDData = 0x1000,
+    /* Masks */
+    hmi3d_DataOutConfigMask_ElectrodeConfiguration = 0x0700,
+    hmi3d_DataOutConfigMask_OutputAll = 0x183F
+} hmi3d_DataOutConfigMask_t;
+
+/* Enum: hmi3d_SystemInfo_t
+ *
+ * Contains information about the system state and the content of the
+ * containing <hmi3d_msg_Sensor_Data_Output> message.
+ *
+ * hmi3d_SystemInfo_PositionValid      - Contained position data is valid
+ * hmi3d_SystemInfo_AirWheelValid      - Contained AirWheel data is valid
+ * hmi3d_SystemInfo_RawDataValid       - Contained RawData fields are valid
+ * hmi3d_SystemInfo_NoisePowerValid    - Contained noise-power data is valid
+ * hmi3d_SystemInfo_EnvironmentalNoise - Environment noise was detected
+ * hmi3d_SystemInfo_Clipping           - Sensor data values are clipped
+ * hmi3d_SystemInfo_DSPRunning         - The signal processing (DSP) is running
+ */
+typedef enum {
+    hmi3d_SystemInfo_PositionValid = 0x01,
+    hmi3d_SystemInfo_AirWheelValid = 0x02,
+    hmi3d_SystemInfo_RawDataValid = 0x04,
+    hmi3d_SystemInfo_NoisePowerValid = 0x08,
+    hmi3d_SystemInfo_EnvironmentalNoise = 0x10,
+    hmi3d_SystemInfo_Clipping = 0x20,
+    hmi3d_SystemInfo_DSPRunning = 0x80
+} hmi3d_SystemInfo_t;
+
+/* Enum: hmi3d_param_category
+ *
+ * Enumeration of possible categories for use with <hmi3d_make_persistent>.
+ *
+ * hmi3d_afe_category    - AFE Category
+ * hmi3d_dsp_category    - DSP Category
+ * hmi3d_system_category - System Category
+ */
+typedef enum {
+    hmi3d_afe_category = 0,
+    hmi3d_dsp_category = 1,
+    hmi3d_system_category = 2
+} hmi3d_param_category;
+
+/* Function: hmi3d_send_message
+ *
+ * Sends a message to the device and waits for a response.
+ *
+ * msg     - Pointer to the message to send
+ * size    - The size of the message as set in msg
+ * timeout - Timeout in milliseconds to wait for a response
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * This function calls <wait_response> to wait for an response.
+ * If <wait_response> returns an error this function retries up to three times
+ * before it in turn returns an error to the caller.
+ *
+ * See also:
+ *    <wait_response>, <hmi3d_set_param>, <hmi3d_trigger_action>
+ */
+HMI_API int CDECL hmi3d_send_message(hmi_t *hmi,
+                                        void *msg,
+                                        int size,
+                                        int timeout);
+
+/* Function: hmi3d_set_param
+ *
+ * Sends the instruction for updating a runtime-parameter to the device.
+ *
+ * param   - The code for the parameter to update
+ * arg0    - First parameter specific argument
+ * arg1    - Second parameter specific argument
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_send_message>, <hmi3d_set_auto_calibration>,
+ *    <hmi3d_select_frequencies>, <hmi3d_set_approach_detection>,
+ *    <hmi3d_set_enabled_gestures>, <hmi3d_get_param>
+ */
+HMI_API int CDECL hmi3d_set_param(hmi_t *hmi,
+                                     unsigned short param,
+                                     unsigned int arg0,
+                                     unsigned int arg1);
+
+/* Function: hmi3d_get_param
+ *
+ * Reads back a parameter from the device.
+ *
+ * param   - The code for the parameter to read
+ * arg0    - Pointer where to store the first argument, could be NULL
+ * arg1    - Pointer where to store the second argument, could be NULL
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * The read parameter arguments are stored in arg0 and arg1 if those pointers
+ * are valid.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_param>
+ */
+HMI_API int CDECL hmi3d_get_param(hmi_t *hmi,
+                                     unsigned short param,
+                                     unsigned int *arg0,
+                                     unsigned int *arg1);
+
+/* Function: hmi3d_trigger_action
+ *
+ * Sends the instruction for a specific action to the device.
+ *
+ * action  - The firmware-specific code for the action
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * The enumeration hmi3d_trigger_id_t provides the possible actions.
+ *
+ * See also:
+ *    <hmi3d_send_message>, <hmi3d_force_calibration>
+ */
+HMI_API int CDECL hmi3d_trigger_action(hmi_t *hmi,
+                                          unsigned short action);
+
+
+/* ======== 3D Data Retrieval ======== */
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+/* Enumeration: hmi3d_gestures_t
+ *
+ * The gestures supported by the API
+ *
+ * hmi3d_gest_none  - No gesture detected
+ * hmi3d_flick_w2e  - Flick from west to east detected
+ * hmi3d_flick_e2w  - Flick from east to west was detected
+ * hmi3d_flick_s2n  - Flick from south to north was detected
+ * hmi3d_flick_n2s  - Flick from north to south was detected
+ * hmi3d_circle_cw  - Clock-wise circle detected
+ * hmi3d_circle_ccw - Counter-clock-wise circle detected
+ * hmi3d_gest_custom - First of the custom gestures added with
+ *                     <hmi3d_add_custom_gesture>
+ */
+typedef enum {
+    hmi3d_gest_none    = 0x00,
+    hmi3d_flick_w2e    = 0x01,
+    hmi3d_flick_e2w    = 0x02,
+    hmi3d_flick_s2n    = 0x03,
+    hmi3d_flick_n2s    = 0x04,
+    hmi3d_circle_cw    = 0x05,
+    hmi3d_circle_ccw   = 0x06,
+    hmi3d_gest_custom  = 0x40
+} hmi3d_gestures_t;
+
+/* Enumeration: hmi3d_gesture_flags_t
+ *
+ * Bitmask of gesture related flags:
+ *
+ * hmi3d_gesture_edge_flick  - The flick was actually an edge flick
+ * hmi3d_gesture_in_progress - Gesture recognition is in progress.
+ *                             Only set while recognizer is active and
+ *                             gets reset once gesture got recognized.
+ * hmi3d_gesture_flags_mask  - Mask of possible flags.
+ */
+typedef enum {
+    hmi3d_gesture_edge_flick = 0x00010000,
+    hmi3d_gesture_in_progress = 0x80000000,
+    hmi3d_gesture_flags_mask = 0x80010000
+} hmi3d_gesture_flags_t;
+
+/* Enum: hmi3d_touch_flags_t
+ *
+ * Bitmask of gesture related flags
+ *
+ * hmi3d_touch_north  - Touch at north electrode detected
+ * hmi3d_touch_east   - Touch at east electrode detected
+ * hmi3d_touch_south  - Touch at south electrode detected
+ * hmi3d_touch_west   - Touch at west electrode detected
+ * hmi3d_touch_center - Touch at center electrode detected
+ * hmi3d_touch_mask   - Mask for detected touchs
+ */
+typedef enum {
+    hmi3d_touch_north = 0x04,
+    hmi3d_touch_east = 0x08,
+    hmi3d_touch_south = 0x01,
+    hmi3d_touch_west = 0x02,
+    hmi3d_touch_center = 0x10,
+    hmi3d_touch_mask = 0x1F
+} hmi3d_touch_flags_t;
+
+/* Enum: hmi3d_tap_flags_t
+ *
+ * Flags for the different tap events as they are communicated by the
+ * <hmi3d_msg_Sensor_Data_Output> message.
+ *
+ * hmi3d_tap_north         - Tap on north electrode
+ * hmi3d_tap_east          - Tap on east electrode
+ * hmi3d_tap_south         - Tap on south electrode
+ * hmi3d_tap_west          - Tap on west electrode
+ * hmi3d_tap_center        - Tap on center electrode
+ * hmi3d_double_tap_north  - Double tap on north electrode
+ * hmi3d_double_tap_east   - Double tap on east electrode
+ * hmi3d_double_tap_south  - Double tap on south electrode
+ * hmi3d_double_tap_west   - Double tap on west electrode
+ * hmi3d_double_tap_center - Double tap on center electrode
+ * hmi3d_single_tap_mask   - Mask for tap events
+ * hmi3d_double_tap_mask   - Mask for double tap events
+ * hmi3d_tap_mask          - Mask for tap and double tap events
+ *
+ * Each tap results in the corresponding tap event while two consecutive taps
+ * result in an additional double-tap event.
+ */
+typedef enum {
+    hmi3d_tap_north = 0x0080,
+    hmi3d_tap_east = 0x0100,
+    hmi3d_tap_south = 0x0020,
+    hmi3d_tap_west = 0x0040,
+    hmi3d_tap_center = 0x0200,
+    hmi3d_double_tap_north = 0x1000,
+    hmi3d_double_tap_east = 0x2000,
+    hmi3d_double_tap_south = 0x0400,
+    hmi3d_double_tap_west = 0x0800,
+    hmi3d_double_tap_center = 0x4000,
+    hmi3d_single_tap_mask = 0x03E0,
+    hmi3d_double_tap_mask = 0x7C00,
+    hmi3d_tap_mask = 0x7FE0
+} hmi3d_tap_flags_t;
+
+/* Enumeration: hmi3d_calib_reason_t
+ *
+ * Bitmask of possible reasons for calibrations
+ *
+ * hmi3d_forced_calib     - Enforced with <hmi3d_force_calibration>
+ * hmi3d_startup_calib    - Triggered during startup
+ * hmi3d_gesture_calib    - Triggered after gesture
+ * hmi3d_negative_calib   - Triggered to compensate negative values
+ * hmi3d_idle_calib       - Triggered to compensate background noise
+ * hmi3d_invalidity_calib - Triggered as signals exceeded their valid range
+ * hmi3d_dsp_forced_calib - Internally triggered calibration
+ */
+typedef enum {
+    hmi3d_forced_calib = 0x0002,
+    hmi3d_startup_calib = 0x0004,
+    hmi3d_gesture_calib = 0x0008,
+    hmi3d_negative_calib = 0x0010,
+    hmi3d_idle_calib = 0x0020,
+    hmi3d_invalidity_calib = 0x0040,
+    hmi3d_dsp_forced_calib = 0x0080,
+} hmi3d_calib_reason_t;
+
+/* Structure: hmi3d_signal_t
+ *
+ * Contains data for all channels of one type of signal.
+ *
+ * channel - The indvidual channels
+ *
+ * The channels are typically in the order
+ * (south, west, north, east, center).
+ *
+ * See also:
+ *    <hmi3d_get_cic>, <hmi3d_get_sd>
+ */
+typedef struct {
+    float channel[5];
+} hmi3d_signal_t;
+
+/* Structure: hmi3d_position_t
+ *
+ * Contains position data that could be accessed with <hmi3d_get_position>.
+ *
+ * x - Ranges from 0 (west) to 65535 (east)
+ * y - Ranges from 0 (south) to 65535 (north)
+ * z - Ranges from 0 (touching) to 65535 (hand away)
+ */
+typedef struct {
+    int x, y, z;
+} hmi3d_position_t;
+
+/* Structure: hmi3d_gesture_t
+ *
+ * Contains information about gestures
+ *
+ * gesture    - The type of the gesture (See <hmi3d_gesture_t>)
+ * flags      - Flags for the gesture (See <hmi3d_gesture_flags_t>)
+ * last_event - Count of samples since the last detected gesture
+ *
+ * gesture will be set only once. It will be reset to <hmi3d_gest_none> by the
+ * next call to <hmi3d_retrieve_data> if no subsequent gesture occured.
+ *
+ * Gesture data could be accessed with <hmi3d_get_gesture>.
+ *
+ * Note:
+ *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
+ *    To be accurate the device isn't allowed to sleep and has to send at least
+ *    one such message per second.
+ *
+ * Note:
+ *    internally last_event is set to the count of samples between start-up
+ *    and last gesture.
+ */
+typedef struct {
+    hmi3d_gestures_t gesture;
+    hmi3d_gesture_flags_t flags;
+    int last_event;
+} hmi3d_gesture_t;
+
+/* Struct: hmi3d_touch_t
+ *
+ * Contains information about touch events.
+ *
+ * flags                  - Flags for the touch (See <hmi3d_touch_flags_t>)
+ * last_event             - Count of samples since last touch event
+ * tap_flags              - Flags for tap events
+ * last_tap_event         - Count of samples since last tap event
+ * last_touch_event_start - Count of samples since last touch event started
+ *
+ * Note:
+ *    The *last_event fields are based on the TimeStamp field of
+ *    SENSOR_DATA_OUTPUT message.
+ *    To be accurate the device isn't allowed to sleep and has to send at least
+ *    one such message per second.
+ *
+ * Note:
+ *    internally the *last_event fiels are set to the count of samples between
+ *    start-up and last gesture.
+ */
+typedef struct {
+    hmi3d_touch_flags_t touch_flags;
+    int last_touch_event;
+    int last_touch_event_start;
+    hmi3d_tap_flags_t tap_flags;
+    int last_tap_event;
+} hmi3d_touch_t;
+
+/* Struct: hmi3d_air_wheel_t
+ *
+ * Contains information about AirWheel events.
+ *
+ * counter    - Counter which indicates how far the AirWheel rotation has
+ *              progressed. Incrementing values indicate a clockwise rotation.
+ *              Decrementing values indicate counter clockwise rotation.
+ *              An increment of 32 approximates one full rotation.
+ * active     - Boolean value indicating whether AirWheel is currently detected
+ * last_event - Count of samples since last change of active
+ * rotation   - Progress of all AirWheel rotations in counts of counter
+ *              without wrapping
+ * velocity   - Filtered angular velocity in counts per second
+ * acceleration - Filtered angular acceleration in counts per second
+ *              squared
+ *
+ * Velocity and acceleration are based on the TimeStamp field and are 0
+ * while AirWheel is not active. They are smoothed as configured with
+ * <hmi3d_set_air_wheel_filter>.
+ *
+ * Note:
+ *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
+ *    To be accurate the device isn't allowed to sleep and has to send at least
+ *    one such message per second.
+ *
+ * Note:
+ *    internally last_event is set to the count of samples between start-up
+ *    and last gesture.
+ */
+typedef struct {
+    int counter;
+    int active;
+    int last_event;
+    HMI_INT64 rotation;
+    float velocity;
+    float acceleration;
+} hmi3d_air_wheel_t;
+
+/* Structure: hmi3d_calib_t
+ *
+ * Contains information about calibrations.
+ *
+ * reason     - Reason of the calibration as OR-combination of
+ *              <hmi3d_calib_reason_t>.
+ * last_event - Count of samples since last calibration
+ *
+ * reason will be set only once. It will be reset to 0 by subsequent calls to
+ * <hmi3d_retrieve_data> when no further calibration occurs.
+ *
+ * Calibration data could be accessed with <hmi3d_get_calibration>.
+ * Calibrations are updated when <hmi3d_DataOutConfigMask_SDData> is set.
+ *
+ * See also:
+ *    <hmi3d_set_auto_calibration>, <hmi3d_force_calibration>
+ *
+ * Note:
+ *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
+ *    To be accurate the device isn't allowed to sleep and has to send at least
+ *    one such message per second.
+ *
+ * Note:
+ *    internally last_event is set to the count of samples between start-up
+ *    and last gesture.
+ */
+typedef struct {
+    hmi3d_calib_reason_t reason;
+    int last_event;
+} hmi3d_calib_t;
+
+/* Structure: hmi3d_freq_t
+ *
+ * Contains information about the working frequency.
+ *
+ * frequency    - The currently active frequency in kHz
+ * freq_changed - Boolean value set to 1 when last frequency changed during
+ *                last call to <hmi3d_retrieve_data>
+ * last_event   - Count of samples since last calibration
+ *
+ * Frequency data could be accessed with <hmi3d_get_frequency>.
+ * Frequency is always updated when any data is retrieved.
+ *
+ * See also:
+ *    <hmi3d_select_frequencies>
+ *
+ * Note:
+ *    last_event is based on the TimeStamp field of SENSOR_DATA_OUTPUT message.
+ *    To be accurate the device isn't allowed to sleep and has to send at least
+ *    one such message per second.
+ *
+ * Note:
+ *    internally last_event is set to the count of samples between start-up
+ *    and last gesture.
+ */
+typedef struct {
+    int frequency;
+    int freq_changed;
+    int last_event;
+} hmi3d_freq_t;
+
+/* Structure: hmi3d_noise_power_t
+ *
+ * Contains current noise value
+ *
+ * value - The value of the noise power
+ * valid - Not zero when value is valid or zero otherwise
+ *
+ * Noise power data is accessed with <hmi3d_get_noise_power>.
+ * Or directly via hmi->results.noise_power when using the
+ * static API.
+ */
+typedef struct {
+    float value;
+    int valid;
+} hmi3d_noise_power_t;
+
+#endif
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+/* Function: hmi3d_retrieve_data
+ *
+ * Retrieves the availabe data output from the device and updates the result
+ * buffer.
+ *
+ * skipped - If a pointer to an integer is provided it will be updated with the
+ *           count of skipped data-sets.
+ *
+ * Returns 0 on success or a negative <hmi_error_t> code if no new data is
+ * available or the communication is broken.
+ *
+ * It is possible that multiple updates were received during calls to different
+ * functions. In this case the buffer will contain an accumulation of received
+ * data after this call and skipped will be set to the amount of skipped
+ * data-sets.
+ *
+ * The fetched data could be accessed with the hmi3d_get_* functions.
+ *
+ * Note:
+ *    <hmi3d_retrieve_data> may process only fragments of the incoming
+ *    data. It is therefore usefull to call it repeatedly until no more data are
+ *    available to keep it in sync with the device.
+ *
+ * See also:
+ *    <hmi3d_get_cic>, <hmi3d_get_sd>,
+ *    <hmi3d_get_position>, <hmi3d_get_gesture>, <hmi3d_get_calibration>
+ */
+HMI_API int CDECL hmi3d_retrieve_data(hmi_t *hmi, int *skipped);
+
+/* Structure: hmi3d_position_filter_t
+ *
+ * Parameters of the One-Euro filter for positions.
+ *
+ * min_cutoff  - Cutoff frequency in Hz while the hand rests. Lower values
+ *               reduce jitter.
+ * beta        - Increase of the cutoff frequency in Hz per position unit
+ *               per second. Higher values reduce lag during fast movements.
+ * d_cutoff    - Cutoff frequency in Hz for the estimated speed
+ * sample_rate - Samples per second as counted by the TimeStamp field of
+ *               <hmi3d_msg_Sensor_Data_Output>
+ *
+ * Reasonable start values are 1 Hz for min_cutoff, 0.0005 for beta,
+ * 1 Hz for d_cutoff and a sample_rate of 200.
+ *
+ * See also:
+ *    <hmi3d_set_position_filter>
+ */
+typedef struct {
+    float min_cutoff;
+    float beta;
+    float d_cutoff;
+    float sample_rate;
+} hmi3d_position_filter_t;
+
+/* Function: hmi3d_set_position_filter
+ *
+ * Enables or disables the filtering of positions.
+ *
+ * filter - The parameters of the filter or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * Every axis is smoothed by a One-Euro filter, a low-pass filter whose
+ * cutoff frequency rises with the speed of the hand. It suppresses jitter
+ * while the hand rests and adds little lag while it moves. The filter
+ * restarts at every calibration of the device.
+ *
+ * The filtered position is accessible via <hmi3d_get_filtered_position>
+ * while <hmi3d_get_position> keeps returning the unfiltered one. Without a
+ * filter both are the same.
+ *
+ * See also:
+ *    <3D Data Retrieval>, <hmi3d_position_filter_t>
+ */
+HMI_API int CDECL hmi3d_set_position_filter(
+        hmi_t *hmi,
+        const hmi3d_position_filter_t *filter);
+
+/* Structure: hmi3d_air_wheel_filter_t
+ *
+ * Parameters of the velocity and acceleration of AirWheel.
+ *
+ * cutoff      - Cutoff frequency in Hz of the low-pass filters of velocity
+ *               and acceleration. Lower values give smoother but later
+ *               values.
+ * sample_rate - Samples per second as counted by the TimeStamp field of
+ *               <hmi3d_msg_Sensor_Data_Output>
+ *
+ * Without <hmi3d_set_air_wheel_filter> a cutoff of 4 Hz and a sample_rate
+ * of 200 are used.
+ */
+typedef struct {
+    float cutoff;
+    float sample_rate;
+} hmi3d_air_wheel_filter_t;
+
+/* Function: hmi3d_set_air_wheel_filter
+ *
+ * Changes the filtering of the velocity and acceleration of AirWheel.
+ *
+ * filter - The parameters of the filter
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * See also:
+ *    <hmi3d_air_wheel_t>, <hmi3d_get_air_wheel>
+ */
+HMI_API int CDECL hmi3d_set_air_wheel_filter(
+        hmi_t *hmi,
+        const hmi3d_air_wheel_filter_t *filter);
+
+/* Structure: hmi3d_prediction_config_t
+ *
+ * Parameters of the prediction of positions.
+ *
+ * cutoff      - Cutoff frequency in Hz of the low-pass filters of the
+ *               estimated velocity and acceleration
+ * max_lead_ms - Predictions reach at most this far beyond the last
+ *               data-frame
+ * sample_rate - Samples per second as counted by the TimeStamp field of
+ *               <hmi3d_msg_Sensor_Data_Output>
+ *
+ * Reasonable start values are 10 Hz for cutoff, 50 ms for max_lead_ms and
+ * a sample_rate of 200.
+ *
+ * See also:
+ *    <hmi3d_set_prediction>
+ */
+typedef struct {
+    float cutoff;
+    float max_lead_ms;
+    float sample_rate;
+} hmi3d_prediction_config_t;
+
+/* Function: hmi3d_set_prediction
+ *
+ * Enables or disables the prediction of positions.
+ *
+ * config - The parameters of the prediction or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * Every data-frame with a valid position updates an estimate of the
+ * velocity and acceleration of the position as returned by
+ * <hmi3d_get_filtered_position>. The estimate is based on the TimeStamp
+ * field, so lost or delayed USB frames don't distort it. It restarts when
+ * the hand leaves and at every calibration of the device.
+ *
+ * See also:
+ *    <hmi3d_prediction_config_t>, <hmi3d_predict_position>
+ */
+HMI_API int CDECL hmi3d_set_prediction(
+        hmi_t *hmi,
+        const hmi3d_prediction_config_t *config);
+
+/* Function: hmi3d_predict_position
+ *
+ * Extrapolates the position of the hand to a point in time.
+ *
+ * target   - The point in time as returned by HMI_TIME_US, for example the
+ *            next vertical sync of the display
+ * position - Pointer to the <hmi3d_position_t> that receives the position
+ *
+ * Returns HMI_NO_ERROR on success or HMI_NO_DATA if no position is
+ * estimated, e.g. because the prediction is disabled or no hand is
+ * detected.
+ *
+ * The position of the last data-frame is extrapolated by its velocity and
+ * acceleration over the time since the frame was received, but at most by
+ * max_lead_ms. Targets before the reception return the position of the
+ * last frame. An axis stops at the point where a deceleration would turn
+ * it around and isn't extrapolated at all while the newest movement
+ * opposes the estimated velocity, so the prediction never overshoots a
+ * reversal of direction. The result is limited to the range of
+ * <hmi3d_position_t>.
+ *
+ * The position is based on the latest data-frame rather than on the
+ * results of <hmi3d_retrieve_data>.
+ *
+ * Note:
+ *    Without a platform timer HMI_TIME_US is always 0, so only the
+ *    position of the last frame is returned.
+ *
+ * See also:
+ *    <hmi3d_set_prediction>
+ */
+HMI_API int CDECL hmi3d_predict_position(hmi_t *hmi,
+                                         unsigned int target,
+                                         hmi3d_position_t *position);
+
+/* Enumeration: hmi3d_signal_stream_t
+ *
+ * The streams of signals with statistics.
+ *
+ * hmi3d_stream_cic - The CIC signals as returned by <hmi3d_get_cic>
+ * hmi3d_stream_sd  - The SD signals as returned by <hmi3d_get_sd>
+ *
+ * See also:
+ *    <hmi3d_get_signal_stats>, <hmi3d_get_signal_percentile>
+ */
+typedef enum {
+    hmi3d_stream_cic = 0,
+    hmi3d_stream_sd = 1
+} hmi3d_signal_stream_t;
+
+/* Structure: hmi3d_signal_stats_config_t
+ *
+ * Parameters of the statistics of the signals.
+ *
+ * ewma_alpha - Weight of the last frame in the exponentially weighted
+ *              moving average between 0 and 1
+ * window     - Count of frames the percentiles are computed over
+ *
+ * See also:
+ *    <hmi3d_set_signal_stats>
+ */
+typedef struct {
+    float ewma_alpha;
+    int window;
+} hmi3d_signal_stats_config_t;
+
+/* Structure: hmi3d_signal_stats_t
+ *
+ * Statistics of every channel of a stream since the statistics were
+ * enabled.
+ *
+ * count    - Count of frames with valid data of the stream
+ * mean     - The mean value
+ * variance - The sample variance
+ * ewma     - The exponentially weighted moving average
+ * min      - The minimum value
+ * max      - The maximum value
+ *
+ * See also:
+ *    <hmi3d_get_signal_stats>
+ */
+typedef struct {
+    unsigned int count;
+    hmi3d_signal_t mean;
+    hmi3d_signal_t variance;
+    hmi3d_signal_t ewma;
+    hmi3d_signal_t min;
+    hmi3d_signal_t max;
+} hmi3d_signal_stats_t;
+
+#ifndef HMI3D_NO_SIGNAL_STATS
+
+/* Function: hmi3d_set_signal_stats
+ *
+ * Enables or disables the statistics of the CIC and SD signals.
+ *
+ * config - The parameters of the statistics or NULL to disable them
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * Every data-frame with valid <hmi3d_DataOutConfigMask_CICData> or
+ * <hmi3d_DataOutConfigMask_SDData> updates the statistics of the
+ * respective stream as it is received, so no history is kept and queries
+ * are cheap at any time. Enabling the statistics again restarts them.
+ *
+ * The window is at most 131070 frames. Defining HMI3D_NO_SIGNAL_STATS
+ * removes the statistics and their 6 KB inside <hmi_t> completely.
+ *
+ * See also:
+ *    <hmi3d_get_signal_stats>, <hmi3d_get_signal_percentile>
+ */
+HMI_API int CDECL hmi3d_set_signal_stats(
+        hmi_t *hmi,
+        const hmi3d_signal_stats_config_t *config);
+
+/* Function: hmi3d_get_signal_stats
+ *
+ * Returns the statistics of a stream.
+ *
+ * stream - The <hmi3d_signal_stream_t>
+ * stats  - Pointer to the <hmi3d_signal_stats_t> that receives the
+ *          statistics
+ *
+ * Returns HMI_NO_ERROR on success, HMI_NO_DATA if the statistics are
+ * disabled or no frame was received yet or HMI_BAD_PARAM_ERROR if the
+ * stream is unknown.
+ */
+HMI_API int CDECL hmi3d_get_signal_stats(hmi_t *hmi,
+                                         hmi3d_signal_stream_t stream,
+                                         hmi3d_signal_stats_t *stats);
+
+/* Function: hmi3d_get_signal_percentile
+ *
+ * Returns a percentile of every channel of a stream over the last frames.
+ *
+ * stream   - The <hmi3d_signal_stream_t>
+ * quantile - The quantile between 0 and 1, e.g. 0.5 for the median
+ * value    - Pointer to the <hmi3d_signal_t> that receives the percentiles
+ *
+ * Returns HMI_NO_ERROR on success, HMI_NO_DATA if the statistics are
+ * disabled or no frame was received yet or HMI_BAD_PARAM_ERROR if a
+ * parameter is out of range.
+ *
+ * The percentiles are interpolated from histograms over the last half to
+ * full window of frames. The histograms span six standard deviations
+ * around the average, values beyond count as the edge.
+ */
+HMI_API int CDECL hmi3d_get_signal_percentile(
+        hmi_t *hmi,
+        hmi3d_signal_stream_t stream,
+        float quantile,
+        hmi3d_signal_t *value);
+
+#endif
+
+/* Constant: HMI3D_NOISE_SAMPLES
+ *
+ * Count of consecutive frames whose spectrum is analyzed for
+ * interference. Has to be a power of 2.
+ */
+#ifndef HMI3D_NOISE_SAMPLES
+#define HMI3D_NOISE_SAMPLES 64
+#endif
+
+/* Typedef: hmi3d_spectrum_t
+ *
+ * Definition of the signature for functions that compute a power
+ * spectrum, e.g. with an FFT library of the platform.
+ *
+ * opaque  - The opaque pointer of <hmi3d_noise_config_t>
+ * samples - <HMI3D_NOISE_SAMPLES> real samples, which may be overwritten
+ * power   - Receives the squared magnitudes of the DFT bins 0 to
+ *           <HMI3D_NOISE_SAMPLES> / 2
+ */
+typedef void (CDECL* hmi3d_spectrum_t)(void *opaque,
+                                       float *samples,
+                                       float *power);
+
+/* Structure: hmi3d_noise_config_t
+ *
+ * Parameters of the noise analysis.
+ *
+ * frequency       - The frequencies in kHz of <hmi3d_freq1> to
+ *                   <hmi3d_freq5> as reported by <hmi3d_get_frequency>.
+ *                   They are listed in the manual of the library. 0 marks
+ *                   a frequency as not available.
+ * cutoff          - Lowest DFT bin counted as interference. Lower bins
+ *                   contain the movements of the hand.
+ * threshold       - Factor above the interference of the cleanest
+ *                   frequency up to which frequencies are allowed, at
+ *                   least 1
+ * hysteresis      - Factor above threshold at which an allowed frequency
+ *                   is excluded again, at least 1
+ * min_frequencies - Count of frequencies that stay allowed at least
+ * hold            - Count of frames between changes of the selection
+ * retry           - Count of frames after which an excluded frequency is
+ *                   allowed again to measure its interference anew
+ * spectrum        - Function that computes the power spectrum or NULL for
+ *                   the built-in FFT
+ * opaque          - Opaque pointer that is passed to spectrum
+ *
+ * See also:
+ *    <hmi3d_set_noise_analysis>
+ */
+typedef struct {
+    int frequency[5];
+    int cutoff;
+    float threshold;
+    float hysteresis;
+    int min_frequencies;
+    int hold;
+    int retry;
+    hmi3d_spectrum_t spectrum;
+    void *opaque;
+} hmi3d_noise_config_t;
+
+/* Structure: hmi3d_noise_analysis_t
+ *
+ * Result of the noise analysis.
+ *
+ * interference - Estimated interference at each frequency as the power of
+ *                the CIC signals above the cutoff plus the noise power
+ *                reported by the device
+ * age          - Count of frames since each frequency was analyzed the
+ *                last time or -1 if it was never analyzed
+ * selected     - The allowed frequencies as combination of
+ *                <hmi3d_frequencies_t>-values
+ * applied      - The frequencies last passed to
+ *                <hmi3d_select_frequencies>
+ *
+ * See also:
+ *    <hmi3d_get_noise_analysis>
+ */
+typedef struct {
+    float interference[5];
+    int age[5];
+    int selected;
+    int applied;
+} hmi3d_noise_analysis_t;
+
+/* Function: hmi3d_set_noise_analysis
+ *
+ * Enables or disables the analysis of the interference at the working
+ * frequencies.
+ *
+ * config - The parameters of the analysis or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * The sum of the CIC signals of <HMI3D_NOISE_SAMPLES> consecutive frames
+ * at the same frequency is windowed and transformed by a real FFT. The
+ * power above the cutoff together with the noise power of the device
+ * estimates the interference at that frequency. The data output has to
+ * contain <hmi3d_DataOutConfigMask_DSPStatus> and
+ * <hmi3d_DataOutConfigMask_CICData>, <hmi3d_DataOutConfigMask_NoisePower>
+ * is optional.
+ *
+ * The analysis selects the frequencies with low interference. The device
+ * only switches between the selected frequencies once
+ * <hmi3d_update_frequency_selection> passes them on.
+ *
+ * See also:
+ *    <hmi3d_get_noise_analysis>, <hmi3d_noise_config_t>
+ */
+HMI_API int CDECL hmi3d_set_noise_analysis(
+        hmi_t *hmi,
+        const hmi3d_noise_config_t *config);
+
+/* Function: hmi3d_get_noise_analysis
+ *
+ * Returns the current result of the noise analysis.
+ *
+ * analysis - Pointer to the <hmi3d_noise_analysis_t> that receives the
+ *            result
+ *
+ * Returns HMI_NO_ERROR on success or HMI_NO_DATA if the analysis is
+ * disabled.
+ */
+HMI_API int CDECL hmi3d_get_noise_analysis(hmi_t *hmi,
+                                           hmi3d_noise_analysis_t *analysis);
+
+#ifndef HMI3D_NO_CALIB_SCHEDULE
+
+/* Structure: hmi3d_calib_schedule_t
+ *
+ * Parameters of the calibration scheduler.
+ *
+ * stream       - The <hmi3d_signal_stream_t> whose drift is tracked. The
+ *                drift of SD is its distance from 0, the drift of CIC its
+ *                distance from the level after the last calibration.
+ * threshold    - Drift of a channel above which a calibration is due
+ * ewma_alpha   - Weight of a frame in the average of the signals between 0
+ *                and 1
+ * idle_frames  - Count of frames without a hand before the signals count
+ *                as settled
+ * min_interval - Count of frames between calibrations at least
+ *
+ * See also:
+ *    <hmi3d_set_calibration_schedule>
+ */
+typedef struct {
+    hmi3d_signal_stream_t stream;
+    float threshold;
+    float ewma_alpha;
+    int idle_frames;
+    int min_interval;
+} hmi3d_calib_schedule_t;
+
+/* Structure: hmi3d_calib_record_t
+ *
+ * A calibration recorded by the calibration scheduler.
+ *
+ * reason     - Reason of the calibration as OR-combination of
+ *              <hmi3d_calib_reason_t>
+ * last_event - Frame counter of the calibration
+ * drift      - Largest drift of the channels before the calibration
+ * scheduled  - Not zero when the scheduler requested the calibration
+ *
+ * See also:
+ *    <hmi3d_get_calibration_log>
+ */
+typedef struct {
+    hmi3d_calib_reason_t reason;
+    int last_event;
+    float drift;
+    int scheduled;
+} hmi3d_calib_record_t;
+
+/* Function: hmi3d_set_calibration_schedule
+ *
+ * Enables or disables the calibration scheduler.
+ *
+ * schedule - The parameters of the scheduler or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * The scheduler averages the signals of the frames without a hand, which
+ * are frames without valid position and without touch. Once the signals
+ * settled and a channel drifted beyond the threshold a calibration is due.
+ * It is requested by <hmi3d_update_calibration>, so a calibration never
+ * happens while a hand is present. The data output has to contain
+ * <hmi3d_DataOutConfigMask_xyzPosition>, <hmi3d_DataOutConfigMask_DSPStatus>
+ * and the tracked stream.
+ *
+ * The automatic calibration of the device should be disabled with
+ * <hmi3d_set_auto_calibration> to leave calibrations to the scheduler.
+ * Defining HMI3D_NO_CALIB_SCHEDULE removes the scheduler completely.
+ *
+ * See also:
+ *    <hmi3d_get_calibration_drift>, <hmi3d_get_calibration_log>
+ */
+HMI_API int CDECL hmi3d_set_calibration_schedule(
+        hmi_t *hmi,
+        const hmi3d_calib_schedule_t *schedule);
+
+/* Function: hmi3d_get_calibration_drift
+ *
+ * Returns the drift of every channel since the last calibration.
+ *
+ * drift - Pointer to the <hmi3d_signal_t> that receives the drift
+ *
+ * Returns HMI_NO_ERROR on success or HMI_NO_DATA if the scheduler is
+ * disabled or the signals did not settle since the last calibration.
+ */
+HMI_API int CDECL hmi3d_get_calibration_drift(hmi_t *hmi,
+                                              hmi3d_signal_t *drift);
+
+/* Constant: HMI3D_CALIB_LOG
+ *
+ * Count of the last calibrations recorded by the calibration scheduler.
+ */
+#ifndef HMI3D_CALIB_LOG
+#define HMI3D_CALIB_LOG 32
+#endif
+
+/* Function: hmi3d_get_calibration_log
+ *
+ * Returns the last calibrations while the calibration scheduler was
+ * enabled.
+ *
+ * records - Array that receives the calibrations from the oldest on
+ * size    - Count of entries of records
+ *
+ * Returns the count of calibrations stored in records. Up to
+ * <HMI3D_CALIB_LOG> calibrations are kept, whether they were caused by the
+ * scheduler or by the device.
+ */
+HMI_API int CDECL hmi3d_get_calibration_log(hmi_t *hmi,
+                                            hmi3d_calib_record_t *records,
+                                            int size);
+
+#endif
+
+#ifndef HMI3D_NO_CUSTOM_GESTURES
+
+/* Constant: HMI3D_CUSTOM_POINTS
+ *
+ * Count of points that describe a custom gesture.
+ */
+#define HMI3D_CUSTOM_POINTS 32
+
+/* Structure: hmi3d_custom_gesture_t
+ *
+ * A custom gesture as captured by <hmi3d_capture_custom_gesture>.
+ *
+ * frames    - Count of frames the gesture lasted
+ * threshold - Maximum distance of a movement to be recognized as this
+ *             gesture. The distance is the mean squared difference of the
+ *             normalized points after alignment, so 0 is a perfect match.
+ *             Values between 0.05 and 0.2 are a good start.
+ * point     - The course of the gesture as normalized position (x, y, z)
+ *             and sum of the SD channels. The SD is zero unless
+ *             <hmi3d_DataOutConfigMask_SDData> is part of the data output.
+ *
+ * Applications may store the structure to add the gesture again later.
+ */
+typedef struct {
+    int frames;
+    float threshold;
+    float point[HMI3D_CUSTOM_POINTS][4];
+} hmi3d_custom_gesture_t;
+
+/* Structure: hmi3d_custom_template_t
+ *
+ * Storage of a custom gesture as prepared for the recognition. Its members
+ * are internal.
+ *
+ * See also:
+ *    <hmi3d_set_custom_storage>
+ */
+typedef struct {
+    hmi3d_custom_gesture_t gesture;
+    /* Envelope of the points within the band of the alignment */
+    float upper[HMI3D_CUSTOM_POINTS][4];
+    float lower[HMI3D_CUSTOM_POINTS][4];
+    /* Index of the gesture with the next larger count of frames */
+    int next;
+} hmi3d_custom_template_t;
+
+/* Function: hmi3d_set_custom_storage
+ *
+ * Sets the storage of the custom gestures.
+ *
+ * templates - Array that holds the gestures or NULL for the storage inside
+ *             <hmi_t>
+ * count     - Count of entries of templates
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if count is out
+ * of range.
+ *
+ * The storage inside <hmi_t> holds <HMI3D_CUSTOM_MAX_GESTURES> gestures.
+ * Applications with dozens of gestures pass an array of their own, which
+ * has to stay valid until it is replaced or <hmi_cleanup> is called. All
+ * custom gestures are removed.
+ *
+ * Defining HMI3D_NO_CUSTOM_GESTURES removes the recognition of custom
+ * gestures completely.
+ *
+ * See also:
+ *    <hmi3d_add_custom_gesture>
+ */
+HMI_API int CDECL hmi3d_set_custom_storage(hmi_t *hmi,
+                                           hmi3d_custom_template_t *templates,
+                                           int count);
+
+/* Function: hmi3d_capture_custom_gesture
+ *
+ * Captures the last movement of the hand as custom gesture.
+ *
+ * frames    - Count of the last frames that contain the gesture
+ * threshold - The threshold of the gesture
+ * gesture   - Pointer to the <hmi3d_custom_gesture_t> that receives the
+ *             gesture
+ *
+ * Returns HMI_NO_ERROR on success, HMI_NO_DATA if the hand was not present
+ * during all frames or did not move or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * The frames are taken from the positions received by
+ * <hmi3d_retrieve_data>. Up to <HMI3D_CUSTOM_HISTORY> frames are available.
+ *
+ * See also:
+ *    <hmi3d_add_custom_gesture>
+ */
+HMI_API int CDECL hmi3d_capture_custom_gesture(
+        hmi_t *hmi,
+        int frames,
+        float threshold,
+        hmi3d_custom_gesture_t *gesture);
+
+/* Function: hmi3d_add_custom_gesture
+ *
+ * Adds a custom gesture to the recognition.
+ *
+ * gesture - The gesture as captured by <hmi3d_capture_custom_gesture>
+ *
+ * Returns the <hmi3d_gestures_t> code of the gesture on success or
+ * HMI_BAD_PARAM_ERROR if the gesture is invalid or the storage of the
+ * gestures is full.
+ *
+ * While the hand is present the movement of the last frames is compared
+ * with every custom gesture after every frame. Movements between 0.8 and
+ * 1.2 times the duration of the gesture are compared and dynamic time
+ * warping aligns both, so the speed of the movement may also vary along the
+ * way. A lower bound of the distance rules out most gestures before the
+ * alignment.
+ *
+ * A recognized gesture is reported like the gestures of the device via
+ * <hmi3d_get_gesture> with its code once <HMI3D_CUSTOM_SETTLE> frames
+ * matched no closer or the hand left. The recognition then waits for the
+ * next movement.
+ *
+ * See also:
+ *    <hmi3d_clear_custom_gestures>
+ */
+HMI_API int CDECL hmi3d_add_custom_gesture(
+        hmi_t *hmi,
+        const hmi3d_custom_gesture_t *gesture);
+
+/* Function: hmi3d_clear_custom_gestures
+ *
+ * Removes all custom gestures from the recognition.
+ */
+HMI_API void CDECL hmi3d_clear_custom_gestures(hmi_t *hmi);
+
+#endif
+
+#endif
+
+/* ======== 3D Firmware Version ======== */
+
+#ifndef HMI3D_NO_FW_VERSION
+
+/* Function: hmi3d_query_fw_version
+ *
+ * Reads the library version information.
+ *
+ * version  - Pointer to a buffer receiving the version string
+ * v_length - Maximal length of version in bytes including the terminating 0.
+ *
+ * Note:
+ *    The complete firmware-version-string has a maximum size of 120
+ *    characters.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ */
+HMI_API int CDECL hmi3d_query_fw_version(hmi_t *hmi,
+                                            char *version,
+                                            int v_length);
+
+#endif
+
+/* ======== 3D Real time control (RTC) ======== */
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+/* Function: hmi3d_set_output_enable_mask
+ *
+ * Changes the data output of the 3D part of the device.
+ *
+ * flags   - Which data to be streamed as a combination of
+ *           <hmi3d_DataOutConfigMask_t>-values
+ * locked  - Which of the streamed data have to be always included in the
+ *           message even when they have no valid data.
+ * mask    - The mask of which data should get configured by this call
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_output_enable_mask>
+ */
+HMI_API int CDECL hmi3d_set_output_enable_mask(hmi_t *hmi,
+                                               hmi3d_DataOutConfigMask_t flags,
+                                               hmi3d_DataOutConfigMask_t locked,
+                                               hmi3d_DataOutConfigMask_t mask);
+
+/* Function: hmi3d_get_output_enable_mask
+ *
+ * Reads back the mask of data output set in the 3D part of the device.
+ *
+ * flags   - Pointer to variable receiving which data is to be streamed as a
+ *           combination of <hmi3d_DataOutConfigMask_t>-values. May be 0.
+ * locked  - Pointer to variable receiving which of the streamed data has to
+ *           be included always even though they are not valid. May be 0.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of flags and locked is not defined.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_output_enable_mask>
+ */
+HMI_API int CDECL hmi3d_get_output_enable_mask(hmi_t *hmi,
+                                               hmi3d_DataOutConfigMask_t *flags,
+                                               hmi3d_DataOutConfigMask_t *locked);
+
+#endif
+
+#ifndef HMI3D_NO_RTC
+
+/* Enumeration: hmi3d_frequencies_t
+ *
+ * Bitmask for working frequencies that could be enabled.
+ * The actual frequencies depend on the library version in place and are listed
+ * in the libraries manual.
+ * The currently selected frequency may be fetched with <hmi3d_get_frequency>.
+ *
+ * hmi3d_freq1    - Frequency 1 enabled (highest)
+ * hmi3d_freq2    - Frequency 2 enabled
+ * hmi3d_freq3    - Frequency 3 enabled
+ * hmi3d_freq4    - Frequency 4 enabled
+ * hmi3d_freq5    - Frequency 5 enabled (lowest)
+ * hmi3d_all_freq - All frequencies enabled
+ *
+ * See also:
+ *    <hmi3d_select_frequencies>
+ */
+typedef enum {
+    hmi3d_freq1 = 0x01,
+    hmi3d_freq2 = 0x02,
+    hmi3d_freq3 = 0x04,
+    hmi3d_freq4 = 0x08,
+    hmi3d_freq5 = 0x10,
+    hmi3d_all_freq = 0x1F
+} hmi3d_frequencies_t;
+
+/* Function: hmi3d_set_auto_calibration
+ *
+ * Enables automatic calibration if enabled is set to a value other than 0.
+ *
+ * enabled - Boolean value whether calibration is enabled
+ *
+ * Returns 0 if the change was succesfull or a negative value on failure.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_auto_calibration>, <hmi3d_force_calibration>,
+ *    <hmi3d_get_calibration>
+ */
+HMI_API int CDECL hmi3d_set_auto_calibration(hmi_t *hmi,
+                                             int enabled);
+
+/* Function: hmi3d_get_auto_calibration
+ *
+ * Reads back whether automatic calibration is enabled.
+ *
+ * enabled - Pointer to variable that receives the state of auto-calibration
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of enabled will not be changed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_auto_calibration>, <hmi3d_force_calibration>
+ */
+HMI_API int CDECL hmi3d_get_auto_calibration(hmi_t *hmi,
+                                             int *enabled);
+
+/* Function: hmi3d_force_calibration
+ *
+ * Enforces a immediate calibration of the device.
+ *
+ * Returns 0 if the device acknoledged the calibration-request.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_auto_calibration>
+ */
+HMI_API int CDECL hmi3d_force_calibration(hmi_t *hmi);
+
+/* Function: hmi3d_select_frequencies
+ *
+ * Selects which working frequencies are allowed.
+ *
+ * frequencies - Allowed frequencies as a combination of <hmi3d_frequencies_t>
+ *
+ * Selects the allowed working frequencies for the device. The allowed
+ * frequencies are passed in the argument frequencies as a bitwise-or
+ * combination of <hmi3d_frequencies_t>-values.
+ *
+ * Returns 0 if the change was successfull.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ */
+HMI_API int CDECL hmi3d_select_frequencies(hmi_t *hmi,
+                                           hmi3d_frequencies_t frequencies);
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+/* Function: hmi3d_update_frequency_selection
+ *
+ * Passes the frequencies selected by the noise analysis on to the device.
+ *
+ * Returns HMI_NO_ERROR if the device already uses the selection or the
+ * result of <hmi3d_select_frequencies> otherwise.
+ *
+ * The analysis runs while data is received but the request to the device
+ * waits for its response, so the application calls this function from its
+ * own context, e.g. after <hmi3d_retrieve_data>. A failed request is tried
+ * again on the next call.
+ *
+ * See also:
+ *    <hmi3d_set_noise_analysis>
+ */
+HMI_API int CDECL hmi3d_update_frequency_selection(hmi_t *hmi);
+
+#ifndef HMI3D_NO_CALIB_SCHEDULE
+
+/* Function: hmi3d_update_calibration
+ *
+ * Forces a calibration when the calibration scheduler found it due.
+ *
+ * Returns HMI_NO_ERROR if no calibration is due or the result of
+ * <hmi3d_force_calibration> otherwise.
+ *
+ * Like <hmi3d_update_frequency_selection> the application calls this
+ * function from its own context, e.g. after <hmi3d_retrieve_data>.
+ *
+ * See also:
+ *    <hmi3d_set_calibration_schedule>
+ */
+HMI_API int CDECL hmi3d_update_calibration(hmi_t *hmi);
+
+#endif
+
+#endif
+
+/* Function: hmi3d_set_approach_detection
+ *
+ * Enables approach detection for power saving.
+ *
+ * enabled - Boolean value whether approach detection is enabled
+ *
+ * Returns 0 if the change was successfull.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_approach_detection>
+ */
+HMI_API int CDECL hmi3d_set_approach_detection(hmi_t *hmi, int enabled);
+
+/* Function: hmi3d_get_approach_detection
+ *
+ * Reads back whether approach detection is enabled.
+ *
+ * enabled - Pointer to a variable receiving the state of the approach detection
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of enabled will not be changed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_approach_detection>
+ */
+HMI_API int CDECL hmi3d_get_approach_detection(hmi_t *hmi, int *enabled);
+
+/* Function: hmi3d_set_enabled_gestures
+ *
+ * Makes certain gestures available for gesture recognition.
+ *
+ * gestures - Bitmask of gestures that are to be enabled
+ *
+ * Returns 0 if the enabled gestures was successfully changed.
+ *
+ * The individual gestures are represented as 1 shifted by the value of the
+ * according <hmi3d_gestures_t>-constant. E.g. Horizontal flicks are
+ * represented by (1 << hmi3d_flick_w2e) | (1 << hmi3d_flick_e2w)
+ *
+ * After a failure or no response within the timeout the request gest resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_enabled_gestures>, <hmi3d_get_gesture>
+ */
+HMI_API int CDECL hmi3d_set_enabled_gestures(hmi_t *hmi, int gestures);
+
+/* Function: hmi3d_get_enabled_gestures
+ *
+ * Reads back which gestures are currently available for gesture detection.
+ *
+ * gestures - Pointer to a variable receiving the bitmask of enabled gestures
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of gestures will not be changed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_enabled_gestures>
+ */
+HMI_API int CDECL hmi3d_get_enabled_gestures(hmi_t *hmi, int *gestures);
+
+/* Function: hmi3d_set_touch_detection
+ *
+ * En-/Disables touch detection.
+ *
+ * enabled - Boolean value whether touch detection is enabled
+ *
+ * Returns 0 if the change was successfull.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_touch_detection>, <hmi3d_get_touch>
+ */
+HMI_API int CDECL hmi3d_set_touch_detection(hmi_t *hmi, int enabled);
+
+/* Function: hmi3d_get_touch_detection
+ *
+ * Reads back whether touch detection is enabled
+ *
+ * enabled - Pointer to a variable receiving the state of touch-detection
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of enabled will not be changed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_touch_detection>
+ */
+HMI_API int CDECL hmi3d_get_touch_detection(hmi_t *hmi, int *enabled);
+
+/* Function: hmi3d_set_air_wheel_enabled
+ *
+ * En-/Disables AirWheel.
+ *
+ * enabled - Boolean value whether AirWheel is enabled
+ *
+ * Returns 0 if the change was successfull.
+ *
+ * If AirWheel is enabled no circle-gestures could be detected.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_get_air_wheel_enabled>, <hmi3d_get_air_wheel>
+ */
+HMI_API int CDECL hmi3d_set_air_wheel_enabled(hmi_t *hmi, int enabled);
+
+/* Function: hmi3d_get_air_wheel_enabled
+ *
+ * Reads back whether the AirWheel-feature is enabled
+ *
+ * enabled - Pointer to a variable receiving the state of AirWheel-feature
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * If the request failed the content of enabled will not be changed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_air_wheel_enabled>
+ */
+HMI_API int CDECL hmi3d_get_air_wheel_enabled(hmi_t *hmi, int *enabled);
+
+/* Function: hmi3d_make_persistent
+ *
+ * Stores current value for all parameters of a category to the flash.
+ *
+ * category - Parameter category which should be stored
+ *
+ * Returns 0 if parameters where successfully stored or
+ * the negative error-code on failure.
+ *
+ * After a failure or no response within the timeout the request gets
+ * resend up to three times.
+ *
+ * See also:
+ *    <hmi3d_set_param>, <hmi3d_param_category>
+ */
+HMI_API int CDECL hmi3d_make_persistent(hmi_t *hmi,
+                                        hmi3d_param_category category);
+
+#endif
+
+/* ======== 3D Firmware Update Functions ======== */
+
+#ifndef HMI3D_NO_UPDATE
+
+/* Enumeration: hmi3d_UpdateFunction_t
+ *
+ * The mode of the update-session
+ *
+ * hmi3d_UpdateFunction_ProgramFlash - Records will be written to the flash
+ * hmi3d_UpdateFunction_VerifyOnly   - Code will only be verified but not
+ *                                     changed in flash.
+ * hmi3d_UpdateFunction_Restart      - Only used internally for final restart.
+ *                                     Don't provide this to the hmi3d_update_*
+ *                                     functions
+ *
+ * If a session gets started by calling <hmi3d_update_begin> with
+ * <hmi3d_UpdateFunction_VerifyOnly> no other value is allowed in subsequent
+ * <hmi3d_update_write> calls.
+ *
+ * If a session gets started with <hmi3d_UpdateFunction_ProgramFlash> it has to
+ * be finished with <hmi3d_UpdateFunction_ProgramFlash> too in order to have a
+ * valid firmware.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
+ *    <hmi3d_update_write>
+ */
+typedef enum {
+    hmi3d_UpdateFunction_ProgramFlash = 0,
+    hmi3d_UpdateFunction_VerifyOnly = 1,
+    hmi3d_UpdateFunction_Restart = 3
+} hmi3d_UpdateFunction_t;
+
+/* Structure: hmi3d_update_record_t
+ *
+ * Contains one record of a firmware library image.
+ *
+ * address - The address of the record aligned to 128 bytes
+ * length  - The length of the data packed in the record.
+ *           This is NOT the size of the record itself.
+ * record  - The 128-byte long content of the record.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_image_t>
+ */
+typedef struct {
+    unsigned short address;
+    unsigned char length;
+    unsigned char data[128];
+} hmi3d_update_record_t;
+
+/* Structure: hmi3d_update_image_t
+ *
+ * Contains the data of a library image as required by <hmi3d_update_image>
+ *
+ * record_count - The actual count of records
+ * iv           - The initialization vector.
+ * fw_version   - The version containing an ASCII-string
+ * data         - The first of record_count records
+ *
+ * For instructions on how to obtain an hmi3d_update_image_t instance see
+ * <3D Firmware Update>.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>
+ */
+typedef struct {
+    int record_count;
+    unsigned char iv[14];
+    unsigned char fw_version[120];
+    hmi3d_update_record_t data[1];
+} hmi3d_update_image_t;
+
+/* Function: hmi3d_update_begin
+ *
+ * Starts a flash session to update the contained firmware-library
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * iv         - The 14-byte long initialization vector.
+ *              It is provided as part of the library-image.
+ * mode       - The mode for this session
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * This function resets the device and starts an session for updating the
+ * contained firmware-library. The session has to be finished with
+ * hmi3d_update_end or another reset to cancel it.
+ *
+ * Note:
+ *    If the mode is <hmi3d_UpdateFunction_VerifyOnly> subsequent calls to
+ *    <hmi3d_update_write> have to be called with the same mode.
+ *    <hmi3d_update_end> implicitely uses the same mode to finish the session.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_write>,
+ *    <hmi3d_update_end>
+ */
+HMI_API int CDECL hmi3d_update_begin(hmi_t *hmi,
+                                     unsigned int session_id,
+                                     void *iv,
+                                     hmi3d_UpdateFunction_t mode);
+
+/* Function: hmi3d_update_write
+ *
+ * Writes one record during a flash session
+ *
+ * address - The address of the record, This is part of the library-image
+ * length  - The size of the data packed in the record.
+ *           This is NOT the size of the record
+ * record  - The 128-byte long data of the record
+ * mode    - The update-mode for this record.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * The address is aligned to 128 bytes and the record is always 128-bytes long
+ * independant of size-argument. If the provided record is less than 128-bytes
+ * the rest of the record has to be filled with zeros.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * Note:
+ *    If <hmi3d_update_begin> was called with <hmi3d_UpdateFunction_VerifyOnly>
+ *    this mode has to be used in the <hmi3d_update_write> too.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
+ *    <hmi3d_update_end>
+ */
+HMI_API int CDECL hmi3d_update_write(hmi_t *hmi,
+                                     unsigned short address,
+                                     unsigned char length,
+                                     unsigned char *record,
+                                     hmi3d_UpdateFunction_t mode);
+
+/* Function: hmi3d_update_end
+ *
+ * Finishes the flash process and ends the flash session.
+ *
+ * version - The 120-byte long library-version containing an ASCII-string
+ *           It is provided as part of the the firmware image
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * This function ends the flash session by finally writing the version-string
+ * and resetting the device. After this function returns the device
+ * needs some time until it finishes the reset and subsequent start-up
+ * procedure. <hmi3d_wait_for_version_info> waits until the
+ * wanted start-up procedure sends the firmware version message which
+ * marks that the library loader is ready (first call) or the library itself
+ * is ready (second call).
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * Note:
+ *    The final reset triggered by <hmi3d_update_end> may be delayed by
+ *    the firmware for a few seconds. This could be shortened by a manual
+ *    <hmi3d_reset> about 200 milliseconds after <hmi3d_update_end> succeeded.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time
+ *    (about 20-25 seconds) to complete the update before it is ready for
+ *    flashing the firmware. <hmi3d_update_wait_loader_done> does the
+ *    required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_begin>,
+ *    <hmi3d_update_write>
+ */
+HMI_API int CDECL hmi3d_update_end(hmi_t *hmi,
+                                   unsigned char *version);
+
+/* Function: hmi3d_update_image
+ *
+ * Does the whole process of writing the image to device including the resets.
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * image      - Ptr to a <hmi3d_update_image_t>-structure containing the image.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * Runs the whole process of flashing the firmware library on the provided
+ * image. This includeds the initial and final restarts of the device.
+ * If the image is not available in a <hmi3d_update_image_t>-structure the
+ * functions <hmi3d_update_begin>, <hmi3d_update_write> and <hmi3d_update_end>
+ * could be used directly.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time to
+ *    complete the update before it is ready for flashing the firmware.
+ *    <hmi3d_update_wait_loader_done> does the required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_begin>, <hmi3d_update_write>,
+ *    <hmi3d_update_end>
+ */
+HMI_API int CDECL hmi3d_update_image(hmi_t *hmi,
+                                     unsigned int session_id,
+                                     hmi3d_update_image_t *image,
+                                     hmi3d_UpdateFunction_t mode);
+
+/* Structure: hmi3d_update_stats_t
+ *
+ * Statistics about the transfer of the records of an update.
+ *
+ * records         - Count of records that were transferred
+ * verified        - Count of records that were sent for verification by
+ *                   <hmi3d_update_image_if_changed> or
+ *                   <hmi3d_update_image_resumable>
+ * mismatch_record - Index of the first record that differs from the flash,
+ *                   the record count of the image when only the version
+ *                   differs or -1 when no difference was found
+ * programmed      - 1 when the flash was programmed, otherwise 0
+ * retransmits     - Count of blocks that were sent again after an error or a
+ *                   missing acknowledge
+ * resumed_record  - Index of the record where <hmi3d_update_image_resumable>
+ *                   continued an interrupted session or -1 when the update
+ *                   started over
+ * recovery_ms     - Time in milliseconds from the start of
+ *                   <hmi3d_update_image_resumable> until flash mode was
+ *                   entered again to continue after the checkpoint or 0
+ *                   when the update started over
+ * elapsed_ms      - Duration of the transfer of the records in milliseconds
+ * records_per_s   - Achieved throughput in records per second
+ *
+ * The durations are 0 on platforms without <HMI_TIME_US>.
+ *
+ * See also:
+ *    <hmi3d_update_image_windowed>, <hmi3d_update_image_if_changed>,
+ *    <hmi3d_update_image_resumable>
+ */
+typedef struct {
+    int records;
+    int verified;
+    int mismatch_record;
+    int programmed;
+    int retransmits;
+    int resumed_record;
+    int recovery_ms;
+    int elapsed_ms;
+    float records_per_s;
+} hmi3d_update_stats_t;
+
+/* Function: hmi3d_update_image_windowed
+ *
+ * Writes the image to the device like <hmi3d_update_image> but keeps
+ * several records in flight.
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * image      - Ptr to a <hmi3d_update_image_t>-structure containing the image.
+ * mode       - The mode for this session
+ * window     - Maximum count of records that are sent before their
+ *              acknowledge was received. It is limited to
+ *              HMI3D_UPDATE_MAX_WINDOW. A window of 1 behaves like
+ *              <hmi3d_update_image>.
+ * stats      - Optional pointer that receives the <hmi3d_update_stats_t> of
+ *              the transfer. May be NULL.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * The acknowledges of the device are expected in the order the records were
+ * sent. Records that are rejected by the device are sent again and fail the
+ * update after three unsuccessful attempts. The window is drained every
+ * HMI3D_UPDATE_SEGMENT records. When acknowledges are missing for
+ * 100 milliseconds all records since the last drain are sent again. Late
+ * acknowledges of these records are discarded before, for up to another
+ * 100 milliseconds without any of them.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time to
+ *    complete the update before it is ready for flashing the firmware.
+ *    <hmi3d_update_wait_loader_done> does the required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>
+ */
+HMI_API int CDECL hmi3d_update_image_windowed(hmi_t *hmi,
+                                              unsigned int session_id,
+                                              hmi3d_update_image_t *image,
+                                              hmi3d_UpdateFunction_t mode,
+                                              int window,
+                                              hmi3d_update_stats_t *stats);
+
+/* Function: hmi3d_update_image_if_changed
+ *
+ * Programs the image only when it differs from the library on the device.
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * image      - Ptr to a <hmi3d_update_image_t>-structure containing the image.
+ * window     - Maximum count of records in flight as for
+ *              <hmi3d_update_image_windowed>
+ * stats      - Optional pointer that receives the <hmi3d_update_stats_t> of
+ *              both passes. May be NULL.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ * Finding a difference is no failure.
+ *
+ * The records are first sent in a session with
+ * <hmi3d_UpdateFunction_VerifyOnly>. This pass ends at the first record the
+ * device reports with <hmi3d_system_ContentMismatch>. When all records match
+ * the session is completed to let the device compare the version-string too.
+ * Only when a difference was found a second session programs the complete
+ * image. <hmi3d_update_stats_t.programmed> tells whether this happened.
+ *
+ * An unchanged image thereby only costs a verification pass and a restart
+ * while the flash is left untouched.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time to
+ *    complete the update before it is ready for flashing the firmware.
+ *    <hmi3d_update_wait_loader_done> does the required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image_windowed>
+ */
+HMI_API int CDECL hmi3d_update_image_if_changed(hmi_t *hmi,
+                                                unsigned int session_id,
+                                                hmi3d_update_image_t *image,
+                                                int window,
+                                                hmi3d_update_stats_t *stats);
+
+/* Structure: hmi3d_update_checkpoint_t
+ *
+ * Progress of <hmi3d_update_image_resumable> that allows to continue an
+ * interrupted update.
+ *
+ * session_id   - The session-id of the interrupted update or 0 when there
+ *                is no session to continue
+ * image_crc    - Checksum identifying the image of the session
+ * records_done - Count of records from the start of the image that were
+ *                written
+ *
+ * The structure has to be zeroed before the first update. It contains
+ * no pointers and may be stored to continue the update after the
+ * application was restarted.
+ *
+ * See also:
+ *    <hmi3d_update_image_resumable>
+ */
+typedef struct {
+    unsigned int session_id;
+    unsigned int image_crc;
+    int records_done;
+} hmi3d_update_checkpoint_t;
+
+/* Function: hmi3d_update_image_resumable
+ *
+ * Writes the image to the device like <hmi3d_update_image_windowed> and
+ * continues where an earlier attempt with the same checkpoint stopped.
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * image      - Ptr to a <hmi3d_update_image_t>-structure containing the image.
+ * window     - Maximum count of records in flight as with
+ *              <hmi3d_update_image_windowed>
+ * checkpoint - Ptr to the <hmi3d_update_checkpoint_t> that gets updated with
+ *              the progress
+ * stats      - Optional pointer that receives the <hmi3d_update_stats_t> of
+ *              the update. May be NULL.
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ *
+ * When the checkpoint belongs to the same session-id and image, the records
+ * before the checkpoint are first verified in a session with
+ * <hmi3d_UpdateFunction_VerifyOnly>, as the device may have been reset in
+ * the meantime. Flash mode is then entered again with the session-id of the
+ * checkpoint and programming continues with the first record that differs
+ * or was not written. Without a checkpoint or when not a single record is
+ * accepted by the continued session, the update starts over from the first
+ * record.
+ *
+ * When the library is built with HMI3D_NO_RESUME_VERIFY, the verification
+ * is skipped and programming continues right after the checkpoint.
+ *
+ * After a failure the checkpoint contains the written records, so the
+ * function can be called again after the connection was reopened. After
+ * a successful update the session of the checkpoint is cleared.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time to
+ *    complete the update before it is ready for flashing the firmware.
+ *    <hmi3d_update_wait_loader_done> does the required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image_windowed>
+ */
+HMI_API int CDECL hmi3d_update_image_resumable(
+        hmi_t *hmi,
+        unsigned int session_id,
+        hmi3d_update_image_t *image,
+        int window,
+        hmi3d_update_checkpoint_t *checkpoint,
+        hmi3d_update_stats_t *stats);
+
+/* Function: hmi3d_update_wait_loader_done
+ *
+ * Waits until loader update is finished.
+ *
+ * Return 0 on success or a negative value when request failed.
+ *
+ * Call this function after a loader got uploaded to the chip to ensure
+ * that it was completely processed and stored in flash before starting
+ * the firmware-update.
+ *
+ * Note:
+ *    An bootloader update can take up to 20 seconds.
+ *
+ * Important:
+ *    Only call this function after a loader-upload.
+ *    Otherwise it will fail and return an error.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_update_end>
+ */
+HMI_API int CDECL hmi3d_update_wait_loader_done(hmi_t *hmi);
+
+/* Function: hmi3d_wait_for_version_info
+ *
+ * After a reset waits until version info message was received.
+ *
+ * Return 0 on success or the negative <hmi_error_t> code
+ * when request failed.
+ *
+ * This function waits after a reset until the library loader
+ * version info was received. At this point the loader is ready
+ * to receive instructions.
+ *
+ * Note:
+ *    <hmi3d_update_begin> already contains the reset and waiting
+ *    until the loader is ready. There is no need to do an extra
+ *    call to <hmi3d_reset> and <hmi3d_wait_for_version_info>
+ *
+ * A second subsequent call will wait until the library version
+ * information was received. At that point the GestIC library is
+ * completely operational.
+ *
+ * Note:
+ *    This function is only intended to be used for waiting until
+ *    the different start-up states are finished.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_reset>
+ */
+HMI_API int CDECL hmi3d_wait_for_version_info(hmi_t *hmi);
+
+/* Enumeration: hmi3d_update_state_t
+ *
+ * The states of an update that advances with <hmi3d_update_step>.
+ *
+ * hmi3d_UpdateState_Idle       - No update was started
+ * hmi3d_UpdateState_Reset      - Waits for the library loader after the reset
+ * hmi3d_UpdateState_Start      - Waits until the session was started
+ * hmi3d_UpdateState_Transfer   - Sends the records of the image
+ * hmi3d_UpdateState_Complete   - Waits until the version was written
+ * hmi3d_UpdateState_Restart    - Waits until the final restart was accepted
+ * hmi3d_UpdateState_WaitLoader - Waits until a loader update was stored
+ * hmi3d_UpdateState_Done       - The update succeeded
+ * hmi3d_UpdateState_Failed     - The update failed
+ * hmi3d_UpdateState_Cancelled  - The update was cancelled with
+ *                                <hmi3d_update_cancel>
+ *
+ * See also:
+ *    <hmi3d_update_status_t>, <hmi3d_update_start>
+ */
+typedef enum {
+    hmi3d_UpdateState_Idle = 0,
+    hmi3d_UpdateState_Reset,
+    hmi3d_UpdateState_Start,
+    hmi3d_UpdateState_Transfer,
+    hmi3d_UpdateState_Complete,
+    hmi3d_UpdateState_Restart,
+    hmi3d_UpdateState_WaitLoader,
+    hmi3d_UpdateState_Done,
+    hmi3d_UpdateState_Failed,
+    hmi3d_UpdateState_Cancelled
+} hmi3d_update_state_t;
+
+/* Structure: hmi3d_update_status_t
+ *
+ * Progress of an update that advances with <hmi3d_update_step>.
+ *
+ * state        - The current <hmi3d_update_state_t>
+ * error        - The negative <hmi_error_t> code of a failed update,
+ *                otherwise 0
+ * records_done - Count of records that were acknowledged by the device
+ * record_count - Count of records of the image
+ * elapsed_ms   - Time in milliseconds since the update was started
+ * bytes_per_s  - Record data acknowledged per second
+ * eta_ms       - Estimated time in milliseconds until all records are
+ *                transferred or -1 before the first record was acknowledged
+ *
+ * The times are 0 on platforms without <HMI_TIME_US>.
+ *
+ * See also:
+ *    <hmi3d_update_get_status>, <hmi3d_update_run>
+ */
+typedef struct {
+    hmi3d_update_state_t state;
+    int error;
+    int records_done;
+    int record_count;
+    int elapsed_ms;
+    float bytes_per_s;
+    int eta_ms;
+} hmi3d_update_status_t;
+
+/* Function: hmi3d_update_start
+ *
+ * Starts an update that advances with <hmi3d_update_step> instead of
+ * blocking until it is finished.
+ *
+ * session_id  - A random session-id. Can be any value except 0.
+ * image       - Ptr to a <hmi3d_update_image_t>-structure containing the
+ *               image. It is only read and has to stay valid until the
+ *               update is finished.
+ * mode        - The mode for this session
+ * window      - Maximum count of records in flight as with
+ *               <hmi3d_update_image_windowed>
+ * wait_loader - Non-zero to wait until a loader update was stored like
+ *               <hmi3d_update_wait_loader_done>
+ *
+ * Returns 0 on success or a negative value when the reset failed.
+ *
+ * The update runs through the same steps as <hmi3d_update_image_windowed>.
+ * Instead of waiting for responses each step only handles the messages that
+ * already arrived and sends what the device is ready to accept. Timeouts are
+ * measured with <HMI_TIME_US>. On platforms without it the timeouts only
+ * count the time that <hmi3d_update_step> waited for messages.
+ *
+ * See also:
+ *    <hmi3d_update_step>, <hmi3d_update_get_status>, <hmi3d_update_run>
+ */
+HMI_API int CDECL hmi3d_update_start(hmi_t *hmi,
+                                     unsigned int session_id,
+                                     const hmi3d_update_image_t *image,
+                                     hmi3d_UpdateFunction_t mode,
+                                     int window,
+                                     int wait_loader);
+
+/* Function: hmi3d_update_step
+ *
+ * Advances an update that was started with <hmi3d_update_start>.
+ *
+ * Returns 1 when the update made progress and 0 when it waits for the
+ * device or is finished.
+ *
+ * The function never waits itself. Callers should sleep a short time when
+ * no progress was made. On platforms without <HMI_TIME_US> the function
+ * instead waits up to 10 milliseconds for a message when no progress was
+ * made, as the timeouts of the update are measured with those waits.
+ *
+ * The update only uses hmi. Other instances can keep streaming sensor data
+ * while it runs, e.g. with the step being called from a worker thread.
+ *
+ * See also:
+ *    <hmi3d_update_start>, <hmi3d_update_get_status>, <hmi3d_update_cancel>
+ */
+HMI_API int CDECL hmi3d_update_step(hmi_t *hmi);
+
+/* Function: hmi3d_update_cancel
+ *
+ * Requests to cancel the update that was started with <hmi3d_update_start>.
+ *
+ * The cancellation takes effect at the next <hmi3d_update_step>. No further
+ * records are sent and the records in flight are still acknowledged, so the
+ * update stops at a record boundary. Afterwards the device gets reset and the
+ * state changes to <hmi3d_UpdateState_Cancelled>. Once all records were
+ * transferred the update is finished instead.
+ *
+ * The function may be called from another thread than the one that calls
+ * <hmi3d_update_step> when the library is built with HMI_SYNC_THREADING.
+ *
+ * Important:
+ *    The flash contains an incomplete firmware after the cancellation. The
+ *    library loader keeps running until the update is repeated.
+ *
+ * See also:
+ *    <hmi3d_update_start>, <hmi3d_update_step>
+ */
+HMI_API void CDECL hmi3d_update_cancel(hmi_t *hmi);
+
+/* Function: hmi3d_update_get_status
+ *
+ * Fills status with the progress of the update started with
+ * <hmi3d_update_start>.
+ *
+ * The function may be called from another thread than the one that calls
+ * <hmi3d_update_step> when the library is built with HMI_SYNC_THREADING.
+ * Otherwise all calls for the update have to come from the same thread.
+ *
+ * See also:
+ *    <hmi3d_update_status_t>, <hmi3d_update_step>
+ */
+HMI_API void CDECL hmi3d_update_get_status(hmi_t *hmi,
+                                           hmi3d_update_status_t *status);
+
+/* Typedef: hmi3d_update_progress_t
+ *
+ * Callback that reports the progress of one device during
+ * <hmi3d_update_run>.
+ *
+ * opaque - The opaque pointer given to <hmi3d_update_run>
+ * index  - The index of the device in the array given to <hmi3d_update_run>
+ * status - The current progress of the device
+ */
+typedef void (CDECL* hmi3d_update_progress_t)(
+        void *opaque, int index, const hmi3d_update_status_t *status);
+
+/* Function: hmi3d_update_run
+ *
+ * Updates several devices with the same image at once.
+ *
+ * devices     - Array of initialized <hmi_t>-instances
+ * count       - Count of devices
+ * session_id  - A random session-id. Can be any value except 0.
+ * image       - Ptr to a <hmi3d_update_image_t>-structure containing the
+ *               image. It is shared by all devices.
+ * mode        - The mode for this session
+ * window      - Maximum count of records in flight per device
+ * wait_loader - Non-zero to wait until a loader update was stored
+ * progress    - Optional callback that gets called whenever a device made
+ *               progress. May be NULL.
+ * opaque      - Opaque pointer that gets passed to progress
+ *
+ * Returns the count of devices whose update failed or was cancelled.
+ *
+ * Starts the update on all devices with <hmi3d_update_start> and steps them
+ * in turn until all are finished. The devices only sleep for a millisecond
+ * when none of them made progress, so that each bus is kept busy while
+ * other devices wait for their acknowledges. Without <HMI_SLEEP> a message
+ * of the first unfinished device is awaited for up to a millisecond
+ * instead. A failed device does not stop
+ * the others. Its error is available with <hmi3d_update_get_status>.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_start>, <hmi3d_update_step>
+ */
+HMI_API int CDECL hmi3d_update_run(hmi_t **devices,
+                                   int count,
+                                   unsigned int session_id,
+                                   const hmi3d_update_image_t *image,
+                                   hmi3d_UpdateFunction_t mode,
+                                   int window,
+                                   int wait_loader,
+                                   hmi3d_update_progress_t progress,
+                                   void *opaque);
+#endif
+
+/* ======== 3D Firmware Packages ======== */
+
+#if !defined(HMI3D_NO_UPDATE) && !defined(HMI3D_NO_ENZ)
+
+/* Enumeration: hmi3d_enz_image_t
+ *
+ * The images contained in an ENZ-package
+ *
+ * hmi3d_EnzImage_Library - The GestIC library
+ * hmi3d_EnzImage_Loader  - The library loader
+ *
+ * See also:
+ *    <hmi3d_enz_update>, <hmi3d_enz_info>
+ */
+typedef enum {
+    hmi3d_EnzImage_Library = 0,
+    hmi3d_EnzImage_Loader = 1
+} hmi3d_enz_image_t;
+
+/* Typedef: hmi3d_enz_reader_t
+ *
+ * Function type for reading a part of an ENZ-package.
+ *
+ * opaque - The opaque pointer of the <hmi3d_enz_source_t>
+ * offset - Position of the requested data within the package
+ * buffer - Receives the data
+ * size   - Count of bytes to read
+ *
+ * Returns the count of bytes read or a negative <hmi_error_t> code.
+ * Less than size bytes are only returned at the end of the package.
+ *
+ * See also:
+ *    <hmi3d_enz_source_t>
+ */
+typedef int (CDECL* hmi3d_enz_reader_t)(void *opaque,
+                                        unsigned int offset,
+                                        void *buffer,
+                                        int size);
+
+/* Constant: HMI3D_ENZ_WORKSPACE_SIZE
+ *
+ * Size of a <hmi3d_enz_workspace_t> in bytes.
+ */
+#define HMI3D_ENZ_WORKSPACE_SIZE 34816
+
+/* Structure: hmi3d_enz_workspace_t
+ *
+ * Memory for the decompression of an ENZ-package. The content is internal.
+ *
+ * See also:
+ *    <hmi3d_enz_source_t>
+ */
+typedef union {
+    void *align;
+    unsigned int data[HMI3D_ENZ_WORKSPACE_SIZE / sizeof(unsigned int)];
+} hmi3d_enz_workspace_t;
+
+/* Structure: hmi3d_enz_source_t
+ *
+ * Describes where an ENZ-package is read from.
+ *
+ * read      - The <hmi3d_enz_reader_t> providing the content
+ * opaque    - Opaque pointer that is passed to read
+ * size      - Total size of the package in bytes
+ * workspace - The <hmi3d_enz_workspace_t> used for the decompression or
+ *             NULL to allocate it with HMI_MALLOC for each call. Without
+ *             HMI_MALLOC a workspace is required.
+ *
+ * A workspace must not be used by two calls at the same time.
+ *
+ * See also:
+ *    <hmi3d_enz_open_file>
+ */
+typedef struct {
+    hmi3d_enz_reader_t read;
+    void *opaque;
+    unsigned int size;
+    hmi3d_enz_workspace_t *workspace;
+} hmi3d_enz_source_t;
+
+/* Typedef: hmi3d_enz_report_t
+ *
+ * Function type receiving the problems found by <hmi3d_enz_check>.
+ *
+ * opaque  - The opaque pointer passed to <hmi3d_enz_check>
+ * problem - Description of the problem
+ */
+typedef void (CDECL* hmi3d_enz_report_t)(void *opaque, const char *problem);
+
+/* Structure: hmi3d_enz_info_t
+ *
+ * Summary of an image of an ENZ-package.
+ *
+ * record_count - Count of records of the image
+ * iv           - The 14-byte initialization vector of the image
+ * fw_version   - The 120-byte version-string of the image
+ *
+ * See also:
+ *    <hmi3d_enz_info>
+ */
+typedef struct {
+    int record_count;
+    unsigned char iv[14];
+    unsigned char fw_version[120];
+} hmi3d_enz_info_t;
+
+/* Function: hmi3d_enz_info
+ *
+ * Reads and validates an image of an ENZ-package.
+ *
+ * source - The <hmi3d_enz_source_t> of the package
+ * image  - The <hmi3d_enz_image_t> to read
+ * info   - Receives the <hmi3d_enz_info_t> of the image
+ *
+ * Returns 0 on success, <HMI_BAD_FORMAT_ERROR> if the package or the image
+ * is malformed or missing, <HMI_BAD_PARAM_ERROR> if no workspace is
+ * available or the error returned by the reader.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_enz_update>
+ */
+HMI_API int CDECL hmi3d_enz_info(const hmi3d_enz_source_t *source,
+                                 hmi3d_enz_image_t image,
+                                 hmi3d_enz_info_t *info);
+
+/* Function: hmi3d_enz_update
+ *
+ * Writes an image of an ENZ-package to the device.
+ *
+ * session_id - A random session-id. Can be any value except 0.
+ * source     - The <hmi3d_enz_source_t> of the package
+ * image      - The <hmi3d_enz_image_t> to write
+ * mode       - The mode for this session
+ *
+ * Returns 0 on success or a negative value when the request failed.
+ * <HMI_BAD_FORMAT_ERROR> is returned if the package or the image is
+ * malformed or missing, <HMI_BAD_PARAM_ERROR> if no workspace is
+ * available.
+ *
+ * ENZ-packages are Zip archives. The image is found by the index
+ * content.json and read from its ENC-file, which contains the records, the
+ * initialization vector and the version-string as Intel HEX records. These
+ * may be split into several records of any order. Consecutive data is
+ * combined into records that don't cross 128-byte boundaries.
+ *
+ * The image is decompressed twice instead of being kept in memory. The first
+ * pass validates the whole image before the device is touched. The second
+ * pass streams the records into <hmi3d_update_write> between
+ * <hmi3d_update_begin> and <hmi3d_update_end>.
+ *
+ * Note:
+ *    The decompression window is kept in the workspace of the source, the
+ *    remaining state takes about 7 kB of stack.
+ *
+ * Important:
+ *    After flashing of loader-updates the chip requires some time to
+ *    complete the update before it is ready for flashing the firmware.
+ *    <hmi3d_update_wait_loader_done> does the required check.
+ *
+ * See also:
+ *    <3D Firmware Update>, <hmi3d_update_image>, <hmi3d_enz_check>
+ */
+HMI_API int CDECL hmi3d_enz_update(hmi_t *hmi,
+                                   unsigned int session_id,
+                                   const hmi3d_enz_source_t *source,
+                                   hmi3d_enz_image_t image,
+                                   hmi3d_UpdateFunction_t mode);
+
+/* Function: hmi3d_enz_check
+ *
+ * Checks an ENZ-package for inconsistencies like MGCConv does with
+ * the option -c.
+ *
+ * source - The <hmi3d_enz_source_t> of the package
+ * report - Function receiving a description of each problem. May be NULL.
+ * opaque - Opaque pointer that is passed to report
+ *
+ * Returns the count of problems found, <HMI_BAD_PARAM_ERROR> if no
+ * workspace is available or the negative error returned by the reader.
+ *
+ * The check covers the Zip structure and the checksums of all contained
+ * files, the entries of content.json and all images it lists. Every
+ * ENC-file is compared with the C-structure file of the same name.
+ *
+ * See also:
+ *    <hmi3d_enz_update>
+ */
+HMI_API int CDECL hmi3d_enz_check(const hmi3d_enz_source_t *source,
+                                  hmi3d_enz_report_t report,
+                                  void *opaque);
+
+#if defined(_WIN32) || defined(__linux__)
+
+/* Function: hmi3d_enz_open_file
+ *
+ * Prepares a <hmi3d_enz_source_t> for reading an ENZ-package from a file.
+ *
+ * source   - The source to prepare
+ * filename - The name of the ENZ-file
+ *
+ * The workspace of the source is NULL and may be set afterwards.
+ *
+ * Returns 0 on success or <HMI_IO_OPEN_ERROR> if the file could not be
+ * opened.
+ *
+ * See also:
+ *    <hmi3d_enz_close_file>
+ */
+HMI_API int CDECL hmi3d_enz_open_file(hmi3d_enz_source_t *source,
+                                      const char *filename);
+
+/* Function: hmi3d_enz_close_file
+ *
+ * Closes the file of a source prepared by <hmi3d_enz_open_file>.
+ */
+HMI_API void CDECL hmi3d_enz_close_file(hmi3d_enz_source_t *source);
+
+#endif
+
+#endif
+
+/* ======== 2D Low Level Communication ======== */
+
+/* Enum: hmi2d_msg_receive_id_t
+ *
+ * IDs for incoming messages from the 2D subsystem as processed by this library
+ *
+ * hmi2d_msg_r_update       - Response to <hmi2d_msg_t_update>
+ * hmi2d_msg_r_parameter    - One parameter entry as response to
+ *                            <hmi2d_msg_t_get_param>
+ * hmi2d_msg_r_mutual_raw_0 - First row of raw sensor data
+ * hmi2d_msg_r_mutual_raw_f - Last row of raw sensor data
+ * hmi2d_msg_r_mutual_cal_0 - First row of calibrated sensor data
+ * hmi2d_msg_r_mutual_cal_f - Last row of calibrated sensor data
+ * hmi2d_msg_r_ack          - Acknowledge of command
+ * hmi2d_msg_r_mouse_btns   - State of the emulated mouse-buttons
+ * hmi2d_msg_r_gesture      - Gestures as used for keyboard-emulation
+ * hmi2d_msg_r_finger_pos   - List of finger positions
+ * hmi2d_msg_r_self_raw     - Raw self scan sensor data
+ * hmi2d_msg_r_self_measure - Calibrated self scan sensor data
+ * hmi2d_msg_r_3d_subsystem - Message that was forwarded from 3D subsystem
+ * hmi2d_msg_r_fw_version   - FW Version as response to <hmi2d_msg_t_fw_version>
+ */
+typedef enum {
+    hmi2d_msg_r_update = 0x55,
+    hmi2d_msg_r_parameter = 0xCF,
+    hmi2d_msg_r_mutual_raw_0 = 0xD0,
+    hmi2d_msg_r_mutual_raw_f = 0xDF,
+    hmi2d_msg_r_mutual_cal_0 = 0xE0,
+    hmi2d_msg_r_mutual_cal_f = 0xEF,
+    hmi2d_msg_r_ack = 0xF0,
+    hmi2d_msg_r_mouse_btns = 0xF6,
+    hmi2d_msg_r_gesture = 0xF7,
+    hmi2d_msg_r_finger_pos = 0xF8,
+    hmi2d_msg_r_self_raw = 0xFA,
+    hmi2d_msg_r_self_measure = 0xFD,
+    hmi2d_msg_r_3d_subsystem = 0xFE,
+    hmi2d_msg_r_fw_version = 0xFF
+} hmi2d_msg_receive_id_t;
+
+/* Enum: hmi2d_msg_transmit_id_t
+ *
+ * IDs for outgoing messages for the 2D-subsystem as sent by this library
+ *
+ * hmi2d_msg_t_update       - <2D Firmware Update> related messages.
+ *                            The exact meaning depends on the data of the
+ *                            message.
+ * hmi2d_msg_t_set_param    - Command to change the value of a parameter.
+ *                            The related API function is <hmi2d_set_param>.
+ * hmi2d_msg_t_get_param    - Query for the current value of a parameter.
+ *                            The related API function is <hmi2d_get_param>.
+ * hmi2d_msg_t_3d_reset     - Command to do a hard reset of the
+ *                            3D subsystem. It gets sent by <hmi3d_reset> when
+ *                            compiled for communication with the 3DTouchPad.
+ * hmi2d_msg_t_3d_subsystem - Command that are addressed to the 3D subsystem.
+ *                            Gets sent by <hmi3d_message_write>
+ *                            when compiled for use with the 3DTouchPad.
+ * hmi2d_msg_t_fw_version   - Query for the version of the 2D firmware.
+ *                            The related API function is
+ *                            <hmi2d_query_fw_version>.
+ */
+typedef enum {
+    hmi2d_msg_t_update = 0x55,
+    hmi2d_msg_t_set_param = 0xE0,
+    hmi2d_msg_t_get_param = 0xE1,
+    hmi2d_msg_t_3d_reset = 0xFC,
+    hmi2d_msg_t_3d_subsystem = 0xFD,
+    hmi2d_msg_t_fw_version = 0xFF
+} hmi2d_msg_transmit_id_t;
+
+/* Enum: hmi2d_parameter_id_t
+ *
+ * IDs of parameters for the 2D-subsystem that are supported by this library
+ *
+ * hmi2d_param_com_mask             - Mask for communicated messages as set by
+ *                                    <hmi2d_set_com_mask>
+ * hmi2d_param_active_mask          - Mask of active features as set by
+ *                                    <hmi2d_set_active_mask>
+ * hmi2d_param_operation_mode       - 2D/3D operation mode as set by
+ *                                    <hmi2d_set_operation_mode>
+ *
+ * hmi2d_param_swipeBorderLeft      - Left border of of swipe region.
+ *                                    Swipes have to start outside the region.
+ *                                    The whole board has range [0,0]-[512,384]
+ * hmi2d_param_swipeBorderRight     - Right border of swipe region.
+ * hmi2d_param_swipeBorderTop       - Top border of swipe region.
+ * hmi2d_param_swipeBorderBottom    - Bottom border of swipe region.
+ * hmi2d_param_clickBorderLeft      - Left border of click region.
+ *                                    Clicks will only be detected inside.
+ *                                    The whole board has range [0,0]-[512,384]
+ * hmi2d_param_clickBorderRight     - Right border of swipe region.
+ * hmi2d_param_clickBorderTop       - Top border of swipe region.
+ * hmi2d_param_clickBorderBottom    - Bottom border of swipe region.
+ * hmi2d_param_autoMovBorderHorz    - Horizontal border for automatic movement
+ *                                    at edges (0 = no auto-mov region,
+ *                                    512/2 = the border takes the whole board)
+ * hmi2d_param_autoMovBorderVert    - Vertical border for automatic movement at
+ *                                    edges (0 = no auto-mov region,
+ *                                    512/2 = the border takes the whole board)
+ * hmi2d_param_autoMovSpeedX        - Speed of horizontal automatic movement
+ * hmi2d_param_autoMovSpeedY        - Speed of vertical automatic movement
+ * hmi2d_param_autoMovDragSpeedX    - Speed of horizontal movement while dragging
+ * hmi2d_param_autoMovDragSpeedY    - Speed of vertical movement while dragging
+ * hmi2d_param_autoMovScrollSpeedX  - Speed of automatic horizontal scrolling
+ * hmi2d_param_autoMovScrollSpeedY  - Speed of automatic Vertical scrolling
+ * hmi2d_param_scrollSpeedX         - Horizontal scroll speed
+ * hmi2d_param_scrollSpeedY         - Vertical scroll speed
+ * hmi2d_param_scrollStartThreshold - Minimal movement to start scrolling
+ * hmi2d_param_scrollInertiaX       - To what degree horizontal scrolling
+ *                                    continues after fingers were raised
+ * hmi2d_param_scrollInertiaY       - To what degree vertical scrolling
+ *                                    continues after fingers were raised
+ *
+ * There are parameters for the key combinations that are sent to the host in
+ * case of an detected gesture. Each of those key-combos consists of four
+ * parameters:
+ *
+ * send - Defines under which conditions the key-combo should be emitted
+ * key1 - The first key of the combo
+ * key2 - The second key of the combo
+ * key3 - The third and last key of the combo
+ *
+ * The sends parameter is the one of the key-combo parameters that is used by
+ * <hmi2d_set_key_combo> to identify the parameters for the key-combo.
+ * The send parameters are:
+ *
+ * hmi2d_param_outkeyFlickL_send   - Flick right to left key-combo
+ * hmi2d_param_outkeyFlickR_send   - Flick left to right key-combo
+ * hmi2d_param_outkeyFlickU_send   - Flick bottom to top key-combo
+ * hmi2d_param_outkeyFlickD_send   - Flick top to bottom key-combo
+ * hmi2d_param_outkeySwipe1FL_send - Swipe from right edge key-combo
+ * hmi2d_param_outkeySwipe1FR_send - Swipe from left edge key-combo
+ * hmi2d_param_outkeySwipe1FU_send - Swipe from bottom edge key-combo
+ * hmi2d_param_outkeySwipe1FD_send - Swipe from top edge key-combo
+ *
+ * See also:
+ *    <hmi2d_set_param>, <hmi2d_get_param>, <2D Real Time Control>
+ */
+typedef enum {
+    hmi2d_param_com_mask = 0x0080,
+    hmi2d_param_active_mask = 0x0081,
+    hmi2d_param_operation_mode = 0x0082,
+
+    hmi2d_param_swipeBorderLeft = 0x0502,
+    hmi2d_param_swipeBorderRight = 0x0503,
+    hmi2d_param_swipeBorderTop = 0x0504,
+    hmi2d_param_swipeBorderBottom = 0x0505,
+    hmi2d_param_clickBorderLeft = 0x0540,
+    hmi2d_param_clickBorderRight = 0x0541,
+    hmi2d_param_clickBorderTop = 0x0542,
+    hmi2d_param_clickBorderBottom = 0x0543,
+    hmi2d_param_autoMovBorderHorz = 0x0600,
+    hmi2d_param_autoMovBorderVert = 0x0601,
+    hmi2d_param_autoMovSpeedX = 0x0602,
+    hmi2d_param_autoMovSpeedY = 0x0603,
+    hmi2d_param_autoMovDragSpeedX = 0x0604,
+    hmi2d_param_autoMovDragSpeedY = 0x0605,
+    hmi2d_param_autoMovScrollSpeedX = 0x0606,
+    hmi2d_param_autoMovScrollSpeedY = 0x0607,
+    hmi2d_param_scrollSpeedX = 0x06A0,
+    hmi2d_param_scrollSpeedY = 0x06A1,
+    hmi2d_param_scrollStartThreshold = 0x6A2,
+    hmi2d_param_scrollInertiaX = 0x6A4,
+    hmi2d_param_inertStartThresX = 0x6A5,
+    hmi2d_param_inertStopThresX = 0x6A6,
+    hmi2d_param_scrollInertiaY = 0x6A8,
+    hmi2d_param_inertStartThresY = 0x6A9,
+    hmi2d_param_inertStopThresY = 0x6AA,
+
+    hmi2d_param_outkeyFlickL_send = 0x1000,
+    hmi2d_param_outkeyFlickL_key1 = 0x1001,
+    hmi2d_param_outkeyFlickL_key2 = 0x1002,
+    hmi2d_param_outkeyFlickL_key3 = 0x1003,
+    hmi2d_param_outkeyFlickR_send = 0x1010,
+    hmi2d_param_outkeyFlickR_key1 = 0x1011,
+    hmi2d_param_outkeyFlickR_key2 = 0x1012,
+    hmi2d_param_outkeyFlickR_key3 = 0x1013,
+    hmi2d_param_outkeyFlickU_send = 0x1020,
+    hmi2d_param_outkeyFlickU_key1 = 0x1021,
+    hmi2d_param_outkeyFlickU_key2 = 0x1022,
+    hmi2d_param_outkeyFlickU_key3 = 0x1023,
+    hmi2d_param_outkeyFlickD_send = 0x1030,
+    hmi2d_param_outkeyFlickD_key1 = 0x1031,
+    hmi2d_param_outkeyFlickD_key2 = 0x1032,
+    hmi2d_param_outkeyFlickD_key3 = 0x1033,
+    hmi2d_param_outkeySwipe1FL_send = 0x1100,
+    hmi2d_param_outkeySwipe1FL_key1 = 0x1101,
+    hmi2d_param_outkeySwipe1FL_key2 = 0x1102,
+    hmi2d_param_outkeySwipe1FL_key3 = 0x1103,
+    hmi2d_param_outkeySwipe1FR_send = 0x1110,
+    hmi2d_param_outkeySwipe1FR_key1 = 0x1111,
+    hmi2d_param_outkeySwipe1FR_key2 = 0x1112,
+    hmi2d_param_outkeySwipe1FR_key3 = 0x1113,
+    hmi2d_param_outkeySwipe1FU_send = 0x1120,
+    hmi2d_param_outkeySwipe1FU_key1 = 0x1121,
+    hmi2d_param_outkeySwipe1FU_key2 = 0x1122,
+    hmi2d_param_outkeySwipe1FU_key3 = 0x1123,
+    hmi2d_param_outkeySwipe1FD_send = 0x1130,
+    hmi2d_param_outkeySwipe1FD_key1 = 0x1131,
+    hmi2d_param_outkeySwipe1FD_key2 = 0x1132,
+    hmi2d_param_outkeySwipe1FD_key3 = 0x1133,
+    hmi2d_param_outkeyApproach_send = 0x1140,
+    hmi2d_param_outkeyApproach_key1 = 0x1141,
+    hmi2d_param_outkeyApproach_key2 = 0x1142,
+    hmi2d_param_outkeyApproach_key3 = 0x1143,
+} hmi2d_parameter_id_t;
+
+/* Function: hmi2d_set_param
+ *
+ * This functions sets a parameter in the 2D subsystem.
+ *
+ * param - The id of the parameter to be set
+ * arg0  - The first arg of the parameter.
+ *         This is normaly the parameter value itself
+ * arg1  - The second arg of the parameter. If not stated otherwise this is
+ *         the mask of the bits of the parameter that have to be changed.
+ *         To change all flags or to set a scalar parameter set this to ~0.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_get_param>, <hmi2d_parameter_id_t>, <2D Real Time Control>
+ */
+HMI_API int CDECL hmi2d_set_param(hmi_t *hmi, hmi2d_parameter_id_t param,
+                                  int arg0, int arg1);
+
+/* Function: hmi2d_get_param
+ *
+ * This function fetches a parameter from the 2D subsystem
+ *
+ * param - The id of the parameter to fetch
+ * arg0  - Pointer to an integer receiving the value of the parameter
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_set_param>, <hmi2d_parameter_id_t>
+ */
+HMI_API int CDECL hmi2d_get_param(hmi_t *hmi, hmi2d_parameter_id_t param,
+                                  unsigned int *arg0);
+
+
+/* ======== 2D Data Retrieval ======== */
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+
+/* Enum: hmi2d_mouse_button_t
+ *
+ * Possible mouse buttons that could be emitted by the mouse emulation of the
+ * 2D subsystem.
+ *
+ * hmi2d_mouse_left_btn   - Left mouse button clicked
+ * hmi2d_mouse_right_btn  - Middle mouse button clicked
+ * hmi2d_mouse_middle_btn - Right mouse button clicked
+ */
+typedef enum {
+    hmi2d_mouse_left_btn   = 0x01,
+    hmi2d_mouse_right_btn  = 0x02,
+    hmi2d_mouse_middle_btn = 0x04
+} hmi2d_mouse_button_t;
+
+/* Enum: hmi2d_gesture_id_t
+ *
+ * hmi2d_no_gesture         - No gesture detected
+ * hmi2d_edge_swipe1f_left  - Leftward swipe with one finger from the right edge
+ * hmi2d_edge_swipe1f_right - Rightward swipe with one finger from the left edge
+ * hmi2d_edge_swipe1f_up    - Upward swipe with one finger from the bottom edge
+ * hmi2d_edge_swipe1f_down  - Downward swipe with one finger from the top edge
+ * hmi2d_flick_left         - Leftward flick (from 3D subsystem)
+ * hmi2d_flick_right        - Rightward flick (from 3D subsystem)
+ * hmi2d_flick_up           - Upward flick (from 3D subsystem)
+ * hmi2d_flick_down         - Downward flick (from 3D subsystem)
+ * hmi2d_approach_detected  - Approach detected (from 3D subsystem)
+ * hmi2d_pinch_narrowing    - Narrowing pinch
+ * hmi2d_pinch_widening     - Widening pinch
+ *
+ */
+typedef enum {
+    hmi2d_no_gesture = 0x00,
+    hmi2d_edge_swipe1f_left  = 0x10,
+    hmi2d_edge_swipe1f_right = 0x11,
+    hmi2d_edge_swipe1f_up    = 0x12,
+    hmi2d_edge_swipe1f_down  = 0x13,
+    hmi2d_flick_left         = 0x20,
+    hmi2d_flick_right        = 0x21,
+    hmi2d_flick_up           = 0x22,
+    hmi2d_flick_down         = 0x23,
+    hmi2d_approach_detected  = 0x30,
+    hmi2d_pinch_narrowing    = 0x40,
+    hmi2d_pinch_widening     = 0x41
+} hmi2d_gesture_id_t;
+
+/* Typedef: hmi2d_row_t
+ *
+ * One row of sensor data.
+ */
+typedef int hmi2d_row_t[16];
+
+/* Typedef: hmi2d_block_t
+ *
+ * One block of sensor data.
+ * The block contains the last complete scan as of the last
+ * <hmi2d_retrieve_data> call. Rows that were not part of that scan are set to
+ * zero.
+ */
+typedef hmi2d_row_t hmi2d_block_t[16];
+
+/* Struct: hmi2d_heatmap_t
+ *
+ * One complete scan of mutual sensor data in 16-bit storage.
+ *
+ * sequence - Number of the scan, counting from 1 after <hmi_initialize>
+ * rows     - Bit mask of the rows that were part of the scan
+ * value    - The sensor data of the scan. Rows that were not part of the
+ *            scan are set to zero.
+ *
+ * A scan is complete when it contains all rows given by
+ * <hmi2d_set_mutual_rows>. A scan that misses one of them is dropped, so
+ * a lost row never shows up as a partial scan.
+ *
+ * See also:
+ *    <hmi2d_copy_heatmap>, <hmi2d_set_mutual_rows>
+ */
+typedef struct {
+    unsigned int sequence;
+    unsigned short rows;
+    unsigned short value[16][16];
+} hmi2d_heatmap_t;
+
+/* Struct: hmi2d_finger_pos_t
+ *
+ * Structure containig touch related data for one finger.
+ *
+ * x         - X-position of finger
+ * y         - Y-position of finger
+ * finger_id - An ID of the finger as assigned by the signal processing
+ */
+typedef struct {
+    int x;
+    int y;
+    int finger_id;
+} hmi2d_finger_pos_t;
+
+/* Struct: hmi2d_finger_pos_list_t
+ *
+ * Structure containing touch related data for all fingers.
+ *
+ * count - The number of active entries in this list.
+ * entry - The individual <hmi2d_finger_pos_t> -entries
+ */
+typedef struct {
+    int count;
+    hmi2d_finger_pos_t entry[10];
+} hmi2d_finger_pos_list_t;
+
+// NOTE This is for debugging purpose
+/* Struct: hmi2d_mouse_t
+ *
+ * Structure containing data about the state of the mouse emulation.
+ *
+ * button_state  - Currently pressed buttons as <hmi2d_mouse_button_t> -flags
+ * press_event   - Emulated mouse buttons pressed since the last update
+ * release_event - Emulated mouse buttons release since the last update
+ */
+typedef struct {
+    hmi2d_mouse_button_t button_state;
+    hmi2d_mouse_button_t press_event;
+    hmi2d_mouse_button_t release_event;
+} hmi2d_mouse_t;
+
+/* Struct: hmi2d_gesture_t
+ *
+ * Structure containing gesture data as used by the keyboard emulation.
+ *
+ * gesture - The id of the detected gesture (See <hmi2d_gesture_id_t>)
+ */
+typedef struct {
+    hmi2d_gesture_id_t gesture;
+} hmi2d_gesture_t;
+
+/* Function: hmi2d_retrieve_data
+ *
+ * Retrieves incoming data from the 2D subsystem and updates result buffers.
+ *
+ * Returns HMI_NO_ERROR on success, HMI_NO_DATA if no data was available
+ * for retrieval or a negative error code in case of an error.
+ *
+ * See also:
+ *    <2D Data Retrieval>
+ */
+HMI_API int CDECL hmi2d_retrieve_data(hmi_t *hmi);
+
+/* Function: hmi2d_copy_heatmap
+ *
+ * Copies the last complete scan of mutual sensor data.
+ *
+ * calibrated - Nonzero for calibrated data, zero for raw data
+ * heatmap    - Pointer to the <hmi2d_heatmap_t> that receives the scan
+ *
+ * Returns HMI_NO_ERROR on success or HMI_NO_DATA if no scan was completed
+ * yet.
+ *
+ * The scan is copied as a whole, so it never mixes rows of different scans.
+ * New scans are only received by <hmi2d_retrieve_data> or other calls that
+ * handle incoming messages. A changed sequence identifies a new scan.
+ *
+ * See also:
+ *    <2D Data Retrieval>, <hmi2d_heatmap_t>
+ */
+HMI_API int CDECL hmi2d_copy_heatmap(hmi_t *hmi,
+                                     int calibrated,
+                                     hmi2d_heatmap_t *heatmap);
+
+/* Function: hmi2d_set_mutual_rows
+ *
+ * Sets the rows of mutual sensor data the device is configured to send.
+ *
+ * rows - Bit mask of the rows or 0 for all 16 rows, which is the default
+ *
+ * Scans are complete once they contain every one of these rows. Other
+ * rows are ignored. Scans that are in progress are dropped.
+ *
+ * See also:
+ *    <2D Data Retrieval>, <hmi2d_heatmap_t>
+ */
+HMI_API void CDECL hmi2d_set_mutual_rows(hmi_t *hmi, unsigned short rows);
+
+/* Constant: HMI2D_MAX_BLOBS
+ *
+ * Maximum number of blobs reported by <hmi2d_find_blobs>.
+ */
+#define HMI2D_MAX_BLOBS 16
+
+/* Struct: hmi2d_blob_config_t
+ *
+ * Parameters of the blob detection in <hmi2d_find_blobs>.
+ *
+ * threshold   - Minimum value of an electrode to be part of a blob. Has to be
+ *               at least 1.
+ * diagonal    - Nonzero to connect diagonally adjacent electrodes, zero for
+ *               horizontally and vertically adjacent electrodes only
+ * min_area    - Blobs with fewer electrodes are dropped as noise
+ * palm_area   - Blobs with at least this many electrodes are flagged as palm.
+ *               Zero disables the check.
+ * palm_extent - Blobs spanning at least this many rows or columns are
+ *               flagged as palm. Zero disables the check.
+ */
+typedef struct {
+    unsigned short threshold;
+    int diagonal;
+    int min_area;
+    int palm_area;
+    int palm_extent;
+} hmi2d_blob_config_t;
+
+/* Struct: hmi2d_blob_t
+ *
+ * One connected area of electrodes above the threshold.
+ *
+ * x      - Weighted centroid within the rows in 1/256 of an electrode.
+ *          The center of column n is at n * 256.
+ * y      - Weighted centroid across the rows in 1/256 of an electrode.
+ *          The center of row n is at n * 256.
+ * area   - Number of electrodes
+ * weight - Sum of the electrode weights. Each electrode weighs its value
+ *          minus the threshold plus 1.
+ * peak   - Highest value of the electrodes
+ * left   - First column of the bounding box
+ * top    - First row of the bounding box
+ * right  - Last column of the bounding box
+ * bottom - Last row of the bounding box
+ * palm   - Nonzero if the blob was rejected as palm
+ */
+typedef struct {
+    int x;
+    int y;
+    int area;
+    unsigned int weight;
+    unsigned short peak;
+    unsigned char left;
+    unsigned char top;
+    unsigned char right;
+    unsigned char bottom;
+    unsigned char palm;
+} hmi2d_blob_t;
+
+/* Struct: hmi2d_blob_list_t
+ *
+ * Blobs found in one scan.
+ *
+ * count   - The number of active entries in this list
+ * touches - The number of entries that were not rejected as palm
+ * dropped - The number of blobs that did not fit into the list
+ * entry   - The individual <hmi2d_blob_t> -entries ordered by their first
+ *           electrode, row by row
+ */
+typedef struct {
+    int count;
+    int touches;
+    int dropped;
+    hmi2d_blob_t entry[HMI2D_MAX_BLOBS];
+} hmi2d_blob_list_t;
+
+/* Function: hmi2d_find_blobs
+ *
+ * Detects touches in a scan of calibrated mutual sensor data.
+ *
+ * heatmap - The scan as received from <hmi2d_copy_heatmap>
+ * config  - The parameters of the detection
+ * blobs   - Pointer to the <hmi2d_blob_list_t> that receives the blobs
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if the threshold
+ * is zero.
+ *
+ * The scan is thresholded and divided into connected areas. Each area
+ * yields its centroid weighted by the electrode values, which resolves
+ * positions between electrodes. Areas larger than a finger are kept but
+ * flagged as palm, so they can be ignored or shown separately.
+ *
+ * The detection depends on the scan only and does not need the device.
+ *
+ * See also:
+ *    <2D Data Retrieval>, <hmi2d_heatmap_t>
+ */
+HMI_API int CDECL hmi2d_find_blobs(const hmi2d_heatmap_t *heatmap,
+                                   const hmi2d_blob_config_t *config,
+                                   hmi2d_blob_list_t *blobs);
+
+#ifndef HMI2D_NO_TRACKING
+
+/* Constant: HMI2D_MAX_CONTACTS
+ *
+ * Maximum number of contacts in a <hmi2d_contact_list_t>.
+ *
+ * Up to 10 contacts follow fingers. The remaining entries hold contacts
+ * that ended or lost their finger briefly.
+ */
+#define HMI2D_MAX_CONTACTS 20
+
+/* Enum: hmi2d_contact_event_t
+ *
+ * Events in the lifetime of a tracked contact.
+ *
+ * hmi2d_contact_down - The contact started
+ * hmi2d_contact_move - The contact moved
+ * hmi2d_contact_up   - The contact ended
+ */
+typedef enum {
+    hmi2d_contact_down = 0x01,
+    hmi2d_contact_move = 0x02,
+    hmi2d_contact_up   = 0x04
+} hmi2d_contact_event_t;
+
+/* Struct: hmi2d_tracking_config_t
+ *
+ * Parameters of the contact tracking as enabled by <hmi2d_set_tracking>.
+ *
+ * gate              - Maximum distance between the predicted position of a
+ *                     contact and a finger to continue the contact
+ * max_missed        - Count of finger messages a contact continues on its
+ *                     prediction without a finger before it ends
+ * process_noise     - Standard deviation of the acceleration of a finger
+ *                     in position units per second squared
+ * measurement_noise - Standard deviation of the reported finger positions
+ * interval_ms       - Interval between finger messages in milliseconds that
+ *                     is assumed without a clock
+ *
+ * Positions are in the units of <hmi2d_finger_pos_t>.
+ */
+typedef struct {
+    int gate;
+    int max_missed;
+    float process_noise;
+    float measurement_noise;
+    int interval_ms;
+} hmi2d_tracking_config_t;
+
+/* Struct: hmi2d_contact_t
+ *
+ * One tracked contact.
+ *
+ * id        - Identifier of the contact. It stays the same for the
+ *             lifetime of the contact and is never reused.
+ * events    - The <hmi2d_contact_event_t> -flags since the last update
+ * x         - Filtered X-position
+ * y         - Filtered Y-position
+ * vx        - Velocity along X in position units per second
+ * vy        - Velocity along Y in position units per second
+ * raw_x     - X-position of the last finger of the contact
+ * raw_y     - Y-position of the last finger of the contact
+ * finger_id - The ID of the last finger of the contact as assigned by the
+ *             signal processing
+ */
+typedef struct {
+    int id;
+    int events;
+    int x;
+    int y;
+    int vx;
+    int vy;
+    int raw_x;
+    int raw_y;
+    int finger_id;
+} hmi2d_contact_t;
+
+/* Struct: hmi2d_contact_list_t
+ *
+ * Structure containing all tracked contacts.
+ *
+ * count - The number of active entries in this list
+ * entry - The individual <hmi2d_contact_t> -entries
+ */
+typedef struct {
+    int count;
+    hmi2d_contact_t entry[HMI2D_MAX_CONTACTS];
+} hmi2d_contact_list_t;
+
+/* Function: hmi2d_set_tracking
+ *
+ * Enables or disables the tracking of contacts across finger messages.
+ *
+ * config - The parameters of the tracking or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * Every <hmi2d_msg_r_finger_pos> message is matched against the predicted
+ * positions of the current contacts with minimal total distance. A
+ * constant-velocity Kalman filter per contact smoothes its position and
+ * estimates its velocity. Fingers without a match start new contacts.
+ *
+ * The contacts as of <hmi2d_retrieve_data> are accessible via
+ * <hmi2d_get_contacts>. Their events accumulate between calls, so short
+ * taps are reported with down and up events together. Contacts that ended
+ * are reported once.
+ *
+ * Enabling the tracking drops all current contacts. Defining
+ * HMI2D_NO_TRACKING removes the tracking completely.
+ *
+ * See also:
+ *    <2D Data Retrieval>, <hmi2d_tracking_config_t>
+ */
+HMI_API int CDECL hmi2d_set_tracking(hmi_t *hmi,
+                                     const hmi2d_tracking_config_t *config);
+
+#endif
+
+#endif
+
+/* ======== Fused Data Retrieval ======== */
+
+#if !defined(HMI2D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_DATA_RETRIEVAL)
+
+/* Enum: hmi_fused_update_t
+ *
+ * Flags for the subsystems that were updated by <hmi_retrieve_fused>.
+ *
+ * hmi_fused_3d - The 3D results contain at least one new data-frame
+ * hmi_fused_2d - The 2D results contain at least one new message
+ */
+typedef enum {
+    hmi_fused_3d = 0x01,
+    hmi_fused_2d = 0x02
+} hmi_fused_update_t;
+
+/* Structure: hmi_fused_t
+ *
+ * Timing of a snapshot as retrieved with <hmi_retrieve_fused>.
+ *
+ * updated - The <hmi_fused_update_t> -flags of the updated subsystems
+ * skipped - Count of 3D data-frames that were accumulated into the results
+ *           without being retrieved individually
+ * time    - HMI_TIME_US at the time of the snapshot
+ * age3d   - Microseconds between the reception of the last 3D data-frame
+ *           and time
+ * age2d   - Microseconds between the reception of the last 2D data message
+ *           and time
+ *
+ * The ages refer to the data in the results and therefore keep growing for
+ * subsystems without updates. Their difference is the offset between the
+ * 2D and 3D data on the timeline of the host.
+ */
+typedef struct {
+    int updated;
+    int skipped;
+    unsigned int time;
+    unsigned int age3d;
+    unsigned int age2d;
+} hmi_fused_t;
+
+/* Function: hmi_retrieve_fused
+ *
+ * Retrieves the available data of both subsystems and updates both result
+ * buffers at once.
+ *
+ * fused - Optional pointer to a <hmi_fused_t> that receives the timing of
+ *         the snapshot
+ *
+ * Returns HMI_NO_ERROR if at least one subsystem was updated, HMI_NO_DATA
+ * if no new data were available or a negative error code if the
+ * communication is broken.
+ *
+ * The incoming messages are handled until none is left, so the 2D and 3D
+ * results reflect the same moment. Both results are updated without
+ * releasing the synchronization against the message handlers in between.
+ * The results of a subsystem without new data keep their last state
+ * including the reported events.
+ *
+ * This replaces calls to <hmi3d_retrieve_data> and <hmi2d_retrieve_data>.
+ * The results are accessible with the hmi3d_get_* and hmi2d_get_*
+ * functions as usual.
+ *
+ * See also:
+ *    <hmi3d_retrieve_data>, <hmi2d_retrieve_data>
+ */
+HMI_API int CDECL hmi_retrieve_fused(hmi_t *hmi, hmi_fused_t *fused);
+
+/* Enum: hmi_trajectory_state_t
+ *
+ * States of the hand in the fused trajectory.
+ *
+ * hmi_trajectory_none     - Neither a 3D position nor a finger is detected
+ * hmi_trajectory_hover    - The trajectory follows the 3D position
+ * hmi_trajectory_approach - The trajectory follows the 3D position and a
+ *                           touch-down is predicted within the horizon
+ * hmi_trajectory_touch    - The trajectory follows a finger on the surface
+ */
+typedef enum {
+    hmi_trajectory_none     = 0,
+    hmi_trajectory_hover    = 1,
+    hmi_trajectory_approach = 2,
+    hmi_trajectory_touch    = 3
+} hmi_trajectory_state_t;
+
+/* Enum: hmi_trajectory_event_t
+ *
+ * Events of the fused trajectory.
+ *
+ * hmi_trajectory_predicted - The state changed to <hmi_trajectory_approach>
+ * hmi_trajectory_down      - A finger touched the surface
+ * hmi_trajectory_up        - The last finger left the surface
+ */
+typedef enum {
+    hmi_trajectory_predicted = 0x01,
+    hmi_trajectory_down      = 0x02,
+    hmi_trajectory_up        = 0x04
+} hmi_trajectory_event_t;
+
+/* Structure: hmi_trajectory_config_t
+ *
+ * Parameters of the trajectory as enabled by <hmi_set_trajectory>.
+ *
+ * scale_x, scale_y   - Factors from 3D positions to 2D positions
+ * offset_x, offset_y - The 2D position of the 3D position (0, 0)
+ * touch_z            - The 3D Z-position at which the hand touches the
+ *                      surface
+ * horizon_ms         - Touch-downs are predicted at most this far ahead
+ * blend_ms           - Time constant in which the trajectory converges
+ *                      after a change between 3D and 2D data
+ * cutoff             - Cutoff frequency in Hz of the low-pass filter of
+ *                      the velocities
+ *
+ * The trajectory is in the units of <hmi2d_finger_pos_t>, so a 2D position
+ * is computed from a 3D position as offset_x + scale_x * x and
+ * offset_y + scale_y * y.
+ */
+typedef struct {
+    float scale_x;
+    float scale_y;
+    float offset_x;
+    float offset_y;
+    float touch_z;
+    float horizon_ms;
+    float blend_ms;
+    float cutoff;
+} hmi_trajectory_config_t;
+
+/* Structure: hmi_trajectory_t
+ *
+ * One sample of the fused trajectory as accessible with
+ * <hmi_get_trajectory>.
+ *
+ * state   - The <hmi_trajectory_state_t> of the hand
+ * events  - The <hmi_trajectory_event_t> -flags of the last
+ *           <hmi_retrieve_fused> call
+ * x, y    - Position in the units of <hmi2d_finger_pos_t>
+ * z       - The 3D Z-position or 0 while touching
+ * vx, vy  - Velocity of x and y in units per second
+ * vz      - Velocity of z in units per second
+ * touch_x - X-position of the predicted touch-down
+ * touch_y - Y-position of the predicted touch-down
+ * eta_ms  - Milliseconds until the predicted touch-down
+ * time    - HMI_TIME_US when the newest data of the sample was received
+ *
+ * touch_x, touch_y and eta_ms are only valid in the state
+ * <hmi_trajectory_approach>.
+ */
+typedef struct {
+    int state;
+    int events;
+    float x, y, z;
+    float vx, vy, vz;
+    float touch_x, touch_y;
+    float eta_ms;
+    unsigned int time;
+} hmi_trajectory_t;
+
+/* Function: hmi_set_trajectory
+ *
+ * Enables or disables the fusion of 3D positions and 2D fingers into one
+ * trajectory.
+ *
+ * config - The parameters of the trajectory or NULL to disable it
+ *
+ * Returns HMI_NO_ERROR on success or HMI_BAD_PARAM_ERROR if a parameter is
+ * out of range.
+ *
+ * Every <hmi_retrieve_fused> call that updates a subsystem advances the
+ * trajectory. It follows the finger closest to it while the surface is
+ * touched and the mapped 3D position otherwise. The jump between both at a
+ * touch-down or a lift-off decays with blend_ms, so the trajectory stays
+ * continuous.
+ *
+ * While hovering the speed of approach predicts when and where the hand
+ * touches down. The state changes to <hmi_trajectory_approach> once the
+ * touch-down is expected within horizon_ms, which is usually earlier than
+ * the first finger message.
+ *
+ * Enabling the trajectory resets it.
+ *
+ * See also:
+ *    <hmi_trajectory_config_t>, <hmi_get_trajectory>
+ */
+HMI_API int CDECL hmi_set_trajectory(hmi_t *hmi,
+                                     const hmi_trajectory_config_t *config);
+
+#endif
+
+/* ======== 2D Real Time Control (RTC) ======== */
+
+#ifndef HMI2D_NO_RTC
+
+/* Enum: hmi2d_operation_mode_t
+ *
+ * hmi2d_mixed_mode  - Both 2D and 3D processing is enabled.
+ * hmi2d_2d_mode     - Only 2D subsystem is enabled.
+ * hmi2d_3d_mode     - Only 3D subsystem and 3D-based event generation
+ *                     are enabled.
+ * hmi2d_bridge_mode - 2D system is reduced to pure forwarding of messages.
+ *                     No event generation is done.
+ *
+ * The default on device-startup is <hmi2d_mixed_mode>.
+ *
+ * Note:
+ *    Communication with the 3D subsystem requires
+ *    <hmi2d_com_3d_messages> to be set. Without it <hmi2d_3d_mode> is
+ *    limited to gestures as accessible with <hmi2d_get_gesture> and
+ *    <hmi2d_bridge_mode> will result in no data output at all.
+ *
+ * See also:
+ *    <hmi2d_set_operation_mode>, <hmi2d_set_com_mask>,
+ *    <hmi2d_com_3d_messages>
+ */
+typedef enum {
+    hmi2d_mixed_mode = 0,
+    hmi2d_2d_mode = 1,
+    hmi2d_3d_mode = 2,
+    hmi2d_bridge_mode = 3
+} hmi2d_operation_mode_t;
+
+/* Function: hmi2d_set_operation_mode
+ *
+ * Sets operation mode for 2D subsystem.
+ *
+ * mode - The new operation mode
+ *
+ * Note:
+ *    Communication with the 3D subsystem requires
+ *    <hmi2d_com_3d_messages> to be set. Without it <hmi2d_3d_mode> is
+ *    limited to gestures as accessible with <hmi2d_get_gesture> and
+ *    <hmi2d_bridge_mode> will result in no data output at all.
+ *
+ * See also:
+ *    <hmi2d_get_operation_mode>, <hmi2d_operation_mode_t>, <hmi2d_set_param>,
+ *    <hmi2d_set_com_mask>, <hmi2d_com_3d_messages>
+ */
+HMI_API int CDECL hmi2d_set_operation_mode(hmi_t *hmi,
+                                           hmi2d_operation_mode_t mode);
+
+/* Function: hmi2d_get_operation_mode
+ *
+ * Gets the currently active operation mode of the 2D subsystem.
+ *
+ * mode - Pointer <hmi2d_operation_mode_t> variable that receives the mode
+ *
+ * See also:
+ *    <hmi2d_set_operation_mode>, <hmi2d_operation_mode_t>, <hmi2d_get_param>
+ */
+HMI_API int CDECL hmi2d_get_operation_mode(hmi_t *hmi,
+                                           hmi2d_operation_mode_t *mode);
+
+/* Enum: hmi2d_active_mask_t
+ *
+ * hmi2d_active_gesture_recognition     - Gesture processing is enabled
+ * hmi2d_active_lock_scroll_dir         - Disables simultaneous scrolling in
+ *                                        horizontal and vertical direction
+ * hmi2d_active_full_mutual             - Full mutal scanning is enabled
+ * hmi2d_active_mouse_buttons           - Emiting of emulated mouse buttons
+ * hmi2d_active_mouse_movement          - Emiting of emulated mouse movement
+ * hmi2d_active_flick_events            - Emiting of keys based on flick events
+ * hmi2d_active_swipe_events            - Emiting of keys based on swipe events
+ * hmi2d_active_air_wheel_scroll_events - Emiting of scroll events based on
+ *                                        AirWheel
+ * hmi2d_active_scroll_events           - Emiting of two-finger scroll events
+ * hmi2d_active_pinch_events            - Emiting of pinch events
+ * hmi2d_active_default                 - Default state after device startup
+ * hmi2d_active_all                     - Mask of all defined flags
+ *
+ * The gesture based HID events (<hmi2d_active_mouse_buttons>,
+ * <hmi2d_active_mouse_movement>, <hmi2d_active_flick_events>,
+ * <hmi2d_active_swipe_events>, <hmi2d_active_air_wheel_scroll_events>,
+ * <hmi2d_active_scroll_events>) also require <hmi2d_active_gesture_recognition>
+ * in order to detect the events for emiting.
+ *
+ * See also:
+ *    <hmi2d_set_active_mask>
+ */
+typedef enum {
+    hmi2d_active_gesture_recognition = 0x0001,
+    hmi2d_active_lock_scroll_dir = 0x0002,
+    hmi2d_active_full_mutual = 0x0004,
+    hmi2d_active_mouse_buttons = 0x0008,
+    hmi2d_active_mouse_movement = 0x0010,
+    hmi2d_active_flick_events = 0x0020,
+    hmi2d_active_swipe_events = 0x0040,
+    hmi2d_active_air_wheel_scroll_events = 0x0080,
+    hmi2d_active_scroll_events = 0x0100,
+    hmi2d_active_pinch_events = 0x0200,
+    hmi2d_active_default = 0x03F9,
+    hmi2d_active_all = 0x03FF
+} hmi2d_active_mask_t;
+
+/* Function: hmi2d_set_active_mask
+ *
+ * Sets/changes mask of activated processings.
+ *
+ * active - Bitmask of active events
+ * mask   - Bitmask of which flags should be changed ~0 changes all flags
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_get_active_mask>, <hmi2d_active_mask_t>, <hmi2d_set_param>
+ */
+HMI_API int CDECL hmi2d_set_active_mask(hmi_t *hmi, hmi2d_active_mask_t active,
+                                        hmi2d_active_mask_t mask);
+
+/* Function: hmi2d_get_active_mask
+ *
+ * Gets the mask of activated processings.
+ *
+ * active - Pointer to <hmi2d_active_mask_t> variable that receives the mask
+ *
+ * Return HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_set_active_mask>, <hmi2d_active_mask_t>, <hmi2d_get_param>
+ */
+HMI_API int CDECL hmi2d_get_active_mask(hmi_t *hmi,
+                                        hmi2d_active_mask_t *active);
+
+/* Function: hmi2d_set_full_mutual
+ *
+ * Enables/disables full-mutual mode.
+ *
+ * enabled - Boolean whether full-mutual is enabled
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_get_full_mutual>, <hmi2d_set_param>, <hmi2d_set_com_mask>
+ */
+HMI_API int CDECL hmi2d_set_full_mutual(hmi_t *hmi, int enabled);
+
+/* Function: hmi2d_get_full_mutual
+ *
+ * Gets current state of mutual mode.
+ *
+ * enabled - Pointer to boolean variable receiving the state
+ *
+ * See also:
+ *    <hmi2d_set_full_mutual>. <hmi2d_get_param>, <hmi2d_get_com_mask>
+ */
+HMI_API int CDECL hmi2d_get_full_mutual(hmi_t *hmi, int *enabled);
+
+/* Enum: hmi2d_com_mask_t
+ *
+ * hmi2d_com_cal_self_measure   - Output of calibrated self-scan data
+ *                                accessed via <hmi2d_get_self_cal>
+ * hmi2d_com_cal_mutual_measure - Output of calibrated mutual-scan data
+ *                                accessed via <hmi2d_get_mutual_cal>
+ * hmi2d_com_raw_self_measure   - Output of raw self-scan data
+ *                                accessed via <hmi2d_get_self_raw>
+ * hmi2d_com_raw_mutual_measure - Output of raw mutual-scan data
+ *                                accessed via <hmi2d_get_mutual_raw>
+ * hmi2d_com_finger_positions   - Output of finger positions
+ *                                accessed via <hmi2d_get_finger_positions>
+ * hmi2d_com_gestures           - Output of gesture events
+ *                                accessed via <hmi2d_get_gesture>
+ *                                Requires <hmi2d_active_gesture_recognition>
+ * hmi2d_com_mouse_buttons      - Output of mouse button state
+ *                                accessed via <hmi2d_get_mouse>
+ *                                Requires <hmi2d_active_gesture_recognition>
+ * hmi2d_com_3d_messages        - Required for 3D communication
+ * hmi2d_com_default            - Default value after device-startup
+ * hmi2d_com_all                - Mask of all defined flags
+ *
+ * <hmi2d_com_3d_messages> is required for all 3D communication in
+ * either direction. Without it the direct communication between the host and
+ * the 3D subsystem is disabled. However events like flicks might still be
+ * accessed via <hmi2d_get_gesture> when <hmi2d_com_gestures> is set.
+ *
+ * <hmi2d_com_gestures> and <hmi2d_com_mouse_buttons> require that gesture
+ * recognition is activated (see <hmi2d_active_gesture_recognition> ) in order
+ * to produce any events.
+ *
+ * See also:
+ *    <hmi2d_set_com_mask>, <hmi2d_get_com_mask>
+ */
+typedef enum {
+    hmi2d_com_cal_self_measure = 0x0001,
+    hmi2d_com_cal_mutual_measure = 0x0002,
+    hmi2d_com_raw_self_measure = 0x0004,
+    hmi2d_com_raw_mutual_measure = 0x0008,
+    hmi2d_com_finger_positions = 0x0800,
+    hmi2d_com_gestures = 0x1000,
+    hmi2d_com_mouse_buttons = 0x2000,
+    hmi2d_com_3d_messages = 0x8000,
+    hmi2d_com_default = 0x0000,
+    hmi2d_com_all = 0xB80F,
+} hmi2d_com_mask_t;
+
+/* Function: hmi2d_set_com_mask
+ *
+ * Sets mask of what messages should be sent to the host.
+ *
+ * enabled - Bitmask containing flags for enabled messages
+ * mask    - Bitmask of which flags should be affected by this change
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * Note:
+ *    Always set <hmi2d_com_3d_messages> when direct communication
+ *    with the 3D subsystem is required. Otherwise communication via functions
+ *    with the hmi3d_-prefix will fail.
+ *
+ * See also:
+ *    <hmi2d_get_com_mask>, <hmi2d_com_mask_t>, <hmi2d_set_param>,
+ *    <hmi2d_set_full_mutual>, <hmi2d_set_operation_mode>
+ */
+HMI_API int CDECL hmi2d_set_com_mask(hmi_t *hmi,
+                                     hmi2d_com_mask_t enabled,
+                                     hmi2d_com_mask_t mask);
+
+/* Function: hmi2d_get_com_mask
+ *
+ * Gets current mask of what messages should be sent to the host.
+ *
+ * enabled - Pointer to <hmi2d_com_mask_t> variable receiving the maks.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_set_com_mask>, <hmi2d_com_mask_t>, <hmi2d_get_param>,
+ *    <hmi2d_get_full_mutual>
+ */
+HMI_API int CDECL hmi2d_get_com_mask(hmi_t *hmi, hmi2d_com_mask_t *enabled);
+
+/* Enum: hmi2d_event_cond_t
+ *
+ * Possible conditions for event generation
+ *
+ * hmi2d_event_disabled  - Event will never cause key-emulation or similar
+ * hmi2d_event_on_single - Single event will cause key-emulation
+ * hmi2d_event_on_double - Double event will cause key-emulation
+ *
+ * Note:
+ *    <hmi2d_event_on_double> only has an effect for flicks. For other events
+ *    will be processed as if <hmi2d_event_on_single> was selected.
+ *
+ * See also:
+ *    <hmi2d_key_combo_t>, <hmi2d_set_key_combo>
+ */
+typedef enum {
+    hmi2d_event_disabled = 0,
+    hmi2d_event_on_single = 1,
+    hmi2d_event_on_double = 2,
+} hmi2d_event_cond_t;
+
+/* Struct: hmi2d_key_combo_t
+ *
+ * cond - Condition for sending the associated key-combo
+ * key  - The keys of the key combo
+ *
+ * The values of the keys are the same as specified in the USB HID Usage Tables.
+ *
+ * See also:
+ *    <hmi2d_set_key_combo>, <hmi2d_event_cond_t>
+ */
+typedef struct {
+    hmi2d_event_cond_t cond;
+    int key[3];
+} hmi2d_key_combo_t;
+
+/* Function: hmi2d_set_key_combo
+ *
+ * Sets the parameters related to one key-combo-mapping
+ *
+ * param - The id of the send-parameter of the key-combo
+ * combo - The combo itself
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_get_key_combo>, <hmi2d_key_combo_t>, <hmi2d_parameter_id_t>,
+ *    <hmi2d_set_param>
+ */
+HMI_API int CDECL hmi2d_set_key_combo(hmi_t *hmi, int param,
+                                      hmi2d_key_combo_t *combo);
+
+/* Function: hmi2d_get_key_combo
+ *
+ * Gets the parameters related to one key-combo-mapping
+ *
+ * param - The id of the send-parameter of the key-combo
+ * combo - Pointer to <hmi2d_key_combo_t> instance receiving the key-combo
+ *
+ * Return HMI_NO_ERROR on success or a negative error code.
+ *
+ * See aslo:
+ *    <hmi2d_set_key_combo>, <hmi2d_key_combo_t>, <hmi2d_parameter_id_t>,
+ *    <hmi2d_get_param>
+ */
+HMI_API int CDECL hmi2d_get_key_combo(hmi_t *hmi, int param,
+                                      hmi2d_key_combo_t *combo);
+
+#endif
+
+/* ======== 2D Firmware Version ======== */
+
+/* Struct: hmi2d_version_info_t
+ *
+ * Structure for the 2D firmware version.
+ *
+ * See also:
+ *    <hmi2d_query_fw_version>
+ */
+typedef struct {
+    unsigned short svn_revision;
+    unsigned char wc_mixed;
+    unsigned char wc_modified;
+    unsigned short build_year;
+    unsigned char build_month;
+    unsigned char build_day;
+    unsigned char build_hour;
+    unsigned char build_minute;
+    unsigned char build_second;
+    char buildBy[9];
+    char infoString[76];
+    unsigned int checksum;
+    unsigned int fw_app_id;
+    unsigned char fw_version[4];
+} hmi2d_version_info_t;
+
+/* Function: hmi2d_query_fw_version
+ *
+ * Queries the version of the currently running 2D firmware and stores it
+ * to the provided version argument.
+ *
+ * version - Pointer to a memory location where to store the retrieved
+ *           firmware version
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * See also:
+ *    <hmi2d_version_info_t>, <2D Firmware Update>
+ */
+HMI_API int CDECL hmi2d_query_fw_version(hmi_t *hmi,
+                                         hmi2d_version_info_t *version);
+
+
+/* ======== 2D Firmware Update Functions ======== */
+
+#ifndef HMI2D_NO_UPDATE
+
+/* Enum: hmi2d_bootloader_error_t
+ *
+ */
+typedef enum {
+    hmi2d_bl_no_error = 0,
+    hmi2d_bl_flash_erase_error = 6,
+    hmi2d_bl_checksum_mismatch_error = 7,
+    hmi2d_bl_block_count_error = 8,
+    hmi2d_bl_flash_write_error = 9,
+    hmi2d_bl_out_of_ragne_address_error = 10,
+    hmi2d_bl_bootloader_locked_error = 11,
+    hmi2d_bl_unrecognized_command_error = 12,
+    hmi2d_bl_number_of_bytes_error = 13,
+    hmi2d_bl_hex_file_error = 14
+} hmi2d_bootloader_error_t;
+
+/* Enum: HMI_PROG
+ *
+ * A few values that are used in the <2D Firmware Update>.
+ *
+ * HMI2D_PROG_MEM_START    - Address of first byte of firmware
+ * HMI2D_PROG_MEM_END      - Address of first byte after firmware
+ * HMI2D_PROG_MEM_SIZE     - Size of firmware in bytes
+ * HMI2D_PROG_PAGE_SIZE    - Size of memory pages (for erasing)
+ * HMI2D_PROG_PAGE_COUNT   - Count of memory pages of the firmware
+ * HMI2D_PROG_BLOCK_SIZE   - Size of single update block
+ * HMI2D_PROG_BLOCK_COUNT  - Count of blocks in the firmware image
+ * HMI2D_PROG_ERASED_VALUE - Value that is used in erased memory
+ */
+enum {
+    HMI2D_PROG_MEM_START = 0x1d003000,
+    HMI2D_PROG_MEM_END = 0x1d010000,
+    HMI2D_PROG_MEM_SIZE = HMI2D_PROG_MEM_END - HMI2D_PROG_MEM_START,
+    HMI2D_PROG_PAGE_SIZE = 0x1000,
+    HMI2D_PROG_PAGE_COUNT = HMI2D_PROG_MEM_SIZE / HMI2D_PROG_PAGE_SIZE,
+    HMI2D_PROG_BLOCK_SIZE = 0x200,
+    HMI2D_PROG_BLOCK_COUNT = HMI2D_PROG_MEM_SIZE / HMI2D_PROG_BLOCK_SIZE,
+    HMI2D_PROG_ERASED_VALUE = 0xFFFFFFFF
+};
+
+/* Typedef: hmi2d_update_block_t
+ *
+ * Typedef for one single block of the firmware image.
+ */
+typedef char hmi2d_update_block_t[HMI2D_PROG_BLOCK_SIZE];
+
+/* Typedef: hmi2d_update_image_t
+ *
+ * Typedef for the complete image.
+ */
+typedef hmi2d_update_block_t hmi2d_update_image_t[HMI2D_PROG_BLOCK_COUNT];
+
+/* Function: hmi2d_update_enter_bootloader
+ *
+ * Enters the bootloader-mode for 2D firmware update.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * This instruction has to be sent to 2D firmware in order to access
+ * 2D bootloader device. It is not needed if already connected to the
+ * 2D bootloader device.
+ *
+ * After a successfull call to hmi2d_update_enter_bootloader the connection
+ * to the 2D device has to be closed and a connection to the
+ * 2D bootloader device has to be opened. It might take some time until this
+ * device is accessible as Windows has to install drivers first.
+ *
+ * The <Update2D Application> demonstrates this.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>,
+ *    <hmi2d_update_exit_bootloader>
+ */
+HMI_API int CDECL hmi2d_update_enter_bootloader(hmi_t *hmi);
+
+/* Function: hmi2d_update_unlock
+ *
+ * Unlocks the memory for the 2D firmware update.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * This instruction has to be sent to the 2D bootloader device. If connected
+ * to normal 2D device <hmi2d_update_enter_bootloader> has to be called first
+ * with a subsequent reconnect to the 2D bootloader device.
+ *
+ * The next step affter hmi2d_update_unlock is a call to
+ * <hmi2d_update_erase_memory>.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>
+ */
+HMI_API int CDECL hmi2d_update_unlock(hmi_t *hmi);
+
+/* Function: hmi2d_update_erase_memory
+ *
+ * Erases the memory of the 2D firmware.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * <hmi2d_update_erase_memory> has to be called while connected to the
+ * 2D bootloader device after the memory was unlocked.
+ * It is followed by programming the new image with either
+ * <hmi2d_update_flash_memory> for the whole image or by individual calls
+ * to <hmi2d_update_flash_block>.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_memory>
+ */
+HMI_API int CDECL hmi2d_update_erase_memory(hmi_t *hmi);
+
+/* Function: hmi2d_update_flash_block
+ *
+ * Writes one block of the firmware image.
+ *
+ * addr  - Address of the first byte of the block
+ * block - The block to be written
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * An alternative to calling hmi2d_update_flash_block for each block of the
+ * firmware image individually would be to call <hmi2d_update_flash_memory>
+ * once for the whole image.
+ *
+ * The <Update2D Application> demonstrates the use of hmi2d_update_flash_block
+ * in order to give detailed feedback on the progress of the update.
+ *
+ * Once the whole 2D firmware image was written the bootloader mode could
+ * be left by calling <hmi2d_update_exit_bootloader>.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_memory>
+ */
+HMI_API int CDECL hmi2d_update_flash_block(hmi_t *hmi,
+                                           int addr,
+                                           hmi2d_update_block_t *block);
+
+/* Function: hmi2d_update_flash_memory
+ *
+ * Writes the whole 2D firmware image at once.
+ *
+ * image - The image to be written.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * hmi2d_update_flash_memory has to be called after erasing the memory while
+ * connected to the 2D bootloader device.
+ *
+ * If detailed feedback on the progress is needed <hmi2d_update_flash_block>
+ * could be called for each block of the image instead of
+ * <hmi2d_update_flash_memory>.
+ *
+ * Once the whole 2D firmware image was written the bootloader mode could
+ * be left by calling <hmi2d_update_exit_bootloader>.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>, <hmi2d_update_flash_block>
+ */
+HMI_API int CDECL hmi2d_update_flash_memory(hmi_t *hmi,
+                                            hmi2d_update_image_t *image);
+
+/* Structure: hmi2d_update_plan_t
+ *
+ * Describes which parts of the memory a 2D firmware update has to change.
+ *
+ * erase       - Nonzero for each page that has to be erased
+ * write       - Nonzero for each block that has to be written
+ * erase_count - Count of pages that have to be erased
+ * write_count - Count of blocks that have to be written
+ *
+ * See also:
+ *    <hmi2d_update_plan>, <hmi2d_update_flash_planned>
+ */
+typedef struct {
+    unsigned char erase[HMI2D_PROG_PAGE_COUNT];
+    unsigned char write[HMI2D_PROG_BLOCK_COUNT];
+    int erase_count;
+    int write_count;
+} hmi2d_update_plan_t;
+
+/* Function: hmi2d_update_plan
+ *
+ * Determines the pages and blocks that have to be changed in order to
+ * install a 2D firmware image.
+ *
+ * plan  - Receives the resulting <hmi2d_update_plan_t>
+ * image - The image to be installed
+ *
+ * All pages are erased. Blocks that only contain the erased value are not
+ * written as erasing already leaves them in this state.
+ *
+ * Pages are never skipped, use <hmi2d_update_plan_differential> to skip
+ * the pages that are already installed.
+ *
+ * See also:
+ *    <2D Firmware Update>, <hmi2d_update_flash_planned>
+ */
+HMI_API void CDECL hmi2d_update_plan(hmi2d_update_plan_t *plan,
+                                     hmi2d_update_image_t *image);
+
+/* Function: hmi2d_update_plan_differential
+ *
+ * Determines the pages and blocks that have to be changed in order to
+ * install a 2D firmware image over an image that is already installed.
+ *
+ * plan      - Receives the resulting <hmi2d_update_plan_t>
+ * image     - The image to be installed
+ * installed - The image that was installed by the last update
+ * checksum  - The checksum of <hmi2d_version_info_t> as reported by
+ *             <hmi2d_query_fw_version> after installed was written
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * hmi2d_update_plan_differential has to be called while connected to the
+ * 2D device before <hmi2d_update_enter_bootloader> is called.
+ *
+ * As the bootloader does not provide any read-back, the checksum reported
+ * by the running firmware is used to verify that the device still holds
+ * installed. Only if it matches the given checksum, the pages that are
+ * equal in both images are neither erased nor written. Otherwise, as after
+ * an interrupted update, the plan equals the one of <hmi2d_update_plan>.
+ *
+ * On failure the plan still equals the one of <hmi2d_update_plan>.
+ *
+ * See also:
+ *    <2D Firmware Update>, <hmi2d_update_plan>,
+ *    <hmi2d_update_flash_planned>
+ */
+HMI_API int CDECL hmi2d_update_plan_differential(
+    hmi_t *hmi, hmi2d_update_plan_t *plan, hmi2d_update_image_t *image,
+    hmi2d_update_image_t *installed, unsigned int checksum);
+
+/* Function: hmi2d_update_flash_planned
+ *
+ * Erases and writes the parts of the memory given by a plan.
+ *
+ * image  - The image to be written.
+ * plan   - The <hmi2d_update_plan_t> as determined by <hmi2d_update_plan>
+ *          or <hmi2d_update_plan_differential>
+ * stream - Nonzero to send the commands of each page erase pass and of
+ *          each block without waiting for the individual responses
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * hmi2d_update_flash_planned replaces the calls to
+ * <hmi2d_update_erase_memory> and <hmi2d_update_flash_memory> and is called
+ * after <hmi2d_update_unlock> while connected to the 2D bootloader device.
+ *
+ * When streaming, the responses of the bootloader are collected after the
+ * commands were sent. A block that fails is sent once more without
+ * streaming after the responses still outstanding were drained.
+ * Streaming requires the bootloader to buffer the commands of a whole
+ * block, so it should be disabled if it fails repeatedly.
+ *
+ * See also:
+ *    <2D Firmware Update>, <hmi2d_update_plan>,
+ *    <hmi2d_update_exit_bootloader>
+ */
+HMI_API int CDECL hmi2d_update_flash_planned(hmi_t *hmi,
+                                             hmi2d_update_image_t *image,
+                                             const hmi2d_update_plan_t *plan,
+                                             int stream);
+
+/* Enumeration: hmi2d_update_state_t
+ *
+ * The states of a 2D update that advances with <hmi2d_update_flash_step>.
+ *
+ * hmi2d_UpdateState_Idle      - No update was started
+ * hmi2d_UpdateState_Erase     - Erases the pages of the plan
+ * hmi2d_UpdateState_Write     - Writes the blocks of the plan
+ * hmi2d_UpdateState_Done      - The update succeeded
+ * hmi2d_UpdateState_Failed    - The update failed
+ * hmi2d_UpdateState_Cancelled - The update was cancelled with
+ *                               <hmi2d_update_flash_cancel>
+ *
+ * See also:
+ *    <hmi2d_update_status_t>, <hmi2d_update_flash_start>
+ */
+typedef enum {
+    hmi2d_UpdateState_Idle = 0,
+    hmi2d_UpdateState_Erase,
+    hmi2d_UpdateState_Write,
+    hmi2d_UpdateState_Done,
+    hmi2d_UpdateState_Failed,
+    hmi2d_UpdateState_Cancelled
+} hmi2d_update_state_t;
+
+/* Structure: hmi2d_update_status_t
+ *
+ * Progress of a 2D update that advances with <hmi2d_update_flash_step>.
+ *
+ * state       - The current <hmi2d_update_state_t>
+ * error       - The negative <hmi_error_t> code of a failed update,
+ *               otherwise 0
+ * blocks_done - Count of blocks that were written
+ * block_count - Count of blocks that the plan writes
+ * elapsed_ms  - Time in milliseconds since the update was started
+ * bytes_per_s - Block data written per second
+ * eta_ms      - Estimated time in milliseconds until all blocks are written
+ *               or -1 before the first block was written
+ *
+ * The times are 0 on platforms without <HMI_TIME_US>.
+ *
+ * See also:
+ *    <hmi2d_update_flash_get_status>
+ */
+typedef struct {
+    hmi2d_update_state_t state;
+    int error;
+    int blocks_done;
+    int block_count;
+    int elapsed_ms;
+    float bytes_per_s;
+    int eta_ms;
+} hmi2d_update_status_t;
+
+/* Function: hmi2d_update_flash_start
+ *
+ * Starts to erase and write the parts of the memory given by a plan like
+ * <hmi2d_update_flash_planned>, but in steps.
+ *
+ * image  - The image to be written. It has to stay valid until the
+ *          update is finished.
+ * plan   - The <hmi2d_update_plan_t> as determined by <hmi2d_update_plan>
+ *          or <hmi2d_update_plan_differential>
+ * stream - Nonzero to send the commands without waiting for the individual
+ *          responses
+ *
+ * Nothing is sent before the first call to <hmi2d_update_flash_step>.
+ * The timeouts for the responses are measured with <HMI_TIME_US>. On
+ * platforms without it the timeouts only count the time that
+ * <hmi2d_update_flash_step> waited for responses.
+ *
+ * See also:
+ *    <2D Firmware Update>, <hmi2d_update_flash_step>,
+ *    <hmi2d_update_flash_get_status>
+ */
+HMI_API void CDECL hmi2d_update_flash_start(hmi_t *hmi,
+                                            hmi2d_update_image_t *image,
+                                            const hmi2d_update_plan_t *plan,
+                                            int stream);
+
+/* Function: hmi2d_update_flash_step
+ *
+ * Advances the update started with <hmi2d_update_flash_start> by handling
+ * the responses that arrived and sending the commands that may follow.
+ *
+ * Returns 1 while the update is running and 0 once it is finished.
+ *
+ * The step never waits for a response. Instead it returns and continues
+ * once the response arrived, so the caller should sleep for about a
+ * millisecond between the steps. On platforms without <HMI_TIME_US> the
+ * step instead waits up to 10 milliseconds for a response when it made
+ * no progress, as the timeouts are measured with those waits. Up to 64
+ * messages are handled per step.
+ *
+ * The library does not run the update in the background by itself. Only
+ * this poll-driven step is provided, which the application may call from
+ * a thread of its own. The update only uses hmi, so other instances can
+ * keep streaming sensor data while it runs.
+ *
+ * See also:
+ *    <hmi2d_update_flash_start>, <hmi2d_update_flash_cancel>
+ */
+HMI_API int CDECL hmi2d_update_flash_step(hmi_t *hmi);
+
+/* Function: hmi2d_update_flash_cancel
+ *
+ * Requests to cancel the update started with <hmi2d_update_flash_start>.
+ *
+ * The cancellation takes effect at a block boundary once the outstanding
+ * responses arrived, which may take a few more calls to
+ * <hmi2d_update_flash_step>. The function may be called from
+ * another thread than the one that calls <hmi2d_update_flash_step> when
+ * the library is built with HMI_SYNC_THREADING.
+ *
+ * Important:
+ *    The memory contains an incomplete firmware after the cancellation.
+ *    The update has to be repeated before leaving the bootloader mode.
+ *
+ * See also:
+ *    <hmi2d_update_flash_start>, <hmi2d_update_flash_step>
+ */
+HMI_API void CDECL hmi2d_update_flash_cancel(hmi_t *hmi);
+
+/* Function: hmi2d_update_flash_get_status
+ *
+ * Fills status with the progress of the update started with
+ * <hmi2d_update_flash_start>.
+ *
+ * The function may be called from another thread than the one that calls
+ * <hmi2d_update_flash_step> when the library is built with
+ * HMI_SYNC_THREADING. Otherwise all calls for the update have to come from
+ * the same thread.
+ *
+ * See also:
+ *    <hmi2d_update_status_t>, <hmi2d_update_flash_step>
+ */
+HMI_API void CDECL hmi2d_update_flash_get_status(
+        hmi_t *hmi, hmi2d_update_status_t *status);
+
+/* Function: hmi2d_update_exit_bootloader
+ *
+ * Exits the 2D bootloader mode.
+ *
+ * Returns HMI_NO_ERROR on success or a negative error code.
+ *
+ * This instruction has to be sent to the 2D bootloader firmware in order to
+ * start the normal operation of the 2D firmware. If a 2D firmware update was
+ * already started it has to be completed in order to successfully leave the
+ * 2D bootloader mode.
+ *
+ * After a successfull call to hmi2d_update_exit_bootloader the connection
+ * to the 2D bootloader device has to be closed and a connection to the
+ * normal 2D device has to be opened in order to be used.
+ * It might take some time until this device is accessible as Windows might
+ * have to install drivers first.
+ *
+ * The <Update2D Application> demonstrates how to do a complete 2D firmware
+ * update.
+ *
+ * See also:
+ *    <Update2D Application>, <2D Firmware Update>,
+ *    <hmi2d_update_enter_bootloader>
+ */
+HMI_API int CDECL hmi2d_update_exit_bootloader(hmi_t *hmi);
+
+#endif
+
+/* Include the dynamic API that has to be used when accessing
+ * the HMI-library via dynamic linking.
+ * This is required because the exact configuration of the dynamic
+ * library and therefore the structure of hmi_t is unknown.
+ */
+#if defined(HMI_API_DYNAMIC) || defined(HMI_HAS_DYNAMIC)
+#include "hmi_dynamic.h"
+#endif
+
+/* Include the static part of the API that is not accessible
+ * to applications linking dynamically against the HMI-library.
+ */
+#if defined(HMI_API_EXPORT) || !defined(HMI_API_DYNAMIC)
+#include "hmi_static.h"
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HMI_API_H */
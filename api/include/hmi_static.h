@@ -1,341 +1,869 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#ifndef HMI_STATIC_H
-#define HMI_STATIC_H
-
-/* This file is included by hmi_api.h and should not be included directly.
- *
- * As most IDEs don't take definitions from the file that is including the
- * header into consideration when parsing a header this file in turn
- * includes hmi_api.h to help the parser find the correct definitions.
- */
-#ifndef HMI_API_H
-#include "hmi_api.h"
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* ======== Logger ======== */
-
-#ifndef HMI_NO_LOGGING
-
-typedef struct {
-    void *opaque;
-    hmi_logger_t logger;
-} hmi_logging_t;
-
-#endif
-
-/* ======== Parameter Request ======== */
-
-typedef struct {
-    int param;
-    unsigned int *arg0;
-    unsigned int *arg1;
-} hmi_param_request_t;
-
-typedef struct {
-    char *version;
-    int size;
-    int received;
-} hmi3d_version_request_t;
-
-typedef struct {
-    hmi2d_version_info_t *version;
-    int received;
-} hmi2d_version_request_t;
-
-/* ======== Structure containing retrieved 3D data ======== */
-
-#ifndef HMI3D_NO_DATA_RETRIEVAL
-
-typedef struct {
-    hmi3d_signal_t cic;
-    hmi3d_signal_t sd;
-    hmi3d_position_t pos;
-    hmi3d_gesture_t gesture;
-    hmi3d_calib_t calib;
-    hmi3d_touch_t touch;
-    hmi3d_air_wheel_t air_wheel;
-    hmi3d_freq_t frequency;
-    hmi3d_noise_power_t noise_power;
-    int frame_counter;
-} hmi3d_input_data_t;
-
-#endif
-
-#ifndef HMI2D_NO_DATA_RETRIEVAL
-
-typedef struct {
-    hmi2d_row_t self_raw;
-    hmi2d_row_t self_cal;
-    hmi2d_block_t mutual_raw;
-    hmi2d_block_t mutual_cal;
-    hmi2d_finger_pos_list_t fingers;
-    hmi2d_mouse_t mouse;
-    hmi2d_gesture_t gesture;
-    int last_gesture;
-    int msg_counter;
-} hmi2d_input_data_t;
-
-#endif
-
-/* ======== Message Extraction State ======== */
-
-#if HMI_IO == HMI_IO_CDC_SERIAL
-/* Message size is limited to what could be expressed with one byte */
-#define HMI3D_MAX_MESSAGE_SIZE 255
-
-/* The maximum of data that is read from the device at once */
-#define HMI3D_INPUT_CAPACITY 1024
-
-typedef struct {
-    int state;
-    int buffer_cursor;
-    int buffer_size;
-    unsigned char buffer[HMI3D_INPUT_CAPACITY];
-    unsigned char msg[HMI3D_MAX_MESSAGE_SIZE];
-} hmi3d_msg_extract_t;
-#endif
-
-/* ======== Flashing Libraries ======== */
-
-#ifndef HMI3D_NO_UPDATE
-
-typedef struct {
-    unsigned int session_id;
-    hmi3d_UpdateFunction_t session_mode;
-    int crc_intialized;
-    unsigned int crc_table[256];
-} hmi3d_update_t;
-
-#endif
-
-/* ======== The hmi_io_t - Structure ======== */
-
-#if HMI_IO == HMI_IO_CDC_SERIAL
-
-typedef struct {
-#if HMI_IO == HMI_IO_CDC_SERIAL
-    void *cdc_serial;
-    hmi3d_msg_extract_t msg_extract;
-#endif
-} hmi_io_t;
-
-#elif HMI_IO == HMI_IO_HID_3DTOUCHPAD
-
-typedef struct hid_device_ hid_device;
-typedef struct {
-    hid_device *handle;
-    unsigned char accum[256];
-    unsigned char packet[64];
-    int cursor;
-    int offset;
-
-    int vendor_id;
-    int product_id;
-    int report_id;
-    int iface;
-} hmi_io_t;
-
-#endif
-
-/* ======== IO Assertion helpers ======== */
-
-/* Macro: HMI_CONNECTED
- *
- * Returns whether the device was connected via <hmi_open>.
- *
- * This macro is used for debugging purpose to detect usage of functions that
- * require a connection even though it wasn't established.
- */
-#ifndef HMI_CONNECTED
-#   if HMI_IO == HMI_IO_CDC_SERIAL
-#       define HMI_CONNECTED(HMI) ((HMI)->io.cdc_serial)
-#   elif HMI_IO == HMI_IO_HID_3DTOUCHPAD
-#       define HMI_CONNECTED(HMI) ((HMI)->io.handle)
-#   else
-#       error "Macro HMI_CONNECTED not defined"
-#   endif
-#endif
-
-/* ======== The hmi_t - Structure ======== */
-
-struct hmi_struct {
-    volatile int resp_msg_id;
-    volatile int resp_error_code;
-    hmi_param_request_t * volatile param_request;
-    hmi3d_version_request_t * volatile version_request;
-
-#ifndef HMI3D_NO_DATA_RETRIEVAL
-    /* Buffer for the result as fetched via <hmi3d_retrieve_data> */
-    hmi3d_input_data_t result;
-    /* Buffer that contains the state after the last received data-frame */
-    hmi3d_input_data_t internal;
-    unsigned char last_time_stamp;
-#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
-    /* Pointer to data required for synchronization (e.g. a mutex) */
-    void *io_sync;
-#endif
-#endif
-
-#ifndef HMI2D_NO_UPDATE
-    int bootloader_2d_error_code;
-#endif
-    volatile int resp2d_msg_id;
-    volatile int resp2d_ack;
-    hmi_param_request_t * volatile param2d_request;
-    hmi2d_version_request_t * volatile version2d_request;
-
-#ifndef HMI2D_NO_DATA_RETRIEVAL
-    hmi2d_input_data_t result2d;
-    hmi2d_input_data_t internal2d;
-#endif
-
-#ifndef HMI_NO_LOGGING
-    hmi_logging_t logging;
-#endif
-    hmi_io_t io;
-#ifndef HMI3D_NO_UPDATE
-    hmi3d_update_t flash;
-    unsigned char fw_valid;
-#endif
-};
-
-/* ======== Internal Communication Implementation ======== */
-
-/* Function: hmi_message_receive
- *
- * Called when incoming messages should be received.
- *
- * timeout - Optional pointer to an integer variable containing the timeout.
- *           This function sets timeout to the remaining time when returning.
- *
- * This function returns a negative error code if an error occured.
- *
- * If timeout is not NULL this function might return at any time with
- * <HMI_NO_ERROR> even if no message was processed but has to
- * return <HMI_NO_DATA> once when the timeout expired.
- *
- * If timeout is NULL this function *might* return <HMI_NO_DATA> if
- * *definitely* no message was received and will return <HMI_NO_ERROR>
- * otherwise.
- *
- * Typical implementations will try to read one message and forward it to
- * <hmi3d_message_handle>. However in case of asynchronous message handling
- * this function might do nothing except returning after a short sleep with
- * <HMI_NO_ERROR> when timeout has a nonzero value.
- *
- * Note:
- *    Custom IO implementations have to provide their own implementation
- *    of this function.
- *
- * See also:
- *    <hmi3d_message_write>, <hmi3d_message_handle>
- */
-int hmi_message_receive(hmi_t *hmi, int *timeout);
-
-/* Function: hmi3d_message_write
- *
- * Writes a message to the device.
- *
- * msg   - The message to write to the device
- * size  - The size of the message in bytes
- *
- * Returns HMI_NO_ERROR on success.
- *
- * Note:
- *    Custom IO implementations have to provide their own implementation of
- *    this function.
- *
- * See also:
- *    <hmi_message_receive>
- */
-int hmi3d_message_write(hmi_t *hmi, void *msg, int size);
-
-/* Function: hmi2d_message_write.
- *
- * Sends a message to the 2D subsystem.
- *
- * id   - ID of the message to be sent
- * size - Size of the message
- * msg  - The content of the message
- *
- * Return HMI_NO_ERROR on success or the IO implementation specific error code
- * on failure.
- *
- * See also:
- *    <hmi_message_receive>, <hmi2d_send_message>
- */
-int hmi2d_message_write(hmi_t *hmi, int id, int size, unsigned char *msg);
-
-/* ========  Message Processing ======== */
-
-/* Function: hmi2d_message_handle
- *
- * Does the evaluation of received messages for the 2D subsystem.
- *
- * msg  - Reference to the received message.
- *        The size of the message is stored as the second byte.
- *
- * This function identifies the messages and calls the appropriate handlers.
- *
- * See also:
- *    <hmi_message_receive>, <hmi2d_handle_ack>, <hmi2d_handle_data_row>,
- *    <hmi2d_handle_finger_pos>, <hmi2d_handle_mouse_btns>,
- *    <hmi2d_handle_gesture>, <hmi2d_handle_parameter>,
- *    <hmi2d_handle_update_response>, <hmi2d_handle_fw_version>
- */
-void hmi2d_message_handle(hmi_t *hmi, const unsigned char *msg);
-
-/* Function: hmi3d_message_handle
- *
- * Does the evaluation of received messages for the 3D subsystem.
- *
- * msg  - Reference to the received message
- * size - The size of the received message
- *
- * This function is the heart of processing of incoming messages.
- * It decodes the messages and calls the appropriate handlers.
- *
- * See also:
- *    <hmi_message_receive>, <hmi3d_handle_system_status>,
- *    <hmi3d_handle_version_info>, <hmi3d_handle_data_output>,
- *    <hmi3d_handle_runtime_parameter>
- */
-void hmi3d_message_handle(hmi_t *hmi, const void *msg, int size);
-
-/* ======== Version information ======== */
-
-#define HMI_API_VERSION_MAJOR 0
-#define HMI_API_VERSION_MINOR 9
-#define HMI_API_VERSION_REVISION 1
-#define HMI_API_VERSION_STRING "0.9.1"
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* HMI_STATIC_H */
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#ifndef HMI_STATIC_H
+#define HMI_STATIC_H
+
+/* This file is included by hmi_api.h and should not be included directly.
+ *
+ * As most IDEs don't take definitions from the file that is including the
+ * header into consideration when parsing a header this file in turn
+ * includes hmi_api.h to help the parser find the correct definitions.
+ */
+#ifndef HMI_API_H
+#include "hmi_api.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======== Logger ======== */
+
+#ifndef HMI_NO_LOGGING
+
+typedef struct {
+    void *opaque;
+    hmi_logger_t logger;
+} hmi_logging_t;
+
+#endif
+
+/* ======== Parameter Request ======== */
+
+typedef struct {
+    int param;
+    unsigned int *arg0;
+    unsigned int *arg1;
+} hmi_param_request_t;
+
+typedef struct {
+    char *version;
+    int size;
+    int received;
+} hmi3d_version_request_t;
+
+typedef struct {
+    hmi2d_version_info_t *version;
+    int received;
+} hmi2d_version_request_t;
+
+/* ======== Structure containing retrieved 3D data ======== */
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+typedef struct {
+    hmi3d_signal_t cic;
+    hmi3d_signal_t sd;
+    hmi3d_position_t pos;
+    hmi3d_position_t filtered_pos;
+    hmi3d_gesture_t gesture;
+    hmi3d_calib_t calib;
+    hmi3d_touch_t touch;
+    hmi3d_air_wheel_t air_wheel;
+    hmi3d_freq_t frequency;
+    hmi3d_noise_power_t noise_power;
+    int frame_counter;
+    /* hmi3d_DataOutConfigMask_t -sections of the last frame with valid
+     * data
+     */
+    int valid;
+} hmi3d_input_data_t;
+
+/* State of the One-Euro filter of positions */
+typedef struct {
+    int enabled;
+    hmi3d_position_filter_t config;
+    /* Whether value holds a filtered sample */
+    int primed;
+    /* Frame counter of the last filtered sample */
+    int last_frame;
+    /* Filtered position and speed per axis */
+    float value[3];
+    float speed[3];
+    /* Sample interval and smoothing factor of the speed for consecutive
+     * samples
+     */
+    float te;
+    float speed_alpha;
+} hmi3d_filter_t;
+
+/* Unwrapping and filtering of AirWheel */
+typedef struct {
+    hmi3d_air_wheel_filter_t config;
+    /* Whether counter holds the counter of an earlier frame */
+    int primed;
+    int counter;
+    /* Whether last_frame holds the frame of an earlier active frame */
+    int tracking;
+    int last_frame;
+} hmi3d_air_wheel_state_t;
+
+/* State of the prediction of positions */
+typedef struct {
+    int enabled;
+    hmi3d_prediction_config_t config;
+    /* Whether value holds a position and whether velocity was estimated
+     * from two positions
+     */
+    int primed;
+    int moving;
+    /* Frame counter and HMI_TIME_US of the last position */
+    int last_frame;
+    unsigned int time;
+    /* Position, velocity and acceleration per axis */
+    float value[3];
+    float velocity[3];
+    float acceleration[3];
+    /* Whether the last movement of an axis opposed its velocity */
+    int reversed[3];
+} hmi3d_predictor_t;
+
+#ifndef HMI3D_NO_CUSTOM_GESTURES
+
+/* Constant: HMI3D_CUSTOM_MAX_GESTURES
+ *
+ * Count of custom gestures the storage inside each hmi_t holds
+ *
+ * Every gesture takes about 1.5 kB, so the default is kept low.
+ * Applications with more gestures pass their own storage to
+ * <hmi3d_set_custom_storage> or define a larger value.
+ */
+#ifndef HMI3D_CUSTOM_MAX_GESTURES
+#define HMI3D_CUSTOM_MAX_GESTURES 4
+#endif
+
+/* Constant: HMI3D_CUSTOM_HISTORY
+ *
+ * Count of frames that are kept for the recognition of custom gestures,
+ * which limits their duration
+ */
+#ifndef HMI3D_CUSTOM_HISTORY
+#define HMI3D_CUSTOM_HISTORY 256
+#endif
+
+/* Width of the band around the diagonal the alignment of custom gestures
+ * is limited to
+ */
+#ifndef HMI3D_CUSTOM_BAND
+#define HMI3D_CUSTOM_BAND 4
+#endif
+
+/* Count of frames without a closer match after which a custom gesture is
+ * reported
+ */
+#ifndef HMI3D_CUSTOM_SETTLE
+#define HMI3D_CUSTOM_SETTLE 6
+#endif
+
+/* Recognition of custom gestures */
+typedef struct {
+    /* Storage of the gestures as passed to hmi3d_set_custom_storage and
+     * its count of entries or NULL for builtin
+     */
+    hmi3d_custom_template_t *templ;
+    int capacity;
+    int count;
+    /* Index of the gesture with the fewest frames. The others follow via
+     * their next index ordered by their count of frames.
+     */
+    int first;
+    hmi3d_custom_template_t builtin[HMI3D_CUSTOM_MAX_GESTURES];
+    /* Ring buffer of position and SD of the last frames. Only the last
+     * frames with the hand present are valid.
+     */
+    float history[HMI3D_CUSTOM_HISTORY][4];
+    int head;
+    int valid;
+    /* Index + 1 of the closest match waiting to be reported, 0 for none */
+    int pending;
+    float pending_distance;
+    int pending_age;
+} hmi3d_custom_t;
+
+#endif
+
+#if !defined(HMI3D_NO_SIGNAL_STATS) || !defined(HMI3D_NO_CALIB_SCHEDULE)
+
+/* Count of buckets of the histograms of the signal statistics */
+#ifndef HMI3D_STATS_BUCKETS
+#define HMI3D_STATS_BUCKETS 128
+#endif
+
+/* Count of frames the statistics accumulate before they are merged into
+ * the totals
+ */
+#ifndef HMI3D_STATS_BLOCK
+#define HMI3D_STATS_BLOCK 256
+#endif
+
+/* Statistics of one stream of signals. The values of the channels are
+ * padded to two vectors of four floats.
+ */
+typedef struct {
+    /* Totals of the merged blocks */
+    unsigned int count;
+    double mean[5];
+    double m2[5];
+    /* Running block of frames */
+    int block_count;
+    float block_mean[8];
+    float block_m2[8];
+    float ewma[8];
+    float min[8];
+    float max[8];
+    /* Histograms of the current and the previous half of the window. Each
+     * spans the values around the average when it was started.
+     */
+    unsigned short histogram[2][5][HMI3D_STATS_BUCKETS];
+    float origin[2][8];
+    float scale[2][8];
+    float step[2][5];
+    int epoch;
+    int epoch_count;
+    int epoch_size;
+} hmi3d_stream_stats_t;
+
+#endif
+
+#ifndef HMI3D_NO_SIGNAL_STATS
+
+/* Statistics of the CIC and SD signals */
+typedef struct {
+    int enabled;
+    hmi3d_signal_stats_config_t config;
+    hmi3d_stream_stats_t stream[2];
+} hmi3d_stats_t;
+
+#endif
+
+#ifndef HMI3D_NO_CALIB_SCHEDULE
+
+/* Scheduler of calibrations by the drift of the signals */
+typedef struct {
+    int enabled;
+    hmi3d_calib_schedule_t config;
+    hmi3d_signal_stats_config_t stats_config;
+    /* Statistics of the settled frames since the last calibration */
+    hmi3d_stream_stats_t idle;
+    float reference[5];
+    float drift[5];
+    float max_drift;
+    int settled;
+    int idle_count;
+    int last_calibration;
+    /* Whether a calibration is due and whether one was requested */
+    int due;
+    int requested;
+    hmi3d_calib_record_t log[HMI3D_CALIB_LOG];
+    int log_head;
+    int log_count;
+} hmi3d_calib_scheduler_t;
+
+#endif
+
+/* Analysis of the interference at the working frequencies */
+typedef struct {
+    int enabled;
+    hmi3d_noise_config_t config;
+    /* Twiddle factors of the FFT and the Hann window */
+    float cos_table[HMI3D_NOISE_SAMPLES / 2 + 1];
+    float sin_table[HMI3D_NOISE_SAMPLES / 2 + 1];
+    float window[HMI3D_NOISE_SAMPLES];
+    /* Consecutive frames of the current frequency */
+    float samples[HMI3D_NOISE_SAMPLES];
+    int fill;
+    int current;
+    int last_frame;
+    float noise_sum;
+    int noise_count;
+    /* Interference and frame counter of the last analysis per frequency */
+    float interference[5];
+    int measured[5];
+    int analyzed;
+    /* Selection of the analysis and the one passed to the device */
+    int selected;
+    int applied;
+    int last_change;
+} hmi3d_noise_t;
+
+/* Decoder for the sections of a Sensor_Data_Output message */
+typedef void (*hmi3d_data_decoder_t)(hmi3d_input_data_t *dest,
+                                     const unsigned char *data,
+                                     int electrodeCount);
+
+#endif
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+
+typedef struct {
+    hmi2d_row_t self_raw;
+    hmi2d_row_t self_cal;
+    hmi2d_finger_pos_list_t fingers;
+    hmi2d_mouse_t mouse;
+    hmi2d_gesture_t gesture;
+    int last_gesture;
+    int msg_counter;
+    /* Sections changed since the last hmi2d_retrieve_data as a combination
+     * of <hmi2d_section_t> flags
+     */
+    int changed;
+} hmi2d_input_data_t;
+
+/* Assembly of the rows of mutual data into complete scans */
+typedef struct {
+    /* The scan that receives rows and the last complete scan */
+    hmi2d_heatmap_t frame[2];
+    int current;
+    int last_row;
+    /* Configured rows that make a scan complete or 0 for all rows */
+    unsigned short expected;
+    unsigned int sequence;
+    /* Sequence and rows of the scan in the block of the last
+     * hmi2d_retrieve_data
+     */
+    unsigned int retrieved;
+    unsigned short retrieved_rows;
+} hmi2d_scan_t;
+
+#ifndef HMI2D_NO_TRACKING
+
+/* Maximum size of the cost matrix of the contact assignment, which has a
+ * row for every contact and every finger
+ */
+#define HMI2D_TRACK_MATRIX (HMI2D_MAX_CONTACTS + 10)
+
+/* State of a tracked contact */
+typedef struct {
+    /* 0 for unused entries, 1 for active contacts and 2 for contacts that
+     * ended but were not reported yet
+     */
+    int state;
+    hmi2d_contact_t contact;
+    /* Kalman state of position and velocity and its covariance as p00,
+     * p01 and p11 per axis
+     */
+    double x[2];
+    double y[2];
+    double px[3];
+    double py[3];
+    /* Finger messages since the last finger of the contact */
+    int missed;
+} hmi2d_track_t;
+
+/* Contact tracking across finger messages */
+typedef struct {
+    int enabled;
+    hmi2d_tracking_config_t config;
+    hmi2d_track_t track[HMI2D_MAX_CONTACTS];
+    int next_id;
+    /* Timestamp as returned by HMI_TIME_US of the last finger message */
+    unsigned int last_time;
+    /* Work buffers of the assignment of fingers to contacts */
+    float cost[HMI2D_TRACK_MATRIX][HMI2D_TRACK_MATRIX];
+    int assigned[HMI2D_TRACK_MATRIX];
+} hmi2d_tracker_t;
+
+#endif
+
+#endif
+
+/* ======== Fused Trajectory State ======== */
+
+#if !defined(HMI2D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_DATA_RETRIEVAL)
+
+/* State of the fusion of 3D positions and 2D fingers */
+typedef struct {
+    int enabled;
+    hmi_trajectory_config_t config;
+    /* Timestamps as returned by HMI_TIME_US of the last sample and of the
+     * last 3D position in it
+     */
+    unsigned int last_time;
+    unsigned int last_time3d;
+    /* Remaining offset from the followed data to the trajectory after a
+     * change between 3D and 2D data
+     */
+    float offset[2];
+} hmi_fusion_t;
+
+#endif
+
+/* ======== Flight Recorder State ======== */
+
+#ifndef HMI_NO_RECORDER
+
+/* Bytes recorded for one 3D frame with all sections of the data output,
+ * which are the entries of the raw message and of the decoded frame, and
+ * the frame rate of the data output
+ */
+#define HMI_RECORDER_FRAME_SIZE 104
+#define HMI_RECORDER_FRAME_RATE 200
+
+/* Seconds of 3D data output the flight recorder holds. Builds that want a
+ * longer history define it larger.
+ */
+#ifndef HMI_RECORDER_SECONDS
+#define HMI_RECORDER_SECONDS 1
+#endif
+
+/* The size of the ring buffer of the flight recorder in bytes */
+#ifndef HMI_RECORDER_CAPACITY
+#define HMI_RECORDER_CAPACITY (HMI_RECORDER_SECONDS * \
+                               HMI_RECORDER_FRAME_RATE * \
+                               HMI_RECORDER_FRAME_SIZE)
+#endif
+
+typedef struct {
+    int enabled;
+    /* Offset of the oldest entry, used bytes and count of entries */
+    int head;
+    int used;
+    int count;
+
+    hmi_recorder_triggers_t triggers;
+    hmi_recorder_writer_t writer;
+    void *opaque;
+
+    /* State of the triggers */
+    unsigned int window_start;
+    int bad_data;
+    int calibrations;
+    int streaming;
+    unsigned int last_frame;
+    unsigned int last_dump;
+    int dumps;
+    int pending;
+
+    /* Set while a dump writes the entries of the snapshot that started at
+     * snap_head and spanned snap_used bytes
+     */
+    int dumping;
+    int snap_head;
+    int snap_used;
+
+    unsigned char buffer[HMI_RECORDER_CAPACITY];
+} hmi_recorder_t;
+
+#endif
+
+/* ======== Message Extraction State ======== */
+
+#if HMI_IO == HMI_IO_CDC_SERIAL
+/* Message size is limited to what could be expressed with one byte */
+#define HMI3D_MAX_MESSAGE_SIZE 255
+
+/* The maximum of data that is read from the device at once */
+#define HMI3D_INPUT_CAPACITY 1024
+
+typedef struct {
+    int state;
+    int buffer_cursor;
+    int buffer_size;
+    unsigned char buffer[HMI3D_INPUT_CAPACITY];
+    unsigned char msg[HMI3D_MAX_MESSAGE_SIZE];
+} hmi3d_msg_extract_t;
+#endif
+
+/* ======== Flashing Libraries ======== */
+
+#ifndef HMI3D_NO_UPDATE
+
+/* Maximum count of Fw_Update_Block messages in flight during
+ * <hmi3d_update_image_windowed>
+ */
+#ifndef HMI3D_UPDATE_MAX_WINDOW
+#define HMI3D_UPDATE_MAX_WINDOW 8
+#endif
+
+/* Count of records after which the window is drained, which limits the
+ * records sent again after lost messages
+ */
+#ifndef HMI3D_UPDATE_SEGMENT
+#define HMI3D_UPDATE_SEGMENT 32
+#endif
+
+typedef struct {
+    /* Prepared messages, their records and attempts indexed by the
+     * sequence number of the message modulo the window size
+     */
+    unsigned char msg[HMI3D_UPDATE_MAX_WINDOW][140];
+    int record[HMI3D_UPDATE_MAX_WINDOW];
+    int attempt[HMI3D_UPDATE_MAX_WINDOW];
+    int size;
+    int sent;
+    int acked;
+    /* Records that have to be sent again */
+    int retry[HMI3D_UPDATE_MAX_WINDOW];
+    int retry_attempt[HMI3D_UPDATE_MAX_WINDOW];
+    int retry_head;
+    int retry_count;
+    /* Records of the current segment and the next record to send */
+    int segment_start;
+    int segment_end;
+    int next;
+    int highest;
+    int retransmits;
+    int error;
+    /* Set for verification passes that stop at the first mismatch instead
+     * of sending the record again
+     */
+    int verify;
+    int mismatch;
+    int mismatch_record;
+    /* Rewinds of the current segment after missing acknowledges */
+    int rewinds;
+    /* Set while late acknowledges are discarded before a rewind */
+    int draining;
+    /* End of the records to transfer, 0 for all records of the image */
+    int last;
+} hmi3d_update_window_t;
+
+/* State of an update that advances with <hmi3d_update_step> */
+typedef struct {
+    hmi3d_update_state_t state;
+    int error;
+    const hmi3d_update_image_t *image;
+    hmi3d_UpdateFunction_t mode;
+    int wait_loader;
+    volatile int cancel;
+    /* Timestamps as returned by HMI_TIME_US when the update started and
+     * finished
+     */
+    unsigned int start_time;
+    unsigned int end_time;
+    /* The message that waits for its acknowledge and its sends so far */
+    unsigned char msg[136];
+    int msg_size;
+    int attempts;
+    /* Timestamp as returned by HMI_TIME_US when waiting fails or, with
+     * HMI_NO_TIME, the milliseconds left to wait
+     */
+    unsigned int deadline;
+    int last_acked;
+    hmi3d_version_request_t version_request;
+    hmi3d_update_window_t window;
+} hmi3d_update_job_t;
+
+typedef struct {
+    unsigned int session_id;
+    hmi3d_UpdateFunction_t session_mode;
+    hmi3d_update_window_t * volatile window;
+    hmi3d_update_job_t job;
+} hmi3d_update_t;
+
+#endif
+
+#ifndef HMI2D_NO_UPDATE
+
+/* State of a 2D update that advances with <hmi2d_update_flash_step> */
+typedef struct {
+    hmi2d_update_state_t state;
+    int error;
+    hmi2d_update_image_t *image;
+    hmi2d_update_plan_t plan;
+    int stream;
+    /* The page or block that is checked next */
+    int index;
+    int blocks_done;
+    volatile int cancel;
+    /* Timestamps as returned by HMI_TIME_US when the update started and
+     * finished
+     */
+    unsigned int start_time;
+    unsigned int end_time;
+    /* Commands of the current block that were sent and count of commands
+     * since the responses were reset
+     */
+    int command;
+    int sent;
+    /* Set while the current block is written waiting for each response
+     * after streaming failed and while the responses of the failed
+     * attempt are drained
+     */
+    int fallback;
+    int draining;
+    /* Timestamp as returned by HMI_TIME_US when waiting fails or, with
+     * HMI_NO_TIME, the milliseconds left to wait and the count of
+     * responses when the timeout was restarted
+     */
+    unsigned int deadline;
+    int last_responses;
+} hmi2d_update_job_t;
+
+#endif
+
+/* ======== The hmi_io_t - Structure ======== */
+
+#if HMI_IO == HMI_IO_CDC_SERIAL
+
+typedef struct {
+#if HMI_IO == HMI_IO_CDC_SERIAL
+    void *cdc_serial;
+    hmi3d_msg_extract_t msg_extract;
+#endif
+} hmi_io_t;
+
+#elif HMI_IO == HMI_IO_HID_3DTOUCHPAD
+
+typedef struct hid_device_ hid_device;
+typedef struct {
+    hid_device *handle;
+    unsigned char accum[256];
+    unsigned char packet[64];
+    int cursor;
+    int offset;
+
+    int vendor_id;
+    int product_id;
+    int report_id;
+    int iface;
+} hmi_io_t;
+
+#endif
+
+/* ======== IO Assertion helpers ======== */
+
+/* Macro: HMI_CONNECTED
+ *
+ * Returns whether the device was connected via <hmi_open>.
+ *
+ * This macro is used for debugging purpose to detect usage of functions that
+ * require a connection even though it wasn't established.
+ */
+#ifndef HMI_CONNECTED
+#   if HMI_IO == HMI_IO_CDC_SERIAL
+#       define HMI_CONNECTED(HMI) ((HMI)->io.cdc_serial)
+#   elif HMI_IO == HMI_IO_HID_3DTOUCHPAD
+#       define HMI_CONNECTED(HMI) ((HMI)->io.handle)
+#   else
+#       error "Macro HMI_CONNECTED not defined"
+#   endif
+#endif
+
+/* ======== The hmi_t - Structure ======== */
+
+struct hmi_struct {
+    volatile int resp_msg_id;
+    volatile int resp_error_code;
+    hmi_param_request_t * volatile param_request;
+    hmi3d_version_request_t * volatile version_request;
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+    /* Buffer for the result as fetched via <hmi3d_retrieve_data> */
+    hmi3d_input_data_t result;
+    /* Buffer that contains the state after the last received data-frame */
+    hmi3d_input_data_t internal;
+    unsigned char last_time_stamp;
+    /* HMI_TIME_US when the last data-frame was received */
+    unsigned int arrival3d;
+    /* Specialized decoder for the dataOutputConfig of the last data-frame
+     * or NULL for the generic one
+     */
+    hmi3d_data_decoder_t data_decoder;
+    int data_config;
+    int data_electrodes;
+    hmi3d_filter_t pos_filter;
+    hmi3d_air_wheel_state_t air_wheel;
+    hmi3d_predictor_t predictor;
+#ifndef HMI3D_NO_CUSTOM_GESTURES
+    hmi3d_custom_t custom;
+#endif
+#ifndef HMI3D_NO_SIGNAL_STATS
+    hmi3d_stats_t signal_stats;
+#endif
+    hmi3d_noise_t noise;
+#ifndef HMI3D_NO_CALIB_SCHEDULE
+    hmi3d_calib_scheduler_t calib_scheduler;
+#endif
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Pointer to data required for synchronization (e.g. a mutex) */
+    void *io_sync;
+#endif
+#endif
+
+#ifndef HMI2D_NO_UPDATE
+    int bootloader_2d_error_code;
+    /* Count of responses and first error while streaming commands */
+    int bootloader_2d_responses;
+    int bootloader_2d_first_error;
+    hmi2d_update_job_t update2d;
+#endif
+    volatile int resp2d_msg_id;
+    volatile int resp2d_ack;
+    hmi_param_request_t * volatile param2d_request;
+    hmi2d_version_request_t * volatile version2d_request;
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+    hmi2d_input_data_t result2d;
+    hmi2d_input_data_t internal2d;
+    /* HMI_TIME_US when the last data message was received */
+    unsigned int arrival2d;
+    /* Mutual data of the last complete scans as of hmi2d_retrieve_data */
+    hmi2d_block_t mutual_raw;
+    hmi2d_block_t mutual_cal;
+    hmi2d_scan_t scan_raw;
+    hmi2d_scan_t scan_cal;
+#ifndef HMI2D_NO_TRACKING
+    /* Tracked contacts as of hmi2d_retrieve_data */
+    hmi2d_contact_list_t contacts2d;
+    hmi2d_tracker_t tracker2d;
+#endif
+#endif
+
+#if !defined(HMI2D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_DATA_RETRIEVAL)
+    /* Fused trajectory as of hmi_retrieve_fused */
+    hmi_trajectory_t trajectory;
+    hmi_fusion_t fusion;
+#endif
+
+#ifndef HMI_NO_LOGGING
+    hmi_logging_t logging;
+#endif
+#ifndef HMI_NO_RECORDER
+    hmi_recorder_t recorder;
+#endif
+    hmi_io_t io;
+#ifndef HMI3D_NO_UPDATE
+    hmi3d_update_t flash;
+    unsigned char fw_valid;
+#endif
+};
+
+/* ======== Internal Communication Implementation ======== */
+
+/* Function: hmi_message_receive
+ *
+ * Called when incoming messages should be received.
+ *
+ * timeout - Optional pointer to an integer variable containing the timeout.
+ *           This function sets timeout to the remaining time when returning.
+ *
+ * This function returns a negative error code if an error occured.
+ *
+ * If timeout is not NULL this function might return at any time with
+ * <HMI_NO_ERROR> even if no message was processed but has to
+ * return <HMI_NO_DATA> once when the timeout expired.
+ *
+ * If timeout is NULL this function *might* return <HMI_NO_DATA> if
+ * *definitely* no message was received and will return <HMI_NO_ERROR>
+ * otherwise.
+ *
+ * Typical implementations will try to read one message and forward it to
+ * <hmi3d_message_handle>. However in case of asynchronous message handling
+ * this function might do nothing except returning after a short sleep with
+ * <HMI_NO_ERROR> when timeout has a nonzero value.
+ *
+ * Note:
+ *    Custom IO implementations have to provide their own implementation
+ *    of this function.
+ *
+ * See also:
+ *    <hmi3d_message_write>, <hmi3d_message_handle>
+ */
+int hmi_message_receive(hmi_t *hmi, int *timeout);
+
+/* Function: hmi3d_message_write
+ *
+ * Writes a message to the device.
+ *
+ * msg   - The message to write to the device
+ * size  - The size of the message in bytes
+ *
+ * Returns HMI_NO_ERROR on success.
+ *
+ * Note:
+ *    Custom IO implementations have to provide their own implementation of
+ *    this function.
+ *
+ * See also:
+ *    <hmi_message_receive>
+ */
+int hmi3d_message_write(hmi_t *hmi, void *msg, int size);
+
+/* Function: hmi2d_message_write.
+ *
+ * Sends a message to the 2D subsystem.
+ *
+ * id   - ID of the message to be sent
+ * size - Size of the message
+ * msg  - The content of the message
+ *
+ * Return HMI_NO_ERROR on success or the IO implementation specific error code
+ * on failure.
+ *
+ * See also:
+ *    <hmi_message_receive>, <hmi2d_send_message>
+ */
+int hmi2d_message_write(hmi_t *hmi, int id, int size, unsigned char *msg);
+
+/* ========  Message Processing ======== */
+
+/* Function: hmi2d_message_handle
+ *
+ * Does the evaluation of received messages for the 2D subsystem.
+ *
+ * msg  - Reference to the received message.
+ *        The size of the message is stored as the second byte.
+ *
+ * This function identifies the messages and calls the appropriate handlers.
+ * The handler and the allowed message sizes are looked up in a table indexed
+ * by the message ID. Messages with an unexpected size are reported as bad
+ * data and are not passed to the handlers.
+ *
+ * See also:
+ *    <hmi_message_receive>, <hmi2d_handle_ack>, <hmi2d_handle_data_row>,
+ *    <hmi2d_handle_finger_pos>, <hmi2d_handle_mouse_btns>,
+ *    <hmi2d_handle_gesture>, <hmi2d_handle_parameter>,
+ *    <hmi2d_handle_update_response>, <hmi2d_handle_fw_version>
+ */
+void hmi2d_message_handle(hmi_t *hmi, const unsigned char *msg);
+
+/* Function: hmi3d_message_handle
+ *
+ * Does the evaluation of received messages for the 3D subsystem.
+ *
+ * msg  - Reference to the received message
+ * size - The size of the received message
+ *
+ * This function is the heart of processing of incoming messages.
+ * It decodes the messages and calls the appropriate handlers.
+ *
+ * See also:
+ *    <hmi_message_receive>, <hmi3d_handle_system_status>,
+ *    <hmi3d_handle_version_info>, <hmi3d_handle_data_output>,
+ *    <hmi3d_handle_runtime_parameter>
+ */
+void hmi3d_message_handle(hmi_t *hmi, const void *msg, int size);
+
+/* ======== Version information ======== */
+
+#define HMI_API_VERSION_MAJOR 0
+#define HMI_API_VERSION_MINOR 9
+#define HMI_API_VERSION_REVISION 1
+#define HMI_API_VERSION_STRING "0.9.1"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HMI_STATIC_H */
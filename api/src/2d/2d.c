@@ -1,123 +1,208 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#include "2d.h"
-
-void hmi2d_handle_ack(hmi_t *hmi, const unsigned char *msg)
-{
-    int size = msg[1];
-    const unsigned char *data = msg + 2;
-    if(size == 1) {
-        if(GET_U8(data) == hmi->resp2d_msg_id) {
-            hmi->resp2d_msg_id = 0;
-            hmi->resp2d_ack = 1;
-        }
-    } else {
-        HMI_BAD_DATA("hmi2d_handle_ack", "Expected message size of 1 byte",
-                     size, 0);
-    }
-}
-
-int hmi2d_wait_response(hmi_t *hmi, int id, int timeout)
-{
-    int result = HMI_NO_ERROR;
-
-    hmi->resp2d_ack = 0;
-    hmi->resp2d_msg_id = id;
-
-    for(;;) {
-        /* Receive and handle message */
-        result = hmi_message_receive(hmi, &timeout);
-        if(result != HMI_NO_ERROR) {
-            if(result == HMI_NO_DATA)
-                result = HMI_NO_RESPONSE_ERROR;
-            break;
-        }
-
-        /* Check whether we got a response */
-        if(hmi->resp2d_ack)
-            break;
-    }
-
-    return result;
-}
-
-int hmi2d_send_message(hmi_t *hmi, int id, int size, void *msg, int timeout)
-{
-    int retries;
-    int result = HMI_NO_ERROR;
-
-    for(retries = 5; retries > 0; --retries) {
-        result = hmi2d_message_write(hmi, id, size, msg);
-        if(result != HMI_NO_ERROR)
-            continue;
-
-        result = hmi2d_wait_response(hmi, id, timeout);
-        if(result == HMI_NO_ERROR)
-            break;
-    }
-    return result;
-}
-
-void hmi2d_message_handle(hmi_t *hmi, const unsigned char *msg)
-{
-    int id = GET_U8(msg);
-
-    if(0) {
-#ifndef HMI2D_NO_UPDATE
-    } else if(id == hmi2d_msg_r_update) {
-        hmi2d_handle_update_response(hmi, msg);
-#endif
-    } else if(id == hmi2d_msg_r_parameter) {
-        hmi2d_handle_parameter(hmi, msg);
-#ifndef HMI2D_NO_DATA_RETRIEVAL
-    } else if((id >= hmi2d_msg_r_mutual_raw_0) &&
-              (id <= hmi2d_msg_r_mutual_raw_f))
-    {
-        int row_idx = id - hmi2d_msg_r_mutual_raw_0;
-        hmi2d_row_t *row = &hmi->internal2d.mutual_raw[row_idx];
-        hmi2d_handle_data_row(hmi, row, msg);
-    } else if((id >= hmi2d_msg_r_mutual_cal_0) &&
-              (id <= hmi2d_msg_r_mutual_cal_f))
-    {
-        int row_idx = id - hmi2d_msg_r_mutual_cal_0;
-        hmi2d_row_t *row = &hmi->internal2d.mutual_cal[row_idx];
-        hmi2d_handle_data_row(hmi, row, msg);
-    } else if(id == hmi2d_msg_r_mouse_btns) {
-        hmi2d_handle_mouse_btns(hmi, msg);
-    } else if(id == hmi2d_msg_r_gesture) {
-        hmi2d_handle_gesture(hmi, msg);
-#endif
-    } else if(id == hmi2d_msg_r_ack) {
-        hmi2d_handle_ack(hmi, msg);
-#ifndef HMI2D_NO_DATA_RETRIEVAL
-    } else if(id == hmi2d_msg_r_finger_pos) {
-        hmi2d_handle_finger_pos(hmi, msg);
-    } else if(id == hmi2d_msg_r_self_raw) {
-        hmi2d_handle_data_row(hmi, &hmi->internal2d.self_raw, msg);
-    } else if(id == hmi2d_msg_r_self_measure) {
-        hmi2d_handle_data_row(hmi, &hmi->internal2d.self_cal, msg);
-#endif
-    } else if(id == hmi2d_msg_r_fw_version) {
-        hmi2d_handle_fw_version(hmi, msg);
-    }
-}
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d.h"
+
+void hmi2d_handle_ack(hmi_t *hmi, const unsigned char *msg)
+{
+    const unsigned char *data = msg + 2;
+    if(GET_U8(data) == hmi->resp2d_msg_id) {
+        hmi->resp2d_msg_id = 0;
+        hmi->resp2d_ack = 1;
+    }
+}
+
+int hmi2d_wait_response(hmi_t *hmi, int id, int timeout)
+{
+    int result = HMI_NO_ERROR;
+
+    hmi->resp2d_ack = 0;
+    hmi->resp2d_msg_id = id;
+
+    for(;;) {
+        /* Receive and handle message */
+        result = hmi_message_receive(hmi, &timeout);
+        if(result != HMI_NO_ERROR) {
+            if(result == HMI_NO_DATA)
+                result = HMI_NO_RESPONSE_ERROR;
+            break;
+        }
+
+        /* Check whether we got a response */
+        if(hmi->resp2d_ack)
+            break;
+    }
+
+    return result;
+}
+
+int hmi2d_send_message(hmi_t *hmi, int id, int size, void *msg, int timeout)
+{
+    int retries;
+    int result = HMI_NO_ERROR;
+
+    for(retries = 5; retries > 0; --retries) {
+        result = hmi2d_message_write(hmi, id, size, msg);
+        if(result != HMI_NO_ERROR)
+            continue;
+
+        result = hmi2d_wait_response(hmi, id, timeout);
+        if(result == HMI_NO_ERROR)
+            break;
+    }
+    return result;
+}
+
+/* Handler for one message ID with the allowed range of message sizes */
+typedef struct {
+    void (*handler)(hmi_t *hmi, const unsigned char *msg);
+    unsigned char min_size;
+    unsigned char max_size;
+} hmi2d_msg_entry_t;
+
+#define MSG_NONE { 0, 0, 0 }
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+
+static void hmi2d_handle_mutual_raw(hmi_t *hmi, const unsigned char *msg)
+{
+    int row_idx = GET_U8(msg) - hmi2d_msg_r_mutual_raw_0;
+    hmi2d_handle_mutual_row(hmi, &hmi->scan_raw, row_idx, msg);
+}
+
+static void hmi2d_handle_mutual_cal(hmi_t *hmi, const unsigned char *msg)
+{
+    int row_idx = GET_U8(msg) - hmi2d_msg_r_mutual_cal_0;
+    hmi2d_handle_mutual_row(hmi, &hmi->scan_cal, row_idx, msg);
+}
+
+static void hmi2d_handle_self_raw(hmi_t *hmi, const unsigned char *msg)
+{
+    hmi2d_handle_data_row(hmi, &hmi->internal2d.self_raw,
+                          hmi2d_section_self_raw, msg);
+}
+
+static void hmi2d_handle_self_measure(hmi_t *hmi, const unsigned char *msg)
+{
+    hmi2d_handle_data_row(hmi, &hmi->internal2d.self_cal,
+                          hmi2d_section_self_cal, msg);
+}
+
+#   define MSG_MUTUAL_RAW   { hmi2d_handle_mutual_raw, 2, 255 }
+#   define MSG_MUTUAL_CAL   { hmi2d_handle_mutual_cal, 2, 255 }
+#   define MSG_MOUSE_BTNS   { hmi2d_handle_mouse_btns, 1, 1 }
+#   define MSG_GESTURE      { hmi2d_handle_gesture, 1, 1 }
+#   define MSG_FINGER_POS   { hmi2d_handle_finger_pos, 0, 255 }
+#   define MSG_SELF_RAW     { hmi2d_handle_self_raw, 2, 255 }
+#   define MSG_SELF_MEASURE { hmi2d_handle_self_measure, 2, 255 }
+#else
+#   define MSG_MUTUAL_RAW   MSG_NONE
+#   define MSG_MUTUAL_CAL   MSG_NONE
+#   define MSG_MOUSE_BTNS   MSG_NONE
+#   define MSG_GESTURE      MSG_NONE
+#   define MSG_FINGER_POS   MSG_NONE
+#   define MSG_SELF_RAW     MSG_NONE
+#   define MSG_SELF_MEASURE MSG_NONE
+#endif
+
+#ifndef HMI2D_NO_UPDATE
+#   define MSG_UPDATE       { hmi2d_handle_update_response, 1, 1 }
+#else
+#   define MSG_UPDATE       MSG_NONE
+#endif
+
+#define MSG_PARAMETER       { hmi2d_handle_parameter, 3, 6 }
+#define MSG_ACK             { hmi2d_handle_ack, 1, 1 }
+#define MSG_FW_VERSION      { hmi2d_handle_fw_version, 128, 128 }
+
+#define MSG_NONE_4  MSG_NONE, MSG_NONE, MSG_NONE, MSG_NONE
+#define MSG_NONE_16 MSG_NONE_4, MSG_NONE_4, MSG_NONE_4, MSG_NONE_4
+#define MSG_MUTUAL_RAW_4 MSG_MUTUAL_RAW, MSG_MUTUAL_RAW, \
+                         MSG_MUTUAL_RAW, MSG_MUTUAL_RAW
+#define MSG_MUTUAL_CAL_4 MSG_MUTUAL_CAL, MSG_MUTUAL_CAL, \
+                         MSG_MUTUAL_CAL, MSG_MUTUAL_CAL
+
+/* Handlers of all received messages indexed by the message ID.
+ * Messages with other IDs (e.g. <hmi2d_msg_r_3d_subsystem>) are ignored.
+ */
+static const hmi2d_msg_entry_t hmi2d_msg_table[] = {
+    /* 0x00 */ MSG_NONE_16,
+    /* 0x10 */ MSG_NONE_16,
+    /* 0x20 */ MSG_NONE_16,
+    /* 0x30 */ MSG_NONE_16,
+    /* 0x40 */ MSG_NONE_16,
+    /* 0x50 */ MSG_NONE_4, MSG_NONE, MSG_UPDATE, MSG_NONE, MSG_NONE,
+    /* 0x58 */ MSG_NONE_4, MSG_NONE_4,
+    /* 0x60 */ MSG_NONE_16,
+    /* 0x70 */ MSG_NONE_16,
+    /* 0x80 */ MSG_NONE_16,
+    /* 0x90 */ MSG_NONE_16,
+    /* 0xA0 */ MSG_NONE_16,
+    /* 0xB0 */ MSG_NONE_16,
+    /* 0xC0 */ MSG_NONE_4, MSG_NONE_4,
+    /* 0xC8 */ MSG_NONE_4, MSG_NONE, MSG_NONE, MSG_NONE, MSG_PARAMETER,
+    /* 0xD0 */ MSG_MUTUAL_RAW_4, MSG_MUTUAL_RAW_4,
+    /* 0xD8 */ MSG_MUTUAL_RAW_4, MSG_MUTUAL_RAW_4,
+    /* 0xE0 */ MSG_MUTUAL_CAL_4, MSG_MUTUAL_CAL_4,
+    /* 0xE8 */ MSG_MUTUAL_CAL_4, MSG_MUTUAL_CAL_4,
+    /* 0xF0 */ MSG_ACK, MSG_NONE, MSG_NONE, MSG_NONE,
+    /* 0xF4 */ MSG_NONE, MSG_NONE, MSG_MOUSE_BTNS, MSG_GESTURE,
+    /* 0xF8 */ MSG_FINGER_POS, MSG_NONE, MSG_SELF_RAW, MSG_NONE,
+    /* 0xFC */ MSG_NONE, MSG_SELF_MEASURE, MSG_NONE, MSG_FW_VERSION
+};
+
+/* Compilation fails when the table does not cover exactly 256 IDs */
+typedef char hmi2d_msg_table_check[
+        sizeof(hmi2d_msg_table) / sizeof(hmi2d_msg_table[0]) == 256 ? 1 : -1];
+
+void hmi2d_message_handle(hmi_t *hmi, const unsigned char *msg)
+{
+    const hmi2d_msg_entry_t *entry = &hmi2d_msg_table[GET_U8(msg)];
+    int size = GET_U8(msg + 1);
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+    int counter;
+#endif
+
+#ifndef HMI_NO_RECORDER
+    hmi_recorder_add(hmi, hmi_rec_2d_message, msg, size + 2);
+#endif
+
+    if(!entry->handler)
+        return;
+
+    if(size < entry->min_size || size > entry->max_size) {
+        HMI_REPORT_BAD_DATA(hmi, "hmi2d_message_handle",
+                            "Unexpected message size",
+                            GET_U8(msg), size);
+        return;
+    }
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+    counter = hmi->internal2d.msg_counter;
+    entry->handler(hmi, msg);
+    /* Data messages advance the counter and are timed for fused results */
+    if(hmi->internal2d.msg_counter != counter)
+        hmi->arrival2d = HMI_TIME_US();
+#else
+    entry->handler(hmi, msg);
+#endif
+}
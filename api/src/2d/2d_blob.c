@@ -0,0 +1,276 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d.h"
+
+#ifndef HMI2D_NO_DATA_RETRIEVAL
+
+#if !defined(HMI2D_NO_SIMD)
+#   if defined(__SSE2__)
+#       include <emmintrin.h>
+#       define HMI2D_BLOB_SSE2
+#   elif defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN)
+#       include <arm_neon.h>
+#       define HMI2D_BLOB_NEON
+#   endif
+#endif
+
+#if defined(__GNUC__)
+#   define blob_ctz(X) __builtin_ctz(X)
+#else
+static int blob_ctz(unsigned int x)
+{
+    int n = 0;
+    while(!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+}
+#endif
+
+/* Builds one bit mask per row of the electrodes at or above the threshold */
+static void threshold_rows(const hmi2d_heatmap_t *heatmap,
+                           unsigned short threshold,
+                           unsigned int *mask)
+{
+#if defined(HMI2D_BLOB_SSE2)
+    /* SSE2 lacks unsigned compares, but value >= threshold exactly when
+     * the saturated difference threshold - value is zero.
+     */
+    __m128i thr = _mm_set1_epi16((short)threshold);
+    __m128i zero = _mm_setzero_si128();
+    int row;
+
+    for(row = 0; row < 16; ++row) {
+        const __m128i *value = (const __m128i *)heatmap->value[row];
+        __m128i lo = _mm_subs_epu16(thr, _mm_loadu_si128(value));
+        __m128i hi = _mm_subs_epu16(thr, _mm_loadu_si128(value + 1));
+        lo = _mm_cmpeq_epi16(lo, zero);
+        hi = _mm_cmpeq_epi16(hi, zero);
+        mask[row] = _mm_movemask_epi8(_mm_packs_epi16(lo, hi));
+    }
+#elif defined(HMI2D_BLOB_NEON)
+    static const uint16_t bits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint16x8_t weight = vld1q_u16(bits);
+    uint16x8_t thr = vdupq_n_u16(threshold);
+    int row;
+
+    for(row = 0; row < 16; ++row) {
+        const uint16_t *value = heatmap->value[row];
+        uint16x8_t lo = vandq_u16(vcgeq_u16(vld1q_u16(value), thr), weight);
+        uint16x8_t hi = vandq_u16(vcgeq_u16(vld1q_u16(value + 8), thr),
+                                  weight);
+        mask[row] = vaddvq_u16(lo) | (vaddvq_u16(hi) << 8);
+    }
+#else
+    int row, col;
+
+    for(row = 0; row < 16; ++row) {
+        mask[row] = 0;
+        for(col = 0; col < 16; ++col) {
+            if(heatmap->value[row][col] >= threshold)
+                mask[row] |= 1u << col;
+        }
+    }
+#endif
+}
+
+/* Extends the seed bits to the complete runs of the mask they are part of */
+static unsigned int fill_runs(unsigned int mask, unsigned int seed)
+{
+    unsigned int last;
+
+    seed &= mask;
+    do {
+        last = seed;
+        seed = (seed | (seed << 1) | (seed >> 1)) & mask;
+    } while(seed != last);
+
+    return seed;
+}
+
+/* Grows the seed in blob until it covers its connected area of mask.
+ *
+ * Every row is a bit mask, so one step extends the blob by a complete row.
+ * Alternating downward and upward passes reach the final area after a few
+ * passes even for curved shapes.
+ */
+static void fill_blob(const unsigned int *mask, unsigned int *blob,
+                      int diagonal)
+{
+    int changed, row, step, end;
+
+    do {
+        changed = 0;
+        for(step = 1; step >= -1; step -= 2) {
+            row = (step > 0) ? 0 : 15;
+            end = (step > 0) ? 16 : -1;
+            for(; row != end; row += step) {
+                unsigned int near = 0, grown;
+
+                if(row > 0)
+                    near |= blob[row - 1];
+                if(row < 15)
+                    near |= blob[row + 1];
+                if(diagonal)
+                    near |= (near << 1) | (near >> 1);
+
+                grown = fill_runs(mask[row], blob[row] | near);
+                if(grown != blob[row]) {
+                    blob[row] = grown;
+                    changed = 1;
+                }
+            }
+        }
+    } while(changed);
+}
+
+/* Computes area, bounding box and weighted centroid of a blob */
+static void measure_blob(const hmi2d_heatmap_t *heatmap,
+                         unsigned short threshold,
+                         const unsigned int *blob,
+                         hmi2d_blob_t *result)
+{
+    unsigned int columns = 0;
+    double sum_x = 0, sum_y = 0;
+    unsigned int weight = 0;
+    unsigned short peak = 0;
+    int area = 0;
+    int top = -1, bottom = 0, right;
+    int row;
+
+    for(row = 0; row < 16; ++row) {
+        unsigned int bits = blob[row];
+        unsigned int row_weight = 0;
+        unsigned int row_x = 0;
+
+        if(!bits)
+            continue;
+        if(top < 0)
+            top = row;
+        bottom = row;
+        columns |= bits;
+
+        for(; bits; bits &= bits - 1) {
+            int col = blob_ctz(bits);
+            unsigned short value = heatmap->value[row][col];
+            unsigned int w = value - threshold + 1u;
+
+            row_weight += w;
+            row_x += w * col;
+            if(value > peak)
+                peak = value;
+            ++area;
+        }
+
+        weight += row_weight;
+        sum_x += row_x;
+        sum_y += (double)row_weight * row;
+    }
+
+    for(right = 15; !(columns & (1u << right)); --right)
+        ;
+
+    result->x = (int)(sum_x * 256.0 / weight + 0.5);
+    result->y = (int)(sum_y * 256.0 / weight + 0.5);
+    result->area = area;
+    result->weight = weight;
+    result->peak = peak;
+    result->left = (unsigned char)blob_ctz(columns);
+    result->top = (unsigned char)top;
+    result->right = (unsigned char)right;
+    result->bottom = (unsigned char)bottom;
+}
+
+/* Checks whether a blob is larger than a finger */
+static int is_palm(const hmi2d_blob_config_t *config,
+                   const hmi2d_blob_t *blob)
+{
+    if(config->palm_area > 0 && blob->area >= config->palm_area)
+        return 1;
+
+    if(config->palm_extent > 0 &&
+            (blob->right - blob->left + 1 >= config->palm_extent ||
+             blob->bottom - blob->top + 1 >= config->palm_extent))
+        return 1;
+
+    return 0;
+}
+
+int hmi2d_find_blobs(const hmi2d_heatmap_t *heatmap,
+                     const hmi2d_blob_config_t *config,
+                     hmi2d_blob_list_t *blobs)
+{
+    unsigned int mask[16];
+    unsigned int blob[16];
+    hmi2d_blob_t result;
+    int row = 0;
+
+    HMI_ASSERT(heatmap && config && blobs);
+
+    if(config->threshold < 1)
+        return HMI_BAD_PARAM_ERROR;
+
+    blobs->count = 0;
+    blobs->touches = 0;
+    blobs->dropped = 0;
+
+    threshold_rows(heatmap, config->threshold, mask);
+
+    for(;;) {
+        int i;
+
+        /* Seed the next blob at the first remaining electrode */
+        while(row < 16 && !mask[row])
+            ++row;
+        if(row == 16)
+            break;
+
+        HMI_MEMSET(blob, 0, sizeof(blob));
+        blob[row] = mask[row] & (~mask[row] + 1);
+        fill_blob(mask, blob, config->diagonal);
+
+        for(i = row; i < 16; ++i)
+            mask[i] &= ~blob[i];
+
+        measure_blob(heatmap, config->threshold, blob, &result);
+
+        if(result.area < config->min_area)
+            continue;
+
+        result.palm = (unsigned char)is_palm(config, &result);
+
+        if(blobs->count == HMI2D_MAX_BLOBS) {
+            blobs->dropped++;
+            continue;
+        }
+
+        blobs->entry[blobs->count++] = result;
+        if(!result.palm)
+            blobs->touches++;
+    }
+
+    return HMI_NO_ERROR;
+}
+
+#endif
@@ -1,218 +1,768 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#include "2d.h"
-
-#ifndef HMI_NO_DATA_RETRIEVAL
-
-void hmi2d_handle_data_row(hmi_t *hmi,
-                           hmi2d_row_t *row,
-                           const unsigned char *msg)
-{
-    int size = msg[1];
-    const unsigned char *data = msg + 2;
-    unsigned short mask = (size >= 2) ? GET_U16(data) : 0;
-    const unsigned char *cursor = data + 2;
-    int i;
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Synchronize against hmi2d_retrieve_data calls from application */
-    HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-    hmi->internal2d.msg_counter++;
-
-    for(i = 0; i < 16; ++i) {
-        if(mask & (1 << i)) {
-            if(cursor + 1 - data >= size) {
-                HMI_BAD_DATA("hmi2d_handle_mutual_raw",
-                             "Mask doesn't fit available entries",
-                             mask, (size-2) / 2);
-                break;
-            }
-            (*row)[i] = GET_U16(cursor);
-            cursor += 2;
-        } else {
-            (*row)[i] = 0;
-        }
-    }
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Release synchronization against hmi2d_retrieve_data */
-    HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-}
-
-void hmi2d_handle_finger_pos(hmi_t *hmi, const unsigned char *msg)
-{
-    int size = msg[1];
-    int i;
-    int count = size / 4;
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Synchronize against hmi2d_retrieve_data calls from application */
-    HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-    hmi->internal2d.msg_counter++;
-
-    if(count > 10) {
-        HMI_BAD_DATA("hmi2d_handle_finger_pos",
-                     "Message contains more than 10 finger positions",
-                     count, 0);
-        count = 10;
-    }
-
-    for(i = 0; i < count; ++i) {
-        unsigned int v = GET_U32(msg + 2 + 4*i);
-        hmi->internal2d.fingers.entry[i].finger_id = v & 0xFF;
-        hmi->internal2d.fingers.entry[i].x = (v >> 20) & 0xFFF;
-        hmi->internal2d.fingers.entry[i].y = (v >> 8) & 0xFFF;
-    }
-    hmi->internal2d.fingers.count = count;
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Release synchronization against hmi2d_retrieve_data */
-    HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-}
-
-void hmi2d_handle_mouse_btns(hmi_t *hmi, const unsigned char *msg)
-{
-    int size = msg[1];
-    int state, old_state;
-
-    if(size != 1) {
-        HMI_BAD_DATA("hmi2d_handle_mouse_btns",
-                     "Expected message of 1 byte",
-                     size, 0);
-        return;
-    }
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Synchronize against hmi2d_retrieve_data calls from application */
-    HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-    hmi->internal2d.msg_counter++;
-
-    state = GET_U8(msg + 2);
-    old_state = hmi->internal2d.mouse.button_state;
-    hmi->internal2d.mouse.button_state = state;
-    hmi->internal2d.mouse.press_event |= state & ~old_state;
-    hmi->internal2d.mouse.release_event |= old_state & ~state;
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Release synchronization against hmi2d_retrieve_data */
-    HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-}
-
-void hmi2d_handle_gesture(hmi_t *hmi, const unsigned char *msg)
-{
-    int size = msg[1];
-
-    if(size != 1) {
-        HMI_BAD_DATA("hmi2d_handle_gesture",
-                     "Expected message of 1 byte",
-                     size, 0);
-        return;
-    }
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Synchronize against hmi2d_retrieve_data calls from application */
-    HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-    hmi->internal2d.msg_counter++;
-
-    hmi->internal2d.gesture.gesture = GET_U8(msg + 2);
-    hmi->internal2d.last_gesture = hmi->internal2d.msg_counter;
-
-#ifdef HMI3D_SYNC_THREADING
-    /* Release synchronization against hmi2d_retrieve_data */
-    HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-}
-
-int hmi2d_retrieve_data(hmi_t *hmi)
-{
-    int count;
-    int result = HMI_NO_DATA;
-    int last_counter, current_counter;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    last_counter = hmi->result2d.msg_counter;
-
-#if defined(HMI3D_SYNC_INTERRUPT) || defined(HMI3D_SYNC_THREADING)
-    /* Synchronize against changes of internal buffer from message-handlers */
-    HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-    for(;;) {
-        /* Check whether new data are available */
-        current_counter = hmi->internal2d.msg_counter;
-        count = current_counter - last_counter;
-        if(count > 0)
-            break;
-
-#if defined(HMI3D_SYNC_INTERRUPT) || defined(HMI3D_SYNC_THREADING)
-        /* Temporarily release synchronization */
-        HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-
-        /* Receive and handle message */
-        result = hmi_message_receive(hmi, NULL);
-
-#if defined(HMI3D_SYNC_INTERRUPT) || defined(HMI3D_SYNC_THREADING)
-        /* Relock after message handling */
-        HMI_SYNC_LOCK(hmi->io_sync);
-#endif
-
-        if(result != HMI_NO_ERROR)
-            break;
-    }
-
-    if(count > 0) {
-        hmi->result2d = hmi->internal2d;
-
-        /* Reset button-events */
-        hmi->internal2d.mouse.press_event = 0;
-        hmi->internal2d.mouse.release_event = 0;
-
-        /* Reset gestures */
-        if(hmi->result2d.last_gesture <= last_counter)
-            hmi->result2d.gesture.gesture = 0;
-
-        result = HMI_NO_ERROR;
-    }
-
-#if defined(HMI3D_SYNC_INTERRUPT) || defined(HMI3D_SYNC_THREADING)
-    /* Release synchronization against message-handlers */
-    HMI_SYNC_UNLOCK(hmi->io_sync);
-#endif
-
-    return result;
-}
-
-#endif
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d.h"
+
+#ifndef HMI_NO_DATA_RETRIEVAL
+
+#if !defined(HMI2D_NO_SIMD)
+#   if defined(__SSSE3__)
+#       include <tmmintrin.h>
+#       define HMI2D_ROW_SHUFFLE
+#   elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#       include <arm_neon.h>
+#       define HMI2D_ROW_SHUFFLE
+#   endif
+#endif
+
+#if defined(__GNUC__)
+#   define row_popcount(X) __builtin_popcount(X)
+#else
+static int row_popcount(unsigned int x)
+{
+    x = x - ((x >> 1) & 0x5555);
+    x = (x & 0x3333) + ((x >> 2) & 0x3333);
+    x = (x + (x >> 4)) & 0x0F0F;
+    return (x + (x >> 8)) & 0x1F;
+}
+#endif
+
+#ifdef HMI2D_ROW_SHUFFLE
+
+/* Byte shuffle controls for the expansion of packed row entries.
+ *
+ * row_shuffle[m] moves the n-th packed 16-bit entry to the lane of the n-th
+ * set bit of the 8-bit mask m. Lanes of cleared bits use index 128 which
+ * yields zero for both SSSE3 pshufb and NEON tbl.
+ */
+static const unsigned char row_shuffle[256][16] = {
+    {128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128},
+    {  0,  1,128,128,128,128,128,128,128,128,128,128,128,128,128,128},
+    {128,128,  0,  1,128,128,128,128,128,128,128,128,128,128,128,128},
+    {  0,  1,  2,  3,128,128,128,128,128,128,128,128,128,128,128,128},
+    {128,128,128,128,  0,  1,128,128,128,128,128,128,128,128,128,128},
+    {  0,  1,128,128,  2,  3,128,128,128,128,128,128,128,128,128,128},
+    {128,128,  0,  1,  2,  3,128,128,128,128,128,128,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,128,128,128,128},
+    {128,128,128,128,128,128,  0,  1,128,128,128,128,128,128,128,128},
+    {  0,  1,128,128,128,128,  2,  3,128,128,128,128,128,128,128,128},
+    {128,128,  0,  1,128,128,  2,  3,128,128,128,128,128,128,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,128,128,128,128},
+    {128,128,128,128,  0,  1,  2,  3,128,128,128,128,128,128,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,128,128,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,128,128,128,128},
+    {128,128,128,128,128,128,128,128,  0,  1,128,128,128,128,128,128},
+    {  0,  1,128,128,128,128,128,128,  2,  3,128,128,128,128,128,128},
+    {128,128,  0,  1,128,128,128,128,  2,  3,128,128,128,128,128,128},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,128,128,128,128},
+    {128,128,128,128,  0,  1,128,128,  2,  3,128,128,128,128,128,128},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,128,128,128,128},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,128,128,128,128},
+    {128,128,128,128,128,128,  0,  1,  2,  3,128,128,128,128,128,128},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,128,128,128,128},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,128,128,128,128},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,128,128,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128,128,128,128,128},
+    {128,128,128,128,128,128,128,128,128,128,  0,  1,128,128,128,128},
+    {  0,  1,128,128,128,128,128,128,128,128,  2,  3,128,128,128,128},
+    {128,128,  0,  1,128,128,128,128,128,128,  2,  3,128,128,128,128},
+    {  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,128,128,128,128},
+    {128,128,128,128,  0,  1,128,128,128,128,  2,  3,128,128,128,128},
+    {  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,128,128,128,128},
+    {128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,128,128,128,128},
+    {128,128,128,128,128,128,  0,  1,128,128,  2,  3,128,128,128,128},
+    {  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,128,128,128,128},
+    {128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,128,128,128,128},
+    {128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,128,128,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9,128,128,128,128},
+    {128,128,128,128,128,128,128,128,  0,  1,  2,  3,128,128,128,128},
+    {  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,128,128,128,128},
+    {128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,128,128},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,128,128,128,128},
+    {128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,128,128},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,128,128,128,128},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9,128,128,128,128},
+    {128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,128,128},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,128,128,128,128},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9,128,128,128,128},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9,128,128,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,128,128,128,128},
+    {128,128,128,128,128,128,128,128,128,128,128,128,  0,  1,128,128},
+    {  0,  1,128,128,128,128,128,128,128,128,128,128,  2,  3,128,128},
+    {128,128,  0,  1,128,128,128,128,128,128,128,128,  2,  3,128,128},
+    {  0,  1,  2,  3,128,128,128,128,128,128,128,128,  4,  5,128,128},
+    {128,128,128,128,  0,  1,128,128,128,128,128,128,  2,  3,128,128},
+    {  0,  1,128,128,  2,  3,128,128,128,128,128,128,  4,  5,128,128},
+    {128,128,  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,  6,  7,128,128},
+    {128,128,128,128,128,128,  0,  1,128,128,128,128,  2,  3,128,128},
+    {  0,  1,128,128,128,128,  2,  3,128,128,128,128,  4,  5,128,128},
+    {128,128,  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,  6,  7,128,128},
+    {128,128,128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,  6,  7,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,  8,  9,128,128},
+    {128,128,128,128,128,128,128,128,  0,  1,128,128,  2,  3,128,128},
+    {  0,  1,128,128,128,128,128,128,  2,  3,128,128,  4,  5,128,128},
+    {128,128,  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,128,128},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,  6,  7,128,128},
+    {128,128,128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,128,128},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,  6,  7,128,128},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,  8,  9,128,128},
+    {128,128,128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,128,128},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,  6,  7,128,128},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,  8,  9,128,128},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,  8,  9,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128, 10, 11,128,128},
+    {128,128,128,128,128,128,128,128,128,128,  0,  1,  2,  3,128,128},
+    {  0,  1,128,128,128,128,128,128,128,128,  2,  3,  4,  5,128,128},
+    {128,128,  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,128,128},
+    {  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,  6,  7,128,128},
+    {128,128,128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,128,128},
+    {  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,  6,  7,128,128},
+    {128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,  8,  9,128,128},
+    {128,128,128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,128,128},
+    {  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,  6,  7,128,128},
+    {128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,  8,  9,128,128},
+    {128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,  8,  9,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9, 10, 11,128,128},
+    {128,128,128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,128,128},
+    {  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,  6,  7,128,128},
+    {128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,128,128},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,  8,  9,128,128},
+    {128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,  8,  9,128,128},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9,128,128},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9, 10, 11,128,128},
+    {128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,  8,  9,128,128},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9,128,128},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9, 10, 11,128,128},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,128,128},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,128,128},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,128,128},
+    {128,128,128,128,128,128,128,128,128,128,128,128,128,128,  0,  1},
+    {  0,  1,128,128,128,128,128,128,128,128,128,128,128,128,  2,  3},
+    {128,128,  0,  1,128,128,128,128,128,128,128,128,128,128,  2,  3},
+    {  0,  1,  2,  3,128,128,128,128,128,128,128,128,128,128,  4,  5},
+    {128,128,128,128,  0,  1,128,128,128,128,128,128,128,128,  2,  3},
+    {  0,  1,128,128,  2,  3,128,128,128,128,128,128,128,128,  4,  5},
+    {128,128,  0,  1,  2,  3,128,128,128,128,128,128,128,128,  4,  5},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,128,128,  6,  7},
+    {128,128,128,128,128,128,  0,  1,128,128,128,128,128,128,  2,  3},
+    {  0,  1,128,128,128,128,  2,  3,128,128,128,128,128,128,  4,  5},
+    {128,128,  0,  1,128,128,  2,  3,128,128,128,128,128,128,  4,  5},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,128,128,  6,  7},
+    {128,128,128,128,  0,  1,  2,  3,128,128,128,128,128,128,  4,  5},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,128,128,  6,  7},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,  6,  7},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,128,128,  8,  9},
+    {128,128,128,128,128,128,128,128,  0,  1,128,128,128,128,  2,  3},
+    {  0,  1,128,128,128,128,128,128,  2,  3,128,128,128,128,  4,  5},
+    {128,128,  0,  1,128,128,128,128,  2,  3,128,128,128,128,  4,  5},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,128,128,  6,  7},
+    {128,128,128,128,  0,  1,128,128,  2,  3,128,128,128,128,  4,  5},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,128,128,  6,  7},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,  6,  7},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,128,128,  8,  9},
+    {128,128,128,128,128,128,  0,  1,  2,  3,128,128,128,128,  4,  5},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,128,128,  6,  7},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,  6,  7},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,128,128,  8,  9},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,128,128,  8,  9},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,  8,  9},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128,128,128, 10, 11},
+    {128,128,128,128,128,128,128,128,128,128,  0,  1,128,128,  2,  3},
+    {  0,  1,128,128,128,128,128,128,128,128,  2,  3,128,128,  4,  5},
+    {128,128,  0,  1,128,128,128,128,128,128,  2,  3,128,128,  4,  5},
+    {  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,128,128,  6,  7},
+    {128,128,128,128,  0,  1,128,128,128,128,  2,  3,128,128,  4,  5},
+    {  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,128,128,  6,  7},
+    {128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,  6,  7},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,128,128,  8,  9},
+    {128,128,128,128,128,128,  0,  1,128,128,  2,  3,128,128,  4,  5},
+    {  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,128,128,  6,  7},
+    {128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,  6,  7},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,128,128,  8,  9},
+    {128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,128,128,  8,  9},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,  8,  9},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9,128,128, 10, 11},
+    {128,128,128,128,128,128,128,128,  0,  1,  2,  3,128,128,  4,  5},
+    {  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,128,128,  6,  7},
+    {128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,  6,  7},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,128,128,  8,  9},
+    {128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,128,128,  8,  9},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,  8,  9},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9,128,128, 10, 11},
+    {128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,128,128,  8,  9},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,  8,  9},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9,128,128, 10, 11},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9,128,128, 10, 11},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128, 10, 11},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,128,128, 12, 13},
+    {128,128,128,128,128,128,128,128,128,128,128,128,  0,  1,  2,  3},
+    {  0,  1,128,128,128,128,128,128,128,128,128,128,  2,  3,  4,  5},
+    {128,128,  0,  1,128,128,128,128,128,128,128,128,  2,  3,  4,  5},
+    {  0,  1,  2,  3,128,128,128,128,128,128,128,128,  4,  5,  6,  7},
+    {128,128,128,128,  0,  1,128,128,128,128,128,128,  2,  3,  4,  5},
+    {  0,  1,128,128,  2,  3,128,128,128,128,128,128,  4,  5,  6,  7},
+    {128,128,  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,  6,  7},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,128,128,  6,  7,  8,  9},
+    {128,128,128,128,128,128,  0,  1,128,128,128,128,  2,  3,  4,  5},
+    {  0,  1,128,128,128,128,  2,  3,128,128,128,128,  4,  5,  6,  7},
+    {128,128,  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,  6,  7},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,128,128,  6,  7,  8,  9},
+    {128,128,128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,128,128,  6,  7,  8,  9},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,  8,  9},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,128,128,  8,  9, 10, 11},
+    {128,128,128,128,128,128,128,128,  0,  1,128,128,  2,  3,  4,  5},
+    {  0,  1,128,128,128,128,128,128,  2,  3,128,128,  4,  5,  6,  7},
+    {128,128,  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,  6,  7},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,128,128,  6,  7,  8,  9},
+    {128,128,128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,128,128,  6,  7,  8,  9},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,  8,  9},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,128,128,  8,  9, 10, 11},
+    {128,128,128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,128,128,  6,  7,  8,  9},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,  8,  9},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,128,128,  8,  9, 10, 11},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,128,128,  8,  9, 10, 11},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9, 10, 11},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,128,128, 10, 11, 12, 13},
+    {128,128,128,128,128,128,128,128,128,128,  0,  1,  2,  3,  4,  5},
+    {  0,  1,128,128,128,128,128,128,128,128,  2,  3,  4,  5,  6,  7},
+    {128,128,  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,  6,  7},
+    {  0,  1,  2,  3,128,128,128,128,128,128,  4,  5,  6,  7,  8,  9},
+    {128,128,128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7},
+    {  0,  1,128,128,  2,  3,128,128,128,128,  4,  5,  6,  7,  8,  9},
+    {128,128,  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,  8,  9},
+    {  0,  1,  2,  3,  4,  5,128,128,128,128,  6,  7,  8,  9, 10, 11},
+    {128,128,128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7},
+    {  0,  1,128,128,128,128,  2,  3,128,128,  4,  5,  6,  7,  8,  9},
+    {128,128,  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,  8,  9},
+    {  0,  1,  2,  3,128,128,  4,  5,128,128,  6,  7,  8,  9, 10, 11},
+    {128,128,128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9},
+    {  0,  1,128,128,  2,  3,  4,  5,128,128,  6,  7,  8,  9, 10, 11},
+    {128,128,  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9, 10, 11},
+    {  0,  1,  2,  3,  4,  5,  6,  7,128,128,  8,  9, 10, 11, 12, 13},
+    {128,128,128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7},
+    {  0,  1,128,128,128,128,128,128,  2,  3,  4,  5,  6,  7,  8,  9},
+    {128,128,  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,  8,  9},
+    {  0,  1,  2,  3,128,128,128,128,  4,  5,  6,  7,  8,  9, 10, 11},
+    {128,128,128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9},
+    {  0,  1,128,128,  2,  3,128,128,  4,  5,  6,  7,  8,  9, 10, 11},
+    {128,128,  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9, 10, 11},
+    {  0,  1,  2,  3,  4,  5,128,128,  6,  7,  8,  9, 10, 11, 12, 13},
+    {128,128,128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9},
+    {  0,  1,128,128,128,128,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11},
+    {128,128,  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11},
+    {  0,  1,  2,  3,128,128,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13},
+    {128,128,128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11},
+    {  0,  1,128,128,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13},
+    {128,128,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13},
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15}
+};
+
+/* Expands the packed entries for 8 mask bits into 8 16-bit values */
+static void expand_entries(unsigned short *values,
+                           const unsigned char *packed,
+                           unsigned int mask)
+{
+#if defined(__SSSE3__)
+    __m128i data = _mm_loadu_si128((const __m128i *)packed);
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)row_shuffle[mask]);
+    _mm_storeu_si128((__m128i *)values, _mm_shuffle_epi8(data, ctrl));
+#elif defined(__aarch64__)
+    uint8x16_t data = vld1q_u8(packed);
+    uint8x16_t ctrl = vld1q_u8(row_shuffle[mask]);
+    vst1q_u16(values, vreinterpretq_u16_u8(vqtbl1q_u8(data, ctrl)));
+#else
+    uint8x8x2_t data;
+    uint8x16_t ctrl = vld1q_u8(row_shuffle[mask]);
+    data.val[0] = vld1_u8(packed);
+    data.val[1] = vld1_u8(packed + 8);
+    vst1q_u16(values, vreinterpretq_u16_u8(
+                  vcombine_u8(vtbl2_u8(data, vget_low_u8(ctrl)),
+                              vtbl2_u8(data, vget_high_u8(ctrl)))));
+#endif
+}
+
+#elif defined(__GNUC__)
+#   define row_ctz(X) __builtin_ctz(X)
+#else
+static int row_ctz(unsigned int x)
+{
+    int n = 0;
+    while(!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+}
+#endif
+
+/* Decodes the entries of a row message selected by its 16-bit mask.
+ * Entries that are not part of the message are set to zero.
+ *
+ * The number of entries is known from the population count of the mask,
+ * so incomplete messages are detected before decoding. With SSSE3 or NEON
+ * each half of the mask expands its packed entries with a single byte
+ * shuffle, otherwise the set bits are visited directly.
+ */
+static void decode_row(hmi_t *hmi, unsigned short *values,
+                       const unsigned char *msg)
+{
+    int size = msg[1];
+    const unsigned char *data = msg + 2;
+    unsigned int mask = (size >= 2) ? GET_U16(data) : 0;
+    int available = (size >= 2) ? (size - 2) / 2 : 0;
+    int entries = row_popcount(mask);
+    unsigned int low;
+#ifdef HMI2D_ROW_SHUFFLE
+    unsigned char packed[32] = { 0 };
+#else
+    const unsigned char *cursor = data + 2;
+#endif
+
+    if(entries > available) {
+        HMI_REPORT_BAD_DATA(hmi, "hmi2d_handle_data_row",
+                            "Mask doesn't fit available entries",
+                            mask, available);
+        /* Keep the mask bits of the entries that are part of the message */
+        low = 0;
+        while(available-- > 0) {
+            low |= mask & (~mask + 1);
+            mask &= mask - 1;
+        }
+        mask = low;
+        entries = row_popcount(mask);
+    }
+
+#ifdef HMI2D_ROW_SHUFFLE
+    HMI_MEMCPY(packed, data + 2, entries * 2);
+    low = row_popcount(mask & 0xFF);
+    expand_entries(values, packed, mask & 0xFF);
+    expand_entries(values + 8, packed + low * 2, mask >> 8);
+#else
+    HMI_MEMSET(values, 0, 16 * sizeof(unsigned short));
+    while(mask) {
+        int i = row_ctz(mask);
+        values[i] = GET_U16(cursor);
+        cursor += 2;
+        mask &= mask - 1;
+    }
+#endif
+}
+
+void hmi2d_handle_data_row(hmi_t *hmi,
+                           hmi2d_row_t *row,
+                           hmi2d_section_t section,
+                           const unsigned char *msg)
+{
+    unsigned short values[16];
+    int i;
+
+    /* Malformed rows are reported before the synchronization is taken */
+    decode_row(hmi, values, msg);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_retrieve_data calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->internal2d.msg_counter++;
+    hmi->internal2d.changed |= section;
+
+    for(i = 0; i < 16; ++i)
+        (*row)[i] = values[i];
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_retrieve_data */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+/* Rows that make a scan complete, all of them unless configured */
+static unsigned short scan_rows(const hmi2d_scan_t *scan)
+{
+    return scan->expected ? scan->expected : 0xFFFF;
+}
+
+/* Makes the current scan the complete one and starts the next scan */
+static void scan_complete(hmi2d_scan_t *scan)
+{
+    hmi2d_heatmap_t *frame = scan->frame + scan->current;
+
+    frame->sequence = ++scan->sequence;
+
+    scan->current ^= 1;
+    frame = scan->frame + scan->current;
+    HMI_MEMSET(frame, 0, sizeof(*frame));
+}
+
+void hmi2d_handle_mutual_row(hmi_t *hmi,
+                             hmi2d_scan_t *scan,
+                             int row,
+                             const unsigned char *msg)
+{
+    hmi2d_heatmap_t *frame;
+    unsigned short bit = (unsigned short)(1 << row);
+    unsigned short values[16];
+    int i;
+
+    /* Malformed rows are reported before the synchronization is taken */
+    decode_row(hmi, values, msg);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_retrieve_data calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->internal2d.msg_counter++;
+
+    /* A row that was already received or that comes before the last one
+     * belongs to the next scan. The current scan lost a row then and is
+     * dropped.
+     */
+    frame = scan->frame + scan->current;
+    if(frame->rows && ((frame->rows & bit) || row < scan->last_row))
+        HMI_MEMSET(frame, 0, sizeof(*frame));
+
+    /* Rows that are not configured are ignored */
+    if(scan_rows(scan) & bit) {
+        for(i = 0; i < 16; ++i)
+            frame->value[row][i] = values[i];
+        frame->rows |= bit;
+        scan->last_row = row;
+
+        if(frame->rows == scan_rows(scan))
+            scan_complete(scan);
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_retrieve_data */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi2d_handle_finger_pos(hmi_t *hmi, const unsigned char *msg)
+{
+    int size = msg[1];
+    int i;
+    int count = size / 4;
+
+    /* Malformed messages are reported before the synchronization is taken */
+    if(count > 10) {
+        HMI_REPORT_BAD_DATA(hmi, "hmi2d_handle_finger_pos",
+                            "Message contains more than 10 finger positions",
+                            count, 0);
+        count = 10;
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_retrieve_data calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->internal2d.msg_counter++;
+
+    for(i = 0; i < count; ++i) {
+        unsigned int v = GET_U32(msg + 2 + 4*i);
+        hmi->internal2d.fingers.entry[i].finger_id = v & 0xFF;
+        hmi->internal2d.fingers.entry[i].x = (v >> 20) & 0xFFF;
+        hmi->internal2d.fingers.entry[i].y = (v >> 8) & 0xFFF;
+    }
+    hmi->internal2d.fingers.count = count;
+    hmi->internal2d.changed |= hmi2d_section_fingers;
+
+#ifndef HMI2D_NO_TRACKING
+    if(hmi->tracker2d.enabled)
+        hmi2d_track_fingers(hmi);
+#endif
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_retrieve_data */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+#ifndef HMI_NO_RECORDER
+    /* Only message handlers change the fingers, so they are still the
+     * ones of this message
+     */
+    hmi_recorder_add(hmi, hmi_rec_2d_fingers, &hmi->internal2d.fingers,
+                     sizeof(hmi->internal2d.fingers));
+#endif
+}
+
+void hmi2d_handle_mouse_btns(hmi_t *hmi, const unsigned char *msg)
+{
+    int state, old_state;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_retrieve_data calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->internal2d.msg_counter++;
+
+    state = GET_U8(msg + 2);
+    old_state = hmi->internal2d.mouse.button_state;
+    hmi->internal2d.mouse.button_state = state;
+    hmi->internal2d.mouse.press_event |= state & ~old_state;
+    hmi->internal2d.mouse.release_event |= old_state & ~state;
+    hmi->internal2d.changed |= hmi2d_section_mouse;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_retrieve_data */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi2d_handle_gesture(hmi_t *hmi, const unsigned char *msg)
+{
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_retrieve_data calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->internal2d.msg_counter++;
+
+    hmi->internal2d.gesture.gesture = GET_U8(msg + 2);
+    hmi->internal2d.last_gesture = hmi->internal2d.msg_counter;
+    hmi->internal2d.changed |= hmi2d_section_gesture;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_retrieve_data */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+/* Copies the last complete scan into the block of the results unless it
+ * is already there. Rows that are neither part of the new nor of the
+ * previous scan are already zero.
+ */
+static void update_block(hmi2d_block_t *block, hmi2d_scan_t *scan)
+{
+    const hmi2d_heatmap_t *frame = scan->frame + (scan->current ^ 1);
+    unsigned short rows;
+    int row, i;
+
+    if(frame->sequence == scan->retrieved)
+        return;
+
+    rows = frame->rows | scan->retrieved_rows;
+    for(row = 0; row < 16; ++row) {
+        if(!(rows & (1 << row)))
+            continue;
+        for(i = 0; i < 16; ++i)
+            (*block)[row][i] = frame->value[row][i];
+    }
+
+    scan->retrieved = frame->sequence;
+    scan->retrieved_rows = frame->rows;
+}
+
+void hmi2d_update_result(hmi_t *hmi)
+{
+    hmi2d_input_data_t *src = &hmi->internal2d;
+    hmi2d_input_data_t *dest = &hmi->result2d;
+    int changed = src->changed;
+    int i;
+
+    if(changed & hmi2d_section_self_raw)
+        HMI_MEMCPY(dest->self_raw, src->self_raw, sizeof(dest->self_raw));
+    if(changed & hmi2d_section_self_cal)
+        HMI_MEMCPY(dest->self_cal, src->self_cal, sizeof(dest->self_cal));
+
+    if(changed & hmi2d_section_fingers) {
+        dest->fingers.count = src->fingers.count;
+        for(i = 0; i < src->fingers.count; ++i)
+            dest->fingers.entry[i] = src->fingers.entry[i];
+    }
+
+    /* Button-events are only reported once */
+    if(changed & hmi2d_section_mouse) {
+        dest->mouse = src->mouse;
+        src->mouse.press_event = 0;
+        src->mouse.release_event = 0;
+    } else {
+        dest->mouse.press_event = 0;
+        dest->mouse.release_event = 0;
+    }
+
+    /* Gestures are only reported once */
+    if(changed & hmi2d_section_gesture) {
+        dest->gesture = src->gesture;
+        dest->last_gesture = src->last_gesture;
+    } else {
+        dest->gesture.gesture = 0;
+    }
+
+    dest->msg_counter = src->msg_counter;
+    src->changed = 0;
+
+    update_block(&hmi->mutual_raw, &hmi->scan_raw);
+    update_block(&hmi->mutual_cal, &hmi->scan_cal);
+#ifndef HMI2D_NO_TRACKING
+    hmi2d_update_contacts(hmi);
+#endif
+}
+
+int hmi2d_retrieve_data(hmi_t *hmi)
+{
+    int count;
+    int result = HMI_NO_DATA;
+    int last_counter, current_counter;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    last_counter = hmi->result2d.msg_counter;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    for(;;) {
+        /* Check whether new data are available */
+        current_counter = hmi->internal2d.msg_counter;
+        count = current_counter - last_counter;
+        if(count > 0)
+            break;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        /* Temporarily release synchronization */
+        HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+        /* Receive and handle message */
+        result = hmi_message_receive(hmi, NULL);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        /* Relock after message handling */
+        HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+        if(result != HMI_NO_ERROR)
+            break;
+    }
+
+    if(count > 0) {
+        hmi2d_update_result(hmi);
+        result = HMI_NO_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+#ifndef HMI_NO_RECORDER
+    /* Automatic dumps are written outside of message handling */
+    hmi_recorder_poll(hmi);
+#endif
+
+    return result;
+}
+
+void hmi2d_set_mutual_rows(hmi_t *hmi, unsigned short rows)
+{
+    HMI_ASSERT(hmi);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    /* Scans in progress restart with the new rows */
+    hmi->scan_raw.expected = rows;
+    hmi->scan_cal.expected = rows;
+    HMI_MEMSET(hmi->scan_raw.frame + hmi->scan_raw.current, 0,
+               sizeof(hmi2d_heatmap_t));
+    HMI_MEMSET(hmi->scan_cal.frame + hmi->scan_cal.current, 0,
+               sizeof(hmi2d_heatmap_t));
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+int hmi2d_copy_heatmap(hmi_t *hmi, int calibrated, hmi2d_heatmap_t *heatmap)
+{
+    hmi2d_scan_t *scan;
+    int result = HMI_NO_DATA;
+
+    HMI_ASSERT(hmi && heatmap);
+
+    scan = calibrated ? &hmi->scan_cal : &hmi->scan_raw;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(scan->sequence) {
+        *heatmap = scan->frame[scan->current ^ 1];
+        result = HMI_NO_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+#endif
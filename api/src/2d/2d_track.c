@@ -0,0 +1,358 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d.h"
+
+#if !defined(HMI2D_NO_DATA_RETRIEVAL) && !defined(HMI2D_NO_TRACKING)
+
+/* Values of hmi2d_track_t.state */
+#define TRACK_UNUSED 0
+#define TRACK_ACTIVE 1
+#define TRACK_ENDED  2
+
+static int round_position(double value)
+{
+    return (value >= 0) ? (int)(value + 0.5) : -(int)(0.5 - value);
+}
+
+/* Returns the time since the last finger message in seconds */
+static double frame_interval(hmi2d_tracker_t *tracker, unsigned int now)
+{
+    unsigned int nominal = tracker->config.interval_ms * 1000u;
+    unsigned int elapsed = now - tracker->last_time;
+
+    /* The nominal interval applies without a clock, after pauses and for
+     * messages that were received in a burst
+     */
+    if(elapsed < nominal / 2 || elapsed > 4 * nominal)
+        elapsed = nominal;
+
+    return elapsed / 1000000.0;
+}
+
+/* Advances position and velocity of one axis by dt seconds.
+ * The uncertainty grows by a white acceleration with variance q.
+ */
+static void predict_axis(double *state, double *p, double dt, double q)
+{
+    double dt2 = dt * dt;
+
+    state[0] += state[1] * dt;
+    p[0] += dt * (2 * p[1] + dt * p[2]) + q * dt2 * dt2 / 4;
+    p[1] += dt * p[2] + q * dt2 * dt / 2;
+    p[2] += q * dt2;
+}
+
+/* Corrects one axis with a position z measured with variance r */
+static void correct_axis(double *state, double *p, double z, double r)
+{
+    double s = p[0] + r;
+    double k0 = p[0] / s;
+    double k1 = p[1] / s;
+    double y = z - state[0];
+
+    state[0] += k0 * y;
+    state[1] += k1 * y;
+    p[2] -= k1 * p[1];
+    p[1] -= k0 * p[1];
+    p[0] -= k0 * p[0];
+}
+
+/* Copies the filtered state to the contact and flags changed positions */
+static void store_contact(hmi2d_track_t *track)
+{
+    hmi2d_contact_t *contact = &track->contact;
+    int x = round_position(track->x[0]);
+    int y = round_position(track->y[0]);
+
+    if(x != contact->x || y != contact->y)
+        contact->events |= hmi2d_contact_move;
+
+    contact->x = x;
+    contact->y = y;
+    contact->vx = round_position(track->x[1]);
+    contact->vy = round_position(track->y[1]);
+}
+
+/* Assigns the rows of the square cost matrix to columns with minimal total
+ * cost using the Hungarian method. Afterwards tracker->assigned holds the
+ * column of every row.
+ */
+static void assign(hmi2d_tracker_t *tracker, int n)
+{
+    /* Potentials, matching and search state indexed from 1 with column 0
+     * as the start of every augmenting path
+     */
+    float u[HMI2D_TRACK_MATRIX + 1];
+    float v[HMI2D_TRACK_MATRIX + 1];
+    float min_v[HMI2D_TRACK_MATRIX + 1];
+    int row_of[HMI2D_TRACK_MATRIX + 1];
+    int way[HMI2D_TRACK_MATRIX + 1];
+    char used[HMI2D_TRACK_MATRIX + 1];
+    int i, j;
+
+    for(j = 0; j <= n; ++j) {
+        u[j] = 0;
+        v[j] = 0;
+        row_of[j] = 0;
+    }
+
+    for(i = 1; i <= n; ++i) {
+        int col = 0;
+
+        row_of[0] = i;
+        for(j = 0; j <= n; ++j) {
+            min_v[j] = 1e30f;
+            used[j] = 0;
+        }
+
+        do {
+            int row = row_of[col];
+            int next = 0;
+            float delta = 1e30f;
+
+            used[col] = 1;
+            for(j = 1; j <= n; ++j) {
+                float reduced;
+
+                if(used[j])
+                    continue;
+                reduced = tracker->cost[row - 1][j - 1] - u[row] - v[j];
+                if(reduced < min_v[j]) {
+                    min_v[j] = reduced;
+                    way[j] = col;
+                }
+                if(min_v[j] < delta) {
+                    delta = min_v[j];
+                    next = j;
+                }
+            }
+            for(j = 0; j <= n; ++j) {
+                if(used[j]) {
+                    u[row_of[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    min_v[j] -= delta;
+                }
+            }
+            col = next;
+        } while(row_of[col]);
+
+        /* Flip the augmenting path */
+        do {
+            int prev = way[col];
+            row_of[col] = row_of[prev];
+            col = prev;
+        } while(col);
+    }
+
+    for(j = 1; j <= n; ++j)
+        tracker->assigned[row_of[j] - 1] = j - 1;
+}
+
+/* Starts a contact for a finger that no contact continues */
+static void start_track(hmi2d_tracker_t *tracker,
+                        const hmi2d_finger_pos_t *finger,
+                        double dt)
+{
+    hmi2d_track_t *track = NULL;
+    double speed;
+    int i;
+
+    /* Ended contacts are only free once hmi2d_update_contacts reported
+     * them. Without a free entry the finger starts a contact with a later
+     * message.
+     */
+    for(i = 0; i < HMI2D_MAX_CONTACTS; ++i) {
+        if(tracker->track[i].state == TRACK_UNUSED) {
+            track = tracker->track + i;
+            break;
+        }
+    }
+    if(!track)
+        return;
+
+    /* The velocity is unknown, but it hardly exceeds the gate per frame */
+    speed = tracker->config.gate / dt;
+
+    track->state = TRACK_ACTIVE;
+    track->missed = 0;
+    track->x[0] = finger->x;
+    track->x[1] = 0;
+    track->y[0] = finger->y;
+    track->y[1] = 0;
+    track->px[0] = tracker->config.measurement_noise *
+                   tracker->config.measurement_noise;
+    track->px[1] = 0;
+    track->px[2] = speed * speed;
+    track->py[0] = track->px[0];
+    track->py[1] = 0;
+    track->py[2] = track->px[2];
+
+    track->contact.id = ++tracker->next_id;
+    track->contact.events = hmi2d_contact_down;
+    track->contact.x = finger->x;
+    track->contact.y = finger->y;
+    track->contact.vx = 0;
+    track->contact.vy = 0;
+    track->contact.raw_x = finger->x;
+    track->contact.raw_y = finger->y;
+    track->contact.finger_id = finger->finger_id;
+}
+
+void hmi2d_track_fingers(hmi_t *hmi)
+{
+    hmi2d_tracker_t *tracker = &hmi->tracker2d;
+    const hmi2d_tracking_config_t *config = &tracker->config;
+    const hmi2d_finger_pos_list_t *fingers = &hmi->internal2d.fingers;
+    unsigned int now = HMI_TIME_US();
+    double dt = frame_interval(tracker, now);
+    double q = (double)config->process_noise * config->process_noise;
+    double r = (double)config->measurement_noise * config->measurement_noise;
+    float gate = (float)config->gate * config->gate;
+    int rows[HMI2D_MAX_CONTACTS];
+    char matched[10];
+    int count = fingers->count < 10 ? fingers->count : 10;
+    int tracks = 0;
+    int n, i, j;
+
+    for(i = 0; i < HMI2D_MAX_CONTACTS; ++i) {
+        hmi2d_track_t *track = tracker->track + i;
+        if(track->state != TRACK_ACTIVE)
+            continue;
+        predict_axis(track->x, track->px, dt, q);
+        predict_axis(track->y, track->py, dt, q);
+        rows[tracks++] = i;
+    }
+
+    /* Every contact and every finger may stay unmatched at the cost of the
+     * gate. Pairs beyond the gate cost more than leaving both unmatched.
+     */
+    n = tracks + count;
+    for(i = 0; i < n; ++i) {
+        for(j = 0; j < n; ++j) {
+            float cost = 0;
+
+            if(i < tracks && j < count) {
+                const hmi2d_track_t *track = tracker->track + rows[i];
+                float dx = (float)(fingers->entry[j].x - track->x[0]);
+                float dy = (float)(fingers->entry[j].y - track->y[0]);
+
+                cost = dx * dx + dy * dy;
+                if(cost > gate)
+                    cost = 2 * gate + 1;
+            } else if(i < tracks || j < count) {
+                cost = gate;
+            }
+            tracker->cost[i][j] = cost;
+        }
+    }
+    if(n > 0)
+        assign(tracker, n);
+
+    for(j = 0; j < count; ++j)
+        matched[j] = 0;
+
+    for(i = 0; i < tracks; ++i) {
+        hmi2d_track_t *track = tracker->track + rows[i];
+
+        j = tracker->assigned[i];
+        if(j < count && tracker->cost[i][j] <= gate) {
+            const hmi2d_finger_pos_t *finger = fingers->entry + j;
+
+            correct_axis(track->x, track->px, finger->x, r);
+            correct_axis(track->y, track->py, finger->y, r);
+            track->missed = 0;
+            track->contact.raw_x = finger->x;
+            track->contact.raw_y = finger->y;
+            track->contact.finger_id = finger->finger_id;
+            matched[j] = 1;
+        } else if(++track->missed > config->max_missed) {
+            track->state = TRACK_ENDED;
+            track->contact.events |= hmi2d_contact_up;
+            continue;
+        }
+        store_contact(track);
+    }
+
+    for(j = 0; j < count; ++j) {
+        if(!matched[j])
+            start_track(tracker, fingers->entry + j, dt);
+    }
+
+    tracker->last_time = now;
+}
+
+void hmi2d_update_contacts(hmi_t *hmi)
+{
+    hmi2d_contact_list_t *dest = &hmi->contacts2d;
+    int i;
+
+    dest->count = 0;
+    for(i = 0; i < HMI2D_MAX_CONTACTS; ++i) {
+        hmi2d_track_t *track = hmi->tracker2d.track + i;
+
+        if(track->state == TRACK_UNUSED)
+            continue;
+
+        dest->entry[dest->count++] = track->contact;
+
+        /* Events and ended contacts are only reported once */
+        track->contact.events = 0;
+        if(track->state == TRACK_ENDED)
+            track->state = TRACK_UNUSED;
+    }
+}
+
+int hmi2d_set_tracking(hmi_t *hmi, const hmi2d_tracking_config_t *config)
+{
+    hmi2d_tracker_t *tracker;
+
+    HMI_ASSERT(hmi);
+
+    if(config && (config->gate < 1 || config->max_missed < 0 ||
+                  config->process_noise <= 0 ||
+                  config->measurement_noise <= 0 ||
+                  config->interval_ms < 1))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    tracker = &hmi->tracker2d;
+    HMI_MEMSET(tracker->track, 0, sizeof(tracker->track));
+    tracker->enabled = (config != NULL);
+    if(config)
+        tracker->config = *config;
+    tracker->last_time = HMI_TIME_US();
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+#endif
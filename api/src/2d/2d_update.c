@@ -1,187 +1,844 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#include "2d.h"
-
-#ifndef HMI2D_NO_UPDATE
-
-void hmi2d_handle_update_response(hmi_t *hmi, const unsigned char *msg)
-{
-    int size = msg[1];
-    if(size == 1)
-        hmi->bootloader_2d_error_code = msg[2];
-}
-
-static int update_wait_response(hmi_t *hmi)
-{
-    int result = HMI_NO_ERROR;
-    int timeout = 100;
-
-    hmi->bootloader_2d_error_code = -1;
-
-    for(;;) {
-        /* Receive and handle message */
-        result = hmi_message_receive(hmi, &timeout);
-        if(result != HMI_NO_ERROR) {
-            if(result == HMI_NO_DATA)
-                result = HMI_NO_RESPONSE_ERROR;
-            break;
-        }
-
-        /* Check whether we got a response */
-        if(hmi->bootloader_2d_error_code >= 0) {
-            if(hmi->bootloader_2d_error_code == 0)
-                result = HMI_NO_ERROR;
-            else
-                result = HMI_2D_BOOTLOADER_ERROR;
-            break;
-        }
-    }
-
-    return result;
-}
-
-int hmi2d_update_enter_bootloader(hmi_t *hmi)
-{
-    unsigned char cmd[] = { 0xF0 };
-    int result;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
-
-    if(result == HMI_NO_ERROR)
-        result = update_wait_response(hmi);
-
-    return result;
-}
-
-int hmi2d_update_unlock(hmi_t *hmi)
-{
-    unsigned char cmd[] = { 0xF7 };
-    int result;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
-
-    if(result == HMI_NO_ERROR)
-        result = update_wait_response(hmi);
-
-    return result;
-}
-
-int hmi2d_update_erase_memory(hmi_t *hmi)
-{
-    unsigned char cmd[5] = { 0xF2 };
-    int result;
-    int addr;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    for(addr = HMI2D_PROG_MEM_START;
-        addr < HMI2D_PROG_MEM_END;
-        addr += HMI2D_PROG_PAGE_SIZE)
-    {
-        SET_U32(cmd + 1, addr);
-
-        result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
-        if(result != HMI_NO_ERROR)
-            break;
-
-        result = update_wait_response(hmi);
-        if(result != HMI_NO_ERROR)
-            break;
-    }
-
-    return result;
-}
-
-int hmi2d_update_flash_block(hmi_t *hmi, int addr, hmi2d_update_block_t *block)
-{
-    unsigned char addrCmd[5] = { 0xF4 };
-    unsigned char dataCmd[35] = { 0xF5, 0x08 };
-    int result;
-    int i, j;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-    HMI_ASSERT(addr >= HMI2D_PROG_MEM_START);
-    HMI_ASSERT(addr + HMI2D_PROG_BLOCK_SIZE <= HMI2D_PROG_MEM_END);
-
-    SET_U32(addrCmd + 1, addr);
-    result = hmi2d_message_write(hmi, hmi2d_msg_t_update,
-                                 sizeof(addrCmd), addrCmd);
-
-    if(result == HMI_NO_ERROR)
-        result = update_wait_response(hmi);
-
-    for(i = 0; (result == HMI_NO_ERROR) && (i < HMI2D_PROG_BLOCK_SIZE/32); ++i)
-    {
-        SET_U8(dataCmd + 2, i);
-
-        for(j = 0; j < 32; ++j)
-            SET_U8(dataCmd + 3 + j, (*block)[i*32 + j]);
-
-        result = hmi2d_message_write(hmi, hmi2d_msg_t_update,
-                                     sizeof(dataCmd), dataCmd);
-        if(result != HMI_NO_ERROR)
-            break;
-
-        result = update_wait_response(hmi);
-    }
-
-    return result;
-}
-
-int hmi2d_update_flash_memory(hmi_t *hmi, hmi2d_update_image_t *image)
-{
-    int result;
-    int i;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    for(i = 0; i < HMI2D_PROG_BLOCK_COUNT; ++i) {
-        int addr = HMI2D_PROG_MEM_START + i * HMI2D_PROG_BLOCK_SIZE;
-        result = hmi2d_update_flash_block(hmi, addr, (*image) + i);
-
-        if(result != HMI_NO_ERROR)
-            break;
-    }
-    return result;
-}
-
-int hmi2d_update_exit_bootloader(hmi_t *hmi)
-{
-    unsigned char cmd[] = { 0xF6 };
-    int result;
-
-    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
-
-    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
-
-    if(result == HMI_NO_ERROR)
-        result = update_wait_response(hmi);
-
-    return result;
-}
-
-#endif
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d.h"
+
+#ifndef HMI2D_NO_UPDATE
+
+void hmi2d_handle_update_response(hmi_t *hmi, const unsigned char *msg)
+{
+    hmi->bootloader_2d_error_code = msg[2];
+    hmi->bootloader_2d_responses++;
+    if(msg[2] && !hmi->bootloader_2d_first_error)
+        hmi->bootloader_2d_first_error = msg[2];
+}
+
+static int update_wait_response(hmi_t *hmi)
+{
+    int result = HMI_NO_ERROR;
+    int timeout = 100;
+
+    hmi->bootloader_2d_error_code = -1;
+
+    for(;;) {
+        /* Receive and handle message */
+        result = hmi_message_receive(hmi, &timeout);
+        if(result != HMI_NO_ERROR) {
+            if(result == HMI_NO_DATA)
+                result = HMI_NO_RESPONSE_ERROR;
+            break;
+        }
+
+        /* Check whether we got a response */
+        if(hmi->bootloader_2d_error_code >= 0) {
+            if(hmi->bootloader_2d_error_code == 0)
+                result = HMI_NO_ERROR;
+            else
+                result = HMI_2D_BOOTLOADER_ERROR;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/* Waits until count responses to streamed commands were received */
+static int update_collect_responses(hmi_t *hmi, int count)
+{
+    int result = HMI_NO_ERROR;
+    int timeout = 100;
+    int last = hmi->bootloader_2d_responses;
+
+    while(hmi->bootloader_2d_responses < count) {
+        /* Receive and handle message */
+        result = hmi_message_receive(hmi, &timeout);
+        if(result != HMI_NO_ERROR) {
+            if(result == HMI_NO_DATA)
+                result = HMI_NO_RESPONSE_ERROR;
+            break;
+        }
+
+        /* The timeout only restarts when responses arrive */
+        if(hmi->bootloader_2d_responses != last) {
+            last = hmi->bootloader_2d_responses;
+            timeout = 100;
+        }
+    }
+
+    if(result == HMI_NO_ERROR && hmi->bootloader_2d_first_error)
+        result = HMI_2D_BOOTLOADER_ERROR;
+
+    return result;
+}
+
+/* Sends one update command without waiting for its response */
+static int update_stream_command(hmi_t *hmi, int size, unsigned char *cmd)
+{
+    return hmi2d_message_write(hmi, hmi2d_msg_t_update, size, cmd);
+}
+
+int hmi2d_update_enter_bootloader(hmi_t *hmi)
+{
+    unsigned char cmd[] = { 0xF0 };
+    int result;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
+
+    if(result == HMI_NO_ERROR)
+        result = update_wait_response(hmi);
+
+    return result;
+}
+
+int hmi2d_update_unlock(hmi_t *hmi)
+{
+    unsigned char cmd[] = { 0xF7 };
+    int result;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
+
+    if(result == HMI_NO_ERROR)
+        result = update_wait_response(hmi);
+
+    return result;
+}
+
+int hmi2d_update_erase_memory(hmi_t *hmi)
+{
+    unsigned char cmd[5] = { 0xF2 };
+    int result;
+    int addr;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    for(addr = HMI2D_PROG_MEM_START;
+        addr < HMI2D_PROG_MEM_END;
+        addr += HMI2D_PROG_PAGE_SIZE)
+    {
+        SET_U32(cmd + 1, addr);
+
+        result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
+        if(result != HMI_NO_ERROR)
+            break;
+
+        result = update_wait_response(hmi);
+        if(result != HMI_NO_ERROR)
+            break;
+    }
+
+    return result;
+}
+
+int hmi2d_update_flash_block(hmi_t *hmi, int addr, hmi2d_update_block_t *block)
+{
+    unsigned char addrCmd[5] = { 0xF4 };
+    unsigned char dataCmd[35] = { 0xF5, 0x08 };
+    int result;
+    int i, j;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+    HMI_ASSERT(addr >= HMI2D_PROG_MEM_START);
+    HMI_ASSERT(addr + HMI2D_PROG_BLOCK_SIZE <= HMI2D_PROG_MEM_END);
+
+    SET_U32(addrCmd + 1, addr);
+    result = hmi2d_message_write(hmi, hmi2d_msg_t_update,
+                                 sizeof(addrCmd), addrCmd);
+
+    if(result == HMI_NO_ERROR)
+        result = update_wait_response(hmi);
+
+    for(i = 0; (result == HMI_NO_ERROR) && (i < HMI2D_PROG_BLOCK_SIZE/32); ++i)
+    {
+        SET_U8(dataCmd + 2, i);
+
+        for(j = 0; j < 32; ++j)
+            SET_U8(dataCmd + 3 + j, (*block)[i*32 + j]);
+
+        result = hmi2d_message_write(hmi, hmi2d_msg_t_update,
+                                     sizeof(dataCmd), dataCmd);
+        if(result != HMI_NO_ERROR)
+            break;
+
+        result = update_wait_response(hmi);
+    }
+
+    return result;
+}
+
+int hmi2d_update_flash_memory(hmi_t *hmi, hmi2d_update_image_t *image)
+{
+    int result;
+    int i;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    for(i = 0; i < HMI2D_PROG_BLOCK_COUNT; ++i) {
+        int addr = HMI2D_PROG_MEM_START + i * HMI2D_PROG_BLOCK_SIZE;
+        result = hmi2d_update_flash_block(hmi, addr, (*image) + i);
+
+        if(result != HMI_NO_ERROR)
+            break;
+    }
+    return result;
+}
+
+static int update_is_erased(const hmi2d_update_block_t *block)
+{
+    int i;
+    for(i = 0; i < HMI2D_PROG_BLOCK_SIZE; ++i) {
+        if((unsigned char)(*block)[i] != (HMI2D_PROG_ERASED_VALUE & 0xFF))
+            return 0;
+    }
+    return 1;
+}
+
+void hmi2d_update_plan(hmi2d_update_plan_t *plan,
+                       hmi2d_update_image_t *image)
+{
+    const int blocks_per_page = HMI2D_PROG_PAGE_SIZE / HMI2D_PROG_BLOCK_SIZE;
+    int page, i;
+
+    HMI_ASSERT(plan && image);
+
+    HMI_MEMSET(plan, 0, sizeof(*plan));
+
+    for(page = 0; page < HMI2D_PROG_PAGE_COUNT; ++page) {
+        int first = page * blocks_per_page;
+
+        plan->erase[page] = 1;
+        plan->erase_count++;
+
+        /* Erasing already leaves the erased value in the page */
+        for(i = first; i < first + blocks_per_page; ++i) {
+            if(!update_is_erased((*image) + i)) {
+                plan->write[i] = 1;
+                plan->write_count++;
+            }
+        }
+    }
+}
+
+static int update_is_equal(const char *a, const char *b, int size)
+{
+    int i;
+    for(i = 0; i < size; ++i) {
+        if(a[i] != b[i])
+            return 0;
+    }
+    return 1;
+}
+
+int hmi2d_update_plan_differential(hmi_t *hmi,
+                                   hmi2d_update_plan_t *plan,
+                                   hmi2d_update_image_t *image,
+                                   hmi2d_update_image_t *installed,
+                                   unsigned int checksum)
+{
+    const int blocks_per_page = HMI2D_PROG_PAGE_SIZE / HMI2D_PROG_BLOCK_SIZE;
+    hmi2d_version_info_t version;
+    int result;
+    int page, i;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi) && plan && image && installed);
+
+    /* Start with a full plan so that it is usable on any failure */
+    hmi2d_update_plan(plan, image);
+
+    result = hmi2d_query_fw_version(hmi, &version);
+    if(result != HMI_NO_ERROR)
+        return result;
+
+    /* The device does not run the installed image, nothing is skipped */
+    if(version.checksum != checksum)
+        return HMI_NO_ERROR;
+
+    for(page = 0; page < HMI2D_PROG_PAGE_COUNT; ++page) {
+        int first = page * blocks_per_page;
+
+        if(!update_is_equal((*image)[first], (*installed)[first],
+                            blocks_per_page * HMI2D_PROG_BLOCK_SIZE))
+            continue;
+
+        plan->erase[page] = 0;
+        plan->erase_count--;
+
+        for(i = first; i < first + blocks_per_page; ++i) {
+            if(plan->write[i]) {
+                plan->write[i] = 0;
+                plan->write_count--;
+            }
+        }
+    }
+    return HMI_NO_ERROR;
+}
+
+/* Writes one block by streaming the address and all data commands */
+static int update_stream_block(hmi_t *hmi, int addr,
+                               hmi2d_update_block_t *block)
+{
+    unsigned char addrCmd[5] = { 0xF4 };
+    unsigned char dataCmd[35] = { 0xF5, 0x08 };
+    int result;
+    int sent = 0;
+    int i;
+
+    hmi->bootloader_2d_responses = 0;
+    hmi->bootloader_2d_first_error = 0;
+
+    SET_U32(addrCmd + 1, addr);
+    result = update_stream_command(hmi, sizeof(addrCmd), addrCmd);
+    if(result == HMI_NO_ERROR)
+        sent++;
+
+    for(i = 0; (result == HMI_NO_ERROR) && (i < HMI2D_PROG_BLOCK_SIZE/32); ++i)
+    {
+        SET_U8(dataCmd + 2, i);
+        HMI_MEMCPY(dataCmd + 3, (*block) + i*32, 32);
+        result = update_stream_command(hmi, sizeof(dataCmd), dataCmd);
+        if(result == HMI_NO_ERROR)
+            sent++;
+    }
+
+    if(result == HMI_NO_ERROR)
+        result = update_collect_responses(hmi, sent);
+
+    /* Responses that are still on their way would otherwise be taken for
+     * the ones of the next commands. They are drained until all arrived or
+     * none arrived for another 100 milliseconds.
+     */
+    if(result != HMI_NO_ERROR)
+        update_collect_responses(hmi, sent);
+
+    return result;
+}
+
+/* Erases one page, streamed or waiting for the response */
+static int update_erase_page(hmi_t *hmi, int page, int stream)
+{
+    unsigned char cmd[5] = { 0xF2 };
+    int result;
+
+    SET_U32(cmd + 1, HMI2D_PROG_MEM_START + page * HMI2D_PROG_PAGE_SIZE);
+    if(stream)
+        return update_stream_command(hmi, sizeof(cmd), cmd);
+
+    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
+    if(result == HMI_NO_ERROR)
+        result = update_wait_response(hmi);
+
+    return result;
+}
+
+/* Writes one block, streamed or waiting for each response */
+static int update_write_block(hmi_t *hmi, int block,
+                              hmi2d_update_image_t *image, int stream)
+{
+    int addr = HMI2D_PROG_MEM_START + block * HMI2D_PROG_BLOCK_SIZE;
+    int result;
+
+    if(!stream)
+        return hmi2d_update_flash_block(hmi, addr, (*image) + block);
+
+    result = update_stream_block(hmi, addr, (*image) + block);
+    /* Fall back to the acknowledged transfer once */
+    if(result != HMI_NO_ERROR)
+        result = hmi2d_update_flash_block(hmi, addr, (*image) + block);
+
+    return result;
+}
+
+int hmi2d_update_flash_planned(hmi_t *hmi,
+                               hmi2d_update_image_t *image,
+                               const hmi2d_update_plan_t *plan,
+                               int stream)
+{
+    int result = HMI_NO_ERROR;
+    int i;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi) && image && plan);
+
+    hmi->bootloader_2d_responses = 0;
+    hmi->bootloader_2d_first_error = 0;
+
+    for(i = 0; (result == HMI_NO_ERROR) && (i < HMI2D_PROG_PAGE_COUNT); ++i)
+    {
+        if(plan->erase[i])
+            result = update_erase_page(hmi, i, stream);
+    }
+
+    if(stream && result == HMI_NO_ERROR)
+        result = update_collect_responses(hmi, plan->erase_count);
+
+    for(i = 0; (result == HMI_NO_ERROR) && (i < HMI2D_PROG_BLOCK_COUNT); ++i)
+    {
+        if(plan->write[i])
+            result = update_write_block(hmi, i, image, stream);
+    }
+
+    return result;
+}
+
+/* Count of commands of a block, the address and the data commands */
+#define UPDATE_BLOCK_COMMANDS (1 + HMI2D_PROG_BLOCK_SIZE/32)
+
+/* Limit of the messages that are handled by one step, so that a device
+ * that sends faster than they are handled can't stall the application
+ */
+#define UPDATE_MAX_MESSAGES 64
+
+#ifdef HMI_NO_TIME
+/* Time in milliseconds that a step waits for responses without a timer */
+#define UPDATE_STEP_WAIT 10
+#endif
+
+static int update_job_finish(hmi2d_update_job_t *job,
+                             hmi2d_update_state_t state, int error)
+{
+    job->error = error;
+    job->state = state;
+    job->end_time = HMI_TIME_US();
+    return 0;
+}
+
+/* Restarts the timeout of 100 milliseconds for the responses. Without a
+ * platform timer the deadline holds the milliseconds left, which only pass
+ * while hmi2d_update_flash_step waits for responses.
+ */
+static void update_job_wait(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+#ifdef HMI_NO_TIME
+    job->deadline = 100;
+#else
+    job->deadline = HMI_TIME_US() + 100000;
+#endif
+    job->last_responses = hmi->bootloader_2d_responses;
+}
+
+static int update_job_timed_out(hmi2d_update_job_t *job)
+{
+#ifdef HMI_NO_TIME
+    return job->deadline == 0;
+#else
+    return (int)(HMI_TIME_US() - job->deadline) >= 0;
+#endif
+}
+
+static void update_job_reset(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    hmi->bootloader_2d_responses = 0;
+    hmi->bootloader_2d_first_error = 0;
+    job->sent = 0;
+    job->last_responses = 0;
+}
+
+/* Checks the responses to the sent commands like update_collect_responses
+ * but without blocking.
+ *
+ * Returns 1 when all arrived, 0 while waiting or a negative error code.
+ */
+static int update_job_collected(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    int responses = hmi->bootloader_2d_responses;
+
+    if(responses >= job->sent)
+        return hmi->bootloader_2d_first_error ? HMI_2D_BOOTLOADER_ERROR : 1;
+
+    /* The timeout only restarts when responses arrive */
+    if(responses != job->last_responses) {
+        update_job_wait(hmi, job);
+        return 0;
+    }
+    if(update_job_timed_out(job))
+        return HMI_NO_RESPONSE_ERROR;
+    return 0;
+}
+
+static int update_job_send(hmi_t *hmi, hmi2d_update_job_t *job,
+                           int size, unsigned char *cmd)
+{
+    int result = update_stream_command(hmi, size, cmd);
+
+    if(result == HMI_NO_ERROR) {
+        job->sent++;
+        update_job_wait(hmi, job);
+    }
+    return result;
+}
+
+/* Erases the next page. Without streaming the response of the previous
+ * page is awaited first.
+ *
+ * Returns 1 on progress, 0 while waiting or a negative error code.
+ */
+static int update_job_erase(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    unsigned char cmd[5] = { 0xF2 };
+    int result;
+
+    if(!job->stream) {
+        result = update_job_collected(hmi, job);
+        if(result <= 0)
+            return result;
+    }
+
+    while(job->index < HMI2D_PROG_PAGE_COUNT &&
+            !job->plan.erase[job->index])
+        job->index++;
+
+    if(job->index < HMI2D_PROG_PAGE_COUNT) {
+        SET_U32(cmd + 1, HMI2D_PROG_MEM_START +
+                         job->index++ * HMI2D_PROG_PAGE_SIZE);
+        result = update_job_send(hmi, job, sizeof(cmd), cmd);
+        return result ? result : 1;
+    }
+
+    /* The erase commands are complete with all responses */
+    result = update_job_collected(hmi, job);
+    if(result <= 0)
+        return result;
+
+    job->state = hmi2d_UpdateState_Write;
+    job->index = 0;
+    update_job_reset(hmi, job);
+    return 1;
+}
+
+/* Sends the next command of the current block */
+static int update_job_command(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    hmi2d_update_block_t *block = (*job->image) + job->index;
+    unsigned char addrCmd[5] = { 0xF4 };
+    unsigned char dataCmd[35] = { 0xF5, 0x08 };
+    int i = job->command++;
+
+    if(i == 0) {
+        SET_U32(addrCmd + 1, HMI2D_PROG_MEM_START +
+                             job->index * HMI2D_PROG_BLOCK_SIZE);
+        return update_job_send(hmi, job, sizeof(addrCmd), addrCmd);
+    }
+
+    SET_U8(dataCmd + 2, i - 1);
+    HMI_MEMCPY(dataCmd + 3, (*block) + (i - 1)*32, 32);
+    return update_job_send(hmi, job, sizeof(dataCmd), dataCmd);
+}
+
+/* Writes the current block. Streaming sends all commands at once,
+ * otherwise each command waits for the response of the previous one. A
+ * block that fails while streaming is written once more without streaming
+ * after the outstanding responses were drained like update_stream_block
+ * does.
+ *
+ * Returns 1 on progress, 0 while waiting or a negative error code.
+ */
+static int update_job_write(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    int streamed = job->stream && !job->fallback;
+    int result;
+
+    if(job->draining) {
+        if(update_job_collected(hmi, job) == 0)
+            return 0;
+        job->draining = 0;
+        job->fallback = 1;
+        job->command = 0;
+        update_job_reset(hmi, job);
+        return 1;
+    }
+
+    if(job->command == 0) {
+        while(job->index < HMI2D_PROG_BLOCK_COUNT &&
+                !job->plan.write[job->index])
+            job->index++;
+
+        if(job->index >= HMI2D_PROG_BLOCK_COUNT)
+            return update_job_finish(job, hmi2d_UpdateState_Done,
+                                     HMI_NO_ERROR);
+        update_job_reset(hmi, job);
+        result = HMI_NO_ERROR;
+    } else {
+        result = update_job_collected(hmi, job);
+        if(result == 0)
+            return 0;
+
+        if(result > 0 && job->command == UPDATE_BLOCK_COMMANDS) {
+            job->blocks_done++;
+            job->index++;
+            job->command = 0;
+            job->fallback = 0;
+            return 1;
+        }
+        if(result > 0)
+            result = HMI_NO_ERROR;
+    }
+
+    while(result == HMI_NO_ERROR) {
+        result = update_job_command(hmi, job);
+        if(!streamed || job->command == UPDATE_BLOCK_COMMANDS)
+            break;
+    }
+
+    if(result != HMI_NO_ERROR && streamed) {
+        job->draining = 1;
+        update_job_wait(hmi, job);
+        result = HMI_NO_ERROR;
+    }
+
+    return result ? result : 1;
+}
+
+static int update_job_running(hmi2d_update_job_t *job)
+{
+    return job->state == hmi2d_UpdateState_Erase ||
+           job->state == hmi2d_UpdateState_Write;
+}
+
+/* Advances the update after responses arrived or time passed.
+ *
+ * Returns 1 on progress and 0 while waiting or when nothing is left.
+ */
+static int update_job_advance(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    int result;
+
+    /* Pages are erased at once, blocks are only left when they are
+     * complete. Commands that are still in flight are awaited.
+     */
+    if(job->cancel && (job->state == hmi2d_UpdateState_Erase ||
+                       (job->command == 0 && !job->draining)))
+    {
+        if(update_job_collected(hmi, job) == 0)
+            return 0;
+        update_job_finish(job, hmi2d_UpdateState_Cancelled, HMI_NO_ERROR);
+        return 1;
+    }
+
+    if(job->state == hmi2d_UpdateState_Erase)
+        result = update_job_erase(hmi, job);
+    else
+        result = update_job_write(hmi, job);
+
+    if(result < 0) {
+        update_job_finish(job, hmi2d_UpdateState_Failed, result);
+        return 1;
+    }
+    return result;
+}
+
+#ifdef HMI_NO_TIME
+/* Waits for a response and counts the waited time against the deadline.
+ * A wait counts at least a millisecond, so that the deadline also passes
+ * when the receive does not wait at all.
+ */
+static void update_job_idle(hmi_t *hmi, hmi2d_update_job_t *job)
+{
+    int timeout = UPDATE_STEP_WAIT;
+    unsigned int waited;
+    int result;
+
+    result = hmi_message_receive(hmi, &timeout);
+    if(result == HMI_NO_ERROR)
+        return;
+
+    waited = timeout < UPDATE_STEP_WAIT ?
+             (unsigned int)(UPDATE_STEP_WAIT - timeout) : 1;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_update_flash_get_status calls */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(result != HMI_NO_DATA)
+        update_job_finish(job, hmi2d_UpdateState_Failed, result);
+    else if(job->deadline > waited)
+        job->deadline -= waited;
+    else
+        job->deadline = 0;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_update_flash_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+#endif
+
+void hmi2d_update_flash_start(hmi_t *hmi,
+                              hmi2d_update_image_t *image,
+                              const hmi2d_update_plan_t *plan,
+                              int stream)
+{
+    hmi2d_update_job_t *job;
+
+    HMI_ASSERT(hmi && image && plan);
+
+    job = &hmi->update2d;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_update_flash_get_status calls */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    HMI_MEMSET(job, 0, sizeof(*job));
+    job->image = image;
+    job->plan = *plan;
+    job->stream = stream;
+    job->state = hmi2d_UpdateState_Erase;
+    job->start_time = HMI_TIME_US();
+
+    update_job_reset(hmi, job);
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_update_flash_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+int hmi2d_update_flash_step(hmi_t *hmi)
+{
+    hmi2d_update_job_t *job;
+    int progress = 0;
+    int running;
+    int result = HMI_NO_DATA;
+    int i;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    job = &hmi->update2d;
+    if(!update_job_running(job))
+        return 0;
+
+    /* Handle the messages that already arrived */
+    for(i = 0; i < UPDATE_MAX_MESSAGES; ++i) {
+        result = hmi_message_receive(hmi, NULL);
+        if(result != HMI_NO_ERROR)
+            break;
+        progress = 1;
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_update_flash_get_status calls */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(result != HMI_NO_ERROR && result != HMI_NO_DATA)
+        update_job_finish(job, hmi2d_UpdateState_Failed, result);
+    else if(update_job_advance(hmi, job))
+        progress = 1;
+    running = update_job_running(job);
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_update_flash_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+#ifdef HMI_NO_TIME
+    /* Only waiting lets the timeouts pass */
+    if(!progress && running) {
+        update_job_idle(hmi, job);
+        running = update_job_running(job);
+    }
+#else
+    HMI_UNUSED(progress)
+#endif
+
+    return running;
+}
+
+void hmi2d_update_flash_cancel(hmi_t *hmi)
+{
+    HMI_ASSERT(hmi);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_update_flash_step */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(update_job_running(&hmi->update2d))
+        hmi->update2d.cancel = 1;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_update_flash_step */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi2d_update_flash_get_status(hmi_t *hmi, hmi2d_update_status_t *status)
+{
+    hmi2d_update_job_t *job;
+    unsigned int elapsed;
+
+    HMI_ASSERT(hmi && status);
+
+    job = &hmi->update2d;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi2d_update_flash_step */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    status->state = job->state;
+    status->error = job->error;
+    status->blocks_done = job->blocks_done;
+    status->block_count = job->plan.write_count;
+
+    if(job->state == hmi2d_UpdateState_Idle)
+        elapsed = 0;
+    else if(job->state >= hmi2d_UpdateState_Done)
+        elapsed = job->end_time - job->start_time;
+    else
+        elapsed = HMI_TIME_US() - job->start_time;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi2d_update_flash_step */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    status->elapsed_ms = elapsed / 1000;
+    status->bytes_per_s = elapsed ? status->blocks_done *
+            HMI2D_PROG_BLOCK_SIZE * 1000000.0f / elapsed : 0.0f;
+    if(!status->blocks_done)
+        status->eta_ms = -1;
+    else
+        status->eta_ms = (int)((float)status->elapsed_ms *
+                (status->block_count - status->blocks_done) /
+                status->blocks_done);
+}
+
+int hmi2d_update_exit_bootloader(hmi_t *hmi)
+{
+    unsigned char cmd[] = { 0xF6 };
+    int result;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    result = hmi2d_message_write(hmi, hmi2d_msg_t_update, sizeof(cmd), cmd);
+
+    if(result == HMI_NO_ERROR)
+        result = update_wait_response(hmi);
+
+    return result;
+}
+
+#endif
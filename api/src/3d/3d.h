@@ -1,108 +1,383 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#ifndef HMI_3D_H
-#define HMI_3D_H
-
-#include "../impl.h"
-
-/* ======== Internal 3D Message Processing ======== */
-
-/* Function: hmi3d_handle_system_status
- *
- * The actual handler for System Status (0x15) messages.
- *
- * data - The raw data of the message
- * size - The size of the message
- *
- * This function evaluates the response and signals to <wait_response> that
- * the instruction was processed.
- *
- * See also:
- *    <wait_response>, <hmi3d_message_handle>
- */
-void hmi3d_handle_system_status(hmi_t *hmi,
-                                const unsigned char *data,
-                                int size);
-
-/* Function: hmi3d_handle_version_info
- *
- * The actual handler for Version Info (0x83) messages.
- *
- * data - The raw data of the message
- * size - The size of the message
- *
- * See also:
- *    <hmi3d_message_handle>
- */
-void hmi3d_handle_version_info(hmi_t *hmi,
-                               const unsigned char *data,
-                               int size);
-
-/* Function: hmi3d_handle_data_output
- *
- * The actual handler for Sensor Data Output (0x91) messages.
- *
- * data - The raw data of the message
- *
- * See alos:
- *    <hmi3d_message_handle>
- */
-void hmi3d_handle_data_output(hmi_t *hmi,
-                              const unsigned char *data);
-
-/* Function: hmi3d_handle_runtime_parameter
- *
- * The actual handler for Set Runtime Parameter (0xA2) messages.
- *
- * data - The raw data of the message
- *
- * See alos:
- *    <hmi3d_message_handle>
- */
-void hmi3d_handle_runtime_parameter(hmi_t *hmi,
-                                    const unsigned char *data);
-
-/* ======== Internal 3D Instruction Processing ======== */
-
-
-/* Function: hmi3d_request_message
- *
- * Requests the message with msg_id from the device.
- *
- * msg_id  - The id of the requested message
- * param   - Optional parameter that specifies the content of the returned
- *           message for some msg_ids.
- * timeout - Timeout in milliseconds to wait for a response
- *
- * This function returns 0 when the device acknowledged that it sent the
- * message or a negative value when the request failed.
- *
- * After a failure or no response within the timeout the request gets resend
- * up to three times.
- */
-int hmi3d_request_message(hmi_t *hmi,
-                          unsigned char msgId,
-                          unsigned int param,
-                          int timeout);
-
-#endif /* HMI_3D_H */
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#ifndef HMI_3D_H
+#define HMI_3D_H
+
+#include "../impl.h"
+
+/* ======== Internal 3D Message Processing ======== */
+
+/* Function: hmi3d_handle_system_status
+ *
+ * The actual handler for System Status (0x15) messages.
+ *
+ * data - The raw data of the message
+ * size - The size of the message
+ *
+ * This function evaluates the response and signals to <wait_response> that
+ * the instruction was processed.
+ *
+ * See also:
+ *    <wait_response>, <hmi3d_message_handle>
+ */
+void hmi3d_handle_system_status(hmi_t *hmi,
+                                const unsigned char *data,
+                                int size);
+
+/* Function: hmi3d_handle_version_info
+ *
+ * The actual handler for Version Info (0x83) messages.
+ *
+ * data - The raw data of the message
+ * size - The size of the message
+ *
+ * See also:
+ *    <hmi3d_message_handle>
+ */
+void hmi3d_handle_version_info(hmi_t *hmi,
+                               const unsigned char *data,
+                               int size);
+
+/* Function: hmi3d_handle_data_output
+ *
+ * The actual handler for Sensor Data Output (0x91) messages.
+ *
+ * data - The raw data of the message
+ *
+ * See alos:
+ *    <hmi3d_message_handle>
+ */
+void hmi3d_handle_data_output(hmi_t *hmi,
+                              const unsigned char *data);
+
+/* Function: hmi3d_sqrt
+ *
+ * Square root by Newton's method, which is precise enough for the
+ * processing of data-frames and avoids the dependency on the math library.
+ *
+ * Returns 0 for values that are not positive.
+ */
+float hmi3d_sqrt(float x);
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+/* Function: hmi3d_update_result
+ *
+ * Copies the state after the last data-frame to the results and turns the
+ * events into counts of samples.
+ *
+ * last_counter - The frame counter of the results before the update
+ *
+ * See also:
+ *    <hmi3d_retrieve_data>, <hmi_retrieve_fused>
+ */
+void hmi3d_update_result(hmi_t *hmi, int last_counter);
+
+/* Function: hmi3d_filter_position
+ *
+ * Filters the position of the last data-frame.
+ *
+ * dest     - The data of the frame
+ * position - Whether the frame contained a valid position
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_position_filter>
+ */
+void hmi3d_filter_position(hmi_t *hmi,
+                           hmi3d_input_data_t *dest,
+                           int position);
+
+/* Function: hmi3d_filter_air_wheel
+ *
+ * Unwraps the AirWheel counter of the last data-frame and filters its
+ * velocity and acceleration.
+ *
+ * dest   - The data of the frame
+ * active - Whether the frame contained valid AirWheel data
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_air_wheel_filter>
+ */
+void hmi3d_filter_air_wheel(hmi_t *hmi,
+                            hmi3d_input_data_t *dest,
+                            int active);
+
+/* Function: hmi3d_update_prediction
+ *
+ * Updates the estimated velocity and acceleration with the filtered
+ * position of the last data-frame.
+ *
+ * dest     - The data of the frame
+ * position - Whether the frame contained a valid position
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_prediction>
+ */
+void hmi3d_update_prediction(hmi_t *hmi,
+                             const hmi3d_input_data_t *dest,
+                             int position);
+
+#ifndef HMI3D_NO_CUSTOM_GESTURES
+
+/* Function: hmi3d_recognize_custom
+ *
+ * Records the last data-frame and recognizes custom gestures.
+ *
+ * dest  - The data of the frame
+ * valid - The <hmi3d_DataOutConfigMask_t> -sections of the frame with
+ *         valid data
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_add_custom_gesture>
+ */
+void hmi3d_recognize_custom(hmi_t *hmi,
+                            hmi3d_input_data_t *dest,
+                            int valid);
+
+#endif
+
+#ifndef HMI3D_NO_SIGNAL_STATS
+
+/* Function: hmi3d_update_signal_stats
+ *
+ * Updates the statistics of the signals with the last data-frame.
+ *
+ * dest  - The data of the frame
+ * valid - The <hmi3d_DataOutConfigMask_t> -sections of the frame with
+ *         valid data
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_signal_stats>
+ */
+void hmi3d_update_signal_stats(hmi_t *hmi,
+                               const hmi3d_input_data_t *dest,
+                               int valid);
+
+#endif
+
+#if !defined(HMI3D_NO_SIGNAL_STATS) || !defined(HMI3D_NO_CALIB_SCHEDULE)
+
+/* Function: hmi3d_stream_stats_reset
+ *
+ * Restarts the statistics of a stream of signals.
+ *
+ * See also:
+ *    <hmi3d_stream_stats_update>
+ */
+void hmi3d_stream_stats_reset(hmi3d_stream_stats_t *stream);
+
+/* Function: hmi3d_stream_stats_update
+ *
+ * Updates the statistics of a stream with the signals of a frame.
+ *
+ * stream - The statistics
+ * config - The parameters of the statistics
+ * signal - The signals of the frame
+ *
+ * See also:
+ *    <hmi3d_update_signal_stats>
+ */
+void hmi3d_stream_stats_update(hmi3d_stream_stats_t *stream,
+                               const hmi3d_signal_stats_config_t *config,
+                               const hmi3d_signal_t *signal);
+
+/* Function: hmi3d_stream_stats_read
+ *
+ * Reads the statistics of a stream.
+ *
+ * Returns HMI_NO_ERROR on success or HMI_NO_DATA if the stream had no
+ * frames yet.
+ *
+ * See also:
+ *    <hmi3d_get_signal_stats>
+ */
+int hmi3d_stream_stats_read(const hmi3d_stream_stats_t *stream,
+                            hmi3d_signal_stats_t *stats);
+
+#endif
+
+/* Function: hmi3d_analyze_noise
+ *
+ * Collects the last data-frame for the noise analysis and analyzes the
+ * interference once enough frames are collected.
+ *
+ * dest  - The data of the frame
+ * valid - The <hmi3d_DataOutConfigMask_t> -sections of the frame with
+ *         valid data
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_noise_analysis>
+ */
+void hmi3d_analyze_noise(hmi_t *hmi,
+                         const hmi3d_input_data_t *dest,
+                         int valid);
+
+#ifndef HMI3D_NO_CALIB_SCHEDULE
+
+/* Function: hmi3d_schedule_calibration
+ *
+ * Tracks the drift of the signals with the last data-frame and records
+ * calibrations.
+ *
+ * dest  - The data of the frame
+ * valid - The <hmi3d_DataOutConfigMask_t> -sections of the frame with
+ *         valid data
+ *
+ * See also:
+ *    <hmi3d_handle_data_output>, <hmi3d_set_calibration_schedule>
+ */
+void hmi3d_schedule_calibration(hmi_t *hmi,
+                                const hmi3d_input_data_t *dest,
+                                int valid);
+
+#endif
+
+#endif
+
+/* Function: hmi3d_handle_runtime_parameter
+ *
+ * The actual handler for Set Runtime Parameter (0xA2) messages.
+ *
+ * data - The raw data of the message
+ *
+ * See alos:
+ *    <hmi3d_message_handle>
+ */
+void hmi3d_handle_runtime_parameter(hmi_t *hmi,
+                                    const unsigned char *data);
+
+/* ======== Internal 3D Instruction Processing ======== */
+
+
+/* Function: hmi3d_request_message
+ *
+ * Requests the message with msg_id from the device.
+ *
+ * msg_id  - The id of the requested message
+ * param   - Optional parameter that specifies the content of the returned
+ *           message for some msg_ids.
+ * timeout - Timeout in milliseconds to wait for a response
+ *
+ * This function returns 0 when the device acknowledged that it sent the
+ * message or a negative value when the request failed.
+ *
+ * After a failure or no response within the timeout the request gets resend
+ * up to three times.
+ */
+int hmi3d_request_message(hmi_t *hmi,
+                          unsigned char msgId,
+                          unsigned int param,
+                          int timeout);
+
+#ifndef HMI3D_NO_UPDATE
+
+/* Function: hmi3d_crc32
+ *
+ * Calculates the CRC-32 checksum that protects messages during
+ * <3D Firmware Update>.
+ *
+ * data - Pointer to the data
+ * size - Size of the data in bytes
+ *
+ * Uses the CRC32 instructions on ARMv8 and a slicing-by-8 table otherwise.
+ */
+unsigned int hmi3d_crc32(const void *data, int size);
+
+/* Function: hmi3d_crc32_update
+ *
+ * Continues a CRC-32 checksum over data that arrives in pieces.
+ *
+ * crc  - The checksum of the preceding data, 0 for the first piece
+ * data - Pointer to the data
+ * size - Size of the data in bytes
+ *
+ * The checksum is the same as used by Zip archives.
+ */
+unsigned int hmi3d_crc32_update(unsigned int crc, const void *data, int size);
+
+/* Function: hmi3d_update_handle_block_ack
+ *
+ * Handles the System Status acknowledging a Fw_Update_Block message while
+ * <hmi3d_update_image_windowed> has blocks in flight.
+ *
+ * error_code - The error code of the System Status message
+ *
+ * See also:
+ *    <hmi3d_handle_system_status>
+ */
+void hmi3d_update_handle_block_ack(hmi_t *hmi, int error_code);
+
+/* Function: hmi3d_update_prepare_start
+ *
+ * Prepares the 28 byte Fw_Update_Start message.
+ */
+void hmi3d_update_prepare_start(unsigned char *msg, unsigned int session_id,
+                                const void *iv, hmi3d_UpdateFunction_t mode);
+
+/* Function: hmi3d_update_prepare_completed
+ *
+ * Prepares the 136 byte Fw_Update_Completed message. The version may be
+ * NULL for the final restart.
+ */
+void hmi3d_update_prepare_completed(unsigned char *msg,
+                                    unsigned int session_id,
+                                    hmi3d_UpdateFunction_t mode,
+                                    const unsigned char *version);
+
+/* Function: hmi3d_update_window_init
+ *
+ * Prepares a window of the given size for a new transfer.
+ */
+void hmi3d_update_window_init(hmi3d_update_window_t *w, int window);
+
+/* Function: hmi3d_update_window_advance
+ *
+ * Sends records until the window is full and moves on to the next segment
+ * once the current one is completely acknowledged.
+ *
+ * Returns 1 when all records were transferred, 0 while records are in
+ * flight or a negative value when the transfer failed.
+ *
+ * Acknowledges have to be forwarded to <hmi3d_update_handle_block_ack> by
+ * setting hmi->flash.window to w.
+ */
+int hmi3d_update_window_advance(hmi_t *hmi, hmi3d_update_window_t *w,
+                                const hmi3d_update_image_t *image,
+                                hmi3d_UpdateFunction_t mode);
+
+/* Function: hmi3d_update_window_timeout
+ *
+ * Handles acknowledges that went missing. The first call drains the
+ * acknowledges still outstanding for the current segment: they are
+ * discarded by <hmi3d_update_handle_block_ack> and the segment is rewound
+ * once all of them arrived. A second call without all of them rewinds the
+ * segment at once.
+ *
+ * Returns <HMI_NO_RESPONSE_ERROR> when the segment was already rewound
+ * three times, otherwise 0.
+ */
+int hmi3d_update_window_timeout(hmi3d_update_window_t *w);
+
+#endif
+
+#endif /* HMI_3D_H */
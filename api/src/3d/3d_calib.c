@@ -0,0 +1,291 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#if !defined(HMI3D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_CALIB_SCHEDULE)
+
+/* Starts tracking the drift after a calibration */
+static void calib_restart(hmi3d_calib_scheduler_t *scheduler, int frame)
+{
+    hmi3d_stream_stats_reset(&scheduler->idle);
+    scheduler->settled = 0;
+    scheduler->max_drift = 0;
+    scheduler->due = 0;
+    scheduler->requested = 0;
+    scheduler->last_calibration = frame;
+}
+
+static void calib_record(hmi3d_calib_scheduler_t *scheduler,
+                         const hmi3d_calib_t *calib)
+{
+    hmi3d_calib_record_t *record = scheduler->log + scheduler->log_head;
+
+    record->reason = calib->reason;
+    record->last_event = calib->last_event;
+    record->drift = scheduler->max_drift;
+    record->scheduled = scheduler->requested;
+
+    scheduler->log_head = (scheduler->log_head + 1) % HMI3D_CALIB_LOG;
+    if(scheduler->log_count < HMI3D_CALIB_LOG)
+        scheduler->log_count++;
+}
+
+void hmi3d_schedule_calibration(hmi_t *hmi,
+                                const hmi3d_input_data_t *dest,
+                                int valid)
+{
+    hmi3d_calib_scheduler_t *scheduler = &hmi->calib_scheduler;
+    const hmi3d_calib_schedule_t *config = &scheduler->config;
+    const hmi3d_signal_t *signal;
+    hmi3d_signal_stats_t stats;
+    int frame = dest->frame_counter;
+    int mask, i;
+
+    if(!scheduler->enabled)
+        return;
+
+    if(dest->calib.last_event == frame) {
+        calib_record(scheduler, &dest->calib);
+        calib_restart(scheduler, frame);
+        return;
+    }
+
+    if(config->stream == hmi3d_stream_cic) {
+        mask = hmi3d_DataOutConfigMask_CICData;
+        signal = &dest->cic;
+    } else {
+        mask = hmi3d_DataOutConfigMask_SDData;
+        signal = &dest->sd;
+    }
+
+    /* Without position in the data output a hand can't be ruled out */
+    if(!(hmi->data_config & hmi3d_DataOutConfigMask_xyzPosition) ||
+            (valid & hmi3d_DataOutConfigMask_xyzPosition) ||
+            dest->touch.touch_flags) {
+        scheduler->idle_count = 0;
+        scheduler->due = 0;
+        return;
+    }
+
+    /* Only the signals of settled frames are averaged, so a leaving hand
+     * doesn't count as drift
+     */
+    if(scheduler->idle_count < config->idle_frames) {
+        scheduler->idle_count++;
+        return;
+    }
+    if(!(valid & mask))
+        return;
+
+    hmi3d_stream_stats_update(&scheduler->idle, &scheduler->stats_config,
+                              signal);
+    hmi3d_stream_stats_read(&scheduler->idle, &stats);
+
+    /* The level of CIC after a calibration is the average of the first
+     * settled frames
+     */
+    if(!scheduler->settled) {
+        if((int)stats.count < config->idle_frames)
+            return;
+        for(i = 0; i < 5; ++i) {
+            scheduler->reference[i] = (config->stream == hmi3d_stream_cic)
+                                      ? stats.ewma.channel[i] : 0.0f;
+        }
+        scheduler->settled = 1;
+    }
+
+    scheduler->max_drift = 0;
+    for(i = 0; i < 5; ++i) {
+        float drift = stats.ewma.channel[i] - scheduler->reference[i];
+
+        scheduler->drift[i] = drift < 0 ? -drift : drift;
+        if(i < hmi->data_electrodes && scheduler->drift[i] >
+                scheduler->max_drift)
+            scheduler->max_drift = scheduler->drift[i];
+    }
+
+    scheduler->due = scheduler->max_drift > config->threshold &&
+                     frame - scheduler->last_calibration >=
+                     config->min_interval;
+}
+
+int hmi3d_set_calibration_schedule(hmi_t *hmi,
+                                   const hmi3d_calib_schedule_t *schedule)
+{
+    HMI_ASSERT(hmi);
+
+    if(schedule && ((schedule->stream != hmi3d_stream_cic &&
+                     schedule->stream != hmi3d_stream_sd) ||
+                    schedule->threshold <= 0 ||
+                    schedule->ewma_alpha <= 0 || schedule->ewma_alpha > 1 ||
+                    schedule->idle_frames < 1 || schedule->min_interval < 0))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->calib_scheduler.enabled = (schedule != NULL);
+    if(schedule) {
+        hmi3d_calib_scheduler_t *scheduler = &hmi->calib_scheduler;
+
+        scheduler->config = *schedule;
+        /* Only the averages are used, the window of the percentiles is
+         * arbitrary
+         */
+        scheduler->stats_config.ewma_alpha = schedule->ewma_alpha;
+        scheduler->stats_config.window = 256;
+        scheduler->idle_count = 0;
+        scheduler->log_head = 0;
+        scheduler->log_count = 0;
+        calib_restart(scheduler, hmi->internal.frame_counter);
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_get_calibration_drift(hmi_t *hmi, hmi3d_signal_t *drift)
+{
+    int result = HMI_NO_DATA;
+    int i;
+
+    HMI_ASSERT(hmi && drift);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(hmi->calib_scheduler.enabled && hmi->calib_scheduler.settled) {
+        for(i = 0; i < 5; ++i)
+            drift->channel[i] = hmi->calib_scheduler.drift[i];
+        result = HMI_NO_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+int hmi3d_get_calibration_log(hmi_t *hmi,
+                              hmi3d_calib_record_t *records,
+                              int size)
+{
+    const hmi3d_calib_scheduler_t *scheduler;
+    int count, first, i;
+
+    HMI_ASSERT(hmi && (records || size <= 0));
+
+    scheduler = &hmi->calib_scheduler;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    count = scheduler->log_count < size ? scheduler->log_count : size;
+    if(count < 0)
+        count = 0;
+    first = scheduler->log_head - scheduler->log_count + HMI3D_CALIB_LOG;
+    for(i = 0; i < count; ++i)
+        records[i] = scheduler->log[(first + i) % HMI3D_CALIB_LOG];
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return count;
+}
+
+#ifndef HMI3D_NO_RTC
+
+int hmi3d_update_calibration(hmi_t *hmi)
+{
+    hmi3d_calib_scheduler_t *scheduler;
+    int last_calibration;
+    int due;
+    int error;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    scheduler = &hmi->calib_scheduler;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    /* The request counts as one before it is sent, so a calibration that
+     * is reported while waiting for the response clears it again
+     */
+    due = scheduler->enabled && scheduler->due;
+    last_calibration = scheduler->last_calibration;
+    if(due) {
+        scheduler->requested = 1;
+        scheduler->due = 0;
+        scheduler->last_calibration = hmi->internal.frame_counter;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    if(!due)
+        return HMI_NO_ERROR;
+
+    /* The request waits for the response, which is received by the
+     * message-handler, so no lock is held meanwhile
+     */
+    error = hmi3d_force_calibration(hmi);
+    if(error) {
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+        /* A failed request leaves the calibration due */
+        if(scheduler->requested) {
+            scheduler->requested = 0;
+            scheduler->due = 1;
+            scheduler->last_calibration = last_calibration;
+        }
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+    }
+
+    return error;
+}
+
+#endif
+
+#endif
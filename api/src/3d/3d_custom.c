@@ -0,0 +1,518 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#if !defined(HMI3D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_CUSTOM_GESTURES)
+
+#if !defined(HMI3D_NO_SIMD)
+#   if defined(__SSE__)
+#       include <xmmintrin.h>
+#       define HMI3D_CUSTOM_SSE
+#   elif defined(__ARM_NEON)
+#       include <arm_neon.h>
+#       define HMI3D_CUSTOM_NEON
+#   endif
+#endif
+
+#define CUSTOM_INFINITY 1e30f
+
+/* Movements whose positions deviate less from their mean are too small to
+ * be gestures
+ */
+#define CUSTOM_MIN_SPREAD 500.0f
+
+/* Every point of a gesture holds x, y, z and SD in one group of 4 floats,
+ * so a point is compared with single vector instructions where available.
+ */
+
+/* Squared distance of two points */
+static HMI_FORCE_INLINE float point_distance(const float *a, const float *b)
+{
+#if defined(HMI3D_CUSTOM_SSE)
+    __m128 d = _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+    d = _mm_mul_ps(d, d);
+    d = _mm_add_ps(d, _mm_movehl_ps(d, d));
+    d = _mm_add_ss(d, _mm_shuffle_ps(d, d, 1));
+    return _mm_cvtss_f32(d);
+#elif defined(HMI3D_CUSTOM_NEON)
+    float32x4_t d = vsubq_f32(vld1q_f32(a), vld1q_f32(b));
+    float32x2_t s;
+    d = vmulq_f32(d, d);
+    s = vadd_f32(vget_low_f32(d), vget_high_f32(d));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+    float d0 = a[0] - b[0], d1 = a[1] - b[1];
+    float d2 = a[2] - b[2], d3 = a[3] - b[3];
+    return d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3;
+#endif
+}
+
+/* LB_Keogh: Sum of the squared distances of the query points to the
+ * envelope of a gesture. No alignment within the band comes closer.
+ */
+static float lower_bound(const float (*query)[4],
+                         const hmi3d_custom_template_t *templ)
+{
+#if defined(HMI3D_CUSTOM_SSE)
+    __m128 zero = _mm_setzero_ps();
+    __m128 sum = zero;
+    int i;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        __m128 q = _mm_loadu_ps(query[i]);
+        __m128 above = _mm_sub_ps(q, _mm_loadu_ps(templ->upper[i]));
+        __m128 below = _mm_sub_ps(_mm_loadu_ps(templ->lower[i]), q);
+        __m128 d = _mm_add_ps(_mm_max_ps(above, zero),
+                              _mm_max_ps(below, zero));
+        sum = _mm_add_ps(sum, _mm_mul_ps(d, d));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+#elif defined(HMI3D_CUSTOM_NEON)
+    float32x4_t zero = vdupq_n_f32(0);
+    float32x4_t sum = zero;
+    float32x2_t s;
+    int i;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        float32x4_t q = vld1q_f32(query[i]);
+        float32x4_t above = vsubq_f32(q, vld1q_f32(templ->upper[i]));
+        float32x4_t below = vsubq_f32(vld1q_f32(templ->lower[i]), q);
+        float32x4_t d = vaddq_f32(vmaxq_f32(above, zero),
+                                  vmaxq_f32(below, zero));
+        sum = vmlaq_f32(sum, d, d);
+    }
+    s = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+    float sum = 0;
+    int i, k;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        for(k = 0; k < 4; ++k) {
+            float d = 0;
+            if(query[i][k] > templ->upper[i][k])
+                d = query[i][k] - templ->upper[i][k];
+            else if(query[i][k] < templ->lower[i][k])
+                d = templ->lower[i][k] - query[i][k];
+            sum += d * d;
+        }
+    }
+    return sum;
+#endif
+}
+
+/* Dynamic time warping within the band around the diagonal.
+ * Returns the sum of the squared distances along the best alignment or
+ * CUSTOM_INFINITY as soon as it can't stay below limit.
+ */
+static float warp_distance(const float (*query)[4],
+                           const float (*point)[4],
+                           float limit)
+{
+    float row[2][HMI3D_CUSTOM_POINTS];
+    float *prev = row[0];
+    float *cur = row[1];
+    int i, j;
+
+    for(j = 0; j < HMI3D_CUSTOM_POINTS; ++j)
+        prev[j] = CUSTOM_INFINITY;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        int first = i > HMI3D_CUSTOM_BAND ? i - HMI3D_CUSTOM_BAND : 0;
+        int last = i + HMI3D_CUSTOM_BAND < HMI3D_CUSTOM_POINTS ?
+                   i + HMI3D_CUSTOM_BAND : HMI3D_CUSTOM_POINTS - 1;
+        float row_min = CUSTOM_INFINITY;
+        float *swap;
+
+        for(j = 0; j < HMI3D_CUSTOM_POINTS; ++j)
+            cur[j] = CUSTOM_INFINITY;
+
+        for(j = first; j <= last; ++j) {
+            float best;
+
+            if(i == 0 && j == 0) {
+                best = 0;
+            } else {
+                best = prev[j];
+                if(j > 0 && cur[j - 1] < best)
+                    best = cur[j - 1];
+                if(j > 0 && prev[j - 1] < best)
+                    best = prev[j - 1];
+            }
+            cur[j] = best + point_distance(query[i], point[j]);
+            if(cur[j] < row_min)
+                row_min = cur[j];
+        }
+
+        /* Every alignment passes this row */
+        if(row_min >= limit)
+            return CUSTOM_INFINITY;
+
+        swap = prev;
+        prev = cur;
+        cur = swap;
+    }
+
+    return prev[HMI3D_CUSTOM_POINTS - 1];
+}
+
+/* Resamples the last frames of the history to the points of a gesture and
+ * normalizes them. The positions are centered and scaled by their spread,
+ * the SD is standardized.
+ *
+ * Returns 0 if the positions hardly moved.
+ */
+static int sample_gesture(const hmi3d_custom_t *custom,
+                          int frames,
+                          float (*point)[4])
+{
+    float mean[4] = { 0, 0, 0, 0 };
+    float spread = 0, sd_spread = 0;
+    int i, k;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        /* Position of the point within the frames from the oldest on */
+        float at = (float)i * (frames - 1) / (HMI3D_CUSTOM_POINTS - 1);
+        int frame = (int)at;
+        float weight = at - frame;
+        int index = custom->head - frames + frame;
+        const float *a, *b;
+
+        if(index < 0)
+            index += HMI3D_CUSTOM_HISTORY;
+        a = custom->history[index];
+        b = custom->history[(index + 1) % HMI3D_CUSTOM_HISTORY];
+        if(frame == frames - 1)
+            b = a;
+
+        for(k = 0; k < 4; ++k) {
+            point[i][k] = a[k] + weight * (b[k] - a[k]);
+            mean[k] += point[i][k];
+        }
+    }
+
+    for(k = 0; k < 4; ++k)
+        mean[k] /= HMI3D_CUSTOM_POINTS;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        for(k = 0; k < 4; ++k)
+            point[i][k] -= mean[k];
+        spread += point[i][0] * point[i][0] + point[i][1] * point[i][1] +
+                  point[i][2] * point[i][2];
+        sd_spread += point[i][3] * point[i][3];
+    }
+
+    spread = hmi3d_sqrt(spread / HMI3D_CUSTOM_POINTS);
+    sd_spread = hmi3d_sqrt(sd_spread / HMI3D_CUSTOM_POINTS);
+    if(spread < CUSTOM_MIN_SPREAD)
+        return 0;
+
+    for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+        for(k = 0; k < 3; ++k)
+            point[i][k] /= spread;
+        point[i][3] = (sd_spread > 0) ? point[i][3] / sd_spread : 0;
+    }
+
+    return 1;
+}
+
+/* Returns the storage of the gestures and its count of entries */
+static hmi3d_custom_template_t *custom_storage(hmi3d_custom_t *custom,
+                                               int *capacity)
+{
+    if(!custom->templ) {
+        *capacity = HMI3D_CUSTOM_MAX_GESTURES;
+        return custom->builtin;
+    }
+    *capacity = custom->capacity;
+    return custom->templ;
+}
+
+/* Durations of the movements compared with a gesture in tenths of the
+ * duration of the gesture
+ */
+static const int custom_scale[] = { 8, 9, 10, 11, 12 };
+
+/* Compares the last movement with all gestures and returns the index of
+ * the closest gesture within its threshold or -1
+ */
+static int find_gesture(hmi3d_custom_t *custom, float *distance)
+{
+    float query[HMI3D_CUSTOM_POINTS][4];
+    float best = CUSTOM_INFINITY;
+    hmi3d_custom_template_t *storage;
+    int found = -1;
+    int capacity, s, n;
+
+    storage = custom_storage(custom, &capacity);
+
+    for(s = 0; s < (int)(sizeof(custom_scale) / sizeof(custom_scale[0]));
+            ++s)
+    {
+        /* Frames of the query and whether they hold a movement */
+        int sampled = 0;
+        int moved = 0;
+        int index = custom->first;
+
+        for(n = 0; n < custom->count; ++n, index = storage[index].next) {
+            const hmi3d_custom_template_t *templ = storage + index;
+            int frames = templ->gesture.frames * custom_scale[s] / 10;
+            float limit, d;
+
+            if(frames < 2 || frames > custom->valid)
+                continue;
+
+            /* Gestures of the same duration share the query */
+            if(frames != sampled) {
+                sampled = frames;
+                moved = sample_gesture(custom, frames, query);
+            }
+            if(!moved)
+                continue;
+
+            limit = templ->gesture.threshold * HMI3D_CUSTOM_POINTS;
+            if(best < limit)
+                limit = best;
+
+            if(lower_bound((const float (*)[4])query, templ) >= limit)
+                continue;
+
+            d = warp_distance((const float (*)[4])query,
+                              (const float (*)[4])templ->gesture.point,
+                              limit);
+            if(d < limit) {
+                best = d;
+                found = index;
+            }
+        }
+    }
+
+    *distance = best;
+    return found;
+}
+
+/* Reports the pending gesture and waits for the next movement */
+static void report_gesture(hmi3d_custom_t *custom, hmi3d_input_data_t *dest)
+{
+    dest->gesture.gesture =
+            (hmi3d_gestures_t)(hmi3d_gest_custom + custom->pending - 1);
+    dest->gesture.flags = 0;
+    dest->gesture.last_event = dest->frame_counter;
+
+    custom->pending = 0;
+    custom->valid = 0;
+}
+
+void hmi3d_recognize_custom(hmi_t *hmi,
+                            hmi3d_input_data_t *dest,
+                            int valid)
+{
+    hmi3d_custom_t *custom = &hmi->custom;
+    float *entry;
+    float distance;
+    int found, i;
+
+    /* Only consecutive frames with the hand present form a movement */
+    if(!(valid & hmi3d_DataOutConfigMask_xyzPosition)) {
+        if(custom->pending)
+            report_gesture(custom, dest);
+        custom->valid = 0;
+        return;
+    }
+
+    entry = custom->history[custom->head];
+    entry[0] = (float)dest->filtered_pos.x;
+    entry[1] = (float)dest->filtered_pos.y;
+    entry[2] = (float)dest->filtered_pos.z;
+    entry[3] = 0;
+    if(valid & hmi3d_DataOutConfigMask_SDData) {
+        for(i = 0; i < hmi->data_electrodes; ++i)
+            entry[3] += dest->sd.channel[i];
+    }
+    custom->head = (custom->head + 1) % HMI3D_CUSTOM_HISTORY;
+    if(custom->valid < HMI3D_CUSTOM_HISTORY)
+        custom->valid++;
+
+    if(!custom->count)
+        return;
+
+    /* A match is only reported when the following frames match no better,
+     * so the end of a gesture doesn't trigger a similar shorter one.
+     */
+    found = find_gesture(custom, &distance);
+    if(found >= 0 && (!custom->pending ||
+                      distance < custom->pending_distance))
+    {
+        custom->pending = found + 1;
+        custom->pending_distance = distance;
+        custom->pending_age = 0;
+    } else if(custom->pending &&
+              ++custom->pending_age >= HMI3D_CUSTOM_SETTLE) {
+        report_gesture(custom, dest);
+    }
+}
+
+int hmi3d_capture_custom_gesture(hmi_t *hmi,
+                                 int frames,
+                                 float threshold,
+                                 hmi3d_custom_gesture_t *gesture)
+{
+    int result = HMI_NO_ERROR;
+
+    HMI_ASSERT(hmi && gesture);
+
+    if(frames < 2 || frames > HMI3D_CUSTOM_HISTORY || threshold <= 0)
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(frames > hmi->custom.valid ||
+            !sample_gesture(&hmi->custom, frames, gesture->point))
+        result = HMI_NO_DATA;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    gesture->frames = frames;
+    gesture->threshold = threshold;
+
+    return result;
+}
+
+int hmi3d_set_custom_storage(hmi_t *hmi,
+                             hmi3d_custom_template_t *templates,
+                             int count)
+{
+    HMI_ASSERT(hmi);
+
+    if(templates && count < 1)
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->custom.templ = templates;
+    hmi->custom.capacity = count;
+    hmi->custom.count = 0;
+    hmi->custom.pending = 0;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_add_custom_gesture(hmi_t *hmi,
+                             const hmi3d_custom_gesture_t *gesture)
+{
+    hmi3d_custom_template_t *storage, *templ;
+    int i, j, k, index, capacity;
+
+    HMI_ASSERT(hmi && gesture);
+
+    if(gesture->frames < 2 || gesture->frames > HMI3D_CUSTOM_HISTORY ||
+            gesture->threshold <= 0)
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    storage = custom_storage(&hmi->custom, &capacity);
+    index = hmi->custom.count;
+    if(index < capacity) {
+        hmi3d_custom_t *custom = &hmi->custom;
+        int *link = &custom->first;
+
+        templ = storage + index;
+        templ->gesture = *gesture;
+        for(i = 0; i < HMI3D_CUSTOM_POINTS; ++i) {
+            for(k = 0; k < 4; ++k) {
+                templ->upper[i][k] = -CUSTOM_INFINITY;
+                templ->lower[i][k] = CUSTOM_INFINITY;
+            }
+            for(j = i - HMI3D_CUSTOM_BAND; j <= i + HMI3D_CUSTOM_BAND; ++j) {
+                if(j < 0 || j >= HMI3D_CUSTOM_POINTS)
+                    continue;
+                for(k = 0; k < 4; ++k) {
+                    if(gesture->point[j][k] > templ->upper[i][k])
+                        templ->upper[i][k] = gesture->point[j][k];
+                    if(gesture->point[j][k] < templ->lower[i][k])
+                        templ->lower[i][k] = gesture->point[j][k];
+                }
+            }
+        }
+
+        /* Gestures of the same duration are visited one after another, so
+         * they share the sampling of the history
+         */
+        for(i = 0; i < index && storage[*link].gesture.frames <=
+                gesture->frames; ++i)
+            link = &storage[*link].next;
+        templ->next = *link;
+        *link = index;
+        custom->count++;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    if(index >= capacity)
+        return HMI_BAD_PARAM_ERROR;
+
+    return hmi3d_gest_custom + index;
+}
+
+void hmi3d_clear_custom_gestures(hmi_t *hmi)
+{
+    HMI_ASSERT(hmi);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->custom.count = 0;
+    hmi->custom.pending = 0;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+#endif
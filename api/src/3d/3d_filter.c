@@ -0,0 +1,370 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+#define FILTER_TWO_PI 6.2831853f
+
+/* Smoothing factor of an exponential low-pass filter with cutoff frequency
+ * fc for samples te seconds apart
+ */
+static HMI_FORCE_INLINE float filter_alpha(float fc, float te)
+{
+    float r = FILTER_TWO_PI * fc * te;
+    return r / (r + 1.0f);
+}
+
+static HMI_FORCE_INLINE int filter_round(float value)
+{
+    return (int)(value + 0.5f);
+}
+
+void hmi3d_filter_position(hmi_t *hmi,
+                           hmi3d_input_data_t *dest,
+                           int position)
+{
+    hmi3d_filter_t *filter = &hmi->pos_filter;
+    const hmi3d_position_filter_t *config = &filter->config;
+    float raw[3];
+    float te, rate, speed_alpha;
+    int i;
+
+    if(!filter->enabled) {
+        dest->filtered_pos = dest->pos;
+        return;
+    }
+
+    /* Positions before and after a calibration are not comparable */
+    if(dest->calib.last_event == dest->frame_counter)
+        filter->primed = 0;
+
+    if(!position)
+        return;
+
+    raw[0] = (float)dest->pos.x;
+    raw[1] = (float)dest->pos.y;
+    raw[2] = (float)dest->pos.z;
+
+    if(!filter->primed) {
+        for(i = 0; i < 3; ++i) {
+            filter->value[i] = raw[i];
+            filter->speed[i] = 0;
+        }
+        filter->primed = 1;
+    } else {
+        /* Consecutive samples use the factors cached by
+         * hmi3d_set_position_filter
+         */
+        int frames = dest->frame_counter - filter->last_frame;
+        if(frames == 1) {
+            te = filter->te;
+            rate = config->sample_rate;
+            speed_alpha = filter->speed_alpha;
+        } else {
+            te = frames / config->sample_rate;
+            rate = 1.0f / te;
+            speed_alpha = filter_alpha(config->d_cutoff, te);
+        }
+
+        for(i = 0; i < 3; ++i) {
+            float speed = (raw[i] - filter->value[i]) * rate;
+            float cutoff;
+
+            filter->speed[i] += speed_alpha * (speed - filter->speed[i]);
+            cutoff = config->min_cutoff + config->beta *
+                     (filter->speed[i] < 0 ? -filter->speed[i]
+                                           : filter->speed[i]);
+            filter->value[i] += filter_alpha(cutoff, te) *
+                                (raw[i] - filter->value[i]);
+        }
+    }
+
+    filter->last_frame = dest->frame_counter;
+    dest->filtered_pos.x = filter_round(filter->value[0]);
+    dest->filtered_pos.y = filter_round(filter->value[1]);
+    dest->filtered_pos.z = filter_round(filter->value[2]);
+}
+
+int hmi3d_set_position_filter(hmi_t *hmi,
+                              const hmi3d_position_filter_t *filter)
+{
+    HMI_ASSERT(hmi);
+
+    if(filter && (filter->min_cutoff <= 0 || filter->beta < 0 ||
+                  filter->d_cutoff <= 0 || filter->sample_rate <= 0))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->pos_filter.enabled = (filter != NULL);
+    if(filter) {
+        hmi->pos_filter.config = *filter;
+        hmi->pos_filter.te = 1.0f / filter->sample_rate;
+        hmi->pos_filter.speed_alpha = filter_alpha(filter->d_cutoff,
+                                                   hmi->pos_filter.te);
+    }
+    hmi->pos_filter.primed = 0;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+void hmi3d_update_prediction(hmi_t *hmi,
+                             const hmi3d_input_data_t *dest,
+                             int position)
+{
+    hmi3d_predictor_t *pred = &hmi->predictor;
+    float raw[3];
+    float te, alpha;
+    int i;
+
+    if(!pred->enabled)
+        return;
+
+    /* Positions before and after a calibration are not comparable and
+     * without a hand there is nothing to predict
+     */
+    if(!position || dest->calib.last_event == dest->frame_counter) {
+        pred->primed = 0;
+        if(!position)
+            return;
+    }
+
+    raw[0] = (float)dest->filtered_pos.x;
+    raw[1] = (float)dest->filtered_pos.y;
+    raw[2] = (float)dest->filtered_pos.z;
+
+    if(!pred->primed) {
+        for(i = 0; i < 3; ++i) {
+            pred->value[i] = raw[i];
+            pred->velocity[i] = 0;
+            pred->acceleration[i] = 0;
+            pred->reversed[i] = 0;
+        }
+        pred->primed = 1;
+        pred->moving = 0;
+    } else {
+        te = (dest->frame_counter - pred->last_frame) /
+             pred->config.sample_rate;
+        alpha = filter_alpha(pred->config.cutoff, te);
+
+        for(i = 0; i < 3; ++i) {
+            float speed = (raw[i] - pred->value[i]) / te;
+            float velocity = pred->velocity[i] +
+                             alpha * (speed - pred->velocity[i]);
+
+            pred->reversed[i] = (speed > 0 && pred->velocity[i] < 0) ||
+                                (speed < 0 && pred->velocity[i] > 0);
+            /* The first velocity has no earlier one to take an
+             * acceleration from
+             */
+            if(pred->moving)
+                pred->acceleration[i] += alpha *
+                        ((velocity - pred->velocity[i]) / te -
+                         pred->acceleration[i]);
+            pred->velocity[i] = velocity;
+            pred->value[i] = raw[i];
+        }
+        pred->moving = 1;
+    }
+
+    pred->last_frame = dest->frame_counter;
+    pred->time = hmi->arrival3d;
+}
+
+int hmi3d_set_prediction(hmi_t *hmi,
+                         const hmi3d_prediction_config_t *config)
+{
+    HMI_ASSERT(hmi);
+
+    if(config && (config->cutoff <= 0 || config->max_lead_ms < 0 ||
+                  config->sample_rate <= 0))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->predictor.enabled = (config != NULL);
+    if(config)
+        hmi->predictor.config = *config;
+    hmi->predictor.primed = 0;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_predict_position(hmi_t *hmi,
+                           unsigned int target,
+                           hmi3d_position_t *position)
+{
+    hmi3d_predictor_t *pred;
+    int result = HMI_NO_DATA;
+    float value[3];
+    float lead, max_lead;
+    int i;
+
+    HMI_ASSERT(hmi && position);
+
+    pred = &hmi->predictor;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(pred->enabled && pred->primed) {
+        lead = (int)(target - pred->time) * 1e-6f;
+        max_lead = pred->config.max_lead_ms * 1e-3f;
+        if(lead < 0)
+            lead = 0;
+        if(lead > max_lead)
+            lead = max_lead;
+
+        for(i = 0; i < 3; ++i) {
+            float v = pred->velocity[i];
+            float a = pred->acceleration[i];
+            float t = lead;
+
+            value[i] = pred->value[i];
+            if(pred->reversed[i])
+                continue;
+
+            /* Stop where the deceleration turns the axis around */
+            if(v * a < 0 && t > -v / a)
+                t = -v / a;
+            value[i] += (v + 0.5f * a * t) * t;
+
+            if(value[i] < 0)
+                value[i] = 0;
+            else if(value[i] > 65535)
+                value[i] = 65535;
+        }
+
+        position->x = filter_round(value[0]);
+        position->y = filter_round(value[1]);
+        position->z = filter_round(value[2]);
+        result = HMI_NO_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+/* Defaults of the AirWheel filter until hmi3d_set_air_wheel_filter */
+#define AIR_WHEEL_CUTOFF 4.0f
+#define AIR_WHEEL_SAMPLE_RATE 200.0f
+
+void hmi3d_filter_air_wheel(hmi_t *hmi,
+                            hmi3d_input_data_t *dest,
+                            int active)
+{
+    hmi3d_air_wheel_state_t *state = &hmi->air_wheel;
+    hmi3d_air_wheel_t *wheel = &dest->air_wheel;
+    float cutoff = state->config.cutoff;
+    float rate = state->config.sample_rate;
+    float te, alpha, velocity;
+    int delta;
+
+    if(!active) {
+        wheel->velocity = 0;
+        wheel->acceleration = 0;
+        state->tracking = 0;
+        return;
+    }
+
+    if(rate <= 0) {
+        cutoff = AIR_WHEEL_CUTOFF;
+        rate = AIR_WHEEL_SAMPLE_RATE;
+    }
+
+    /* The counter only changes while AirWheel is active and a turn is 32
+     * counts, so the 8-bit difference never wraps between two frames
+     */
+    delta = 0;
+    if(state->primed)
+        delta = (signed char)(unsigned char)(wheel->counter - state->counter);
+    state->counter = wheel->counter;
+    state->primed = 1;
+    wheel->rotation += delta;
+
+    /* The first active frame has no earlier one to take a speed from */
+    if(!state->tracking) {
+        state->tracking = 1;
+        state->last_frame = dest->frame_counter;
+        return;
+    }
+
+    te = (dest->frame_counter - state->last_frame) / rate;
+    state->last_frame = dest->frame_counter;
+    if(te <= 0)
+        return;
+
+    alpha = filter_alpha(cutoff, te);
+    velocity = wheel->velocity + alpha * (delta / te - wheel->velocity);
+    wheel->acceleration += alpha * ((velocity - wheel->velocity) / te -
+                                    wheel->acceleration);
+    wheel->velocity = velocity;
+}
+
+int hmi3d_set_air_wheel_filter(hmi_t *hmi,
+                               const hmi3d_air_wheel_filter_t *filter)
+{
+    HMI_ASSERT(hmi && filter);
+
+    if(filter->cutoff <= 0 || filter->sample_rate <= 0)
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->air_wheel.config = *filter;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+#endif
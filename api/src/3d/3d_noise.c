@@ -0,0 +1,447 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+
+#define NOISE_HALF (HMI3D_NOISE_SAMPLES / 2)
+
+#if HMI3D_NOISE_SAMPLES < 8 || (HMI3D_NOISE_SAMPLES & (HMI3D_NOISE_SAMPLES - 1))
+#   error "HMI3D_NOISE_SAMPLES has to be a power of 2 of at least 8"
+#endif
+
+/* Fills the twiddle factors cos(2 pi k / N) and sin(2 pi k / N) for k up
+ * to N / 2 and the Hann window. The angle 2 pi / N is reached by halving a
+ * right angle, which needs nothing but square roots.
+ */
+static void noise_init_tables(hmi3d_noise_t *noise)
+{
+    double c = 0, s = 1, cr, ci, t;
+    int n, k;
+
+    for(n = 4; n < HMI3D_NOISE_SAMPLES; n *= 2) {
+        c = hmi3d_sqrt((float)((1 + c) / 2));
+        s = s / (2 * c);
+    }
+
+    cr = 1;
+    ci = 0;
+    for(k = 0; k <= NOISE_HALF; ++k) {
+        noise->cos_table[k] = (float)cr;
+        noise->sin_table[k] = (float)ci;
+        t = cr * c - ci * s;
+        ci = cr * s + ci * c;
+        cr = t;
+    }
+
+    for(k = 0; k < HMI3D_NOISE_SAMPLES; ++k) {
+        float cosine = noise->cos_table[k <= NOISE_HALF ? k
+                                        : HMI3D_NOISE_SAMPLES - k];
+        noise->window[k] = 0.5f - 0.5f * cosine;
+    }
+}
+
+/* In-place radix-2 FFT of N / 2 complex values */
+static void noise_fft(const hmi3d_noise_t *noise, float *re, float *im)
+{
+    int i, j, k, bit, len, step;
+    float t;
+
+    for(i = 1, j = 0; i < NOISE_HALF; ++i) {
+        for(bit = NOISE_HALF >> 1; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if(i < j) {
+            t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for(len = 2; len <= NOISE_HALF; len <<= 1) {
+        step = HMI3D_NOISE_SAMPLES / len;
+        for(i = 0; i < NOISE_HALF; i += len) {
+            for(k = 0; k < len / 2; ++k) {
+                float wr = noise->cos_table[k * step];
+                float wi = -noise->sin_table[k * step];
+                int a = i + k;
+                int b = a + len / 2;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+/* Power spectrum of N real samples. The even and odd samples form N / 2
+ * complex values whose FFT is split into the bins of the real signal.
+ */
+static void noise_spectrum(const hmi3d_noise_t *noise,
+                           const float *samples,
+                           float *power)
+{
+    float re[NOISE_HALF], im[NOISE_HALF];
+    int k;
+
+    for(k = 0; k < NOISE_HALF; ++k) {
+        re[k] = samples[2 * k];
+        im[k] = samples[2 * k + 1];
+    }
+
+    noise_fft(noise, re, im);
+
+    for(k = 0; k <= NOISE_HALF; ++k) {
+        int a = k % NOISE_HALF;
+        int b = (NOISE_HALF - k) % NOISE_HALF;
+        /* Spectra of the even and the odd samples */
+        float er = 0.5f * (re[a] + re[b]);
+        float ei = 0.5f * (im[a] - im[b]);
+        float or_ = 0.5f * (im[a] + im[b]);
+        float oi = -0.5f * (re[a] - re[b]);
+        float wr = noise->cos_table[k];
+        float wi = -noise->sin_table[k];
+        float xr = er + wr * or_ - wi * oi;
+        float xi = ei + wr * oi + wi * or_;
+
+        power[k] = xr * xr + xi * xi;
+    }
+}
+
+/* Starts collecting the next frames */
+static void noise_restart(hmi3d_noise_t *noise)
+{
+    noise->fill = 0;
+    noise->noise_sum = 0;
+    noise->noise_count = 0;
+}
+
+/* Selects the frequencies whose interference is within the threshold of
+ * the cleanest one. Allowed frequencies are only excluded beyond the
+ * hysteresis and not measured ones stay allowed.
+ */
+static void noise_select(hmi3d_noise_t *noise, int frame)
+{
+    const hmi3d_noise_config_t *config = &noise->config;
+    float best = 3.4e38f;
+    int fresh = 0, available = 0, selected = noise->selected;
+    int count = 0, i;
+
+    if(frame - noise->last_change < config->hold)
+        return;
+
+    for(i = 0; i < 5; ++i) {
+        if(!config->frequency[i])
+            continue;
+        available |= 1 << i;
+        if((noise->analyzed & (1 << i)) &&
+                frame - noise->measured[i] <= config->retry) {
+            fresh |= 1 << i;
+            if(noise->interference[i] < best)
+                best = noise->interference[i];
+        }
+    }
+
+    for(i = 0; i < 5; ++i) {
+        int bit = 1 << i;
+
+        if(!(available & bit))
+            continue;
+
+        if(!(fresh & bit))
+            selected |= bit;
+        else if(noise->interference[i] <= best * config->threshold)
+            selected |= bit;
+        else if(noise->interference[i] > best * config->threshold *
+                                         config->hysteresis)
+            selected &= ~bit;
+    }
+    selected &= available;
+
+    for(i = 0; i < 5; ++i) {
+        if(selected & (1 << i))
+            ++count;
+    }
+
+    /* Allow the cleanest of the excluded frequencies again */
+    while(count < config->min_frequencies) {
+        int cleanest = -1;
+
+        for(i = 0; i < 5; ++i) {
+            if((available & ~selected & (1 << i)) && (cleanest < 0 ||
+                    noise->interference[i] < noise->interference[cleanest]))
+                cleanest = i;
+        }
+        if(cleanest < 0)
+            break;
+        selected |= 1 << cleanest;
+        ++count;
+    }
+
+    if(selected != noise->selected) {
+        noise->selected = selected;
+        noise->last_change = frame;
+    }
+}
+
+/* Estimates the interference from the collected frames */
+static void noise_analyze_block(hmi3d_noise_t *noise, int frame)
+{
+    const hmi3d_noise_config_t *config = &noise->config;
+    float samples[HMI3D_NOISE_SAMPLES];
+    float power[NOISE_HALF + 1];
+    float mean = 0, energy = 0, band = 0, value;
+    int f = noise->current;
+    int k;
+
+    for(k = 0; k < HMI3D_NOISE_SAMPLES; ++k)
+        mean += noise->samples[k];
+    mean /= HMI3D_NOISE_SAMPLES;
+
+    for(k = 0; k < HMI3D_NOISE_SAMPLES; ++k) {
+        samples[k] = (noise->samples[k] - mean) * noise->window[k];
+        energy += noise->window[k] * noise->window[k];
+    }
+
+    if(config->spectrum)
+        config->spectrum(config->opaque, samples, power);
+    else
+        noise_spectrum(noise, samples, power);
+
+    /* Bins between 0 and N / 2 stand for two bins of the full spectrum.
+     * Scaled by Parseval's theorem the band holds the variance of the
+     * interference.
+     */
+    for(k = config->cutoff; k < NOISE_HALF; ++k)
+        band += 2 * power[k];
+    band += power[NOISE_HALF];
+    value = band / (HMI3D_NOISE_SAMPLES * energy);
+
+    if(noise->noise_count)
+        value += noise->noise_sum / noise->noise_count;
+
+    /* Blocks of a frequency are averaged to smooth out single bursts. An
+     * estimate older than the retry interval is replaced.
+     */
+    if((noise->analyzed & (1 << f)) &&
+            frame - noise->measured[f] <= config->retry)
+        noise->interference[f] += 0.25f * (value - noise->interference[f]);
+    else
+        noise->interference[f] = value;
+    noise->measured[f] = frame;
+    noise->analyzed |= 1 << f;
+
+    noise_select(noise, frame);
+}
+
+void hmi3d_analyze_noise(hmi_t *hmi,
+                         const hmi3d_input_data_t *dest,
+                         int valid)
+{
+    hmi3d_noise_t *noise = &hmi->noise;
+    int frame = dest->frame_counter;
+    float sum = 0;
+    int f, i;
+
+    if(!noise->enabled)
+        return;
+
+    if(!(valid & hmi3d_DataOutConfigMask_DSPStatus) ||
+            !(valid & hmi3d_DataOutConfigMask_CICData)) {
+        noise_restart(noise);
+        return;
+    }
+
+    for(f = 0; f < 5; ++f) {
+        if(noise->config.frequency[f] &&
+                noise->config.frequency[f] == dest->frequency.frequency)
+            break;
+    }
+    if(f == 5) {
+        noise_restart(noise);
+        return;
+    }
+
+    /* The frames of a block have to follow each other at the same
+     * frequency without a calibration in between
+     */
+    if(f != noise->current || frame - noise->last_frame != 1 ||
+            dest->calib.last_event == frame)
+        noise_restart(noise);
+    noise->current = f;
+    noise->last_frame = frame;
+
+    for(i = 0; i < hmi->data_electrodes; ++i)
+        sum += dest->cic.channel[i];
+    noise->samples[noise->fill++] = sum;
+
+    if((valid & hmi3d_DataOutConfigMask_NoisePower) &&
+            dest->noise_power.valid) {
+        noise->noise_sum += dest->noise_power.value;
+        noise->noise_count++;
+    }
+
+    if(noise->fill == HMI3D_NOISE_SAMPLES) {
+        noise_analyze_block(noise, frame);
+        noise_restart(noise);
+    }
+}
+
+int hmi3d_set_noise_analysis(hmi_t *hmi,
+                             const hmi3d_noise_config_t *config)
+{
+    int available = 0;
+    int i;
+
+    HMI_ASSERT(hmi);
+
+    if(config) {
+        for(i = 0; i < 5; ++i) {
+            if(config->frequency[i] < 0)
+                return HMI_BAD_PARAM_ERROR;
+            if(config->frequency[i])
+                ++available;
+        }
+        if(!available || config->cutoff < 1 || config->cutoff > NOISE_HALF ||
+                config->threshold < 1 || config->hysteresis < 1 ||
+                config->min_frequencies < 1 ||
+                config->min_frequencies > available ||
+                config->hold < 0 || config->retry < 1)
+            return HMI_BAD_PARAM_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->noise.enabled = (config != NULL);
+    if(config) {
+        hmi->noise.config = *config;
+        noise_init_tables(&hmi->noise);
+        noise_restart(&hmi->noise);
+        hmi->noise.analyzed = 0;
+        hmi->noise.last_change = hmi->internal.frame_counter -
+                                 config->hold;
+        /* The device starts with all frequencies allowed */
+        hmi->noise.applied = 0x1F;
+        hmi->noise.selected = 0;
+        for(i = 0; i < 5; ++i) {
+            if(config->frequency[i])
+                hmi->noise.selected |= 1 << i;
+        }
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_get_noise_analysis(hmi_t *hmi, hmi3d_noise_analysis_t *analysis)
+{
+    int result = HMI_NO_DATA;
+    int i;
+
+    HMI_ASSERT(hmi && analysis);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(hmi->noise.enabled) {
+        for(i = 0; i < 5; ++i) {
+            if(hmi->noise.analyzed & (1 << i)) {
+                analysis->interference[i] = hmi->noise.interference[i];
+                analysis->age[i] = hmi->internal.frame_counter -
+                                   hmi->noise.measured[i];
+            } else {
+                analysis->interference[i] = 0;
+                analysis->age[i] = -1;
+            }
+        }
+        analysis->selected = hmi->noise.selected;
+        analysis->applied = hmi->noise.applied;
+        result = HMI_NO_ERROR;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+#ifndef HMI3D_NO_RTC
+
+int hmi3d_update_frequency_selection(hmi_t *hmi)
+{
+    int enabled, selected, applied;
+    int error = HMI_NO_ERROR;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    enabled = hmi->noise.enabled;
+    selected = hmi->noise.selected;
+    applied = hmi->noise.applied;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    if(!enabled || selected == applied)
+        return HMI_NO_ERROR;
+
+    /* The request waits for the response, which is received by the
+     * message-handler, so no lock is held meanwhile
+     */
+    error = hmi3d_select_frequencies(hmi, (hmi3d_frequencies_t)selected);
+    if(!error) {
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+        hmi->noise.applied = selected;
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+        HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+    }
+
+    return error;
+}
+
+#endif
+
+#endif
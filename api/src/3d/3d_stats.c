@@ -0,0 +1,484 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+/* The statistics of the streams also serve the calibration scheduler */
+#if !defined(HMI3D_NO_DATA_RETRIEVAL) && \
+    (!defined(HMI3D_NO_SIGNAL_STATS) || !defined(HMI3D_NO_CALIB_SCHEDULE))
+
+#if !defined(HMI3D_NO_SIMD)
+#   if defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       include <emmintrin.h>
+#       define HMI3D_STATS_SSE
+#   elif defined(__ARM_NEON)
+#       include <arm_neon.h>
+#       define HMI3D_STATS_NEON
+#   endif
+#endif
+
+#define STATS_MAX_WINDOW 131070
+
+/* Frames of the first histogram, which spans the values around the first
+ * frame as long as there is no standard deviation
+ */
+#define STATS_FIRST_EPOCH 16
+
+/* Standard deviations the histograms span on either side of the average */
+#define STATS_SPAN 6.0f
+
+/* Maps four values to their histogram buckets. Values beyond the span of
+ * the histogram end up in the first or last bucket.
+ */
+static HMI_FORCE_INLINE void stats_buckets(const float *value,
+                                           const float *origin,
+                                           const float *scale,
+                                           int *bucket)
+{
+#if defined(HMI3D_STATS_SSE)
+    __m128 f = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(value),
+                                     _mm_loadu_ps(origin)),
+                          _mm_loadu_ps(scale));
+
+    /* The maximum is taken first, so NaN ends up in the first bucket */
+    f = _mm_min_ps(_mm_max_ps(f, _mm_setzero_ps()),
+                   _mm_set1_ps(HMI3D_STATS_BUCKETS - 1));
+    _mm_storeu_si128((__m128i *)bucket, _mm_cvttps_epi32(f));
+#elif defined(HMI3D_STATS_NEON)
+    float32x4_t f = vmulq_f32(vsubq_f32(vld1q_f32(value), vld1q_f32(origin)),
+                              vld1q_f32(scale));
+
+    f = vminq_f32(vmaxq_f32(f, vdupq_n_f32(0)),
+                  vdupq_n_f32(HMI3D_STATS_BUCKETS - 1));
+    vst1q_s32(bucket, vcvtq_s32_f32(f));
+#else
+    int i;
+
+    for(i = 0; i < 4; ++i) {
+        float f = (value[i] - origin[i]) * scale[i];
+
+        if(!(f >= 0))
+            bucket[i] = 0;
+        else if(f >= HMI3D_STATS_BUCKETS - 1)
+            bucket[i] = HMI3D_STATS_BUCKETS - 1;
+        else
+            bucket[i] = (int)f;
+    }
+#endif
+}
+
+/* Combines the totals and the running block to the mean and the M2 of all
+ * frames of a channel
+ */
+static void stats_moments(const hmi3d_stream_stats_t *stream,
+                          int channel,
+                          double *mean,
+                          double *m2)
+{
+    double total = stream->count;
+    double count = stream->block_count;
+    double delta = stream->block_mean[channel] - stream->mean[channel];
+
+    *mean = stream->mean[channel];
+    *m2 = stream->m2[channel] + stream->block_m2[channel];
+    if(count > 0) {
+        *mean += delta * count / (total + count);
+        *m2 += delta * delta * total * count / (total + count);
+    }
+}
+
+/* Starts the histogram of the next frames around the average and the
+ * standard deviation so far, or around the value of the first frame
+ */
+static void stats_start_epoch(hmi3d_stream_stats_t *stream,
+                              const float *value)
+{
+    int epoch = stream->epoch;
+    double n = (double)stream->count + stream->block_count;
+    double mean, m2;
+    float center, deviation, step;
+    int i;
+
+    HMI_MEMSET(stream->histogram[epoch], 0, sizeof(stream->histogram[0]));
+
+    for(i = 0; i < 5; ++i) {
+        if(n > 1) {
+            stats_moments(stream, i, &mean, &m2);
+            center = stream->ewma[i];
+            deviation = hmi3d_sqrt((float)(m2 / (n - 1)));
+        } else {
+            center = value[i];
+            deviation = (center < 0 ? -center : center) / 64 + 1;
+        }
+
+        step = 2 * STATS_SPAN * deviation / HMI3D_STATS_BUCKETS;
+        if(step < 0.001f)
+            step = 0.001f;
+        stream->step[epoch][i] = step;
+        stream->scale[epoch][i] = 1.0f / step;
+        stream->origin[epoch][i] = center - step * HMI3D_STATS_BUCKETS / 2;
+    }
+}
+
+void hmi3d_stream_stats_reset(hmi3d_stream_stats_t *stream)
+{
+    int i;
+
+    HMI_MEMSET(stream, 0, sizeof(hmi3d_stream_stats_t));
+    for(i = 0; i < 8; ++i) {
+        stream->min[i] = 3.4e38f;
+        stream->max[i] = -3.4e38f;
+    }
+}
+
+/* Merges the running block into the totals with the formula of Chan et
+ * al., which keeps the float updates of the block precise over long runs
+ */
+static void stats_merge(hmi3d_stream_stats_t *stream)
+{
+    double total = stream->count;
+    double count = stream->block_count;
+    int i;
+
+    if(!stream->block_count)
+        return;
+
+    for(i = 0; i < 5; ++i) {
+        double delta = stream->block_mean[i] - stream->mean[i];
+
+        stream->mean[i] += delta * count / (total + count);
+        stream->m2[i] += stream->block_m2[i] +
+                         delta * delta * total * count / (total + count);
+        stream->block_mean[i] = 0;
+        stream->block_m2[i] = 0;
+    }
+    stream->count += stream->block_count;
+    stream->block_count = 0;
+}
+
+void hmi3d_stream_stats_update(hmi3d_stream_stats_t *stream,
+                               const hmi3d_signal_stats_config_t *config,
+                               const hmi3d_signal_t *signal)
+{
+    float value[8];
+    int bucket[8];
+    float weight, alpha;
+    int i;
+
+    for(i = 0; i < 5; ++i)
+        value[i] = signal->channel[i];
+    value[5] = value[6] = value[7] = 0;
+
+    /* Welford's update of the block, the first frame starts the average */
+    stream->block_count++;
+    weight = 1.0f / stream->block_count;
+    alpha = (stream->count || stream->block_count > 1) ? config->ewma_alpha
+                                                       : 1.0f;
+
+#if defined(HMI3D_STATS_SSE)
+    for(i = 0; i < 8; i += 4) {
+        __m128 x = _mm_loadu_ps(value + i);
+        __m128 mean = _mm_loadu_ps(stream->block_mean + i);
+        __m128 delta = _mm_sub_ps(x, mean);
+        __m128 ewma = _mm_loadu_ps(stream->ewma + i);
+
+        mean = _mm_add_ps(mean, _mm_mul_ps(delta, _mm_set1_ps(weight)));
+        _mm_storeu_ps(stream->block_mean + i, mean);
+        _mm_storeu_ps(stream->block_m2 + i,
+                      _mm_add_ps(_mm_loadu_ps(stream->block_m2 + i),
+                                 _mm_mul_ps(delta, _mm_sub_ps(x, mean))));
+        ewma = _mm_add_ps(ewma, _mm_mul_ps(_mm_sub_ps(x, ewma),
+                                           _mm_set1_ps(alpha)));
+        _mm_storeu_ps(stream->ewma + i, ewma);
+        _mm_storeu_ps(stream->min + i,
+                      _mm_min_ps(_mm_loadu_ps(stream->min + i), x));
+        _mm_storeu_ps(stream->max + i,
+                      _mm_max_ps(_mm_loadu_ps(stream->max + i), x));
+    }
+#elif defined(HMI3D_STATS_NEON)
+    for(i = 0; i < 8; i += 4) {
+        float32x4_t x = vld1q_f32(value + i);
+        float32x4_t mean = vld1q_f32(stream->block_mean + i);
+        float32x4_t delta = vsubq_f32(x, mean);
+        float32x4_t ewma = vld1q_f32(stream->ewma + i);
+
+        mean = vmlaq_n_f32(mean, delta, weight);
+        vst1q_f32(stream->block_mean + i, mean);
+        vst1q_f32(stream->block_m2 + i,
+                  vmlaq_f32(vld1q_f32(stream->block_m2 + i),
+                            delta, vsubq_f32(x, mean)));
+        vst1q_f32(stream->ewma + i,
+                  vmlaq_n_f32(ewma, vsubq_f32(x, ewma), alpha));
+        vst1q_f32(stream->min + i, vminq_f32(vld1q_f32(stream->min + i), x));
+        vst1q_f32(stream->max + i, vmaxq_f32(vld1q_f32(stream->max + i), x));
+    }
+#else
+    for(i = 0; i < 5; ++i) {
+        float delta = value[i] - stream->block_mean[i];
+
+        stream->block_mean[i] += delta * weight;
+        stream->block_m2[i] += delta * (value[i] - stream->block_mean[i]);
+        stream->ewma[i] += (value[i] - stream->ewma[i]) * alpha;
+        if(value[i] < stream->min[i])
+            stream->min[i] = value[i];
+        if(value[i] > stream->max[i])
+            stream->max[i] = value[i];
+    }
+#endif
+
+    if(stream->block_count >= HMI3D_STATS_BLOCK)
+        stats_merge(stream);
+
+    /* Each histogram covers half of the window. The older one is started
+     * again when the current one is full, so the percentiles cover between
+     * half and all of the window.
+     */
+    if(!stream->epoch_size) {
+        stream->epoch_size = (config->window + 1) / 2;
+        if(stream->epoch_size > STATS_FIRST_EPOCH)
+            stream->epoch_size = STATS_FIRST_EPOCH;
+        stats_start_epoch(stream, value);
+    }
+
+    stats_buckets(value, stream->origin[stream->epoch],
+                  stream->scale[stream->epoch], bucket);
+    stats_buckets(value + 4, stream->origin[stream->epoch] + 4,
+                  stream->scale[stream->epoch] + 4, bucket + 4);
+    for(i = 0; i < 5; ++i)
+        stream->histogram[stream->epoch][i][bucket[i]]++;
+
+    if(++stream->epoch_count >= stream->epoch_size) {
+        stream->epoch ^= 1;
+        stream->epoch_count = 0;
+        stream->epoch_size = (config->window + 1) / 2;
+        stats_start_epoch(stream, value);
+    }
+}
+
+int hmi3d_stream_stats_read(const hmi3d_stream_stats_t *stream,
+                            hmi3d_signal_stats_t *stats)
+{
+    double n = (double)stream->count + stream->block_count;
+    double mean, m2;
+    int i;
+
+    if(n == 0)
+        return HMI_NO_DATA;
+
+    stats->count = stream->count + stream->block_count;
+    for(i = 0; i < 5; ++i) {
+        stats_moments(stream, i, &mean, &m2);
+        stats->mean.channel[i] = (float)mean;
+        stats->variance.channel[i] = (n > 1) ? (float)(m2 / (n - 1)) : 0.0f;
+        stats->ewma.channel[i] = stream->ewma[i];
+        stats->min.channel[i] = stream->min[i];
+        stats->max.channel[i] = stream->max[i];
+    }
+
+    return HMI_NO_ERROR;
+}
+
+#ifndef HMI3D_NO_SIGNAL_STATS
+
+void hmi3d_update_signal_stats(hmi_t *hmi,
+                               const hmi3d_input_data_t *dest,
+                               int valid)
+{
+    hmi3d_stats_t *stats = &hmi->signal_stats;
+
+    if(!stats->enabled)
+        return;
+
+    if(valid & hmi3d_DataOutConfigMask_CICData)
+        hmi3d_stream_stats_update(&stats->stream[hmi3d_stream_cic],
+                                  &stats->config, &dest->cic);
+    if(valid & hmi3d_DataOutConfigMask_SDData)
+        hmi3d_stream_stats_update(&stats->stream[hmi3d_stream_sd],
+                                  &stats->config, &dest->sd);
+}
+
+int hmi3d_set_signal_stats(hmi_t *hmi,
+                           const hmi3d_signal_stats_config_t *config)
+{
+    HMI_ASSERT(hmi);
+
+    if(config && (config->ewma_alpha <= 0 || config->ewma_alpha > 1 ||
+                  config->window < 2 || config->window > STATS_MAX_WINDOW))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->signal_stats.enabled = (config != NULL);
+    if(config) {
+        hmi->signal_stats.config = *config;
+        hmi3d_stream_stats_reset(&hmi->signal_stats.stream[hmi3d_stream_cic]);
+        hmi3d_stream_stats_reset(&hmi->signal_stats.stream[hmi3d_stream_sd]);
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_get_signal_stats(hmi_t *hmi,
+                           hmi3d_signal_stream_t stream,
+                           hmi3d_signal_stats_t *stats)
+{
+    int result = HMI_NO_DATA;
+
+    HMI_ASSERT(hmi && stats);
+
+    if(stream != hmi3d_stream_cic && stream != hmi3d_stream_sd)
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(hmi->signal_stats.enabled)
+        result = hmi3d_stream_stats_read(&hmi->signal_stats.stream[stream],
+                                         stats);
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+/* Returns the percentile of a channel over both histograms. The frames
+ * are taken as evenly spread within their buckets, so the buckets of both
+ * histograms are walked in the order of their edges.
+ */
+static float stats_percentile(const hmi3d_stream_stats_t *stream,
+                              int channel,
+                              float quantile)
+{
+    int bucket[2] = { 0, 0 };
+    int inside[2] = { 0, 0 };
+    unsigned int total = 0, count;
+    float seen = 0, at = 3.4e38f;
+    float target, next, density, edge;
+    int e, j;
+
+    for(e = 0; e < 2; ++e) {
+        count = 0;
+        for(j = 0; j < HMI3D_STATS_BUCKETS; ++j)
+            count += stream->histogram[e][channel][j];
+
+        /* Histograms without frames are left out */
+        if(!count)
+            bucket[e] = HMI3D_STATS_BUCKETS;
+        else if(stream->origin[e][channel] < at)
+            at = stream->origin[e][channel];
+        total += count;
+    }
+    target = quantile * total;
+
+    for(;;) {
+        density = 0;
+        next = 3.4e38f;
+
+        for(e = 0; e < 2; ++e) {
+            if(bucket[e] >= HMI3D_STATS_BUCKETS)
+                continue;
+            edge = stream->origin[e][channel] +
+                   (bucket[e] + inside[e]) * stream->step[e][channel];
+            if(!inside[e] && edge <= at) {
+                inside[e] = 1;
+                edge += stream->step[e][channel];
+            }
+            if(inside[e])
+                density += stream->histogram[e][channel][bucket[e]] /
+                           stream->step[e][channel];
+            if(edge < next)
+                next = edge;
+        }
+
+        if(next >= 3.4e38f)
+            return at;
+
+        if(density > 0 && seen + density * (next - at) >= target)
+            return at + (target - seen) / density;
+
+        seen += density * (next - at);
+        at = next;
+
+        /* Move on past the buckets that end here */
+        for(e = 0; e < 2; ++e) {
+            if(inside[e] && bucket[e] < HMI3D_STATS_BUCKETS &&
+                    stream->origin[e][channel] +
+                    (bucket[e] + 1) * stream->step[e][channel] <= at)
+                bucket[e]++;
+        }
+    }
+}
+
+int hmi3d_get_signal_percentile(hmi_t *hmi,
+                                hmi3d_signal_stream_t stream,
+                                float quantile,
+                                hmi3d_signal_t *value)
+{
+    const hmi3d_stream_stats_t *src;
+    int result = HMI_NO_ERROR;
+    int i;
+
+    HMI_ASSERT(hmi && value);
+
+    if((stream != hmi3d_stream_cic && stream != hmi3d_stream_sd) ||
+            !(quantile >= 0 && quantile <= 1))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffer from message-handler */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    src = &hmi->signal_stats.stream[stream];
+
+    if(!hmi->signal_stats.enabled || (!src->count && !src->block_count)) {
+        result = HMI_NO_DATA;
+    } else {
+        for(i = 0; i < 5; ++i)
+            value->channel[i] = stats_percentile(src, i, quantile);
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handler */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+#endif
+
+#endif
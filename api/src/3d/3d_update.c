@@ -1,233 +1,725 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#include "3d.h"
-
-#ifndef HMI3D_NO_UPDATE
-
-#define CRC_P_32 0xEDB88320L
-
-static unsigned int crc(hmi_t *hmi, const unsigned char *msg, int size)
-{
-    unsigned int crc = 0xFFFFFFFF;
-    int i;
-    for(i = 0; i < size; ++i)
-        crc = (crc >> 8) ^ hmi->flash.crc_table[(crc ^ msg[i]) & 0xFF];
-    return crc ^ 0xFFFFFFFF;
-}
-
-static void init_crc(hmi_t *hmi)
-{
-    int i, j;
-    unsigned long crc;
-
-    for (i = 0; i < 256; ++i) {
-        crc = i;
-
-        for (j = 0; j < 8; ++j) {
-            if ( crc & 0x00000001L )
-                crc = (crc >> 1) ^ CRC_P_32;
-            else
-                crc = crc >> 1;
-        }
-
-        hmi->flash.crc_table[i] = crc;
-    }
-
-    hmi->flash.crc_intialized = 1;
-}
-
-int hmi3d_wait_for_version_info(hmi_t *hmi)
-{
-    int error = HMI_NO_ERROR;
-    /* 100 is a usefull timeout here because the bootloader requires
-     * some time to start and will continue with firmware after
-     * a timeout of 100 ms
-     */
-    int timeout = 100;
-
-    for(;;) {
-        /* Receive and handle one message */
-        error = hmi_message_receive(hmi, &timeout);
-        if(error != HMI_NO_ERROR) {
-            if(error == HMI_NO_DATA)
-                error = HMI_NO_RESPONSE_ERROR;
-            break;
-        }
-
-        /* Check whether we received version info */
-        if(hmi->version_request->received) {
-            error = HMI_NO_ERROR;
-            break;
-        }
-    }
-
-    return error;
-}
-
-int hmi3d_update_begin(hmi_t *hmi, unsigned int session_id, void *iv,
-                       hmi3d_UpdateFunction_t mode)
-{
-    int error = HMI_NO_ERROR;
-    unsigned char msg[28];
-    hmi3d_version_request_t v_request;
-
-    /* Init table for CRC32-checksum */
-    if(!hmi->flash.crc_intialized)
-        init_crc(hmi);
-
-    /* Prepare flash start message */
-    HMI_MEMSET(msg, 0, sizeof(msg));
-    SET_U8(msg, sizeof(msg));
-    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Start);
-    SET_U32(msg+8, session_id);
-    HMI_MEMCPY(msg+12, iv, 14);
-    SET_U8(msg+26, mode);
-
-    HMI_MEMSET(&v_request, 0, sizeof(v_request));
-
-    SET_U32(msg+4, crc(hmi, msg+8, 20));
-
-    hmi->flash.session_id = session_id;
-
-    /* Reset device and wait for the firmware-version */
-    hmi->version_request = &v_request;
-    error = hmi3d_reset(hmi);
-
-    if(!error)
-        error = hmi3d_wait_for_version_info(hmi);
-    hmi->version_request = 0;
-
-    /* Send message to start flash-mode */
-    if(!error)
-        error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
-
-    return error;
-}
-
-int hmi3d_update_write(hmi_t *hmi, unsigned short address,
-                       unsigned char length, unsigned char *record,
-                       hmi3d_UpdateFunction_t mode)
-{
-    unsigned char msg[140];
-
-    /* Assert that only verification is used for verification sessions */
-    HMI_ASSERT(hmi->flash.session_mode != hmi3d_UpdateFunction_VerifyOnly ||
-            mode == hmi3d_UpdateFunction_VerifyOnly);
-
-    HMI_MEMSET(msg, 0, sizeof(msg));
-    SET_U8(msg, sizeof(msg));
-    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Block);
-    SET_U16(msg + 8, address);
-    SET_U8(msg + 10, length);
-    SET_U8(msg + 11, mode);
-    HMI_MEMCPY(msg + 12, record, 128);
-
-    SET_U32(msg + 4, crc(hmi, msg + 8, 132));
-
-    return hmi3d_send_message(hmi, msg, sizeof(msg), 100);
-}
-
-int hmi3d_update_end(hmi_t *hmi, unsigned char *version)
-{
-    int error = HMI_NO_ERROR;
-    unsigned char msg[136];
-    HMI_MEMSET(msg, 0, sizeof(msg));
-
-    /* Finish by writing the version information */
-
-    SET_U8(msg, sizeof(msg));
-    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Completed);
-    SET_U32(msg + 8, hmi->flash.session_id);
-    SET_U8(msg + 12, hmi->flash.session_mode);
-    HMI_MEMCPY(msg + 13, version, 120);
-
-    SET_U32(msg + 4, crc(hmi, msg + 8, 128));
-
-    error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
-
-    /* Finally restart device */
-
-    if(!error) {
-        SET_U8(msg + 12, hmi3d_UpdateFunction_Restart);
-        HMI_MEMSET(msg + 13, 0, 120);
-
-        SET_U32(msg + 4, crc(hmi, msg + 8, 128));
-
-        error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
-    }
-
-    return error;
-}
-
-int hmi3d_update_image(hmi_t *hmi,
-                       unsigned int session_id,
-                       hmi3d_update_image_t *image,
-                       hmi3d_UpdateFunction_t mode)
-{
-    int error = HMI_NO_ERROR;
-    int i;
-    hmi3d_update_record_t *record;
-
-    error = hmi3d_update_begin(hmi, session_id, image->iv, mode);
-
-    for(i = 0; !error && i < image->record_count; ++i) {
-        record = image->data + i;
-        error = hmi3d_update_write(hmi, record->address, record->length,
-                                   record->data, mode);
-    }
-
-    if(!error)
-        error = hmi3d_update_end(hmi, image->fw_version);
-
-    return error;
-}
-
-int hmi3d_update_wait_loader_done(hmi_t *hmi)
-{
-    int error = HMI_NO_ERROR;
-    /* The complete bootloader-update process can take up to 20 seconds */
-    int timeout = 20000;
-
-    /* 0xFF is an invalid value for this field in fw-version-info */
-    hmi->fw_valid = 0xFF;
-
-    for(;;) {
-        /* Receive and handle one message */
-        error = hmi_message_receive(hmi, &timeout);
-        if(error != HMI_NO_ERROR) {
-            if(error == HMI_NO_DATA)
-                error = HMI_NO_RESPONSE_ERROR;
-            break;
-        }
-
-        /* Check whether we got a response */
-        if(hmi->fw_valid == 0) {
-            error = HMI_NO_ERROR;
-            break;
-        }
-    }
-
-    return error;
-}
-
-#endif
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#ifndef HMI3D_NO_UPDATE
+
+int hmi3d_wait_for_version_info(hmi_t *hmi)
+{
+    int error = HMI_NO_ERROR;
+    /* 100 is a usefull timeout here because the bootloader requires
+     * some time to start and will continue with firmware after
+     * a timeout of 100 ms
+     */
+    int timeout = 100;
+
+    for(;;) {
+        /* Receive and handle one message */
+        error = hmi_message_receive(hmi, &timeout);
+        if(error != HMI_NO_ERROR) {
+            if(error == HMI_NO_DATA)
+                error = HMI_NO_RESPONSE_ERROR;
+            break;
+        }
+
+        /* Check whether we received version info */
+        if(hmi->version_request->received) {
+            error = HMI_NO_ERROR;
+            break;
+        }
+    }
+
+    return error;
+}
+
+void hmi3d_update_prepare_start(unsigned char *msg, unsigned int session_id,
+                                const void *iv, hmi3d_UpdateFunction_t mode)
+{
+    HMI_MEMSET(msg, 0, 28);
+    SET_U8(msg, 28);
+    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Start);
+    SET_U32(msg+8, session_id);
+    HMI_MEMCPY(msg+12, iv, 14);
+    SET_U8(msg+26, mode);
+
+    SET_U32(msg+4, hmi3d_crc32(msg+8, 20));
+}
+
+void hmi3d_update_prepare_completed(unsigned char *msg,
+                                    unsigned int session_id,
+                                    hmi3d_UpdateFunction_t mode,
+                                    const unsigned char *version)
+{
+    HMI_MEMSET(msg, 0, 136);
+    SET_U8(msg, 136);
+    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Completed);
+    SET_U32(msg + 8, session_id);
+    SET_U8(msg + 12, mode);
+    if(version)
+        HMI_MEMCPY(msg + 13, version, 120);
+
+    SET_U32(msg + 4, hmi3d_crc32(msg + 8, 128));
+}
+
+int hmi3d_update_begin(hmi_t *hmi, unsigned int session_id, void *iv,
+                       hmi3d_UpdateFunction_t mode)
+{
+    int error = HMI_NO_ERROR;
+    unsigned char msg[28];
+    hmi3d_version_request_t v_request;
+
+    /* Prepare flash start message */
+    hmi3d_update_prepare_start(msg, session_id, iv, mode);
+
+    HMI_MEMSET(&v_request, 0, sizeof(v_request));
+
+    hmi->flash.session_id = session_id;
+    hmi->flash.session_mode = mode;
+
+    /* Reset device and wait for the firmware-version */
+    hmi->version_request = &v_request;
+    error = hmi3d_reset(hmi);
+
+    if(!error)
+        error = hmi3d_wait_for_version_info(hmi);
+    hmi->version_request = 0;
+
+    /* Send message to start flash-mode */
+    if(!error)
+        error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
+
+    return error;
+}
+
+/* Prepares the 140 byte Fw_Update_Block message for one record */
+static void prepare_block(unsigned char *msg, unsigned short address,
+                          unsigned char length, const unsigned char *record,
+                          hmi3d_UpdateFunction_t mode)
+{
+    HMI_MEMSET(msg, 0, 12);
+    SET_U8(msg, 140);
+    SET_U8(msg + 3, hmi3d_msg_Fw_Update_Block);
+    SET_U16(msg + 8, address);
+    SET_U8(msg + 10, length);
+    SET_U8(msg + 11, mode);
+    HMI_MEMCPY(msg + 12, record, 128);
+
+    SET_U32(msg + 4, hmi3d_crc32(msg + 8, 132));
+}
+
+int hmi3d_update_write(hmi_t *hmi, unsigned short address,
+                       unsigned char length, unsigned char *record,
+                       hmi3d_UpdateFunction_t mode)
+{
+    unsigned char msg[140];
+
+    /* Assert that only verification is used for verification sessions */
+    HMI_ASSERT(hmi->flash.session_mode != hmi3d_UpdateFunction_VerifyOnly ||
+            mode == hmi3d_UpdateFunction_VerifyOnly);
+
+    prepare_block(msg, address, length, record, mode);
+
+    return hmi3d_send_message(hmi, msg, sizeof(msg), 100);
+}
+
+int hmi3d_update_end(hmi_t *hmi, unsigned char *version)
+{
+    int error = HMI_NO_ERROR;
+    unsigned char msg[136];
+
+    /* Finish by writing the version information */
+
+    hmi3d_update_prepare_completed(msg, hmi->flash.session_id,
+                                   hmi->flash.session_mode, version);
+
+    error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
+
+    /* Finally restart device */
+
+    if(!error) {
+        hmi3d_update_prepare_completed(msg, hmi->flash.session_id,
+                                       hmi3d_UpdateFunction_Restart, 0);
+
+        error = hmi3d_send_message(hmi, msg, sizeof(msg), 100);
+    }
+
+    return error;
+}
+
+int hmi3d_update_image(hmi_t *hmi,
+                       unsigned int session_id,
+                       hmi3d_update_image_t *image,
+                       hmi3d_UpdateFunction_t mode)
+{
+    int error = HMI_NO_ERROR;
+    int i;
+    hmi3d_update_record_t *record;
+
+    error = hmi3d_update_begin(hmi, session_id, image->iv, mode);
+
+    for(i = 0; !error && i < image->record_count; ++i) {
+        record = image->data + i;
+        error = hmi3d_update_write(hmi, record->address, record->length,
+                                   record->data, mode);
+    }
+
+    if(!error)
+        error = hmi3d_update_end(hmi, image->fw_version);
+
+    return error;
+}
+
+/* Queues a record to be sent again or fails the update when the record
+ * already used up its attempts.
+ */
+static void window_retry(hmi3d_update_window_t *w, int record, int attempt)
+{
+    if(attempt >= 3) {
+        if(!w->error)
+            w->error = HMI_3D_SYSTEM_ERROR;
+    } else {
+        int idx = (w->retry_head + w->retry_count) % HMI3D_UPDATE_MAX_WINDOW;
+        w->retry[idx] = record;
+        w->retry_attempt[idx] = attempt;
+        w->retry_count++;
+    }
+}
+
+/* Starts the current segment again. The records that are still queued
+ * for a retry are part of the segment and are sent again anyway.
+ */
+static void window_rewind(hmi3d_update_window_t *w)
+{
+    w->acked = w->sent;
+    w->draining = 0;
+    w->retry_count = 0;
+    w->next = w->segment_start;
+    w->error = HMI_NO_ERROR;
+}
+
+void hmi3d_update_handle_block_ack(hmi_t *hmi, int error_code)
+{
+    hmi3d_update_window_t *w = hmi->flash.window;
+    int slot;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_get_status calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(w->acked == w->sent) {
+        /* Ignore acknowledges of blocks that were already given up */
+    } else if(w->draining) {
+        /* Late acknowledges of the segment that is about to be sent again
+         * only count down the outstanding ones. They would otherwise be
+         * assigned to the records of the next attempt.
+         */
+        if(++w->acked == w->sent)
+            window_rewind(w);
+    } else {
+        slot = w->acked % w->size;
+        if(w->verify && error_code == hmi3d_system_ContentMismatch) {
+            /* A mismatch is a result of the verification, not a failure */
+            if(!w->mismatch || w->record[slot] < w->mismatch_record)
+                w->mismatch_record = w->record[slot];
+            w->mismatch = 1;
+        } else if(error_code != 0) {
+            window_retry(w, w->record[slot], w->attempt[slot]);
+        }
+        w->acked++;
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+/* Sends records of the current segment until the window is full.
+ * No further records are sent once a record failed or did not match.
+ */
+static int window_fill(hmi_t *hmi, hmi3d_update_window_t *w,
+                       const hmi3d_update_image_t *image,
+                       hmi3d_UpdateFunction_t mode)
+{
+    int error;
+
+    while(!w->error && !w->mismatch && w->sent - w->acked < w->size) {
+        int slot = w->sent % w->size;
+        int record, attempt;
+        const hmi3d_update_record_t *data;
+
+        if(w->retry_count) {
+            record = w->retry[w->retry_head];
+            attempt = w->retry_attempt[w->retry_head] + 1;
+            w->retry_head = (w->retry_head + 1) % HMI3D_UPDATE_MAX_WINDOW;
+            w->retry_count--;
+        } else if(w->next < w->segment_end) {
+            record = w->next++;
+            attempt = 1;
+        } else {
+            break;
+        }
+
+        if(record < w->highest)
+            w->retransmits++;
+        else
+            w->highest = record + 1;
+
+        data = image->data + record;
+        prepare_block(w->msg[slot], data->address, data->length,
+                      data->data, mode);
+        w->record[slot] = record;
+        w->attempt[slot] = attempt;
+
+        error = hmi3d_message_write(hmi, w->msg[slot], 140);
+        if(error) {
+            if(attempt >= 3)
+                return error;
+            window_retry(w, record, attempt);
+        } else {
+            w->sent++;
+        }
+    }
+
+    return HMI_NO_ERROR;
+}
+
+int hmi3d_update_window_advance(hmi_t *hmi, hmi3d_update_window_t *w,
+                                const hmi3d_update_image_t *image,
+                                hmi3d_UpdateFunction_t mode)
+{
+    int error;
+    int last = w->last > 0 ? w->last : image->record_count;
+
+    /* Nothing is sent until the outstanding acknowledges are drained */
+    if(w->draining)
+        return 0;
+
+    for(;;) {
+        error = window_fill(hmi, w, image, mode);
+        if(error)
+            return error;
+
+        if(w->sent != w->acked)
+            return 0;
+
+        /* Failed records are only final for a completely
+         * acknowledged segment
+         */
+        if(w->error)
+            return w->error;
+
+        /* A verification is done with the first mismatch */
+        if(w->mismatch)
+            return 1;
+
+        /* Segment done, continue with the next one */
+        if(w->next >= last)
+            return 1;
+        w->segment_end = w->next + HMI3D_UPDATE_SEGMENT;
+        if(w->segment_end > last)
+            w->segment_end = last;
+        w->segment_start = w->next;
+        w->rewinds = 0;
+    }
+}
+
+int hmi3d_update_window_timeout(hmi3d_update_window_t *w)
+{
+    /* The acknowledges that are still missing after draining are lost */
+    if(w->draining) {
+        window_rewind(w);
+        return HMI_NO_ERROR;
+    }
+
+    if(++w->rewinds >= 3)
+        return HMI_NO_RESPONSE_ERROR;
+
+    w->draining = 1;
+
+    return HMI_NO_ERROR;
+}
+
+/* Sends all records of the image while keeping up to w->size of them
+ * in flight.
+ *
+ * As the acknowledges don't identify the block, they are assigned to the
+ * blocks in the order of sending. A lost message or acknowledge would shift
+ * this assignment. Therefore the records are sent in segments that are
+ * completely acknowledged before the next one starts. A segment where
+ * acknowledges are missing for 100 milliseconds is sent again as a whole.
+ * Before that, acknowledges that still arrive for the segment are drained
+ * until all of them were received or none arrived for another 100
+ * milliseconds, so that late ones are not taken for the new attempt.
+ */
+static int window_transfer(hmi_t *hmi, hmi3d_update_window_t *w,
+                           const hmi3d_update_image_t *image,
+                           hmi3d_UpdateFunction_t mode)
+{
+    int error = HMI_NO_ERROR;
+    int timeout = 100;
+    int last_acked = 0;
+
+    hmi->flash.window = w;
+
+    for(;;) {
+        error = hmi3d_update_window_advance(hmi, w, image, mode);
+        if(error) {
+            if(error > 0)
+                error = HMI_NO_ERROR;
+            break;
+        }
+
+        /* Receive and handle one message */
+        error = hmi_message_receive(hmi, &timeout);
+        if(error == HMI_NO_DATA) {
+            error = hmi3d_update_window_timeout(w);
+            if(error)
+                break;
+        } else if(error != HMI_NO_ERROR) {
+            break;
+        }
+
+        /* The timeout only restarts when the device makes progress */
+        if(w->acked != last_acked || timeout <= 0) {
+            last_acked = w->acked;
+            timeout = 100;
+        }
+    }
+
+    hmi->flash.window = 0;
+
+    return error;
+}
+
+void hmi3d_update_window_init(hmi3d_update_window_t *w, int window)
+{
+    if(window < 1)
+        window = 1;
+    if(window > HMI3D_UPDATE_MAX_WINDOW)
+        window = HMI3D_UPDATE_MAX_WINDOW;
+
+    HMI_MEMSET(w, 0, sizeof(*w));
+    w->size = window;
+}
+
+int hmi3d_update_image_windowed(hmi_t *hmi,
+                                unsigned int session_id,
+                                hmi3d_update_image_t *image,
+                                hmi3d_UpdateFunction_t mode,
+                                int window,
+                                hmi3d_update_stats_t *stats)
+{
+    int error = HMI_NO_ERROR;
+    hmi3d_update_window_t w;
+    unsigned int start;
+
+    HMI_ASSERT(hmi && image);
+
+    hmi3d_update_window_init(&w, window);
+
+    error = hmi3d_update_begin(hmi, session_id, image->iv, mode);
+
+    start = HMI_TIME_US();
+    if(!error)
+        error = window_transfer(hmi, &w, image, mode);
+
+    if(stats) {
+        unsigned int elapsed = HMI_TIME_US() - start;
+        stats->records = error ? 0 : image->record_count;
+        stats->verified = 0;
+        stats->mismatch_record = -1;
+        stats->programmed = !error &&
+                            mode == hmi3d_UpdateFunction_ProgramFlash;
+        stats->retransmits = w.retransmits;
+        stats->resumed_record = -1;
+        stats->recovery_ms = 0;
+        stats->elapsed_ms = elapsed / 1000;
+        stats->records_per_s = elapsed ?
+                    stats->records * 1000000.0f / elapsed : 0.0f;
+    }
+
+    if(!error)
+        error = hmi3d_update_end(hmi, image->fw_version);
+
+    return error;
+}
+
+int hmi3d_update_image_if_changed(hmi_t *hmi,
+                                  unsigned int session_id,
+                                  hmi3d_update_image_t *image,
+                                  int window,
+                                  hmi3d_update_stats_t *stats)
+{
+    int error = HMI_NO_ERROR;
+    hmi3d_update_window_t w;
+    unsigned int start;
+    int mismatch, mismatch_record;
+    int verified, retransmits;
+    int programmed = 0;
+
+    HMI_ASSERT(hmi && image);
+
+    start = HMI_TIME_US();
+
+    /* Compare all records with the flash content */
+    hmi3d_update_window_init(&w, window);
+    w.verify = 1;
+    error = hmi3d_update_begin(hmi, session_id, image->iv,
+                               hmi3d_UpdateFunction_VerifyOnly);
+    if(!error)
+        error = window_transfer(hmi, &w, image,
+                                hmi3d_UpdateFunction_VerifyOnly);
+
+    mismatch = w.mismatch;
+    mismatch_record = w.mismatch ? w.mismatch_record : -1;
+    verified = w.highest;
+    retransmits = w.retransmits;
+
+    /* The device compares the version-string when the verification session
+     * is completed. A matching image is thereby only restarted.
+     */
+    if(!error && !mismatch) {
+        error = hmi3d_update_end(hmi, image->fw_version);
+        if(error == HMI_3D_SYSTEM_ERROR &&
+                hmi->resp_error_code == hmi3d_system_ContentMismatch)
+        {
+            mismatch = 1;
+            mismatch_record = image->record_count;
+            error = HMI_NO_ERROR;
+        }
+    }
+
+    /* Any difference is resolved by programming the complete image */
+    if(!error && mismatch) {
+        hmi3d_update_window_init(&w, window);
+        error = hmi3d_update_begin(hmi, session_id, image->iv,
+                                   hmi3d_UpdateFunction_ProgramFlash);
+        if(!error)
+            error = window_transfer(hmi, &w, image,
+                                    hmi3d_UpdateFunction_ProgramFlash);
+        if(!error)
+            error = hmi3d_update_end(hmi, image->fw_version);
+        programmed = !error;
+        retransmits += w.retransmits;
+    }
+
+    if(stats) {
+        unsigned int elapsed = HMI_TIME_US() - start;
+        stats->records = verified + (programmed ? image->record_count : 0);
+        stats->verified = verified;
+        stats->mismatch_record = mismatch_record;
+        stats->programmed = programmed;
+        stats->retransmits = retransmits;
+        stats->resumed_record = -1;
+        stats->recovery_ms = 0;
+        stats->elapsed_ms = elapsed / 1000;
+        stats->records_per_s = elapsed ?
+                    stats->records * 1000000.0f / elapsed : 0.0f;
+    }
+
+    return error;
+}
+
+/* Identifies the image a checkpoint was made for */
+static unsigned int image_crc(const hmi3d_update_image_t *image)
+{
+    unsigned char count[4];
+    unsigned int crc;
+
+    SET_U32(count, image->record_count);
+    crc = hmi3d_crc32_update(0, count, sizeof(count));
+    crc = hmi3d_crc32_update(crc, image->iv, sizeof(image->iv));
+    return hmi3d_crc32_update(crc, image->fw_version,
+                              sizeof(image->fw_version));
+}
+
+int hmi3d_update_image_resumable(hmi_t *hmi,
+                                 unsigned int session_id,
+                                 hmi3d_update_image_t *image,
+                                 int window,
+                                 hmi3d_update_checkpoint_t *checkpoint,
+                                 hmi3d_update_stats_t *stats)
+{
+    int error = HMI_NO_ERROR;
+    hmi3d_update_window_t w;
+    unsigned int start, crc;
+    unsigned int recovery = 0;
+    int resumed = -1;
+    int first = -1;
+    int mismatch_record = -1;
+    int verified = 0;
+    int retransmits = 0;
+    int transferred = 0;
+
+    HMI_ASSERT(hmi && image && checkpoint);
+
+    start = HMI_TIME_US();
+    crc = image_crc(image);
+
+    /* A session of the same image that was interrupted is continued
+     * after the records before the checkpoint
+     */
+    if(checkpoint->session_id == session_id && checkpoint->image_crc == crc &&
+            checkpoint->records_done > 0 &&
+            checkpoint->records_done <= image->record_count)
+    {
+        first = checkpoint->records_done;
+
+#ifndef HMI3D_NO_RESUME_VERIFY
+        /* The records before the checkpoint are verified in a session of
+         * its own, as the device might have lost them when it was reset.
+         * Programming continues with the first one that differs.
+         */
+        hmi3d_update_window_init(&w, window);
+        w.verify = 1;
+        w.last = checkpoint->records_done;
+        error = hmi3d_update_begin(hmi, session_id, image->iv,
+                                   hmi3d_UpdateFunction_VerifyOnly);
+        if(!error)
+            error = window_transfer(hmi, &w, image,
+                                    hmi3d_UpdateFunction_VerifyOnly);
+        verified = w.highest;
+        retransmits = w.retransmits;
+
+        if(error) {
+            first = -1;
+        } else if(w.mismatch) {
+            /* The records from the mismatch on are written again */
+            mismatch_record = w.mismatch_record;
+            first = checkpoint->records_done = mismatch_record;
+        }
+#endif
+    }
+
+    /* Flash mode is entered again with the session-id of the checkpoint,
+     * which resets the device like any start of a session
+     */
+    if(first > 0) {
+        hmi3d_update_window_init(&w, window);
+        w.next = first;
+        w.segment_start = first;
+
+        error = hmi3d_update_begin(hmi, session_id, image->iv,
+                                   hmi3d_UpdateFunction_ProgramFlash);
+        recovery = HMI_TIME_US() - start;
+
+        if(!error) {
+            error = window_transfer(hmi, &w, image,
+                                    hmi3d_UpdateFunction_ProgramFlash);
+            retransmits += w.retransmits;
+        }
+
+        /* A session that can't be entered again or does not accept a
+         * single record is not continued
+         */
+        if(error && w.segment_start == first)
+            first = -1;
+        else
+            resumed = first;
+    } else {
+        first = -1;
+    }
+
+    /* Without a session to continue the update starts over. The
+     * checkpoint is kept until the new session was started.
+     */
+    if(first < 0) {
+        error = hmi3d_update_begin(hmi, session_id, image->iv,
+                                   hmi3d_UpdateFunction_ProgramFlash);
+        if(!error) {
+            checkpoint->session_id = session_id;
+            checkpoint->image_crc = crc;
+            checkpoint->records_done = 0;
+            first = 0;
+
+            hmi3d_update_window_init(&w, window);
+            error = window_transfer(hmi, &w, image,
+                                    hmi3d_UpdateFunction_ProgramFlash);
+            retransmits += w.retransmits;
+        }
+    }
+
+    /* Segments are completely acknowledged before the next one starts, so
+     * all records before the current one were written
+     */
+    if(error) {
+        if(first >= 0 && checkpoint->records_done < w.segment_start)
+            checkpoint->records_done = w.segment_start;
+    } else {
+        checkpoint->records_done = image->record_count;
+        transferred = image->record_count - first;
+        error = hmi3d_update_end(hmi, image->fw_version);
+
+        /* The finished session can't be continued */
+        if(!error)
+            checkpoint->session_id = 0;
+    }
+
+    if(stats) {
+        unsigned int elapsed = HMI_TIME_US() - start;
+        stats->records = verified + transferred;
+        stats->verified = verified;
+        stats->mismatch_record = mismatch_record;
+        stats->programmed = !error;
+        stats->retransmits = retransmits;
+        stats->resumed_record = resumed;
+        stats->recovery_ms = resumed >= 0 ? recovery / 1000 : 0;
+        stats->elapsed_ms = elapsed / 1000;
+        stats->records_per_s = elapsed ?
+                    stats->records * 1000000.0f / elapsed : 0.0f;
+    }
+
+    return error;
+}
+
+int hmi3d_update_wait_loader_done(hmi_t *hmi)
+{
+    int error = HMI_NO_ERROR;
+    /* The complete bootloader-update process can take up to 20 seconds */
+    int timeout = 20000;
+
+    /* 0xFF is an invalid value for this field in fw-version-info */
+    hmi->fw_valid = 0xFF;
+
+    for(;;) {
+        /* Receive and handle one message */
+        error = hmi_message_receive(hmi, &timeout);
+        if(error != HMI_NO_ERROR) {
+            if(error == HMI_NO_DATA)
+                error = HMI_NO_RESPONSE_ERROR;
+            break;
+        }
+
+        /* Check whether we got a response */
+        if(hmi->fw_valid == 0) {
+            error = HMI_NO_ERROR;
+            break;
+        }
+    }
+
+    return error;
+}
+
+#endif
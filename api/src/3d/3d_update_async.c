@@ -0,0 +1,567 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "3d.h"
+
+#ifndef HMI3D_NO_UPDATE
+
+/* Timeouts in milliseconds of the single steps */
+#define VERSION_TIMEOUT 100
+#define RESPONSE_TIMEOUT 100
+#define LOADER_TIMEOUT 20000
+
+#ifdef HMI_NO_TIME
+/* Time in milliseconds that a step waits for messages without a timer */
+#define STEP_WAIT 10
+
+/* Without a platform timer the deadline holds the milliseconds left, which
+ * only pass while hmi3d_update_step waits for messages.
+ */
+static void set_deadline(hmi3d_update_job_t *job, int timeout)
+{
+    job->deadline = (unsigned int)timeout;
+}
+
+static int deadline_passed(hmi3d_update_job_t *job)
+{
+    return job->deadline == 0;
+}
+#else
+static void set_deadline(hmi3d_update_job_t *job, int timeout)
+{
+    job->deadline = HMI_TIME_US() + (unsigned int)timeout * 1000;
+}
+
+static int deadline_passed(hmi3d_update_job_t *job)
+{
+    return (int)(HMI_TIME_US() - job->deadline) >= 0;
+}
+#endif
+
+static int job_finished(hmi3d_update_job_t *job)
+{
+    return job->state == hmi3d_UpdateState_Idle ||
+           job->state >= hmi3d_UpdateState_Done;
+}
+
+static int job_finish(hmi3d_update_job_t *job, hmi3d_update_state_t state)
+{
+    job->end_time = HMI_TIME_US();
+    job->state = state;
+    return 1;
+}
+
+static int job_fail(hmi_t *hmi, hmi3d_update_job_t *job, int error)
+{
+    hmi->flash.window = 0;
+    hmi->version_request = 0;
+    job->error = error;
+    return job_finish(job, hmi3d_UpdateState_Failed);
+}
+
+/* Resets the device to leave the session of a cancelled update */
+static int job_cancel(hmi_t *hmi, hmi3d_update_job_t *job)
+{
+    hmi->flash.window = 0;
+    hmi->version_request = 0;
+    hmi3d_reset(hmi);
+    return job_finish(job, hmi3d_UpdateState_Cancelled);
+}
+
+/* Sends the prepared message of the job and waits for its acknowledge
+ * like <hmi3d_send_message> but without blocking.
+ */
+static int job_send(hmi_t *hmi, hmi3d_update_job_t *job)
+{
+    int error;
+
+    for(;;) {
+        job->attempts++;
+        hmi->resp_error_code = -1;
+        hmi->resp_msg_id = job->msg[3];
+        error = hmi3d_message_write(hmi, job->msg, job->msg_size);
+        if(!error)
+            break;
+        if(job->attempts >= 3)
+            return error;
+    }
+
+    set_deadline(job, RESPONSE_TIMEOUT);
+    return HMI_NO_ERROR;
+}
+
+/* Checks the acknowledge of the sent message.
+ *
+ * Returns 1 when it was acknowledged, 0 while waiting for it and a
+ * negative value when all attempts failed.
+ */
+static int job_acknowledged(hmi_t *hmi, hmi3d_update_job_t *job)
+{
+    int error;
+
+    if(hmi->resp_error_code == 0)
+        return 1;
+
+    if(hmi->resp_error_code > 0)
+        error = HMI_3D_SYSTEM_ERROR;
+    else if(deadline_passed(job))
+        error = HMI_NO_RESPONSE_ERROR;
+    else
+        return 0;
+
+    if(job->attempts >= 3)
+        return error;
+
+    error = job_send(hmi, job);
+    return error ? error : 0;
+}
+
+static int job_start_send(hmi_t *hmi, hmi3d_update_job_t *job,
+                          hmi3d_update_state_t state)
+{
+    job->attempts = 0;
+    job->state = state;
+    return job_send(hmi, job);
+}
+
+int hmi3d_update_start(hmi_t *hmi,
+                       unsigned int session_id,
+                       const hmi3d_update_image_t *image,
+                       hmi3d_UpdateFunction_t mode,
+                       int window,
+                       int wait_loader)
+{
+    hmi3d_update_job_t *job;
+    int error;
+
+    HMI_ASSERT(hmi && image);
+
+    job = &hmi->flash.job;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_get_status calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    HMI_MEMSET(job, 0, sizeof(*job));
+    job->image = image;
+    job->mode = mode;
+    job->start_time = HMI_TIME_US();
+    job->wait_loader = wait_loader;
+    hmi3d_update_window_init(&job->window, window);
+
+    hmi->flash.session_id = session_id;
+    hmi->flash.session_mode = mode;
+    hmi->flash.window = 0;
+
+    /* Reset device and wait for the firmware-version of the loader */
+    hmi->version_request = &job->version_request;
+    job->state = hmi3d_UpdateState_Reset;
+    set_deadline(job, VERSION_TIMEOUT);
+
+    error = hmi3d_reset(hmi);
+    if(error)
+        job_fail(hmi, job, error);
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return error;
+}
+
+/* Advances the state after a message was handled or time passed */
+static int job_advance(hmi_t *hmi, hmi3d_update_job_t *job)
+{
+    hmi3d_update_window_t *w = &job->window;
+    int result;
+
+    /* Sessions that did not start sending records are left at once */
+    if(job->cancel && (job->state == hmi3d_UpdateState_Reset ||
+                       job->state == hmi3d_UpdateState_Start))
+        return job_cancel(hmi, job);
+
+    switch(job->state) {
+    case hmi3d_UpdateState_Reset:
+        if(!job->version_request.received) {
+            if(deadline_passed(job))
+                return job_fail(hmi, job, HMI_NO_RESPONSE_ERROR);
+            return 0;
+        }
+        hmi->version_request = 0;
+
+        hmi3d_update_prepare_start(job->msg, hmi->flash.session_id,
+                                   job->image->iv, job->mode);
+        job->msg_size = 28;
+        result = job_start_send(hmi, job, hmi3d_UpdateState_Start);
+        return result ? job_fail(hmi, job, result) : 1;
+
+    case hmi3d_UpdateState_Start:
+        result = job_acknowledged(hmi, job);
+        if(result <= 0)
+            return result ? job_fail(hmi, job, result) : 0;
+
+        job->state = hmi3d_UpdateState_Transfer;
+        job->last_acked = 0;
+        set_deadline(job, RESPONSE_TIMEOUT);
+        hmi->flash.window = w;
+        return 1;
+
+    case hmi3d_UpdateState_Transfer:
+    {
+        int sent = w->sent;
+
+        /* Records in flight are still acknowledged before leaving */
+        if(job->cancel) {
+            if(w->sent == w->acked || deadline_passed(job))
+                return job_cancel(hmi, job);
+            if(w->acked != job->last_acked) {
+                job->last_acked = w->acked;
+                set_deadline(job, RESPONSE_TIMEOUT);
+            }
+            return 0;
+        }
+
+        result = hmi3d_update_window_advance(hmi, w, job->image, job->mode);
+        if(result < 0)
+            return job_fail(hmi, job, result);
+
+        if(result > 0) {
+            hmi->flash.window = 0;
+            hmi3d_update_prepare_completed(job->msg, hmi->flash.session_id,
+                                           job->mode,
+                                           job->image->fw_version);
+            job->msg_size = 136;
+            result = job_start_send(hmi, job, hmi3d_UpdateState_Complete);
+            return result ? job_fail(hmi, job, result) : 1;
+        }
+
+        /* The timeout only restarts when the device makes progress */
+        if(w->acked != job->last_acked) {
+            job->last_acked = w->acked;
+            set_deadline(job, RESPONSE_TIMEOUT);
+        } else if(deadline_passed(job)) {
+            result = hmi3d_update_window_timeout(w);
+            if(result)
+                return job_fail(hmi, job, result);
+            set_deadline(job, RESPONSE_TIMEOUT);
+            return 1;
+        }
+        return w->sent != sent;
+    }
+
+    case hmi3d_UpdateState_Complete:
+        result = job_acknowledged(hmi, job);
+        if(result <= 0)
+            return result ? job_fail(hmi, job, result) : 0;
+
+        /* Finally restart device */
+        hmi3d_update_prepare_completed(job->msg, hmi->flash.session_id,
+                                       hmi3d_UpdateFunction_Restart, 0);
+        result = job_start_send(hmi, job, hmi3d_UpdateState_Restart);
+        return result ? job_fail(hmi, job, result) : 1;
+
+    case hmi3d_UpdateState_Restart:
+        result = job_acknowledged(hmi, job);
+        if(result <= 0)
+            return result ? job_fail(hmi, job, result) : 0;
+
+        if(job->wait_loader) {
+            /* 0xFF is an invalid value for this field in fw-version-info */
+            hmi->fw_valid = 0xFF;
+            job->state = hmi3d_UpdateState_WaitLoader;
+            set_deadline(job, LOADER_TIMEOUT);
+        } else {
+            job_finish(job, hmi3d_UpdateState_Done);
+        }
+        return 1;
+
+    case hmi3d_UpdateState_WaitLoader:
+        if(hmi->fw_valid == 0)
+            return job_finish(job, hmi3d_UpdateState_Done);
+        if(deadline_passed(job))
+            return job_fail(hmi, job, HMI_NO_RESPONSE_ERROR);
+        return 0;
+
+    default:
+        return 0;
+    }
+}
+
+#ifdef HMI_NO_TIME
+/* Waits for a message and counts the waited time against the deadline.
+ * A wait counts at least a millisecond, so that the deadline also passes
+ * when the receive does not wait at all.
+ *
+ * Returns 1 when a message was handled or the update failed, otherwise 0.
+ */
+static int job_wait(hmi_t *hmi, hmi3d_update_job_t *job)
+{
+    int timeout = STEP_WAIT;
+    unsigned int waited;
+    int error;
+
+    error = hmi_message_receive(hmi, &timeout);
+    if(error == HMI_NO_ERROR)
+        return 1;
+
+    waited = timeout < STEP_WAIT ? (unsigned int)(STEP_WAIT - timeout) : 1;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_get_status calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(error != HMI_NO_DATA)
+        job_fail(hmi, job, error);
+    else if(job->deadline > waited)
+        job->deadline -= waited;
+    else
+        job->deadline = 0;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return error != HMI_NO_DATA;
+}
+#endif
+
+int hmi3d_update_step(hmi_t *hmi)
+{
+    hmi3d_update_job_t *job;
+    int progress = 0;
+    int error;
+
+    HMI_ASSERT(hmi);
+
+    job = &hmi->flash.job;
+    if(job_finished(job))
+        return 0;
+
+    /* Handle all messages that already arrived. The acknowledges are
+     * synchronized by hmi3d_update_handle_block_ack itself.
+     */
+    for(;;) {
+        error = hmi_message_receive(hmi, NULL);
+        if(error != HMI_NO_ERROR)
+            break;
+        progress = 1;
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_get_status calls from application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(error != HMI_NO_DATA)
+        progress = job_fail(hmi, job, error);
+    else if(job_advance(hmi, job))
+        progress = 1;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_get_status */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+#ifdef HMI_NO_TIME
+    /* Only waiting lets the timeouts pass */
+    if(!progress && !job_finished(job))
+        progress = job_wait(hmi, job);
+#endif
+
+    return progress;
+}
+
+void hmi3d_update_cancel(hmi_t *hmi)
+{
+    HMI_ASSERT(hmi);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_step */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(!job_finished(&hmi->flash.job))
+        hmi->flash.job.cancel = 1;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_step */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi3d_update_get_status(hmi_t *hmi, hmi3d_update_status_t *status)
+{
+    hmi3d_update_job_t *job;
+    const hmi3d_update_window_t *w;
+    unsigned int elapsed;
+
+    HMI_ASSERT(hmi && status);
+
+    job = &hmi->flash.job;
+    w = &job->window;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi3d_update_step */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    status->state = job->state;
+    status->error = job->error;
+    status->record_count = job->image ? job->image->record_count : 0;
+
+    if(job->state < hmi3d_UpdateState_Transfer) {
+        status->records_done = 0;
+    } else if(job->state == hmi3d_UpdateState_Transfer ||
+              job->state >= hmi3d_UpdateState_Failed) {
+        /* Records before the next one that are neither in flight nor
+         * waiting to be sent again
+         */
+        status->records_done = w->next - (w->sent - w->acked) -
+                               w->retry_count;
+        if(status->records_done < 0)
+            status->records_done = 0;
+    } else {
+        status->records_done = status->record_count;
+    }
+
+    if(job->state == hmi3d_UpdateState_Idle)
+        elapsed = 0;
+    else if(job_finished(job))
+        elapsed = job->end_time - job->start_time;
+    else
+        elapsed = HMI_TIME_US() - job->start_time;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi3d_update_step */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    status->elapsed_ms = elapsed / 1000;
+    status->bytes_per_s = elapsed ?
+            status->records_done * 128 * 1000000.0f / elapsed : 0.0f;
+    if(!status->records_done)
+        status->eta_ms = -1;
+    else
+        status->eta_ms = (int)((float)status->elapsed_ms *
+                (status->record_count - status->records_done) /
+                status->records_done);
+}
+
+/* Waits a millisecond for the devices. Without <HMI_SLEEP> it waits for a
+ * message of the first device whose update is still running instead.
+ */
+static void run_wait(hmi_t **devices, int count)
+{
+#ifdef HMI_SLEEP
+    HMI_UNUSED(devices)
+    HMI_UNUSED(count)
+
+    HMI_SLEEP(1);
+#else
+    int timeout = 1;
+    int error;
+    int i;
+
+    for(i = 0; i < count; ++i) {
+        hmi3d_update_job_t *job = &devices[i]->flash.job;
+        if(job_finished(job))
+            continue;
+
+        /* The message is handled and the next step advances with it */
+        error = hmi_message_receive(devices[i], &timeout);
+        if(error != HMI_NO_ERROR && error != HMI_NO_DATA) {
+#ifdef HMI_SYNC_THREADING
+            HMI_SYNC_LOCK(devices[i]->io_sync);
+#endif
+            job_fail(devices[i], job, error);
+#ifdef HMI_SYNC_THREADING
+            HMI_SYNC_UNLOCK(devices[i]->io_sync);
+#endif
+        }
+        break;
+    }
+#endif
+}
+
+int hmi3d_update_run(hmi_t **devices,
+                     int count,
+                     unsigned int session_id,
+                     const hmi3d_update_image_t *image,
+                     hmi3d_UpdateFunction_t mode,
+                     int window,
+                     int wait_loader,
+                     hmi3d_update_progress_t progress,
+                     void *opaque)
+{
+    hmi3d_update_status_t status;
+    int i, active, stepped, failed;
+
+    HMI_ASSERT(devices && image);
+
+    for(i = 0; i < count; ++i) {
+        hmi3d_update_start(devices[i], session_id, image, mode, window,
+                           wait_loader);
+        if(progress) {
+            hmi3d_update_get_status(devices[i], &status);
+            progress(opaque, i, &status);
+        }
+    }
+
+    do {
+        active = 0;
+        stepped = 0;
+
+        for(i = 0; i < count; ++i) {
+            if(!hmi3d_update_step(devices[i]))
+                continue;
+
+            stepped = 1;
+            if(progress) {
+                hmi3d_update_get_status(devices[i], &status);
+                progress(opaque, i, &status);
+            }
+        }
+
+        for(i = 0; i < count; ++i) {
+            if(!job_finished(&devices[i]->flash.job))
+                active++;
+        }
+
+        /* Give the devices time to respond when nobody made progress */
+        if(active && !stepped)
+            run_wait(devices, count);
+    } while(active);
+
+    failed = 0;
+    for(i = 0; i < count; ++i) {
+        if(devices[i]->flash.job.state != hmi3d_UpdateState_Done)
+            failed++;
+    }
+
+    return failed;
+}
+
+#endif
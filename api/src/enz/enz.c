@@ -0,0 +1,1550 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "inflate.h"
+#include "../3d/3d.h"
+
+#if !defined(HMI3D_NO_UPDATE) && !defined(HMI3D_NO_ENZ)
+
+#if defined(_WIN32) || defined(__linux__)
+#include <stdio.h>
+#endif
+
+/* Longest file name within the package that is recognized */
+#define ENZ_NAME_SIZE 64
+/* Maximum count of images listed in content.json */
+#define ENZ_MAX_IMAGES 8
+/* Maximum size of content.json */
+#define ENZ_INDEX_SIZE 4096
+/* Maximum count of records that are compared by the check */
+#define ENZ_MAX_RECORDS 1024
+
+/* Addresses of the initialization vector and the version-string in
+ * ENC-files. Together they form the end of the address range.
+ */
+#define ENZ_IV_ADDRESS 0xFFF0
+#define ENZ_VERSION_ADDRESS 0xFF78
+#define ENZ_END_ADDRESS (ENZ_IV_ADDRESS + 14)
+
+/* ======== Zip Archive ======== */
+
+typedef struct {
+    char name[ENZ_NAME_SIZE];
+    int method;
+    unsigned int crc;
+    unsigned int compressed;
+    unsigned int size;
+    unsigned int offset;
+} enz_entry_t;
+
+typedef struct {
+    const hmi3d_enz_source_t *source;
+    /* Central directory */
+    unsigned int directory;
+    unsigned int directory_end;
+    /* Member that is currently decompressed */
+    unsigned int offset;
+    unsigned int left;
+    unsigned char buffer[1024];
+    hmi_inflate_output_t sink;
+    void *sink_opaque;
+    unsigned int crc;
+    unsigned int size;
+    /* Decompression state in the workspace of the source */
+    hmi_inflate_t *inflate;
+    int allocated;
+} enz_t;
+
+/* Compilation fails when the decompression state exceeds the workspace */
+typedef char enz_workspace_check[
+        sizeof(hmi_inflate_t) <= sizeof(hmi3d_enz_workspace_t) ? 1 : -1];
+
+/* Reads exactly size bytes. A short read means a truncated package. */
+static int enz_read(enz_t *enz, unsigned int offset, void *buffer, int size)
+{
+    int result = enz->source->read(enz->source->opaque, offset, buffer, size);
+
+    if(result < 0)
+        return result;
+    return result == size ? HMI_NO_ERROR : HMI_BAD_FORMAT_ERROR;
+}
+
+/* Compares two names ignoring the case of ASCII letters */
+static int enz_equal(const char *a, const char *b)
+{
+    for(;; ++a, ++b) {
+        char ca = (*a >= 'A' && *a <= 'Z') ? *a - 'A' + 'a' : *a;
+        char cb = (*b >= 'A' && *b <= 'Z') ? *b - 'A' + 'a' : *b;
+        if(ca != cb)
+            return 0;
+        if(!ca)
+            return 1;
+    }
+}
+
+/* Releases the workspace allocated by enz_open */
+static void enz_close(enz_t *enz)
+{
+#if defined(HMI_MALLOC) && defined(HMI_FREE)
+    if(enz->allocated)
+        HMI_FREE(enz->inflate);
+#endif
+    enz->inflate = 0;
+    enz->allocated = 0;
+}
+
+/* Acquires the workspace and locates the central directory by the end of
+ * central directory record. enz_close has to be called in any case.
+ */
+static int enz_open(enz_t *enz, const hmi3d_enz_source_t *source)
+{
+    unsigned char tail[1024];
+    unsigned int size = source->size;
+    unsigned int start, end;
+    int error, i;
+
+    enz->source = source;
+    enz->inflate = (hmi_inflate_t *)source->workspace;
+    enz->allocated = 0;
+#if defined(HMI_MALLOC) && defined(HMI_FREE)
+    if(!enz->inflate) {
+        enz->inflate = (hmi_inflate_t *)HMI_MALLOC(sizeof(hmi_inflate_t));
+        enz->allocated = 1;
+    }
+#endif
+    if(!enz->inflate)
+        return HMI_BAD_PARAM_ERROR;
+
+    if(size < 22)
+        return HMI_BAD_FORMAT_ERROR;
+
+    /* The record is followed by a comment of up to 64 kB */
+    end = size;
+    do {
+        start = end > sizeof(tail) ? end - sizeof(tail) : 0;
+        if(start + 65535 + 22 + sizeof(tail) < size)
+            return HMI_BAD_FORMAT_ERROR;
+
+        error = enz_read(enz, start, tail, end - start);
+        if(error)
+            return error;
+
+        for(i = end - start - 22; i >= 0; --i) {
+            if(GET_U32(tail + i) == 0x06054b50)
+                break;
+        }
+
+        /* Keep the overlap for records crossing the chunks */
+        if(i < 0)
+            end = start + 21;
+    } while(i < 0 && start > 0);
+
+    if(i < 0)
+        return HMI_BAD_FORMAT_ERROR;
+
+    /* Split archives are not supported */
+    if(GET_U16(tail + i + 4) != 0 || GET_U16(tail + i + 6) != 0)
+        return HMI_BAD_FORMAT_ERROR;
+
+    enz->directory = GET_U32(tail + i + 16);
+    enz->directory_end = enz->directory + GET_U32(tail + i + 12);
+    if(enz->directory_end < enz->directory ||
+            enz->directory_end > start + i)
+    {
+        return HMI_BAD_FORMAT_ERROR;
+    }
+
+    return HMI_NO_ERROR;
+}
+
+/* Reads the central directory entry at *position and advances *position.
+ * Returns 1 for an entry, 0 at the end of the directory or a negative
+ * error code.
+ */
+static int enz_next_entry(enz_t *enz, unsigned int *position,
+                          enz_entry_t *entry)
+{
+    unsigned char header[46];
+    int name_length, error;
+
+    if(*position >= enz->directory_end)
+        return 0;
+
+    error = enz_read(enz, *position, header, sizeof(header));
+    if(error)
+        return error;
+    if(GET_U32(header) != 0x02014b50)
+        return HMI_BAD_FORMAT_ERROR;
+
+    entry->method = GET_U16(header + 10);
+    entry->crc = GET_U32(header + 16);
+    entry->compressed = GET_U32(header + 20);
+    entry->size = GET_U32(header + 24);
+    entry->offset = GET_U32(header + 42);
+    name_length = GET_U16(header + 28);
+
+    /* Longer names are truncated and won't match any expected name */
+    if(name_length < ENZ_NAME_SIZE) {
+        error = enz_read(enz, *position + 46, entry->name, name_length);
+        if(error)
+            return error;
+        entry->name[name_length] = 0;
+    } else {
+        error = enz_read(enz, *position + 46, entry->name,
+                         ENZ_NAME_SIZE - 2);
+        if(error)
+            return error;
+        entry->name[ENZ_NAME_SIZE - 2] = '~';
+        entry->name[ENZ_NAME_SIZE - 1] = 0;
+    }
+
+    *position += 46 + name_length + GET_U16(header + 30) +
+                 GET_U16(header + 32);
+    if(*position > enz->directory_end)
+        return HMI_BAD_FORMAT_ERROR;
+
+    return 1;
+}
+
+/* Looks up a file. Returns 1 if found, 0 if not or a negative error code. */
+static int enz_find(enz_t *enz, const char *name, enz_entry_t *entry)
+{
+    unsigned int position = enz->directory;
+    int result;
+
+    while((result = enz_next_entry(enz, &position, entry)) > 0) {
+        if(enz_equal(entry->name, name))
+            return 1;
+    }
+
+    return result;
+}
+
+static int enz_input(void *opaque, const unsigned char **data)
+{
+    enz_t *enz = (enz_t *)opaque;
+    int size = enz->left > sizeof(enz->buffer) ?
+               (int)sizeof(enz->buffer) : (int)enz->left;
+    int error;
+
+    if(size == 0)
+        return 0;
+
+    error = enz_read(enz, enz->offset, enz->buffer, size);
+    if(error)
+        return error;
+
+    enz->offset += size;
+    enz->left -= size;
+    *data = enz->buffer;
+    return size;
+}
+
+static int enz_output(void *opaque, const unsigned char *data, int size)
+{
+    enz_t *enz = (enz_t *)opaque;
+
+    enz->crc = hmi3d_crc32_update(enz->crc, data, size);
+    enz->size += size;
+    return enz->sink(enz->sink_opaque, data, size);
+}
+
+/* Decompresses a file and passes its content to sink.
+ * The content is only valid when its checksum matches, which is known
+ * after the last byte was passed on.
+ */
+static int enz_extract(enz_t *enz, const enz_entry_t *entry,
+                       hmi_inflate_output_t sink, void *opaque)
+{
+    unsigned char header[30];
+    int error;
+
+    error = enz_read(enz, entry->offset, header, sizeof(header));
+    if(error)
+        return error;
+    if(GET_U32(header) != 0x04034b50)
+        return HMI_BAD_FORMAT_ERROR;
+
+    enz->offset = entry->offset + 30 + GET_U16(header + 26) +
+                  GET_U16(header + 28);
+    enz->left = entry->compressed;
+    enz->sink = sink;
+    enz->sink_opaque = opaque;
+    enz->crc = 0;
+    enz->size = 0;
+
+    if(entry->method == 8) {
+        error = hmi_inflate(enz->inflate, enz_input, enz_output, enz);
+    } else if(entry->method == 0) {
+        const unsigned char *data;
+        int size;
+        while((size = enz_input(enz, &data)) > 0) {
+            error = enz_output(enz, data, size);
+            if(error)
+                return error;
+        }
+        error = size;
+    } else {
+        error = HMI_BAD_FORMAT_ERROR;
+    }
+
+    if(!error && (enz->crc != entry->crc || enz->size != entry->size))
+        error = HMI_BAD_FORMAT_ERROR;
+
+    return error;
+}
+
+static int enz_discard(void *opaque, const unsigned char *data, int size)
+{
+    HMI_UNUSED(opaque)
+    HMI_UNUSED(data)
+    HMI_UNUSED(size)
+
+    return HMI_NO_ERROR;
+}
+
+/* ======== Index ======== */
+
+typedef struct {
+    char file_name[ENZ_NAME_SIZE];
+    char type[16];
+    int has_version;
+    int has_platform;
+    int has_min_loader;
+    /* Value of parameterizationComplete or -1 when missing */
+    int parameterized;
+} enz_image_entry_t;
+
+typedef struct {
+    unsigned char text[ENZ_INDEX_SIZE];
+    int size;
+    enz_image_entry_t images[ENZ_MAX_IMAGES];
+    int image_count;
+    int has_images;
+    /* Description of the first problem of the index */
+    const char *problem;
+} enz_index_t;
+
+typedef struct {
+    const char *pos;
+    const char *end;
+    int error;
+} enz_json_t;
+
+static int enz_collect(void *opaque, const unsigned char *data, int size)
+{
+    enz_index_t *index = (enz_index_t *)opaque;
+
+    if(index->size + size > ENZ_INDEX_SIZE)
+        return HMI_BAD_FORMAT_ERROR;
+
+    HMI_MEMCPY(index->text + index->size, data, size);
+    index->size += size;
+    return HMI_NO_ERROR;
+}
+
+static char json_peek(enz_json_t *json)
+{
+    while(json->pos < json->end && (*json->pos == ' ' ||
+            *json->pos == '\t' || *json->pos == '\r' || *json->pos == '\n'))
+    {
+        json->pos++;
+    }
+    return json->pos < json->end ? *json->pos : 0;
+}
+
+static void json_expect(enz_json_t *json, char c)
+{
+    if(json_peek(json) == c)
+        json->pos++;
+    else
+        json->error = 1;
+}
+
+/* Reads a string into value which may be NULL. Escaped characters other
+ * than the simple ones are replaced by '?'.
+ */
+static void json_string(enz_json_t *json, char *value, int size)
+{
+    int length = 0;
+
+    json_expect(json, '"');
+    while(!json->error) {
+        char c;
+
+        if(json->pos >= json->end) {
+            json->error = 1;
+            break;
+        }
+        c = *json->pos++;
+        if(c == '"')
+            break;
+        if(c == '\\') {
+            if(json->pos >= json->end) {
+                json->error = 1;
+                break;
+            }
+            c = *json->pos++;
+            if(c == 'u') {
+                json->pos += 4;
+                c = '?';
+            } else if(c == 'n' || c == 'r' || c == 't' ||
+                      c == 'b' || c == 'f') {
+                c = ' ';
+            }
+        }
+        if(value && length < size - 1)
+            value[length++] = c;
+    }
+
+    if(value)
+        value[length] = 0;
+}
+
+/* Skips a literal or number and returns its first character */
+static char json_literal(enz_json_t *json)
+{
+    const char *start = json->pos;
+
+    while(json->pos < json->end &&
+            ((*json->pos >= '0' && *json->pos <= '9') ||
+             (*json->pos >= 'a' && *json->pos <= 'z') ||
+             *json->pos == '-' || *json->pos == '+' ||
+             *json->pos == '.' || *json->pos == 'E'))
+    {
+        json->pos++;
+    }
+
+    if(json->pos == start) {
+        json->error = 1;
+        return 0;
+    }
+    return *start;
+}
+
+static void json_skip(enz_json_t *json, int depth)
+{
+    char c = json_peek(json);
+
+    if(depth > 16) {
+        json->error = 1;
+    } else if(c == '"') {
+        json_string(json, 0, 0);
+    } else if(c == '{' || c == '[') {
+        char close = c == '{' ? '}' : ']';
+        json->pos++;
+        if(json_peek(json) == close) {
+            json->pos++;
+            return;
+        }
+        while(!json->error) {
+            if(c == '{') {
+                json_string(json, 0, 0);
+                json_expect(json, ':');
+            }
+            json_skip(json, depth + 1);
+            if(json_peek(json) != ',')
+                break;
+            json->pos++;
+        }
+        json_expect(json, close);
+    } else {
+        json_literal(json);
+    }
+}
+
+/* Reads a value that has to be a string or a number.
+ * Returns 1 when it has a content.
+ */
+static int json_text(enz_json_t *json, char *value, int size)
+{
+    char c = json_peek(json);
+
+    if(c == '"') {
+        char first[2];
+        if(!value) {
+            value = first;
+            size = sizeof(first);
+        }
+        json_string(json, value, size);
+        return value[0] != 0;
+    }
+
+    if(value)
+        value[0] = 0;
+    c = json_literal(json);
+    return c == '-' || (c >= '0' && c <= '9');
+}
+
+static void json_image(enz_json_t *json, enz_image_entry_t *image)
+{
+    HMI_MEMSET(image, 0, sizeof(*image));
+    image->parameterized = -1;
+
+    json_expect(json, '{');
+    if(json_peek(json) == '}') {
+        json->pos++;
+        return;
+    }
+
+    while(!json->error) {
+        char key[32];
+        json_string(json, key, sizeof(key));
+        json_expect(json, ':');
+        if(json->error)
+            break;
+
+        if(enz_equal(key, "fileName")) {
+            json_text(json, image->file_name, sizeof(image->file_name));
+        } else if(enz_equal(key, "type")) {
+            json_text(json, image->type, sizeof(image->type));
+        } else if(enz_equal(key, "version")) {
+            image->has_version = json_text(json, 0, 0);
+        } else if(enz_equal(key, "platform")) {
+            image->has_platform = json_text(json, 0, 0);
+        } else if(enz_equal(key, "minLoaderVersion")) {
+            image->has_min_loader = json_text(json, 0, 0);
+        } else if(enz_equal(key, "parameterizationComplete")) {
+            if(json_peek(json) == 't' || json_peek(json) == 'f')
+                image->parameterized = json_literal(json) == 't';
+            else
+                json_skip(json, 1);
+        } else {
+            json_skip(json, 1);
+        }
+
+        if(json_peek(json) != ',')
+            break;
+        json->pos++;
+    }
+    json_expect(json, '}');
+}
+
+/* Reads and parses content.json. A missing or malformed index is described
+ * by index->problem.
+ */
+static int enz_read_index(enz_t *enz, enz_index_t *index)
+{
+    enz_json_t json;
+    enz_entry_t entry;
+    int result;
+
+    index->size = 0;
+    index->image_count = 0;
+    index->has_images = 0;
+    index->problem = 0;
+
+    result = enz_find(enz, "content.json", &entry);
+    if(result < 0)
+        return result;
+    if(result == 0) {
+        index->problem = "Missing content.json file";
+        return HMI_NO_ERROR;
+    }
+
+    result = enz_extract(enz, &entry, enz_collect, index);
+    if(result == HMI_BAD_FORMAT_ERROR) {
+        index->problem = "content.json: Could not read file";
+        return HMI_NO_ERROR;
+    }
+    if(result)
+        return result;
+
+    json.pos = (const char *)index->text;
+    json.end = json.pos + index->size;
+    json.error = 0;
+
+    json_expect(&json, '{');
+    if(json_peek(&json) == '}')
+        json.pos++;
+    else while(!json.error) {
+        char key[32];
+        json_string(&json, key, sizeof(key));
+        json_expect(&json, ':');
+        if(json.error)
+            break;
+
+        if(enz_equal(key, "images") && json_peek(&json) == '[') {
+            index->has_images = 1;
+            json.pos++;
+            while(!json.error && json_peek(&json) != ']') {
+                if(json_peek(&json) != '{') {
+                    index->problem = "content.json: \"images\" contains "
+                                     "non object entries";
+                    json_skip(&json, 1);
+                } else if(index->image_count < ENZ_MAX_IMAGES) {
+                    json_image(&json, index->images + index->image_count++);
+                } else {
+                    json_skip(&json, 1);
+                }
+                if(json_peek(&json) != ',')
+                    break;
+                json.pos++;
+            }
+            json_expect(&json, ']');
+        } else {
+            json_skip(&json, 1);
+        }
+
+        if(json_peek(&json) != ',')
+            break;
+        json.pos++;
+    }
+    json_expect(&json, '}');
+
+    if(json.error) {
+        index->problem = "content.json: Bad syntax";
+        index->image_count = 0;
+    } else if(!index->has_images && !index->problem) {
+        index->problem = "content.json: Does not contain image-list";
+    }
+
+    return HMI_NO_ERROR;
+}
+
+static const char *enz_type_name(hmi3d_enz_image_t image)
+{
+    return image == hmi3d_EnzImage_Loader ? "loader" : "library";
+}
+
+/* Finds the ENC-file of an image by the index or by its default name */
+static int enz_find_image(enz_t *enz, enz_index_t *index,
+                          hmi3d_enz_image_t image, enz_entry_t *entry)
+{
+    const char *name = image == hmi3d_EnzImage_Loader ?
+                       "Loader.enc" : "Library.enc";
+    int error, i, result;
+
+    error = enz_read_index(enz, index);
+    if(error)
+        return error;
+
+    for(i = 0; i < index->image_count; ++i) {
+        if(enz_equal(index->images[i].type, enz_type_name(image)) &&
+                index->images[i].file_name[0])
+        {
+            name = index->images[i].file_name;
+            break;
+        }
+    }
+
+    result = enz_find(enz, name, entry);
+    if(result < 0)
+        return result;
+    return result ? HMI_NO_ERROR : HMI_BAD_FORMAT_ERROR;
+}
+
+/* ======== Images ======== */
+
+typedef int (*enz_record_handler_t)(void *opaque,
+                                    const hmi3d_update_record_t *record);
+
+typedef struct {
+    enz_record_handler_t handler;
+    void *opaque;
+    /* Line that is currently collected */
+    char line[1 + 2 * (5 + 255) + 1];
+    int line_length;
+    int line_number;
+    int overflow;
+    /* Parsed content */
+    unsigned int upper;
+    int end;
+    unsigned char iv[14];
+    unsigned char fw_version[120];
+    /* Nonzero for each byte of fw_version and iv that was given */
+    unsigned char given[ENZ_END_ADDRESS - ENZ_VERSION_ADDRESS];
+    hmi3d_update_record_t record;
+    int pending;
+    int record_count;
+    /* Description of the first problem */
+    const char *problem;
+    int problem_line;
+} enz_hex_t;
+
+static void hex_init(enz_hex_t *hex, enz_record_handler_t handler,
+                     void *opaque)
+{
+    HMI_MEMSET(hex, 0, sizeof(*hex));
+    hex->handler = handler;
+    hex->opaque = opaque;
+}
+
+static int hex_fail(enz_hex_t *hex, const char *problem)
+{
+    hex->problem = problem;
+    hex->problem_line = hex->line_number;
+    return HMI_BAD_FORMAT_ERROR;
+}
+
+static int hex_digit(char c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+static int hex_flush(enz_hex_t *hex)
+{
+    int error = HMI_NO_ERROR;
+
+    if(hex->pending) {
+        hex->pending = 0;
+        hex->record_count++;
+        if(hex->handler)
+            error = hex->handler(hex->opaque, &hex->record);
+    }
+
+    return error;
+}
+
+/* Appends data to the records. Contiguous data is merged into records
+ * that don't cross 128-byte boundaries like those of the C-structure.
+ */
+static int hex_data(enz_hex_t *hex, unsigned int address,
+                    const unsigned char *data, int size)
+{
+    int error;
+
+    for(; size > 0; --size, ++data, ++address) {
+        hmi3d_update_record_t *record = &hex->record;
+
+        if(!hex->pending || address % 128 == 0 ||
+                address != record->address + record->length)
+        {
+            error = hex_flush(hex);
+            if(error)
+                return error;
+            HMI_MEMSET(record->data, 0xFF, sizeof(record->data));
+            record->address = (unsigned short)address;
+            record->length = 0;
+            hex->pending = 1;
+        }
+        record->data[record->length++] = *data;
+    }
+
+    return HMI_NO_ERROR;
+}
+
+static int hex_line(enz_hex_t *hex)
+{
+    unsigned char bytes[5 + 255];
+    int count = (hex->line_length - 1) / 2;
+    unsigned int address;
+    unsigned char sum = 0;
+    int i;
+
+    if(hex->overflow)
+        return hex_fail(hex, "Line too long");
+    if(hex->line[0] != ':' || hex->line_length % 2 != 1 || count < 5)
+        return hex_fail(hex, "Bad record");
+    if(hex->end)
+        return hex_fail(hex, "Data after end of file record");
+
+    for(i = 0; i < count; ++i) {
+        int high = hex_digit(hex->line[1 + 2 * i]);
+        int low = hex_digit(hex->line[2 + 2 * i]);
+        if(high < 0 || low < 0)
+            return hex_fail(hex, "Bad record");
+        bytes[i] = (unsigned char)(high << 4 | low);
+        sum += bytes[i];
+    }
+
+    if(bytes[0] + 5 != count)
+        return hex_fail(hex, "Bad record length");
+    if(sum != 0)
+        return hex_fail(hex, "Bad record checksum");
+
+    address = hex->upper + (bytes[1] << 8 | bytes[2]);
+
+    switch(bytes[3]) {
+    case 0:
+        if(address + bytes[0] > ENZ_END_ADDRESS)
+            return hex_fail(hex, "Address out of range");
+
+        /* The version-string and the initialization vector may be split
+         * into several records of any order
+         */
+        for(i = 0; i < bytes[0]; ++i) {
+            unsigned int offset = address + i - ENZ_VERSION_ADDRESS;
+            if(address + i < ENZ_VERSION_ADDRESS)
+                continue;
+            if(offset < sizeof(hex->fw_version))
+                hex->fw_version[offset] = bytes[4 + i];
+            else
+                hex->iv[offset - sizeof(hex->fw_version)] = bytes[4 + i];
+            hex->given[offset] = 1;
+        }
+
+        if(address < ENZ_VERSION_ADDRESS) {
+            count = bytes[0];
+            if(address + count > ENZ_VERSION_ADDRESS)
+                count = ENZ_VERSION_ADDRESS - address;
+            return hex_data(hex, address, bytes + 4, count);
+        }
+        break;
+    case 1:
+        hex->end = 1;
+        break;
+    case 4:
+        if(bytes[0] != 2)
+            return hex_fail(hex, "Bad record length");
+        hex->upper = (unsigned int)(bytes[4] << 8 | bytes[5]) << 16;
+        break;
+    default:
+        return hex_fail(hex, "Unsupported record type");
+    }
+
+    return HMI_NO_ERROR;
+}
+
+static int hex_output(void *opaque, const unsigned char *data, int size)
+{
+    enz_hex_t *hex = (enz_hex_t *)opaque;
+    int error;
+
+    for(; size > 0; --size, ++data) {
+        if(*data == '\n' || *data == '\r') {
+            if(hex->line_length > 0) {
+                error = hex_line(hex);
+                if(error)
+                    return error;
+            }
+            hex->line_length = 0;
+            hex->overflow = 0;
+        } else if(hex->line_length < (int)sizeof(hex->line)) {
+            if(hex->line_length == 0)
+                hex->line_number++;
+            hex->line[hex->line_length++] = (char)*data;
+        } else {
+            hex->overflow = 1;
+        }
+    }
+
+    return HMI_NO_ERROR;
+}
+
+/* Completes the image after the last chunk was passed to hex_output */
+static int hex_finish(enz_hex_t *hex)
+{
+    int error, i;
+
+    if(hex->line_length > 0) {
+        error = hex_line(hex);
+        if(error)
+            return error;
+    }
+
+    error = hex_flush(hex);
+    if(error)
+        return error;
+
+    if(!hex->end)
+        return hex_fail(hex, "Missing end of file record");
+    for(i = sizeof(hex->fw_version); i < (int)sizeof(hex->given); ++i) {
+        if(!hex->given[i])
+            return hex_fail(hex, "Missing initialization vector");
+    }
+    for(i = 0; i < (int)sizeof(hex->fw_version); ++i) {
+        if(!hex->given[i])
+            return hex_fail(hex, "Missing version-string");
+    }
+    if(hex->record_count == 0)
+        return hex_fail(hex, "Record count == 0");
+
+    return HMI_NO_ERROR;
+}
+
+/* Reads an ENC-file and passes its records to the handler of hex */
+static int enz_read_image(enz_t *enz, const enz_entry_t *entry,
+                          enz_hex_t *hex)
+{
+    int error = enz_extract(enz, entry, hex_output, hex);
+
+    if(!error)
+        error = hex_finish(hex);
+    return error;
+}
+
+/* Checksum of a record used to compare it with the C-structure */
+static unsigned int enz_record_crc(const hmi3d_update_record_t *record)
+{
+    unsigned char header[3];
+
+    SET_U16(header, record->address);
+    SET_U8(header + 2, record->length);
+    return hmi3d_crc32_update(hmi3d_crc32(header, sizeof(header)),
+                              record->data, record->length);
+}
+
+/* ======== C-Structures ======== */
+
+typedef struct {
+    enz_record_handler_t handler;
+    void *opaque;
+    /* Tokenizer */
+    int comment;
+    int slash;
+    int star;
+    char token[24];
+    int token_length;
+    int started;
+    int depth;
+    int done;
+    /* Values of the initializer */
+    unsigned int value_count;
+    unsigned int declared_count;
+    unsigned char iv[14];
+    unsigned char fw_version[120];
+    hmi3d_update_record_t record;
+    int record_count;
+    const char *problem;
+} enz_cstruct_t;
+
+static int cstruct_value(enz_cstruct_t *c, unsigned int value)
+{
+    unsigned int index = c->value_count++;
+    unsigned int field;
+
+    if(index == 0) {
+        c->declared_count = value;
+        return HMI_NO_ERROR;
+    }
+    if(index < 1 + 14) {
+        c->iv[index - 1] = (unsigned char)value;
+        return HMI_NO_ERROR;
+    }
+    if(index < 1 + 14 + 120) {
+        c->fw_version[index - 15] = (unsigned char)value;
+        return HMI_NO_ERROR;
+    }
+
+    field = (index - 135) % 130;
+    if(field == 0) {
+        c->record.address = (unsigned short)value;
+    } else if(field == 1) {
+        if(value > 128) {
+            c->problem = "Bad record length";
+            return HMI_BAD_FORMAT_ERROR;
+        }
+        c->record.length = (unsigned char)value;
+    } else {
+        c->record.data[field - 2] = (unsigned char)value;
+        if(field == 129) {
+            c->record_count++;
+            if(c->handler)
+                return c->handler(c->opaque, &c->record);
+        }
+    }
+
+    return HMI_NO_ERROR;
+}
+
+static int cstruct_token(enz_cstruct_t *c)
+{
+    unsigned int value = 0;
+    int i = 0;
+    int base = 10;
+
+    if(c->token_length == 0 || !c->started || c->done)
+        return HMI_NO_ERROR;
+
+    c->token[c->token_length] = 0;
+    c->token_length = 0;
+
+    if(c->token[0] == '0' && (c->token[1] == 'x' || c->token[1] == 'X')) {
+        base = 16;
+        i = 2;
+    }
+
+    for(; c->token[i] && c->token[i] != 'u' && c->token[i] != 'U'; ++i) {
+        int digit = hex_digit(c->token[i]);
+        if(digit < 0 || digit >= base) {
+            c->problem = "Unexpected token";
+            return HMI_BAD_FORMAT_ERROR;
+        }
+        value = value * base + digit;
+    }
+
+    return cstruct_value(c, value);
+}
+
+static int cstruct_output(void *opaque, const unsigned char *data, int size)
+{
+    enz_cstruct_t *c = (enz_cstruct_t *)opaque;
+    int error;
+
+    for(; size > 0; --size, ++data) {
+        char ch = (char)*data;
+
+        if(c->comment == 1) {
+            if(ch == '\n')
+                c->comment = 0;
+            continue;
+        }
+        if(c->comment == 2) {
+            if(c->star && ch == '/')
+                c->comment = 0;
+            c->star = ch == '*';
+            continue;
+        }
+        if(c->slash) {
+            c->slash = 0;
+            if(ch == '/' || ch == '*') {
+                c->comment = ch == '/' ? 1 : 2;
+                c->star = 0;
+                continue;
+            }
+            c->problem = "Unexpected token /";
+            return HMI_BAD_FORMAT_ERROR;
+        }
+
+        if((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') ||
+                (ch >= 'A' && ch <= 'Z') || ch == '_')
+        {
+            if(c->token_length >= (int)sizeof(c->token) - 1) {
+                c->problem = "Unexpected token";
+                return HMI_BAD_FORMAT_ERROR;
+            }
+            c->token[c->token_length++] = ch;
+            continue;
+        }
+
+        error = cstruct_token(c);
+        c->token_length = 0;
+        if(error)
+            return error;
+
+        if(ch == '/') {
+            c->slash = 1;
+        } else if(ch == '=') {
+            c->started = 1;
+        } else if(c->started && !c->done) {
+            if(ch == '{') {
+                c->depth++;
+            } else if(ch == '}') {
+                if(--c->depth == 0)
+                    c->done = 1;
+            } else if(ch != ',' && ch != ' ' && ch != '\t' &&
+                      ch != '\r' && ch != '\n') {
+                c->problem = "Unexpected token";
+                return HMI_BAD_FORMAT_ERROR;
+            }
+        }
+    }
+
+    return HMI_NO_ERROR;
+}
+
+static int cstruct_finish(enz_cstruct_t *c)
+{
+    int error = cstruct_token(c);
+
+    if(error)
+        return error;
+
+    if(!c->done) {
+        c->problem = "Unexpected end of input";
+        return HMI_BAD_FORMAT_ERROR;
+    }
+    if(c->value_count < 135 || (c->value_count - 135) % 130 != 0 ||
+            (unsigned int)c->record_count != c->declared_count)
+    {
+        c->problem = "Record count does not match the records";
+        return HMI_BAD_FORMAT_ERROR;
+    }
+    if(c->record_count == 0) {
+        c->problem = "Record count == 0";
+        return HMI_BAD_FORMAT_ERROR;
+    }
+
+    return HMI_NO_ERROR;
+}
+
+/* ======== Check ======== */
+
+typedef struct {
+    hmi3d_enz_report_t report;
+    void *opaque;
+    int problems;
+    /* Records of the ENC-file for comparison with the C-structure */
+    unsigned int crc[ENZ_MAX_RECORDS];
+    int count;
+    int mismatch;
+} enz_check_t;
+
+static char *enz_append(char *pos, char *end, const char *text)
+{
+    while(*text && pos < end)
+        *pos++ = *text++;
+    return pos;
+}
+
+/* Reports "<name>: <text><label><number>" where name and label are
+ * optional.
+ */
+static void enz_report(enz_check_t *check, const char *name,
+                       const char *text, const char *label, int number)
+{
+    char message[256];
+    char *pos = message;
+    char *end = message + sizeof(message) - 1;
+
+    check->problems++;
+    if(!check->report)
+        return;
+
+    if(name) {
+        pos = enz_append(pos, end, name);
+        pos = enz_append(pos, end, ": ");
+    }
+    pos = enz_append(pos, end, text);
+    if(label) {
+        char digits[12];
+        int i = sizeof(digits) - 1;
+        unsigned int value = number < 0 ? 0 : (unsigned int)number;
+
+        digits[i] = 0;
+        do {
+            digits[--i] = (char)('0' + value % 10);
+            value /= 10;
+        } while(value && i > 0);
+
+        pos = enz_append(pos, end, label);
+        pos = enz_append(pos, end, digits + i);
+    }
+    *pos = 0;
+
+    check->report(check->opaque, message);
+}
+
+static int check_enc_record(void *opaque, const hmi3d_update_record_t *record)
+{
+    enz_check_t *check = (enz_check_t *)opaque;
+
+    if(check->count < ENZ_MAX_RECORDS)
+        check->crc[check->count] = enz_record_crc(record);
+    check->count++;
+    return HMI_NO_ERROR;
+}
+
+static int check_c_record(void *opaque, const hmi3d_update_record_t *record)
+{
+    enz_check_t *check = (enz_check_t *)opaque;
+    int index = check->mismatch;
+
+    /* mismatch counts the matching records until the first difference */
+    if(index >= 0 && index < check->count && index < ENZ_MAX_RECORDS) {
+        if(check->crc[index] == enz_record_crc(record))
+            check->mismatch++;
+        else
+            check->mismatch = -1 - index;
+    }
+    return HMI_NO_ERROR;
+}
+
+/* Replaces the extension of an ENC-file name */
+static void enz_sibling(char *name, const char *file_name,
+                        const char *extension)
+{
+    int length = 0;
+    int dot = -1;
+    int i;
+
+    for(i = 0; file_name[i] && i < ENZ_NAME_SIZE - 1; ++i) {
+        if(file_name[i] == '.')
+            dot = i;
+        else if(file_name[i] == '/' || file_name[i] == '\\')
+            dot = -1;
+    }
+    length = dot >= 0 ? dot : i;
+
+    for(i = 0; i < length && i < ENZ_NAME_SIZE - 10; ++i)
+        name[i] = file_name[i];
+    for(; *extension; ++extension)
+        name[i++] = *extension;
+    name[i] = 0;
+}
+
+/* Checks one image and the C-structure file that belongs to it */
+static int check_image(enz_t *enz, enz_check_t *check,
+                       const char *file_name, int has_evc)
+{
+    enz_hex_t hex;
+    enz_cstruct_t c;
+    enz_entry_t entry;
+    char name[ENZ_NAME_SIZE];
+    int result;
+
+    result = enz_find(enz, file_name, &entry);
+    if(result < 0)
+        return result;
+    if(result == 0) {
+        enz_report(check, file_name, "Missing image file", 0, 0);
+        return HMI_NO_ERROR;
+    }
+
+    check->count = 0;
+    hex_init(&hex, check_enc_record, check);
+    result = enz_read_image(enz, &entry, &hex);
+    if(result == HMI_BAD_FORMAT_ERROR) {
+        if(hex.problem)
+            enz_report(check, file_name, hex.problem,
+                       " in line ", hex.problem_line);
+        else
+            enz_report(check, file_name, "Could not read image file", 0, 0);
+        return HMI_NO_ERROR;
+    }
+    if(result)
+        return result;
+    if(check->count > ENZ_MAX_RECORDS)
+        enz_report(check, file_name, "Too many records to compare", 0, 0);
+
+    /* Parameterization requires the encrypted Aurea data */
+    enz_sibling(name, file_name, ".settings");
+    result = enz_find(enz, name, &entry);
+    if(result < 0)
+        return result;
+    if(result && !has_evc) {
+        enz_report(check, name, "aurea.evc which is required for "
+                   "parameterization is missing", 0, 0);
+    }
+
+    /* The C-structure has to describe the same image */
+    enz_sibling(name, file_name, ".c");
+    result = enz_find(enz, name, &entry);
+    if(result < 0)
+        return result;
+    if(result == 0) {
+        enz_report(check, name, "Missing the c-struct file", 0, 0);
+        return HMI_NO_ERROR;
+    }
+
+    HMI_MEMSET(&c, 0, sizeof(c));
+    c.handler = check_c_record;
+    c.opaque = check;
+    check->mismatch = 0;
+
+    result = enz_extract(enz, &entry, cstruct_output, &c);
+    if(!result)
+        result = cstruct_finish(&c);
+    if(result == HMI_BAD_FORMAT_ERROR) {
+        enz_report(check, name, c.problem ? c.problem :
+                   "Could not read c-struct file", 0, 0);
+        return HMI_NO_ERROR;
+    }
+    if(result)
+        return result;
+
+    if(c.record_count != check->count) {
+        enz_report(check, name, "Record count does not match to the "
+                   "ENC-file", 0, 0);
+    } else if(check->mismatch < 0) {
+        enz_report(check, name, "Does not match to the ENC-file",
+                   " at record ", -1 - check->mismatch);
+    } else {
+        int i;
+        for(i = 0; i < 14 && c.iv[i] == hex.iv[i]; ++i) ;
+        if(i < 14)
+            enz_report(check, name, "Initialization vector does not "
+                       "match to the ENC-file", 0, 0);
+        for(i = 0; i < 120 && c.fw_version[i] == hex.fw_version[i]; ++i) ;
+        if(i < 120)
+            enz_report(check, name, "Version-string does not match to "
+                       "the ENC-file", 0, 0);
+    }
+
+    return HMI_NO_ERROR;
+}
+
+/* Checks the content of an opened package */
+static int check_package(enz_t *enz, enz_check_t *check)
+{
+    enz_index_t index;
+    enz_entry_t entry;
+    unsigned int position;
+    int has_evc = 0;
+    int result, i;
+
+    /* Every file has to be readable and match its checksum */
+    position = enz->directory;
+    while((result = enz_next_entry(enz, &position, &entry)) > 0) {
+        if(enz_equal(entry.name, "aurea.evc"))
+            has_evc = 1;
+        if((entry.name[0] == 'a' || entry.name[0] == 'A') &&
+                (entry.name[5] == '/' || entry.name[5] == '\\'))
+        {
+            char directory[6];
+            HMI_MEMCPY(directory, entry.name, 5);
+            directory[5] = 0;
+            if(enz_equal(directory, "aurea") && entry.size != 0)
+                enz_report(check, entry.name, "The aurea directory "
+                           "contains unencrypted confidential data", 0, 0);
+        }
+
+        result = enz_extract(enz, &entry, enz_discard, 0);
+        if(result == HMI_BAD_FORMAT_ERROR)
+            enz_report(check, entry.name, "Could not read file", 0, 0);
+        else if(result)
+            return result;
+    }
+    if(result == HMI_BAD_FORMAT_ERROR) {
+        enz_report(check, 0, "Bad entry of central directory", 0, 0);
+        return check->problems;
+    }
+    if(result)
+        return result;
+
+    result = enz_read_index(enz, &index);
+    if(result)
+        return result;
+    if(index.problem)
+        enz_report(check, 0, index.problem, 0, 0);
+
+    for(i = 0; i < index.image_count; ++i) {
+        enz_image_entry_t *image = index.images + i;
+
+        if(!image->file_name[0]) {
+            enz_report(check, 0, "content.json: Entry without valid "
+                       "image file name", 0, 0);
+            continue;
+        }
+        if(!image->has_version)
+            enz_report(check, image->file_name, "Has no valid version "
+                       "property", 0, 0);
+        if(!image->has_platform)
+            enz_report(check, image->file_name, "Has no valid platform "
+                       "property", 0, 0);
+        if(!enz_equal(image->type, "library") &&
+                !enz_equal(image->type, "loader"))
+        {
+            enz_report(check, image->file_name, "Entry is not a known "
+                       "image type", 0, 0);
+            continue;
+        }
+        if(enz_equal(image->type, "library")) {
+            if(!image->has_min_loader)
+                enz_report(check, image->file_name, "Has no valid "
+                           "minLoaderVersion property", 0, 0);
+            if(image->parameterized < 0)
+                enz_report(check, image->file_name, "Has no valid "
+                           "parameterizationComplete property", 0, 0);
+            else if(!image->parameterized)
+                enz_report(check, image->file_name, "Has incomplete "
+                           "parameterization", 0, 0);
+        }
+
+        result = check_image(enz, check, image->file_name, has_evc);
+        if(result)
+            return result;
+    }
+
+    /* Without usable index the images are checked by their default names */
+    if(index.image_count == 0) {
+        static const char *defaults[2] = { "Library.enc", "Loader.enc" };
+        for(i = 0; i < 2; ++i) {
+            result = enz_find(enz, defaults[i], &entry);
+            if(result > 0)
+                result = check_image(enz, check, defaults[i], has_evc);
+            if(result < 0)
+                return result;
+        }
+    }
+
+    return check->problems;
+}
+
+int hmi3d_enz_check(const hmi3d_enz_source_t *source,
+                    hmi3d_enz_report_t report,
+                    void *opaque)
+{
+    enz_t enz;
+    enz_check_t check;
+    int result;
+
+    HMI_ASSERT(source && source->read);
+
+    check.report = report;
+    check.opaque = opaque;
+    check.problems = 0;
+
+    result = enz_open(&enz, source);
+    if(result == HMI_BAD_FORMAT_ERROR) {
+        enz_report(&check, 0, "Is not an ENZ-file", 0, 0);
+        result = check.problems;
+    } else if(!result) {
+        result = check_package(&enz, &check);
+    }
+
+    enz_close(&enz);
+
+    return result;
+}
+
+/* ======== Update ======== */
+
+typedef struct {
+    hmi_t *hmi;
+    hmi3d_UpdateFunction_t mode;
+} enz_update_t;
+
+static int update_record(void *opaque, const hmi3d_update_record_t *record)
+{
+    enz_update_t *update = (enz_update_t *)opaque;
+
+    return hmi3d_update_write(update->hmi, record->address, record->length,
+                              (unsigned char *)record->data, update->mode);
+}
+
+int hmi3d_enz_info(const hmi3d_enz_source_t *source,
+                   hmi3d_enz_image_t image,
+                   hmi3d_enz_info_t *info)
+{
+    enz_t enz;
+    enz_index_t index;
+    enz_entry_t entry;
+    enz_hex_t hex;
+    int error;
+
+    HMI_ASSERT(source && source->read && info);
+
+    error = enz_open(&enz, source);
+    if(!error)
+        error = enz_find_image(&enz, &index, image, &entry);
+
+    hex_init(&hex, 0, 0);
+    if(!error)
+        error = enz_read_image(&enz, &entry, &hex);
+
+    if(!error) {
+        info->record_count = hex.record_count;
+        HMI_MEMCPY(info->iv, hex.iv, sizeof(info->iv));
+        HMI_MEMCPY(info->fw_version, hex.fw_version,
+                   sizeof(info->fw_version));
+    }
+
+    enz_close(&enz);
+
+    return error;
+}
+
+int hmi3d_enz_update(hmi_t *hmi,
+                     unsigned int session_id,
+                     const hmi3d_enz_source_t *source,
+                     hmi3d_enz_image_t image,
+                     hmi3d_UpdateFunction_t mode)
+{
+    enz_t enz;
+    enz_index_t index;
+    enz_entry_t entry;
+    enz_hex_t hex;
+    enz_update_t update;
+    int error;
+
+    HMI_ASSERT(hmi && source && source->read);
+
+    error = enz_open(&enz, source);
+    if(!error)
+        error = enz_find_image(&enz, &index, image, &entry);
+
+    /* Validate the whole image before the device is touched */
+    hex_init(&hex, 0, 0);
+    if(!error)
+        error = enz_read_image(&enz, &entry, &hex);
+
+    if(!error)
+        error = hmi3d_update_begin(hmi, session_id, hex.iv, mode);
+
+    /* Stream the records straight from the decompression */
+    update.hmi = hmi;
+    update.mode = mode;
+    hex_init(&hex, update_record, &update);
+    if(!error)
+        error = enz_read_image(&enz, &entry, &hex);
+
+    if(!error)
+        error = hmi3d_update_end(hmi, hex.fw_version);
+
+    enz_close(&enz);
+
+    return error;
+}
+
+#if defined(_WIN32) || defined(__linux__)
+
+static int CDECL file_reader(void *opaque, unsigned int offset,
+                             void *buffer, int size)
+{
+    FILE *file = (FILE *)opaque;
+    size_t result;
+
+    if(fseek(file, (long)offset, SEEK_SET))
+        return HMI_IO_ERROR;
+
+    result = fread(buffer, 1, size, file);
+    if(result < (size_t)size && ferror(file))
+        return HMI_IO_ERROR;
+
+    return (int)result;
+}
+
+int hmi3d_enz_open_file(hmi3d_enz_source_t *source, const char *filename)
+{
+    FILE *file;
+    long size;
+
+    HMI_ASSERT(source && filename);
+
+    HMI_MEMSET(source, 0, sizeof(*source));
+
+    file = fopen(filename, "rb");
+    if(!file)
+        return HMI_IO_OPEN_ERROR;
+
+    if(fseek(file, 0, SEEK_END) || (size = ftell(file)) < 0) {
+        fclose(file);
+        return HMI_IO_OPEN_ERROR;
+    }
+
+    source->read = file_reader;
+    source->opaque = file;
+    source->size = (unsigned int)size;
+
+    return HMI_NO_ERROR;
+}
+
+void hmi3d_enz_close_file(hmi3d_enz_source_t *source)
+{
+    HMI_ASSERT(source);
+
+    if(source->opaque)
+        fclose((FILE *)source->opaque);
+    HMI_MEMSET(source, 0, sizeof(*source));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,391 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "inflate.h"
+
+#if !defined(HMI3D_NO_UPDATE) && !defined(HMI3D_NO_ENZ)
+
+/* The decoder follows RFC 1951 in the style of the puff reference decoder:
+ * Codes are decoded bit by bit with canonical Huffman tables, which keeps
+ * the tables small and is fast enough for firmware packages.
+ */
+
+#define WINDOW_MASK 0x7FFF
+#define MAX_BITS 15
+
+static const short length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const short length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const short distance_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const short distance_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Fetches the next input byte. Errors are kept in s->error. */
+static int next_byte(hmi_inflate_t *s)
+{
+    if(s->in_left <= 0) {
+        if(s->error)
+            return 0;
+        s->in_left = s->input(s->opaque, &s->in);
+        if(s->in_left <= 0) {
+            s->error = s->in_left < 0 ? s->in_left : HMI_BAD_FORMAT_ERROR;
+            s->in_left = 0;
+            return 0;
+        }
+    }
+    s->in_left--;
+    return *s->in++;
+}
+
+/* Returns the next count bits of the input, least significant first */
+static int get_bits(hmi_inflate_t *s, int count)
+{
+    unsigned int value = s->bits;
+
+    while(s->bit_count < count) {
+        value |= (unsigned int)next_byte(s) << s->bit_count;
+        s->bit_count += 8;
+    }
+
+    s->bits = value >> count;
+    s->bit_count -= count;
+    return (int)(value & ((1u << count) - 1));
+}
+
+/* Appends one byte to the window which is passed on when it is full */
+static void put_byte(hmi_inflate_t *s, unsigned char value)
+{
+    s->window[s->total & WINDOW_MASK] = value;
+    s->total++;
+
+    if(s->total - s->flushed > WINDOW_MASK && !s->error) {
+        s->error = s->output(s->opaque, s->window, WINDOW_MASK + 1);
+        s->flushed = s->total;
+    }
+}
+
+/* Decodes one symbol with the canonical code given by count and symbol */
+static int decode(hmi_inflate_t *s, const short *count, const short *symbol)
+{
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    int length;
+
+    for(length = 1; length <= MAX_BITS; ++length) {
+        code |= get_bits(s, 1);
+        if(code - count[length] < first)
+            return symbol[index + (code - first)];
+        index += count[length];
+        first = (first + count[length]) << 1;
+        code <<= 1;
+    }
+
+    /* Ran out of codes */
+    if(!s->error)
+        s->error = HMI_BAD_FORMAT_ERROR;
+    return -1;
+}
+
+/* Builds the canonical code of the given code lengths.
+ * Returns 0 for a complete code, a positive value for an incomplete code
+ * and a negative value for an over-subscribed code.
+ */
+static int construct(short *count, short *symbol,
+                     const short *lengths, int n)
+{
+    short offsets[MAX_BITS + 1];
+    int left = 1;
+    int length, i;
+
+    for(length = 0; length <= MAX_BITS; ++length)
+        count[length] = 0;
+    for(i = 0; i < n; ++i)
+        count[lengths[i]]++;
+
+    if(count[0] == n)
+        return 0;
+
+    for(length = 1; length <= MAX_BITS; ++length) {
+        left = (left << 1) - count[length];
+        if(left < 0)
+            return left;
+    }
+
+    offsets[1] = 0;
+    for(length = 1; length < MAX_BITS; ++length)
+        offsets[length + 1] = offsets[length] + count[length];
+
+    for(i = 0; i < n; ++i) {
+        if(lengths[i] != 0)
+            symbol[offsets[lengths[i]]++] = (short)i;
+    }
+
+    return left;
+}
+
+/* Decodes the symbols of a compressed block */
+static void codes(hmi_inflate_t *s)
+{
+    for(;;) {
+        int symbol = decode(s, s->length_count, s->length_symbol);
+        int length, distance;
+
+        if(s->error)
+            return;
+
+        if(symbol < 256) {
+            put_byte(s, (unsigned char)symbol);
+            continue;
+        }
+        if(symbol == 256)
+            return;
+
+        symbol -= 257;
+        if(symbol >= 29) {
+            s->error = HMI_BAD_FORMAT_ERROR;
+            return;
+        }
+        length = length_base[symbol] + get_bits(s, length_extra[symbol]);
+
+        symbol = decode(s, s->distance_count, s->distance_symbol);
+        if(s->error)
+            return;
+        if(symbol >= 30) {
+            s->error = HMI_BAD_FORMAT_ERROR;
+            return;
+        }
+        distance = distance_base[symbol] +
+                   get_bits(s, distance_extra[symbol]);
+
+        if((unsigned int)distance > s->total) {
+            s->error = HMI_BAD_FORMAT_ERROR;
+            return;
+        }
+
+        while(length-- > 0)
+            put_byte(s, s->window[(s->total - distance) & WINDOW_MASK]);
+    }
+}
+
+/* Copies a stored block */
+static void stored(hmi_inflate_t *s)
+{
+    unsigned int length, complement;
+
+    /* Stored blocks start at a byte boundary */
+    s->bits = 0;
+    s->bit_count = 0;
+
+    length = next_byte(s);
+    length |= next_byte(s) << 8;
+    complement = next_byte(s);
+    complement |= next_byte(s) << 8;
+    if(!s->error && length != (~complement & 0xFFFF))
+        s->error = HMI_BAD_FORMAT_ERROR;
+
+    while(!s->error && length-- > 0)
+        put_byte(s, (unsigned char)next_byte(s));
+}
+
+/* Decodes a block with the fixed codes */
+static void fixed(hmi_inflate_t *s)
+{
+    short lengths[288];
+    int i;
+
+    for(i = 0; i < 144; ++i)
+        lengths[i] = 8;
+    for(; i < 256; ++i)
+        lengths[i] = 9;
+    for(; i < 280; ++i)
+        lengths[i] = 7;
+    for(; i < 288; ++i)
+        lengths[i] = 8;
+    construct(s->length_count, s->length_symbol, lengths, 288);
+
+    for(i = 0; i < 30; ++i)
+        lengths[i] = 5;
+    construct(s->distance_count, s->distance_symbol, lengths, 30);
+
+    codes(s);
+}
+
+/* Decodes a block with dynamic codes */
+static void dynamic(hmi_inflate_t *s)
+{
+    static const short order[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+    };
+    short lengths[286 + 30];
+    int literal_count, distance_count, code_count;
+    int index, result;
+
+    literal_count = get_bits(s, 5) + 257;
+    distance_count = get_bits(s, 5) + 1;
+    code_count = get_bits(s, 4) + 4;
+    if(literal_count > 286 || distance_count > 30) {
+        s->error = HMI_BAD_FORMAT_ERROR;
+        return;
+    }
+
+    /* Code lengths of the code length code */
+    for(index = 0; index < code_count; ++index)
+        lengths[order[index]] = (short)get_bits(s, 3);
+    for(; index < 19; ++index)
+        lengths[order[index]] = 0;
+
+    if(construct(s->length_count, s->length_symbol, lengths, 19) != 0) {
+        s->error = HMI_BAD_FORMAT_ERROR;
+        return;
+    }
+
+    /* Code lengths of the literal/length and distance codes */
+    index = 0;
+    while(!s->error && index < literal_count + distance_count) {
+        int symbol = decode(s, s->length_count, s->length_symbol);
+        int value = 0;
+        int repeat;
+
+        if(symbol < 16) {
+            lengths[index++] = (short)symbol;
+            continue;
+        }
+
+        if(symbol == 16) {
+            if(index == 0) {
+                s->error = HMI_BAD_FORMAT_ERROR;
+                break;
+            }
+            value = lengths[index - 1];
+            repeat = 3 + get_bits(s, 2);
+        } else if(symbol == 17) {
+            repeat = 3 + get_bits(s, 3);
+        } else {
+            repeat = 11 + get_bits(s, 7);
+        }
+
+        if(index + repeat > literal_count + distance_count) {
+            s->error = HMI_BAD_FORMAT_ERROR;
+            break;
+        }
+        while(repeat-- > 0)
+            lengths[index++] = (short)value;
+    }
+
+    if(s->error)
+        return;
+
+    /* A block without end code could not terminate */
+    if(lengths[256] == 0) {
+        s->error = HMI_BAD_FORMAT_ERROR;
+        return;
+    }
+
+    /* Incomplete codes are only allowed for a single length */
+    result = construct(s->length_count, s->length_symbol,
+                       lengths, literal_count);
+    if(result < 0 || (result > 0 && literal_count !=
+                      s->length_count[0] + s->length_count[1]))
+    {
+        s->error = HMI_BAD_FORMAT_ERROR;
+        return;
+    }
+
+    result = construct(s->distance_count, s->distance_symbol,
+                       lengths + literal_count, distance_count);
+    if(result < 0 || (result > 0 && distance_count !=
+                      s->distance_count[0] + s->distance_count[1]))
+    {
+        s->error = HMI_BAD_FORMAT_ERROR;
+        return;
+    }
+
+    codes(s);
+}
+
+int hmi_inflate(hmi_inflate_t *state,
+                hmi_inflate_input_t input,
+                hmi_inflate_output_t output,
+                void *opaque)
+{
+    int last;
+
+    HMI_ASSERT(state && input && output);
+
+    state->input = input;
+    state->output = output;
+    state->opaque = opaque;
+    state->in = 0;
+    state->in_left = 0;
+    state->bits = 0;
+    state->bit_count = 0;
+    state->error = HMI_NO_ERROR;
+    state->total = 0;
+    state->flushed = 0;
+
+    do {
+        int type;
+
+        last = get_bits(state, 1);
+        type = get_bits(state, 2);
+        if(state->error)
+            break;
+
+        switch(type) {
+        case 0:
+            stored(state);
+            break;
+        case 1:
+            fixed(state);
+            break;
+        case 2:
+            dynamic(state);
+            break;
+        default:
+            state->error = HMI_BAD_FORMAT_ERROR;
+            break;
+        }
+    } while(!last && !state->error);
+
+    /* Pass on the remaining part of the window */
+    if(!state->error && state->total != state->flushed) {
+        state->error = output(opaque, state->window,
+                              (int)(state->total - state->flushed));
+        state->flushed = state->total;
+    }
+
+    return state->error;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#ifndef HMI_ENZ_INFLATE_H
+#define HMI_ENZ_INFLATE_H
+
+#include "../impl.h"
+
+#if !defined(HMI3D_NO_UPDATE) && !defined(HMI3D_NO_ENZ)
+
+/* ======== Internal Inflate Interface ======== */
+
+/* Typedef: hmi_inflate_input_t
+ *
+ * Provides the next chunk of compressed data.
+ *
+ * opaque - The opaque pointer of the <hmi_inflate_t>
+ * data   - Receives a pointer to the chunk
+ *
+ * Returns the size of the chunk, 0 at the end of the input or a negative
+ * error code.
+ */
+typedef int (*hmi_inflate_input_t)(void *opaque, const unsigned char **data);
+
+/* Typedef: hmi_inflate_output_t
+ *
+ * Consumes a chunk of decompressed data.
+ *
+ * Returns 0 on success or a negative error code that aborts decompression.
+ */
+typedef int (*hmi_inflate_output_t)(void *opaque,
+                                    const unsigned char *data,
+                                    int size);
+
+/* Structure: hmi_inflate_t
+ *
+ * State of a streaming raw deflate (RFC 1951) decoder.
+ *
+ * Only the 32 kB window of the output is kept. It is handed to the output
+ * function whenever it is full, so arbitrary large streams are decoded with
+ * a fixed amount of memory.
+ */
+typedef struct {
+    hmi_inflate_input_t input;
+    hmi_inflate_output_t output;
+    void *opaque;
+    /* Input */
+    const unsigned char *in;
+    int in_left;
+    unsigned int bits;
+    int bit_count;
+    int error;
+    /* Output window */
+    unsigned char window[32768];
+    unsigned int total;
+    unsigned int flushed;
+    /* Canonical Huffman codes of the current block */
+    short length_count[16];
+    short length_symbol[288];
+    short distance_count[16];
+    short distance_symbol[30];
+} hmi_inflate_t;
+
+/* Function: hmi_inflate
+ *
+ * Decompresses a complete raw deflate stream.
+ *
+ * state  - Memory for the decoder state
+ * input  - Function providing the compressed data
+ * output - Function consuming the decompressed data
+ * opaque - Opaque pointer that is passed to input and output
+ *
+ * Returns 0 on success, <HMI_BAD_FORMAT_ERROR> for malformed or truncated
+ * streams or the error returned by input or output.
+ */
+int hmi_inflate(hmi_inflate_t *state,
+                hmi_inflate_input_t input,
+                hmi_inflate_output_t output,
+                void *opaque);
+
+#endif
+
+#endif
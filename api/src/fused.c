@@ -0,0 +1,274 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "2d/2d.h"
+#include "3d/3d.h"
+
+#if !defined(HMI2D_NO_DATA_RETRIEVAL) && !defined(HMI3D_NO_DATA_RETRIEVAL)
+
+/* Limit of the messages that are handled by one call, so that a device
+ * that sends faster than they are handled can't stall the application
+ */
+#define FUSED_MAX_MESSAGES 256
+
+/* Interval between samples in seconds that is assumed without a platform
+ * timer, which is the interval of 3D data-frames
+ */
+#define FUSED_INTERVAL 0.005f
+
+#define FUSED_TWO_PI 6.28318531f
+
+/* Returns the time between two timestamps in seconds */
+static float fused_interval(unsigned int now, unsigned int last)
+{
+    float dt = (int)(now - last) * 1e-6f;
+    return (dt > 0) ? dt : FUSED_INTERVAL;
+}
+
+/* Smoothing factor of a first order low-pass filter */
+static float fused_alpha(float cutoff, float dt)
+{
+    float r = FUSED_TWO_PI * cutoff * dt;
+    return r / (r + 1.0f);
+}
+
+/* Advances the trajectory with the updated results */
+static void fuse_trajectory(hmi_t *hmi, int updated)
+{
+    hmi_fusion_t *fusion = &hmi->fusion;
+    const hmi_trajectory_config_t *config = &fusion->config;
+    hmi_trajectory_t *traj = &hmi->trajectory;
+    const hmi2d_finger_pos_list_t *fingers = &hmi->result2d.fingers;
+    const hmi3d_position_t *pos = &hmi->result.filtered_pos;
+    int previous = traj->state;
+    int state = hmi_trajectory_none;
+    int position = (updated & hmi_fused_3d) &&
+                   (hmi->result.valid & hmi3d_DataOutConfigMask_xyzPosition);
+    unsigned int now;
+    float x = 0, y = 0;
+    float dt, alpha, decay, eta;
+    int i;
+
+    traj->events = 0;
+    if(!fusion->enabled || !updated)
+        return;
+
+    /* The sample is as new as the newest data in it */
+    if(updated == (hmi_fused_3d | hmi_fused_2d))
+        now = ((int)(hmi->arrival2d - hmi->arrival3d) > 0) ?
+              hmi->arrival2d : hmi->arrival3d;
+    else
+        now = (updated & hmi_fused_2d) ? hmi->arrival2d : hmi->arrival3d;
+
+    if(fingers->count > 0) {
+        /* Follow the finger closest to the trajectory */
+        float best = 0;
+        for(i = 0; i < fingers->count; ++i) {
+            float dx = fingers->entry[i].x - traj->x;
+            float dy = fingers->entry[i].y - traj->y;
+            if(!i || dx * dx + dy * dy < best) {
+                best = dx * dx + dy * dy;
+                x = (float)fingers->entry[i].x;
+                y = (float)fingers->entry[i].y;
+            }
+        }
+        state = hmi_trajectory_touch;
+    } else if(hmi->result.valid & hmi3d_DataOutConfigMask_xyzPosition) {
+        x = config->offset_x + config->scale_x * pos->x;
+        y = config->offset_y + config->scale_y * pos->y;
+        state = hmi_trajectory_hover;
+    }
+
+    if(state == hmi_trajectory_touch && previous != hmi_trajectory_touch)
+        traj->events |= hmi_trajectory_down;
+    if(state != hmi_trajectory_touch && previous == hmi_trajectory_touch)
+        traj->events |= hmi_trajectory_up;
+
+    /* Hovering advances only with new 3D positions */
+    if(state == hmi_trajectory_hover && !position &&
+       (previous == hmi_trajectory_hover ||
+        previous == hmi_trajectory_approach))
+        return;
+
+    /* Touching advances only with new finger positions */
+    if(state == hmi_trajectory_touch && previous == hmi_trajectory_touch &&
+       !(updated & hmi_fused_2d)) {
+        if(position)
+            fusion->last_time3d = hmi->arrival3d;
+        return;
+    }
+
+    dt = fused_interval(now, fusion->last_time);
+    fusion->last_time = now;
+    traj->time = now;
+
+    if(state == hmi_trajectory_none || previous == hmi_trajectory_none) {
+        /* A new trajectory starts without a history */
+        traj->x = x;
+        traj->y = y;
+        traj->z = (state == hmi_trajectory_hover) ? (float)pos->z : 0;
+        traj->vx = traj->vy = traj->vz = 0;
+        fusion->offset[0] = fusion->offset[1] = 0;
+        fusion->last_time3d = hmi->arrival3d;
+        traj->state = state;
+        return;
+    }
+
+    if((state == hmi_trajectory_touch) != (previous == hmi_trajectory_touch)) {
+        /* Continue from the last sample instead of jumping between the
+         * 3D position and the finger
+         */
+        fusion->offset[0] = traj->x - x;
+        fusion->offset[1] = traj->y - y;
+    } else {
+        decay = config->blend_ms / (config->blend_ms + dt * 1000);
+        fusion->offset[0] *= decay;
+        fusion->offset[1] *= decay;
+    }
+    x += fusion->offset[0];
+    y += fusion->offset[1];
+
+    alpha = fused_alpha(config->cutoff, dt);
+    traj->vx += alpha * ((x - traj->x) / dt - traj->vx);
+    traj->vy += alpha * ((y - traj->y) / dt - traj->vy);
+    traj->x = x;
+    traj->y = y;
+
+    if(state == hmi_trajectory_touch) {
+        traj->z = 0;
+        traj->vz = 0;
+    } else if(position) {
+        float z = (float)pos->z;
+        float dt3 = fused_interval(hmi->arrival3d, fusion->last_time3d);
+        alpha = fused_alpha(config->cutoff, dt3);
+        traj->vz += alpha * ((z - traj->z) / dt3 - traj->vz);
+        traj->z = z;
+    }
+    if(position)
+        fusion->last_time3d = hmi->arrival3d;
+
+    /* Predict the touch-down from the speed of approach */
+    if(state == hmi_trajectory_hover && traj->vz < 0) {
+        eta = (traj->z > config->touch_z) ?
+              (traj->z - config->touch_z) / -traj->vz : 0;
+        if(eta * 1000 <= config->horizon_ms) {
+            state = hmi_trajectory_approach;
+            traj->eta_ms = eta * 1000;
+            traj->touch_x = traj->x + traj->vx * eta;
+            traj->touch_y = traj->y + traj->vy * eta;
+            if(previous != hmi_trajectory_approach)
+                traj->events |= hmi_trajectory_predicted;
+        }
+    }
+
+    traj->state = state;
+}
+
+int hmi_retrieve_fused(hmi_t *hmi, hmi_fused_t *fused)
+{
+    int error = HMI_NO_ERROR;
+    int last3d, last2d;
+    int updated = 0;
+    int skipped = 0;
+    int i;
+
+    HMI_ASSERT(hmi && HMI_CONNECTED(hmi));
+
+    last3d = hmi->result.frame_counter;
+    last2d = hmi->result2d.msg_counter;
+
+    for(i = 0; i < FUSED_MAX_MESSAGES; ++i) {
+        /* Receive and handle message */
+        error = hmi_message_receive(hmi, NULL);
+        if(error != HMI_NO_ERROR)
+            break;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffers from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(hmi->internal.frame_counter - last3d > 0) {
+        skipped = hmi->internal.frame_counter - last3d - 1;
+        hmi3d_update_result(hmi, last3d);
+        updated |= hmi_fused_3d;
+    }
+
+    if(hmi->internal2d.msg_counter - last2d > 0) {
+        hmi2d_update_result(hmi);
+        updated |= hmi_fused_2d;
+    }
+
+    fuse_trajectory(hmi, updated);
+
+    if(fused) {
+        fused->updated = updated;
+        fused->skipped = skipped;
+        fused->time = HMI_TIME_US();
+        fused->age3d = fused->time - hmi->arrival3d;
+        fused->age2d = fused->time - hmi->arrival2d;
+    }
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+#ifndef HMI_NO_RECORDER
+    /* Automatic dumps are written outside of message handling */
+    hmi_recorder_poll(hmi);
+#endif
+
+    if(updated)
+        return HMI_NO_ERROR;
+    return error == HMI_NO_ERROR ? HMI_NO_DATA : error;
+}
+
+int hmi_set_trajectory(hmi_t *hmi, const hmi_trajectory_config_t *config)
+{
+    HMI_ASSERT(hmi);
+
+    if(config && (config->touch_z < 0 || config->horizon_ms < 0 ||
+                  config->blend_ms < 0 || config->cutoff <= 0))
+        return HMI_BAD_PARAM_ERROR;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Synchronize against changes of internal buffers from message-handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    HMI_MEMSET(&hmi->trajectory, 0, sizeof(hmi->trajectory));
+    HMI_MEMSET(&hmi->fusion, 0, sizeof(hmi->fusion));
+    hmi->fusion.enabled = (config != NULL);
+    if(config)
+        hmi->fusion.config = *config;
+
+#if defined(HMI_SYNC_INTERRUPT) || defined(HMI_SYNC_THREADING)
+    /* Release synchronization against message-handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return HMI_NO_ERROR;
+}
+
+#endif
@@ -0,0 +1,453 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include "../impl.h"
+
+#ifndef HMI_NO_RECORDER
+
+#if defined(_WIN32) || defined(__linux__)
+#include <stdio.h>
+#endif
+
+#if HMI_RECORDER_CAPACITY & 3
+#   error "HMI_RECORDER_CAPACITY has to be a multiple of 4"
+#endif
+
+/* Each entry consists of an 8 byte header followed by the payload which is
+ * padded to a multiple of 4 bytes:
+ *
+ * time | 4 bytes | Timestamp as returned by HMI_TIME_US
+ * size | 2 bytes | Size of the payload without padding
+ * type | 1 byte  | The hmi_recorder_entry_type_t of the entry
+ *      | 1 byte  | Reserved
+ *
+ * The entries are stored back-to-back in the ring buffer and might wrap
+ * around at its end. Therefore the used part of the buffer consists of at
+ * most two contiguous segments.
+ */
+#define ENTRY_HEADER_SIZE 8
+#define ENTRY_SIZE(PAYLOAD) (ENTRY_HEADER_SIZE + (((PAYLOAD) + 3) & ~3))
+
+static int ring_offset(int offset)
+{
+    return offset >= HMI_RECORDER_CAPACITY ?
+                offset - HMI_RECORDER_CAPACITY : offset;
+}
+
+static void ring_write(hmi_recorder_t *rec, int offset,
+                       const void *data, int size)
+{
+    int first = HMI_RECORDER_CAPACITY - offset;
+    if(first > size)
+        first = size;
+
+    HMI_MEMCPY(rec->buffer + offset, data, first);
+    if(size > first)
+        HMI_MEMCPY(rec->buffer, (const unsigned char *)data + first,
+                   size - first);
+}
+
+static int ring_entry_size(const hmi_recorder_t *rec, int offset)
+{
+    /* Headers are aligned to 4 bytes, but the size field still wraps when
+     * the header starts 4 bytes before the end
+     */
+    return ENTRY_SIZE(rec->buffer[ring_offset(offset + 4)] |
+                      (rec->buffer[ring_offset(offset + 5)] << 8));
+}
+
+static void update_window(hmi_recorder_t *rec, unsigned int now)
+{
+    unsigned int window = (unsigned int)rec->triggers.window_ms * 1000;
+
+    if(now - rec->window_start >= window) {
+        rec->window_start = now;
+        rec->bad_data = 0;
+        rec->calibrations = 0;
+    }
+}
+
+void hmi_recorder_init(hmi_t *hmi)
+{
+    hmi_recorder_t *rec = &hmi->recorder;
+
+    rec->enabled = 1;
+    rec->triggers.window_ms = 1000;
+    rec->triggers.bad_data_limit = 10;
+    rec->triggers.calibration_limit = 5;
+    rec->triggers.stall_ms = 500;
+    rec->triggers.holdoff_ms = 10000;
+    rec->window_start = HMI_TIME_US();
+}
+
+/* Appends an entry while the synchronization is already held */
+static void ring_add(hmi_t *hmi, int type, const void *data, int size)
+{
+    hmi_recorder_t *rec = &hmi->recorder;
+    unsigned char header[ENTRY_HEADER_SIZE];
+    int needed = ENTRY_SIZE(size);
+    int tail;
+
+    if(!rec->enabled || needed > HMI_RECORDER_CAPACITY)
+        return;
+
+    tail = ring_offset(rec->head + rec->used);
+
+    /* While a dump is written the entries of its snapshot must not be
+     * overwritten, so entries that don't fit in front of it are dropped
+     */
+    if(rec->dumping && rec->snap_used) {
+        int room = rec->snap_head - tail;
+        if(room < 0)
+            room += HMI_RECORDER_CAPACITY;
+        if(needed > room)
+            return;
+    }
+
+    /* Discard the oldest entries until the new entry fits */
+    while(rec->used + needed > HMI_RECORDER_CAPACITY) {
+        int old = ring_entry_size(rec, rec->head);
+        rec->head = ring_offset(rec->head + old);
+        rec->used -= old;
+        rec->count--;
+    }
+
+    SET_U32(header, HMI_TIME_US());
+    SET_U16(header + 4, size);
+    SET_U8(header + 6, type);
+    SET_U8(header + 7, 0);
+
+    ring_write(rec, tail, header, ENTRY_HEADER_SIZE);
+    ring_write(rec, ring_offset(tail + ENTRY_HEADER_SIZE), data, size);
+
+    rec->used += needed;
+    rec->count++;
+}
+
+void hmi_recorder_add(hmi_t *hmi, int type, const void *data, int size)
+{
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against dumps from the application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    ring_add(hmi, type, data, size);
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against dumps */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi_recorder_frame(hmi_t *hmi, int calibration)
+{
+    hmi_recorder_t *rec = &hmi->recorder;
+    unsigned int now = HMI_TIME_US();
+
+#ifndef HMI3D_NO_DATA_RETRIEVAL
+    /* The raw message is already recorded, so the frame only keeps what
+     * the host derived from it
+     */
+    const hmi3d_input_data_t *dest = &hmi->internal;
+    unsigned char frame[16];
+
+    SET_U32(frame, dest->frame_counter);
+    SET_U16(frame + 4, dest->valid);
+    SET_U16(frame + 6, dest->filtered_pos.x);
+    SET_U16(frame + 8, dest->filtered_pos.y);
+    SET_U16(frame + 10, dest->filtered_pos.z);
+    SET_U16(frame + 12, dest->gesture.gesture);
+    SET_U16(frame + 14, 0);
+    ring_add(hmi, hmi_rec_3d_frame, frame, sizeof(frame));
+#endif
+
+    rec->streaming = 1;
+    rec->last_frame = now;
+
+    if(calibration) {
+        update_window(rec, now);
+        rec->calibrations++;
+        if(rec->triggers.calibration_limit &&
+                rec->calibrations >= rec->triggers.calibration_limit)
+            rec->pending |= hmi_rec_trigger_calibration;
+    }
+}
+
+void hmi_recorder_bad_data(hmi_t *hmi)
+{
+    hmi_recorder_t *rec = &hmi->recorder;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi_recorder_poll from the application */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    update_window(rec, HMI_TIME_US());
+    rec->bad_data++;
+    if(rec->triggers.bad_data_limit &&
+            rec->bad_data >= rec->triggers.bad_data_limit)
+        rec->pending |= hmi_rec_trigger_bad_data;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi_recorder_poll */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi_recorder_set_enabled(hmi_t *hmi, int enabled)
+{
+    HMI_ASSERT(hmi);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against recording from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->recorder.enabled = enabled ? 1 : 0;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi_recorder_clear(hmi_t *hmi)
+{
+    hmi_recorder_t *rec;
+
+    HMI_ASSERT(hmi);
+
+    rec = &hmi->recorder;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against recording from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    /* The ring restarts at the current end, so a dump that is being
+     * written keeps its snapshot
+     */
+    rec->head = ring_offset(rec->head + rec->used);
+    rec->used = 0;
+    rec->count = 0;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi_recorder_set_triggers(hmi_t *hmi,
+                               const hmi_recorder_triggers_t *triggers)
+{
+    HMI_ASSERT(hmi && triggers);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against trigger updates from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->recorder.triggers = *triggers;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+void hmi_recorder_set_target(hmi_t *hmi,
+                             hmi_recorder_writer_t writer,
+                             void *opaque)
+{
+    HMI_ASSERT(hmi);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against hmi_recorder_poll from other threads */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    hmi->recorder.writer = writer;
+    hmi->recorder.opaque = opaque;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against hmi_recorder_poll */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+}
+
+/* Writes a snapshot of the ring. The synchronization is only held to take
+ * and to release the snapshot, so message handlers keep recording into the
+ * free space while the writer runs.
+ */
+static int dump(hmi_t *hmi, int triggers,
+                hmi_recorder_writer_t writer, void *opaque)
+{
+    hmi_recorder_t *rec = &hmi->recorder;
+    unsigned char header[8] = { 'H', 'M', 'I', 'R' };
+    unsigned char marker[4];
+    int head, used, first, result = HMI_NO_ERROR;
+
+    SET_U16(header + 4, 1);
+    SET_U16(header + 6, 0);
+    SET_U32(marker, triggers);
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against recording from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    if(rec->dumping) {
+        result = HMI_NO_DATA;
+    } else {
+        /* Mark the dump within the recording itself */
+        ring_add(hmi, hmi_rec_trigger, marker, sizeof(marker));
+
+        rec->dumping = 1;
+        rec->snap_head = rec->head;
+        rec->snap_used = rec->used;
+    }
+    head = rec->snap_head;
+    used = rec->snap_used;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    if(result)
+        return result;
+
+    first = HMI_RECORDER_CAPACITY - head;
+    if(first > used)
+        first = used;
+
+    if(writer(opaque, header, sizeof(header)))
+        result = HMI_IO_ERROR;
+    if(!result && first && writer(opaque, rec->buffer + head, first))
+        result = HMI_IO_ERROR;
+    if(!result && used > first &&
+            writer(opaque, rec->buffer, used - first))
+        result = HMI_IO_ERROR;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against recording from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    rec->dumping = 0;
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    return result;
+}
+
+int hmi_recorder_dump(hmi_t *hmi, hmi_recorder_writer_t writer, void *opaque)
+{
+    HMI_ASSERT(hmi && writer);
+
+    return dump(hmi, hmi_rec_trigger_manual, writer, opaque);
+}
+
+int hmi_recorder_poll(hmi_t *hmi)
+{
+    hmi_recorder_t *rec;
+    hmi_recorder_writer_t writer = NULL;
+    void *opaque = NULL;
+    unsigned int now = HMI_TIME_US();
+    unsigned int stall, holdoff;
+    int triggers = 0;
+    int result;
+
+    HMI_ASSERT(hmi);
+
+    rec = &hmi->recorder;
+
+#ifdef HMI_SYNC_THREADING
+    /* Synchronize against trigger updates from message handlers */
+    HMI_SYNC_LOCK(hmi->io_sync);
+#endif
+
+    stall = (unsigned int)rec->triggers.stall_ms * 1000;
+    holdoff = (unsigned int)rec->triggers.holdoff_ms * 1000;
+
+    /* A stall is only reported once until the stream continues */
+    if(rec->streaming && stall && now - rec->last_frame >= stall) {
+        rec->streaming = 0;
+        rec->pending |= hmi_rec_trigger_stall;
+    }
+
+    if(rec->pending) {
+        if(rec->writer && (!rec->dumps || now - rec->last_dump >= holdoff)) {
+            triggers = rec->pending;
+            writer = rec->writer;
+            opaque = rec->opaque;
+            rec->last_dump = now;
+            rec->dumps++;
+        }
+        /* Triggers during the holdoff are dropped */
+        rec->pending = 0;
+    }
+
+#ifdef HMI_SYNC_THREADING
+    /* Release synchronization against message handlers */
+    HMI_SYNC_UNLOCK(hmi->io_sync);
+#endif
+
+    if(!triggers)
+        return 0;
+
+    result = dump(hmi, triggers, writer, opaque);
+    return result == HMI_NO_ERROR ? triggers : result;
+}
+
+#if defined(_WIN32) || defined(__linux__)
+
+static int CDECL file_writer(void *opaque, const void *data, int size)
+{
+    return fwrite(data, 1, size, (FILE *)opaque) == (size_t)size ? 0 : -1;
+}
+
+int hmi_recorder_dump_file(hmi_t *hmi, const char *filename)
+{
+    FILE *file;
+    int result;
+
+    HMI_ASSERT(hmi && filename);
+
+    file = fopen(filename, "wb");
+    if(!file)
+        return HMI_IO_OPEN_ERROR;
+
+    result = hmi_recorder_dump(hmi, file_writer, file);
+
+    if(fclose(file) && result == HMI_NO_ERROR)
+        result = HMI_IO_ERROR;
+
+    return result;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#ifndef HMI_RECORDER_H
+#define HMI_RECORDER_H
+
+#ifndef HMI_NO_RECORDER
+
+/* ======== Internal Flight Recorder Interface ======== */
+
+/* Function: hmi_recorder_init
+ *
+ * Enables the flight recorder and sets the default triggers.
+ *
+ * This function is called by <hmi_initialize>.
+ */
+void hmi_recorder_init(hmi_t *hmi);
+
+/* Function: hmi_recorder_add
+ *
+ * Appends one entry to the ring buffer of the flight recorder.
+ *
+ * type - The <hmi_recorder_entry_type_t> of the entry
+ * data - The payload of the entry
+ * size - The size of the payload in bytes
+ *
+ * The oldest entries get discarded until the new entry fits.
+ * This function is called for every incoming message and therefore only
+ * copies the payload. It synchronizes against dumps by itself, so callers
+ * must not hold the synchronization.
+ */
+void hmi_recorder_add(hmi_t *hmi, int type, const void *data, int size);
+
+/* Function: hmi_recorder_frame
+ *
+ * Records the host side results of a 3D frame in a compact entry and
+ * updates the stall and calibration triggers.
+ *
+ * calibration - Nonzero if the frame reported a calibration
+ *
+ * Called by <hmi3d_handle_data_output> after the frame was decoded while
+ * the synchronization against the application is held.
+ */
+void hmi_recorder_frame(hmi_t *hmi, int calibration);
+
+/* Function: hmi_recorder_bad_data
+ *
+ * Counts a report of malformed incoming data for the bad data trigger.
+ *
+ * The function synchronizes against the application by itself, so callers
+ * must not hold the synchronization.
+ *
+ * See also:
+ *    <HMI_REPORT_BAD_DATA>
+ */
+void hmi_recorder_bad_data(hmi_t *hmi);
+
+/* Macro: HMI_REPORT_BAD_DATA
+ *
+ * Forwards a report of malformed incoming data to HMI_BAD_DATA and counts
+ * it for the flight recorder.
+ */
+#define HMI_REPORT_BAD_DATA(HMI, FUNC, MSG, VALUE1, VALUE2) \
+    do { \
+        hmi_recorder_bad_data(HMI); \
+        HMI_BAD_DATA(FUNC, MSG, VALUE1, VALUE2); \
+    } while(0)
+
+#else
+
+#define HMI_REPORT_BAD_DATA(HMI, FUNC, MSG, VALUE1, VALUE2) \
+    HMI_BAD_DATA(FUNC, MSG, VALUE1, VALUE2)
+
+#endif
+
+#endif /* HMI_RECORDER_H */
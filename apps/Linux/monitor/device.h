@@ -1,67 +1,67 @@
-/******************************************************************************
- *
- * Copyright (C) 2014 Microchip Technology Inc. and its
- *                    subsidiaries ("Microchip").
- *
- * All rights reserved.
- *
- * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
- * accompanying software with Microchip products.  Refer to the license
- * agreement accompanying this software, if any, for additional info regarding
- * your rights and obligations.
- *
- * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
- * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
- * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
- * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
- * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
- * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
- * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
- * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
- *
- ******************************************************************************/
-#pragma once
-
-#include <hmi_api.h>
-#include <stdio.h>
-//#include <curses.h>
-
-#define FLICK_TIMEOUT 200
-
-typedef struct 
-{
-    int running;
-    int menu_current;
-    int auto_calib;
-    int last_gesture;
-    int touch_detect;
-    int air_wheel;
-    int last_mouse;
-    int mouse_countdown;
-
-    /* Common */
-    hmi_t *hmi;
-
-    /* 3D */
-    hmi3d_position_t *out_pos;
-    hmi3d_gesture_t *out_gesture;
-    hmi3d_signal_t *out_sd;
-    hmi3d_calib_t *out_calib;
-    hmi3d_touch_t *out_touch;
-    hmi3d_air_wheel_t *out_air_wheel;
-
-    /* 2D */
-    hmi2d_finger_pos_list_t *fingers;
-    hmi2d_mouse_t *mouse;
-} data_t;
-
-void init_data(data_t *data);
-void init_device(data_t *data);
-void free_device(data_t *data);
-void update_device(data_t *data);
-
-void switch_auto_calib(data_t *data);
-void calibrate_now(data_t *data);
-
-void switch_touch_detect(data_t *data);
-void switch_air_wheel(data_t *data);
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <hmi_api.h>
+#include <stdio.h>
+//#include <curses.h>
+
+#define FLICK_TIMEOUT 200
+
+typedef struct 
+{
+    int running;
+    int menu_current;
+    int auto_calib;
+    int last_gesture;
+    int touch_detect;
+    int air_wheel;
+    int last_mouse;
+    int mouse_countdown;
+
+    /* Common */
+    hmi_t *hmi;
+
+    /* 3D */
+    hmi3d_position_t *out_pos;
+    hmi3d_gesture_t *out_gesture;
+    hmi3d_signal_t *out_sd;
+    hmi3d_calib_t *out_calib;
+    hmi3d_touch_t *out_touch;
+    hmi3d_air_wheel_t *out_air_wheel;
+
+    /* 2D */
+    hmi2d_finger_pos_list_t *fingers;
+    hmi2d_mouse_t *mouse;
+} data_t;
+
+void init_data(data_t *data);
+void init_device(data_t *data);
+void free_device(data_t *data);
+void update_device(data_t *data);
+
+void switch_auto_calib(data_t *data);
+void calibrate_now(data_t *data);
+
+void switch_touch_detect(data_t *data);
+void switch_air_wheel(data_t *data);
@@ -0,0 +1,178 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2014 Microchip Technology Inc. and its
+ *                    subsidiaries ("Microchip").
+ *
+ * All rights reserved.
+ *
+ * You are permitted to use the Aurea software, 3DTouchPad SDK, and other
+ * accompanying software with Microchip products.  Refer to the license
+ * agreement accompanying this software, if any, for additional info regarding
+ * your rights and obligations.
+ *
+ * SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+ * MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR
+ * PURPOSE. IN NO EVENT SHALL MICROCHIP, SMSC, OR ITS LICENSORS BE LIABLE OR
+ * OBLIGATED UNDER CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH
+ * OF WARRANTY, OR OTHER LEGAL EQUITABLE THEORY FOR ANY DIRECT OR INDIRECT
+ * DAMAGES OR EXPENSES INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL,
+ * INDIRECT OR CONSEQUENTIAL DAMAGES, OR OTHER SIMILAR COSTS.
+ *
+ ******************************************************************************/
+#include <hmi_api.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Programs the 3D firmware of an ENZ-package into the device or checks the
+ * package for inconsistencies. Other than MGCConv no conversion to a
+ * C-structure and no rebuild are required.
+ */
+
+static void usage(void)
+{
+    printf("Usage: programmer <options> <input.enz>\n"
+           "\n"
+           "Options:\n"
+           "    -h, --help\n"
+           "        show this help page\n"
+           "    -c, --check\n"
+           "        validate the input file instead of programming it\n"
+           "    -w, --what <image>\n"
+           "        select whether library or loader image should be used\n"
+           "    -v, --verify\n"
+           "        only verify the image against the flash of the device\n");
+}
+
+static void CDECL print_problem(void *opaque, const char *problem)
+{
+    (void)opaque;
+    printf("%s\n", problem);
+}
+
+static int check(hmi3d_enz_source_t *source, const char *filename)
+{
+    int problems;
+
+    printf("Checking %s for inconsistencies\n", filename);
+    problems = hmi3d_enz_check(source, print_problem, 0);
+    if(problems < 0) {
+        printf("Could not read %s (%d)\n", filename, problems);
+        return 1;
+    }
+
+    printf("%d problem(s) found\n", problems);
+    return problems ? 1 : 0;
+}
+
+static int program(hmi3d_enz_source_t *source, hmi3d_enz_image_t image,
+                   hmi3d_UpdateFunction_t mode)
+{
+    hmi3d_enz_info_t info;
+    hmi_t *hmi;
+    int error;
+
+    error = hmi3d_enz_info(source, image, &info);
+    if(error) {
+        printf("Image is missing or malformed (%d), run with -c for "
+               "details\n", error);
+        return 1;
+    }
+    info.fw_version[sizeof(info.fw_version) - 1] = 0;
+    printf("%s %d records of %s\n",
+           mode == hmi3d_UpdateFunction_VerifyOnly ? "Verifying" : "Programming",
+           info.record_count, (char *)info.fw_version);
+
+    hmi = hmi_create();
+    hmi_initialize(hmi);
+    if(hmi_open(hmi) < 0) {
+        printf("Could not open connection to device.\n");
+        hmi_free(hmi);
+        return 1;
+    }
+
+    srand((unsigned int)time(0));
+    error = hmi3d_enz_update(hmi, (unsigned int)rand() | 1, source, image,
+                             mode);
+
+    /* The loader finishes its update before it accepts a library */
+    if(!error && image == hmi3d_EnzImage_Loader &&
+            mode == hmi3d_UpdateFunction_ProgramFlash)
+    {
+        printf("Waiting for the loader update to complete\n");
+        error = hmi3d_update_wait_loader_done(hmi);
+    }
+
+    if(error == HMI_3D_SYSTEM_ERROR && mode == hmi3d_UpdateFunction_VerifyOnly)
+        printf("Flash content does not match the image\n");
+    else if(error)
+        printf("Failed with error %d\n", error);
+    else
+        printf("Done\n");
+
+    hmi_close(hmi);
+    hmi_cleanup(hmi);
+    hmi_free(hmi);
+
+    return error ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    hmi3d_enz_source_t source;
+    hmi3d_enz_image_t image = hmi3d_EnzImage_Library;
+    hmi3d_UpdateFunction_t mode = hmi3d_UpdateFunction_ProgramFlash;
+    const char *filename = 0;
+    int check_only = 0;
+    int result;
+    int i;
+
+    for(i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if(!strcmp(arg, "-h") || !strcmp(arg, "--help")) {
+            usage();
+            return 0;
+        } else if(!strcmp(arg, "-c") || !strcmp(arg, "--check")) {
+            check_only = 1;
+        } else if(!strcmp(arg, "-v") || !strcmp(arg, "--verify")) {
+            mode = hmi3d_UpdateFunction_VerifyOnly;
+        } else if((!strcmp(arg, "-w") || !strcmp(arg, "--what")) &&
+                  i + 1 < argc) {
+            arg = argv[++i];
+            if(!strcmp(arg, "library")) {
+                image = hmi3d_EnzImage_Library;
+            } else if(!strcmp(arg, "loader")) {
+                image = hmi3d_EnzImage_Loader;
+            } else {
+                printf("Unknown image %s\n", arg);
+                return 1;
+            }
+        } else if(arg[0] != '-' && !filename) {
+            filename = arg;
+        } else {
+            printf("Try 'programmer --help' for more information.\n");
+            return 1;
+        }
+    }
+
+    if(!filename) {
+        usage();
+        return 1;
+    }
+
+    if(hmi3d_enz_open_file(&source, filename)) {
+        printf("Could not open %s\n", filename);
+        return 1;
+    }
+
+    if(check_only)
+        result = check(&source, filename);
+    else
+        result = program(&source, image, mode);
+
+    hmi3d_enz_close_file(&source);
+
+    return result;
+}